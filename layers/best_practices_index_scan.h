@@ -0,0 +1,275 @@
+/* Copyright (c) 2022 The Khronos Group Inc.
+ * Copyright (c) 2022 Valve Corporation
+ * Copyright (c) 2022 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+// Models a FIFO post-transform vertex cache. Rather than searching the FIFO for every index, each index is hashed to a
+// direct-mapped tag slot remembering when the index was inserted, and it hits while fewer than kCacheSize newer vertices
+// have been inserted since. Two live indices sharing a slot evict each other early, slightly under-estimating hit rates.
+class PostTransformCacheModel {
+  public:
+    static constexpr uint32_t kCacheSize = 32;
+
+    PostTransformCacheModel() : slots_(), insertions_(kCacheSize) {}
+
+    // Returns true if there was a cache hit, otherwise models the vertex being shaded and inserted into the cache.
+    bool QueryCache(uint32_t value) {
+        Slot& slot = slots_[(value * 0x9E3779B1u) >> (32 - kSlotBits)];
+        if (slot.value == value && insertions_ - slot.inserted_at < kCacheSize) return true;
+        slot.value = value;
+        slot.inserted_at = ++insertions_;
+        return false;
+    }
+
+  private:
+    // 8x the cache size keeps tag collisions between the kCacheSize live entries rare
+    static constexpr uint32_t kSlotBits = 8;
+
+    struct Slot {
+        uint32_t value;
+        uint32_t inserted_at;
+    };
+    Slot slots_[1u << kSlotBits];
+    uint32_t insertions_;
+};
+
+// Index buffer scanning for the Arm index buffer checks. The min/max reduction has no ordering dependency and is
+// vectorized per index width; the post-transform cache model is order dependent and stays a single scalar pass.
+template <typename IndexType>
+struct IndexScanTraits {
+    static constexpr uint32_t kPrimitiveRestart = std::numeric_limits<IndexType>::max();
+
+    // Index buffers are only required to be aligned to the index size by the offset given to vkCmdBindIndexBuffer,
+    // so avoid relying on the alignment of the mapped pointer.
+    static IndexType Load(const uint8_t* ptr) {
+        IndexType value;
+        std::memcpy(&value, ptr, sizeof(IndexType));
+        return value;
+    }
+
+    static void MinMaxScalar(const uint8_t* begin, size_t count, uint32_t& min_index, uint32_t& max_index) {
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t index = Load(begin + i * sizeof(IndexType));
+            min_index = std::min(min_index, index);
+            max_index = std::max(max_index, index);
+        }
+    }
+
+    template <typename Lane, size_t kLanes>
+    static void ReduceLanes(const Lane (&lanes_min)[kLanes], const Lane (&lanes_max)[kLanes], Lane bias, uint32_t& min_index,
+                            uint32_t& max_index) {
+        for (size_t i = 0; i < kLanes; ++i) {
+            min_index = std::min(min_index, static_cast<uint32_t>(static_cast<IndexType>(lanes_min[i] ^ bias)));
+            max_index = std::max(max_index, static_cast<uint32_t>(static_cast<IndexType>(lanes_max[i] ^ bias)));
+        }
+    }
+};
+
+template <typename IndexType>
+constexpr uint32_t IndexScanTraits<IndexType>::kPrimitiveRestart;
+
+// Widens the running [min_index, max_index] range by the indices in [begin, begin + count * sizeof(IndexType)).
+template <typename IndexType>
+void ScanIndexRange(const uint8_t* begin, size_t count, uint32_t& min_index, uint32_t& max_index);
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+// SSE2 only has unsigned min/max for 8-bit lanes, 16-bit and 32-bit lanes are biased into the signed range instead.
+template <>
+inline void ScanIndexRange<uint8_t>(const uint8_t* begin, size_t count, uint32_t& min_index, uint32_t& max_index) {
+    using Traits = IndexScanTraits<uint8_t>;
+    const size_t vector_count = count & ~size_t(15);
+    if (vector_count) {
+        __m128i v_min = _mm_set1_epi8(-1);
+        __m128i v_max = _mm_setzero_si128();
+        for (size_t i = 0; i < vector_count; i += 16) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + i));
+            v_min = _mm_min_epu8(v_min, v);
+            v_max = _mm_max_epu8(v_max, v);
+        }
+        uint8_t lanes_min[16], lanes_max[16];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes_min), v_min);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes_max), v_max);
+        Traits::ReduceLanes<uint8_t, 16>(lanes_min, lanes_max, 0, min_index, max_index);
+    }
+    Traits::MinMaxScalar(begin + vector_count, count - vector_count, min_index, max_index);
+}
+
+template <>
+inline void ScanIndexRange<uint16_t>(const uint8_t* begin, size_t count, uint32_t& min_index, uint32_t& max_index) {
+    using Traits = IndexScanTraits<uint16_t>;
+    const size_t vector_count = count & ~size_t(7);
+    if (vector_count) {
+        const __m128i bias = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+        __m128i v_min = _mm_set1_epi16(0x7FFF);
+        __m128i v_max = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+        for (size_t i = 0; i < vector_count; i += 8) {
+            const __m128i v =
+                _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + i * sizeof(uint16_t))), bias);
+            v_min = _mm_min_epi16(v_min, v);
+            v_max = _mm_max_epi16(v_max, v);
+        }
+        uint16_t lanes_min[8], lanes_max[8];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes_min), v_min);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes_max), v_max);
+        Traits::ReduceLanes<uint16_t, 8>(lanes_min, lanes_max, 0x8000, min_index, max_index);
+    }
+    Traits::MinMaxScalar(begin + vector_count * sizeof(uint16_t), count - vector_count, min_index, max_index);
+}
+
+template <>
+inline void ScanIndexRange<uint32_t>(const uint8_t* begin, size_t count, uint32_t& min_index, uint32_t& max_index) {
+    using Traits = IndexScanTraits<uint32_t>;
+    const size_t vector_count = count & ~size_t(3);
+    if (vector_count) {
+        const __m128i bias = _mm_set1_epi32(static_cast<int32_t>(0x80000000u));
+        __m128i v_min = _mm_set1_epi32(0x7FFFFFFF);
+        __m128i v_max = bias;
+        for (size_t i = 0; i < vector_count; i += 4) {
+            const __m128i v =
+                _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + i * sizeof(uint32_t))), bias);
+            const __m128i less = _mm_cmpgt_epi32(v_min, v);
+            const __m128i greater = _mm_cmpgt_epi32(v, v_max);
+            v_min = _mm_or_si128(_mm_and_si128(less, v), _mm_andnot_si128(less, v_min));
+            v_max = _mm_or_si128(_mm_and_si128(greater, v), _mm_andnot_si128(greater, v_max));
+        }
+        uint32_t lanes_min[4], lanes_max[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes_min), v_min);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes_max), v_max);
+        Traits::ReduceLanes<uint32_t, 4>(lanes_min, lanes_max, 0x80000000u, min_index, max_index);
+    }
+    Traits::MinMaxScalar(begin + vector_count * sizeof(uint32_t), count - vector_count, min_index, max_index);
+}
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+template <>
+inline void ScanIndexRange<uint8_t>(const uint8_t* begin, size_t count, uint32_t& min_index, uint32_t& max_index) {
+    using Traits = IndexScanTraits<uint8_t>;
+    const size_t vector_count = count & ~size_t(15);
+    if (vector_count) {
+        uint8x16_t v_min = vdupq_n_u8(0xFF);
+        uint8x16_t v_max = vdupq_n_u8(0);
+        for (size_t i = 0; i < vector_count; i += 16) {
+            const uint8x16_t v = vld1q_u8(begin + i);
+            v_min = vminq_u8(v_min, v);
+            v_max = vmaxq_u8(v_max, v);
+        }
+        uint8_t lanes_min[16], lanes_max[16];
+        vst1q_u8(lanes_min, v_min);
+        vst1q_u8(lanes_max, v_max);
+        Traits::ReduceLanes<uint8_t, 16>(lanes_min, lanes_max, 0, min_index, max_index);
+    }
+    Traits::MinMaxScalar(begin + vector_count, count - vector_count, min_index, max_index);
+}
+
+template <>
+inline void ScanIndexRange<uint16_t>(const uint8_t* begin, size_t count, uint32_t& min_index, uint32_t& max_index) {
+    using Traits = IndexScanTraits<uint16_t>;
+    const size_t vector_count = count & ~size_t(7);
+    if (vector_count) {
+        uint16x8_t v_min = vdupq_n_u16(0xFFFF);
+        uint16x8_t v_max = vdupq_n_u16(0);
+        for (size_t i = 0; i < vector_count; i += 8) {
+            const uint16x8_t v = vreinterpretq_u16_u8(vld1q_u8(begin + i * sizeof(uint16_t)));
+            v_min = vminq_u16(v_min, v);
+            v_max = vmaxq_u16(v_max, v);
+        }
+        uint16_t lanes_min[8], lanes_max[8];
+        vst1q_u16(lanes_min, v_min);
+        vst1q_u16(lanes_max, v_max);
+        Traits::ReduceLanes<uint16_t, 8>(lanes_min, lanes_max, 0, min_index, max_index);
+    }
+    Traits::MinMaxScalar(begin + vector_count * sizeof(uint16_t), count - vector_count, min_index, max_index);
+}
+
+template <>
+inline void ScanIndexRange<uint32_t>(const uint8_t* begin, size_t count, uint32_t& min_index, uint32_t& max_index) {
+    using Traits = IndexScanTraits<uint32_t>;
+    const size_t vector_count = count & ~size_t(3);
+    if (vector_count) {
+        uint32x4_t v_min = vdupq_n_u32(0xFFFFFFFFu);
+        uint32x4_t v_max = vdupq_n_u32(0);
+        for (size_t i = 0; i < vector_count; i += 4) {
+            const uint32x4_t v = vreinterpretq_u32_u8(vld1q_u8(begin + i * sizeof(uint32_t)));
+            v_min = vminq_u32(v_min, v);
+            v_max = vmaxq_u32(v_max, v);
+        }
+        uint32_t lanes_min[4], lanes_max[4];
+        vst1q_u32(lanes_min, v_min);
+        vst1q_u32(lanes_max, v_max);
+        Traits::ReduceLanes<uint32_t, 4>(lanes_min, lanes_max, 0, min_index, max_index);
+    }
+    Traits::MinMaxScalar(begin + vector_count * sizeof(uint32_t), count - vector_count, min_index, max_index);
+}
+#else
+template <typename IndexType>
+void ScanIndexRange(const uint8_t* begin, size_t count, uint32_t& min_index, uint32_t& max_index) {
+    IndexScanTraits<IndexType>::MinMaxScalar(begin, count, min_index, max_index);
+}
+#endif
+
+// Second pass over the indices, once their range is known: models the post-transform cache to estimate how many
+// vertices get shaded, and counts how many distinct vertices in [min_index, max_index] the draw references.
+template <typename IndexType>
+void ScanIndexReuse(const uint8_t* begin, size_t count, bool primitive_restart_enable, uint32_t min_index,
+                           uint32_t max_index, uint32_t& vertex_shade_count, uint32_t& vertex_reference_count) {
+    using Traits = IndexScanTraits<IndexType>;
+
+    // The size of the cache being modelled positively correlates with how much behaviour it can capture about
+    // arbitrary ground-truth hardware/architecture cache behaviour. I.e. it's a good solution when we don't know the
+    // target architecture.
+    // However, modelling a post-transform cache with more than 32 elements gives diminishing returns in practice.
+    // http://eelpi.gotdns.org/papers/fast_vert_cache_opt.html
+    PostTransformCacheModel post_transform_cache;
+
+    // use a dynamic vector of bitsets as a memory-compact representation of which indices are included in the draw call
+    // each bit of the n-th bucket contains the inclusion information for indices (n*n_buckets) to ((n+1)*n_buckets)
+    const size_t refs_per_bucket = 64;
+    const size_t n_indices = static_cast<size_t>(max_index - min_index) + 1;
+    std::vector<std::bitset<refs_per_bucket>> vertex_reference_buckets((n_indices + refs_per_bucket - 1) / refs_per_bucket);
+
+    vertex_shade_count = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t scan_index = Traits::Load(begin + i * sizeof(IndexType));
+
+        if (!primitive_restart_enable || scan_index != Traits::kPrimitiveRestart) {
+            // if the shaded vertex corresponding to the index is not in the PT-cache, we need to shade again
+            if (!post_transform_cache.QueryCache(scan_index)) vertex_shade_count++;
+        }
+
+        // keep track of the set of all indices used to reference vertices in the draw call
+        const size_t index_offset = scan_index - min_index;
+        vertex_reference_buckets[index_offset / refs_per_bucket].set(index_offset % refs_per_bucket);
+    }
+
+    vertex_reference_count = 0;
+    for (const auto& bitset : vertex_reference_buckets) {
+        vertex_reference_count += static_cast<uint32_t>(bitset.count());
+    }
+}
@@ -27,6 +27,7 @@
 #include "cmd_buffer_state.h"
 #include "device_state.h"
 #include "render_pass_state.h"
+#include "best_practices_index_scan.h"
 
 #include <string>
 #include <bitset>
@@ -1775,8 +1776,8 @@ void BestPractices::QueueValidateImage(QueueCallbacks& funcs, const char* functi
 
 void BestPractices::QueueValidateImage(QueueCallbacks& funcs, const char* function_name, std::shared_ptr<bp_state::Image>& state,
                                        IMAGE_SUBRESOURCE_USAGE_BP usage, uint32_t array_layer, uint32_t mip_level) {
-    funcs.push_back([this, function_name, state, usage, array_layer, mip_level](const ValidationStateTracker&, const QUEUE_STATE&,
-                                                                                const CMD_BUFFER_STATE&) -> bool {
+    funcs.emplace_back([this, function_name, state, usage, array_layer, mip_level](
+                           const ValidationStateTracker&, const QUEUE_STATE&, const CMD_BUFFER_STATE&) -> bool {
         ValidateImageInQueue(function_name, *state, usage, array_layer, mip_level);
         return false;
     });
@@ -1874,8 +1875,7 @@ void BestPractices::ValidateImageInQueue(const char* function_name, bp_state::Im
 }
 
 void BestPractices::AddDeferredQueueOperations(bp_state::CommandBuffer& cb) {
-    cb.queue_submit_functions.insert(cb.queue_submit_functions.end(), cb.queue_submit_functions_after_render_pass.begin(),
-                                     cb.queue_submit_functions_after_render_pass.end());
+    cb.queue_submit_functions.append(cb.queue_submit_functions_after_render_pass);
     cb.queue_submit_functions_after_render_pass.clear();
 }
 
@@ -2228,55 +2228,60 @@ bool BestPractices::ValidateIndexBufferArm(const bp_state::CommandBuffer& cmd_st
             scan_stride = sizeof(uint32_t);
         }
 
-        const uint8_t* scan_begin = static_cast<const uint8_t*>(ib_mem) + ib_mem_offset + firstIndex * scan_stride;
-        const uint8_t* scan_end = scan_begin + indexCount * scan_stride;
+        const VkDeviceSize scan_offset = ib_mem_offset + firstIndex * scan_stride;
+        const uint8_t* scan_begin = static_cast<const uint8_t*>(ib_mem) + scan_offset;
 
-        // Min and max are important to track for some Mali architectures. In older Mali devices without IDVS, all
-        // vertices corresponding to indices between the minimum and maximum may be loaded, and possibly shaded,
-        // irrespective of whether or not they're part of the draw call.
+        IndexBufferScan scan = {};
+        scan.offset = scan_offset;
+        scan.count = indexCount;
+        scan.index_type = ib_type;
+        scan.primitive_restart_enable = primitive_restart_enable;
 
-        // start with minimum as 0xFFFFFFFF and adjust to indices in the buffer
-        uint32_t min_index = ~0u;
-        // start with maximum as 0 and adjust to indices in the buffer
-        uint32_t max_index = 0u;
+        // Static geometry is drawn with the same range many times, only scan the indices again if they may have changed. Host
+        // writes to coherent memory can't be seen (they need no flush), so indices in persistently mapped coherent memory are
+        // scanned by every draw.
+        const bool memoize = !ib_mem_state.host_coherent;
+        const uint64_t map_generation = ib_mem_state.map_generation;
+        if (!memoize || !ib_state->FindIndexBufferScan(map_generation, scan)) {
+            // Min and max are important to track for some Mali architectures. In older Mali devices without IDVS, all
+            // vertices corresponding to indices between the minimum and maximum may be loaded, and possibly shaded,
+            // irrespective of whether or not they're part of the draw call.
 
-        // first scan-through, we're looking to simulate a model LRU post-transform cache, estimating the number of vertices shaded
-        // for the given index buffer
-        uint32_t vertex_shade_count = 0;
+            // start with minimum as 0xFFFFFFFF and adjust to indices in the buffer
+            scan.min_index = ~0u;
+            // start with maximum as 0 and adjust to indices in the buffer
+            scan.max_index = 0u;
 
-        PostTransformLRUCacheModel post_transform_cache;
-
-        // The size of the cache being modelled positively correlates with how much behaviour it can capture about
-        // arbitrary ground-truth hardware/architecture cache behaviour. I.e. it's a good solution when we don't know the
-        // target architecture.
-        // However, modelling a post-transform cache with more than 32 elements gives diminishing returns in practice.
-        // http://eelpi.gotdns.org/papers/fast_vert_cache_opt.html
-        post_transform_cache.resize(32);
-
-        for (const uint8_t* scan_ptr = scan_begin; scan_ptr < scan_end; scan_ptr += scan_stride) {
-            uint32_t scan_index;
-            uint32_t primitive_restart_value;
             if (ib_type == VK_INDEX_TYPE_UINT8_EXT) {
-                scan_index = *reinterpret_cast<const uint8_t*>(scan_ptr);
-                primitive_restart_value = 0xFF;
+                ScanIndexRange<uint8_t>(scan_begin, indexCount, scan.min_index, scan.max_index);
             } else if (ib_type == VK_INDEX_TYPE_UINT16) {
-                scan_index = *reinterpret_cast<const uint16_t*>(scan_ptr);
-                primitive_restart_value = 0xFFFF;
+                ScanIndexRange<uint16_t>(scan_begin, indexCount, scan.min_index, scan.max_index);
             } else {
-                scan_index = *reinterpret_cast<const uint32_t*>(scan_ptr);
-                primitive_restart_value = 0xFFFFFFFF;
+                ScanIndexRange<uint32_t>(scan_begin, indexCount, scan.min_index, scan.max_index);
+            }
+
+            // Knowing the range from the first scan allows us to simulate a model post-transform cache, estimating the number
+            // of vertices shaded, while recording index usage with bitsets. Not needed if the range already tells the story.
+            if (scan.max_index > scan.min_index && scan.max_index - scan.min_index < indexCount) {
+                if (ib_type == VK_INDEX_TYPE_UINT8_EXT) {
+                    ScanIndexReuse<uint8_t>(scan_begin, indexCount, primitive_restart_enable, scan.min_index, scan.max_index,
+                                            scan.vertex_shade_count, scan.vertex_reference_count);
+                } else if (ib_type == VK_INDEX_TYPE_UINT16) {
+                    ScanIndexReuse<uint16_t>(scan_begin, indexCount, primitive_restart_enable, scan.min_index, scan.max_index,
+                                             scan.vertex_shade_count, scan.vertex_reference_count);
+                } else {
+                    ScanIndexReuse<uint32_t>(scan_begin, indexCount, primitive_restart_enable, scan.min_index, scan.max_index,
+                                             scan.vertex_shade_count, scan.vertex_reference_count);
+                }
             }
-
-            max_index = std::max(max_index, scan_index);
-            min_index = std::min(min_index, scan_index);
-
-            if (!primitive_restart_enable || scan_index != primitive_restart_value) {
-                bool in_cache = post_transform_cache.query_cache(scan_index);
-                // if the shaded vertex corresponding to the index is not in the PT-cache, we need to shade again
-                if (!in_cache) vertex_shade_count++;
+            if (memoize) {
+                ib_state->AddIndexBufferScan(map_generation, scan);
             }
         }
 
+        const uint32_t min_index = scan.min_index;
+        const uint32_t max_index = scan.max_index;
+
         // if the max and min values were not set, then we either have no indices, or all primitive restarts, exit...
         // if the max and min are the same, then it implies all the indices are the same, then we don't need to do anything
         if (max_index < min_index || max_index == min_index) return skip;
@@ -2293,40 +2298,8 @@ bool BestPractices::ValidateIndexBufferArm(const bp_state::CommandBuffer& cmd_st
             return skip;
         }
 
-        // use a dynamic vector of bitsets as a memory-compact representation of which indices are included in the draw call
-        // each bit of the n-th bucket contains the inclusion information for indices (n*n_buckets) to ((n+1)*n_buckets)
-        const size_t refs_per_bucket = 64;
-        std::vector<std::bitset<refs_per_bucket>> vertex_reference_buckets;
-
-        const uint32_t n_indices = max_index - min_index + 1;
-        const uint32_t n_buckets = (n_indices / static_cast<uint32_t>(refs_per_bucket)) +
-                                   ((n_indices % static_cast<uint32_t>(refs_per_bucket)) != 0 ? 1 : 0);
-
-        // there needs to be at least one bitset to store a set of indices smaller than n_buckets
-        vertex_reference_buckets.resize(std::max(1u, n_buckets));
-
-        // To avoid using too much memory, we run over the indices again.
-        // Knowing the size from the last scan allows us to record index usage with bitsets
-        for (const uint8_t* scan_ptr = scan_begin; scan_ptr < scan_end; scan_ptr += scan_stride) {
-            uint32_t scan_index;
-            if (ib_type == VK_INDEX_TYPE_UINT8_EXT) {
-                scan_index = *reinterpret_cast<const uint8_t*>(scan_ptr);
-            } else if (ib_type == VK_INDEX_TYPE_UINT16) {
-                scan_index = *reinterpret_cast<const uint16_t*>(scan_ptr);
-            } else {
-                scan_index = *reinterpret_cast<const uint32_t*>(scan_ptr);
-            }
-            // keep track of the set of all indices used to reference vertices in the draw call
-            size_t index_offset = scan_index - min_index;
-            size_t bitset_bucket_index = index_offset / refs_per_bucket;
-            uint64_t used_indices = 1ull << ((index_offset % refs_per_bucket) & 0xFFFFFFFFu);
-            vertex_reference_buckets[bitset_bucket_index] |= used_indices;
-        }
-
-        uint32_t vertex_reference_count = 0;
-        for (const auto& bitset : vertex_reference_buckets) {
-            vertex_reference_count += static_cast<uint32_t>(bitset.count());
-        }
+        const uint32_t vertex_shade_count = scan.vertex_shade_count;
+        const uint32_t vertex_reference_count = scan.vertex_reference_count;
 
         // low index buffer utilization implies that: of the vertices available to the draw call, not all are utilized
         float utilization = static_cast<float>(vertex_reference_count) / static_cast<float>(max_index - min_index + 1);
@@ -3685,31 +3658,6 @@ bool BestPractices::PreCallValidateCreateFence(VkDevice device, const VkFenceCre
     return skip;
 }
 
-void BestPractices::PostTransformLRUCacheModel::resize(size_t size) { _entries.resize(size); }
-
-bool BestPractices::PostTransformLRUCacheModel::query_cache(uint32_t value) {
-    // look for a cache hit
-    auto hit = std::find_if(_entries.begin(), _entries.end(), [value](const CacheEntry& entry) { return entry.value == value; });
-    if (hit != _entries.end()) {
-        // mark the cache hit as being most recently used
-        hit->age = iteration++;
-        return true;
-    }
-
-    // if there's no cache hit, we need to model the entry being inserted into the cache
-    CacheEntry new_entry = {value, iteration};
-    if (iteration < static_cast<uint32_t>(std::distance(_entries.begin(), _entries.end()))) {
-        // if there is still space left in the cache, use the next available slot
-        *(_entries.begin() + iteration) = new_entry;
-    } else {
-        // otherwise replace the least recently used cache entry
-        auto lru = std::min_element(_entries.begin(), hit, [](const CacheEntry& a, const CacheEntry& b) { return a.age < b.age; });
-        *lru = new_entry;
-    }
-    iteration++;
-    return false;
-}
-
 bool BestPractices::PreCallValidateAcquireNextImageKHR(VkDevice device, VkSwapchainKHR swapchain, uint64_t timeout,
                                                        VkSemaphore semaphore, VkFence fence, uint32_t* pImageIndex) const {
     auto swapchain_data = Get<SWAPCHAIN_NODE>(swapchain);
@@ -517,7 +517,7 @@ class BestPractices : public ValidationStateTracker {
     bool PreCallValidateCmdResolveImage2(VkCommandBuffer commandBuffer,
                                          const VkResolveImageInfo2* pResolveImageInfo) const override;
 
-    using QueueCallbacks = std::vector<CMD_BUFFER_STATE::QueueCallback>;
+    using QueueCallbacks = CMD_BUFFER_STATE::QueueCallbacks;
 
     void QueueValidateImageView(QueueCallbacks &func, const char* function_name,
                                 IMAGE_VIEW_STATE* view, IMAGE_SUBRESOURCE_USAGE_BP usage);
@@ -743,26 +743,6 @@ class BestPractices : public ValidationStateTracker {
                                                                 std::shared_ptr<const PIPELINE_LAYOUT_STATE>&& layout) const final;
 
   private:
-    // CacheEntry and PostTransformLRUCacheModel are used on the stack
-    struct CacheEntry {
-        uint32_t value;
-        uint32_t age;
-    };
-
-    class PostTransformLRUCacheModel {
-      public:
-        typedef std::vector<CacheEntry>::iterator cache_iterator;
-
-        void resize(size_t size);
-
-        // Returns true if there was a cache hit - also models LRU behavior which will effect subsequent calls.
-        bool query_cache(uint32_t value);
-
-      private:
-        std::vector<CacheEntry> _entries = {};
-        uint32_t iteration = 0;
-    };
-
     // Check that vendor-specific checks are enabled for at least one of the vendors
     bool VendorCheckEnabled(BPVendorFlags vendors) const;
 
@@ -48,3 +48,35 @@ BUFFER_STATE::BUFFER_STATE(ValidationStateTracker *dev_data, VkBuffer buff, cons
           deviceAddress(0),
           requirements(GetMemoryRequirements(dev_data, buff)),
           memory_requirements_checked(false) {}
+
+constexpr size_t BUFFER_STATE::kMaxIndexBufferScans;
+
+bool BUFFER_STATE::FindIndexBufferScan(uint64_t map_generation, IndexBufferScan &scan) const {
+    std::lock_guard<std::mutex> guard(index_buffer_scan_lock_);
+    if (map_generation != index_buffer_scan_map_generation_) return false;
+    for (const auto &cached : index_buffer_scans_) {
+        if (cached.SameRange(scan)) {
+            scan = cached;
+            return true;
+        }
+    }
+    return false;
+}
+
+void BUFFER_STATE::AddIndexBufferScan(uint64_t map_generation, const IndexBufferScan &scan) const {
+    std::lock_guard<std::mutex> guard(index_buffer_scan_lock_);
+    if (map_generation != index_buffer_scan_map_generation_) {
+        index_buffer_scans_.clear();
+        index_buffer_scan_map_generation_ = map_generation;
+    }
+    // Buffers drawn with many different ranges are unlikely to benefit, keep only the most recent ones
+    if (index_buffer_scans_.size() == kMaxIndexBufferScans) {
+        index_buffer_scans_.erase(index_buffer_scans_.begin());
+    }
+    index_buffer_scans_.push_back(scan);
+}
+
+void BUFFER_STATE::InvalidateIndexBufferScans() {
+    std::lock_guard<std::mutex> guard(index_buffer_scan_lock_);
+    index_buffer_scans_.clear();
+}
@@ -29,8 +29,29 @@
 #include "device_memory_state.h"
 #include "range_vector.h"
 
+#include <mutex>
+
 class ValidationStateTracker;
 
+// Summary of the indices read by an indexed draw, see BestPractices::ValidateIndexBufferArm
+struct IndexBufferScan {
+    VkDeviceSize offset;
+    uint32_t count;
+    VkIndexType index_type;
+    bool primitive_restart_enable;
+
+    uint32_t min_index;
+    uint32_t max_index;
+    // Only valid when the indices weren't found to be sparse by min_index and max_index alone
+    uint32_t vertex_shade_count;
+    uint32_t vertex_reference_count;
+
+    bool SameRange(const IndexBufferScan &other) const {
+        return offset == other.offset && count == other.count && index_type == other.index_type &&
+               primitive_restart_enable == other.primitive_restart_enable;
+    }
+};
+
 class BUFFER_STATE : public BINDABLE {
   public:
     const safe_VkBufferCreateInfo safe_create_info;
@@ -49,6 +70,21 @@ class BUFFER_STATE : public BINDABLE {
     sparse_container::range<VkDeviceAddress> DeviceAddressRange() const {
         return {deviceAddress, deviceAddress + createInfo.size};
     }
+
+    // Scanning index data is expensive and static meshes are drawn many times, so scans are memoized per range. They are
+    // dropped whenever the buffer contents may have changed: the buffer is bound, a transfer command writing it is submitted
+    // or completes, or its memory is mapped again, flushed or invalidated (map_generation differs). Host writes that are never
+    // flushed are not tracked, so callers must not memoize scans of host coherent memory.
+    bool FindIndexBufferScan(uint64_t map_generation, IndexBufferScan &scan) const;
+    void AddIndexBufferScan(uint64_t map_generation, const IndexBufferScan &scan) const;
+    void InvalidateIndexBufferScans();
+
+  private:
+    static constexpr size_t kMaxIndexBufferScans = 16;
+
+    mutable std::mutex index_buffer_scan_lock_;
+    mutable std::vector<IndexBufferScan> index_buffer_scans_;
+    mutable uint64_t index_buffer_scan_map_generation_ = 0;
 };
 
 using BUFFER_STATE_LINEAR = MEMORY_TRACKED_RESOURCE_STATE<BUFFER_STATE, BindableLinearMemoryTracker>;
@@ -343,6 +343,7 @@ void CMD_BUFFER_STATE::Reset() {
         obj->RemoveParent(this);
     }
     object_bindings.clear();
+    transfer_dst_buffers.clear();
 
     for (auto &item : lastBound) {
         item.Reset();
@@ -886,6 +887,8 @@ void CMD_BUFFER_STATE::End(VkResult result) {
 void CMD_BUFFER_STATE::ExecuteCommands(uint32_t commandBuffersCount, const VkCommandBuffer *pCommandBuffers) {
     RecordCmd(CMD_EXECUTECOMMANDS);
     for (uint32_t i = 0; i < commandBuffersCount; i++) {
+        // Executing a command buffer within itself is invalid usage, and its lock is already held by this thread
+        if (pCommandBuffers[i] == commandBuffer()) continue;
         auto sub_cb_state = dev_data->GetWrite<CMD_BUFFER_STATE>(pCommandBuffers[i]);
         assert(sub_cb_state);
         if (!(sub_cb_state->beginInfo.flags & VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT)) {
@@ -913,15 +916,9 @@ void CMD_BUFFER_STATE::ExecuteCommands(uint32_t commandBuffersCount, const VkCom
         sub_cb_state->primaryCommandBuffer = commandBuffer();
         linkedCommandBuffers.insert(sub_cb_state.get());
         AddChild(sub_cb_state);
-        for (auto &function : sub_cb_state->queryUpdates) {
-            queryUpdates.push_back(function);
-        }
-        for (auto &function : sub_cb_state->eventUpdates) {
-            eventUpdates.push_back(function);
-        }
-        for (auto &function : sub_cb_state->queue_submit_functions) {
-            queue_submit_functions.push_back(function);
-        }
+        queryUpdates.append(sub_cb_state->queryUpdates);
+        eventUpdates.append(sub_cb_state->eventUpdates);
+        queue_submit_functions.append(sub_cb_state->queue_submit_functions);
 
         // State is trashed after executing secondary command buffers.
         // Importantly, this function runs after CoreChecks::PreCallValidateCmdExecuteCommands.
@@ -1242,6 +1239,17 @@ void CMD_BUFFER_STATE::RecordTransferCmd(CMD_TYPE cmd_type, std::shared_ptr<BIND
     if (buf2) {
         AddChild(buf2);
     }
+    // The destination is always the last resource, any analysis of its contents goes stale once the command executes
+    const auto &dst = buf2 ? buf2 : buf1;
+    if (dst && dst->Type() == kVulkanObjectTypeBuffer) {
+        transfer_dst_buffers.insert(std::static_pointer_cast<BUFFER_STATE>(dst));
+    }
+}
+
+void CMD_BUFFER_STATE::InvalidateTransferDstScans() const {
+    for (const auto &buffer_state : transfer_dst_buffers) {
+        buffer_state->InvalidateIndexBufferScans();
+    }
 }
 
 static bool SetEventStageMask(VkEvent event, VkPipelineStageFlags2KHR stageMask, EventToStageMap *localEventToStageMap) {
@@ -1349,6 +1357,12 @@ void CMD_BUFFER_STATE::RecordWriteTimestamp(CMD_TYPE cmd_type, VkPipelineStageFl
 }
 
 void CMD_BUFFER_STATE::Submit(uint32_t perf_submit_pass) {
+    // Scans taken while the submission is pending may read either contents, so they are dropped again when it retires
+    InvalidateTransferDstScans();
+    for (const auto *secondary_cb : linkedCommandBuffers) {
+        secondary_cb->InvalidateTransferDstScans();
+    }
+
     VkQueryPool first_pool = VK_NULL_HANDLE;
     EventToStageMap local_event_to_stage_map;
     QueryMap local_query_to_state_map;
@@ -1372,6 +1386,7 @@ void CMD_BUFFER_STATE::Submit(uint32_t perf_submit_pass) {
 }
 
 void CMD_BUFFER_STATE::Retire(uint32_t perf_submit_pass, const std::function<bool(const QueryObject &)>& is_query_updated_after) {
+    InvalidateTransferDstScans();
     // First perform decrement on general case bound objects
     for (auto event : writeEventsBeforeWait) {
         auto event_state = dev_data->Get<EVENT_STATE>(event);
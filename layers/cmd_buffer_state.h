@@ -299,6 +299,8 @@ class CMD_BUFFER_STATE : public REFCOUNTED_NODE {
     //  dependencies that have been broken : either destroyed objects, or updated descriptor sets
     layer_data::unordered_set<std::shared_ptr<BASE_NODE>> object_bindings;
     layer_data::unordered_map<VulkanTypedHandle, LogObjectList> broken_bindings;
+    // Buffers written by transfer commands, whose memoized index buffer scans are dropped when the writes are submitted
+    layer_data::unordered_set<std::shared_ptr<BUFFER_STATE>> transfer_dst_buffers;
 
     QFOTransferBarrierSets<QFOBufferTransferBarrier> qfo_transfer_buffer_barriers;
     QFOTransferBarrierSets<QFOImageTransferBarrier> qfo_transfer_image_barriers;
@@ -319,19 +321,21 @@ class CMD_BUFFER_STATE : public REFCOUNTED_NODE {
     // If primary, the secondary command buffers we will call.
     // If secondary, the primary command buffers we will be called by.
     layer_data::unordered_set<CMD_BUFFER_STATE *> linkedCommandBuffers;
+    // The deferred operations below are kept in streams, whose memory is reused when the command buffer is re-recorded
     // Validation functions run at primary CB queue submit time
-    using QueueCallback = std::function<bool(const ValidationStateTracker &device_data, const class QUEUE_STATE &queue_state,
-                                             const CMD_BUFFER_STATE &cb_state)>;
-    std::vector<QueueCallback> queue_submit_functions;
+    using QueueCallbacks = layer_data::DeferredOpStream<bool(
+        const ValidationStateTracker &device_data, const class QUEUE_STATE &queue_state, const CMD_BUFFER_STATE &cb_state)>;
+    QueueCallbacks queue_submit_functions;
     // Used by some layers to defer actions until vkCmdEndRenderPass time.
     // Layers using this are responsible for inserting the callbacks into queue_submit_functions.
-    std::vector<QueueCallback> queue_submit_functions_after_render_pass;
+    QueueCallbacks queue_submit_functions_after_render_pass;
     // Validation functions run when secondary CB is executed in primary
-    std::vector<std::function<bool(const CMD_BUFFER_STATE &secondary, const CMD_BUFFER_STATE *primary, const FRAMEBUFFER_STATE *)>>
+    layer_data::DeferredOpStream<bool(const CMD_BUFFER_STATE &secondary, const CMD_BUFFER_STATE *primary,
+                                      const FRAMEBUFFER_STATE *fb)>
         cmd_execute_commands_functions;
-    std::vector<std::function<bool(CMD_BUFFER_STATE &cb, bool do_validate, EventToStageMap *localEventToStageMap)>> eventUpdates;
-    std::vector<std::function<bool(const ValidationStateTracker *device_data, bool do_validate, VkQueryPool &firstPerfQueryPool,
-                                   uint32_t perfQueryPass, QueryMap *localQueryToStateMap)>>
+    layer_data::DeferredOpStream<bool(CMD_BUFFER_STATE &cb, bool do_validate, EventToStageMap *localEventToStageMap)> eventUpdates;
+    layer_data::DeferredOpStream<bool(const ValidationStateTracker *device_data, bool do_validate, VkQueryPool &firstPerfQueryPool,
+                                      uint32_t perfQueryPass, QueryMap *localQueryToStateMap)>
         queryUpdates;
     layer_data::unordered_set<const cvdescriptorset::DescriptorSet *> validated_descriptor_sets;
     layer_data::unordered_map<const cvdescriptorset::DescriptorSet *, cvdescriptorset::DescriptorSet::CachedValidation>
@@ -476,6 +480,7 @@ class CMD_BUFFER_STATE : public REFCOUNTED_NODE {
     void RecordStateCmd(CMD_TYPE cmd_type, CBStatusFlags state_bits);
     void RecordColorWriteEnableStateCmd(CMD_TYPE cmd_type, CBStatusFlags state_bits, uint32_t attachment_count);
     void RecordTransferCmd(CMD_TYPE cmd_type, std::shared_ptr<BINDABLE> &&buf1, std::shared_ptr<BINDABLE> &&buf2 = nullptr);
+    void InvalidateTransferDstScans() const;
     void RecordSetEvent(CMD_TYPE cmd_type, VkEvent event, VkPipelineStageFlags2KHR stageMask);
     void RecordResetEvent(CMD_TYPE cmd_type, VkEvent event, VkPipelineStageFlags2KHR stageMask);
     virtual void RecordWaitEvents(CMD_TYPE cmd_type, uint32_t eventCount, const VkEvent *pEvents,
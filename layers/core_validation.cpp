@@ -4182,9 +4182,25 @@ void CoreChecks::CreateDevice(const VkDeviceCreateInfo *pCreateInfo) {
             cb_node->SetImageViewInitialLayout(iv_state, layout);
         });
 
+    // Pipeline validation only reads device state, and is run concurrently with other validation when fine grained locking is
+    // enabled. Without it, validation is serialized by the device lock, so is kept on the calling thread. Parallel validation
+    // is opt-in, as a callback returning true can't cut short the rest of the validation of its pipeline (see
+    // ValidateInParallel).
+    std::string threads_string = getLayerOption("khronos_validation.pipeline_validation_threads");
+    if (threads_string.empty()) threads_string = GetEnvironment("VK_LAYER_PIPELINE_VALIDATION_THREADS");
+    const uint32_t pipeline_threads = threads_string.empty() ? 1 : static_cast<uint32_t>(std::max(atoi(threads_string.c_str()), 0));
+    if (fine_grained_locking && pipeline_threads != 1) {
+        pipeline_worker_pool = layer_data::make_unique<WorkerPool>(pipeline_threads);
+        if (pipeline_worker_pool->ThreadCount() < 2) {
+            pipeline_worker_pool.reset();
+        }
+    }
+
     // Allocate shader validation cache
     if (!disabled[shader_validation_caching] && !disabled[shader_validation] && !core_validation_cache) {
-        auto tmp_path = GetEnvironment("XDG_CACHE_HOME");
+        std::string tmp_path = getLayerOption("khronos_validation.shader_validation_cache_dir");
+        if (!tmp_path.size()) tmp_path = GetEnvironment("VK_LAYER_SHADER_VALIDATION_CACHE_DIR");
+        if (!tmp_path.size()) tmp_path = GetEnvironment("XDG_CACHE_HOME");
         if (!tmp_path.size()) {
             auto cachepath = GetEnvironment("HOME") + "/.cache";
             struct stat info;
@@ -4205,12 +4221,7 @@ void CoreChecks::CreateDevice(const VkDeviceCreateInfo *pCreateInfo) {
         validation_cache_path += ".bin";
 
         std::vector<char> validation_cache_data;
-        std::ifstream read_file(validation_cache_path.c_str(), std::ios::in | std::ios::binary);
-
-        if (read_file) {
-            std::copy(std::istreambuf_iterator<char>(read_file), {}, std::back_inserter(validation_cache_data));
-            read_file.close();
-        } else {
+        if (!ReadBinaryFile(validation_cache_path, validation_cache_data)) {
             LogInfo(device, "UNASSIGNED-cache-file-error",
                     "Cannot open shader validation cache at %s for reading (it may not exist yet)", validation_cache_path.c_str());
         }
@@ -4228,38 +4239,60 @@ void CoreChecks::PreCallRecordDestroyDevice(VkDevice device, const VkAllocationC
 
     StateTracker::PreCallRecordDestroyDevice(device, pAllocator);
 
+    pipeline_worker_pool.reset();
+
     if (core_validation_cache) {
-        size_t validation_cache_size = 0;
-        void *validation_cache_data = nullptr;
+        SaveValidationCache(true);
+        CoreLayerDestroyValidationCacheEXT(device, core_validation_cache, NULL);
+        core_validation_cache = VK_NULL_HANDLE;
+    }
+}
 
-        CoreLayerGetValidationCacheDataEXT(device, core_validation_cache, &validation_cache_size, nullptr);
+void CoreChecks::PostCallRecordCreateShaderModule(VkDevice device, const VkShaderModuleCreateInfo *pCreateInfo,
+                                                  const VkAllocationCallbacks *pAllocator, VkShaderModule *pShaderModule,
+                                                  VkResult result, void *csm_state) {
+    StateTracker::PostCallRecordCreateShaderModule(device, pCreateInfo, pAllocator, pShaderModule, result, csm_state);
 
-        validation_cache_data = (char *)malloc(sizeof(char) * validation_cache_size);
-        if (!validation_cache_data) {
-            LogInfo(device, "UNASSIGNED-cache-memory-error", "Validation Cache Memory Error");
-            return;
+    // Periodically write the cache out, so that an application that does not shut down cleanly still benefits from it
+    if (core_validation_cache) {
+        const auto cache = CastFromHandle<ValidationCache *>(core_validation_cache);
+        if (cache->InsertedCount() >= validation_cache_save_count + kValidationCacheSaveInterval) {
+            SaveValidationCache(false);
         }
+    }
+}
 
-        VkResult result =
-            CoreLayerGetValidationCacheDataEXT(device, core_validation_cache, &validation_cache_size, validation_cache_data);
+// Write core_validation_cache to validation_cache_path. Entries saved by other processes since the cache was loaded are merged in
+// first, and the file is replaced atomically so that concurrent readers never see a partially written cache. If wait is false and
+// another thread is already saving, return without saving.
+void CoreChecks::SaveValidationCache(bool wait) {
+    std::unique_lock<std::mutex> guard(validation_cache_save_lock, std::defer_lock);
+    if (wait) {
+        guard.lock();
+    } else if (!guard.try_lock()) {
+        return;
+    }
+    if (!validation_cache_path.size()) return;
 
-        if (result != VK_SUCCESS) {
-            LogInfo(device, "UNASSIGNED-cache-retrieval-error", "Validation Cache Retrieval Error");
-            return;
-        }
+    auto cache = CastFromHandle<ValidationCache *>(core_validation_cache);
+    // Count the attempt whether or not it succeeds, so that a cache that can't be written is retried once per save interval
+    // rather than on every shader module created after it
+    validation_cache_save_count = cache->InsertedCount();
 
-        if (validation_cache_path.size() > 0) {
-            std::ofstream write_file(validation_cache_path.c_str(), std::ios::out | std::ios::binary);
-            if (write_file) {
-                write_file.write(static_cast<char *>(validation_cache_data), validation_cache_size);
-                write_file.close();
-            } else {
-                LogInfo(device, "UNASSIGNED-cache-write-error", "Cannot open shader validation cache at %s for writing",
-                        validation_cache_path.c_str());
-            }
-        }
-        free(validation_cache_data);
-        CoreLayerDestroyValidationCacheEXT(device, core_validation_cache, NULL);
+    std::vector<char> validation_cache_data;
+    if (ReadBinaryFile(validation_cache_path, validation_cache_data)) {
+        VkValidationCacheCreateInfoEXT cacheCreateInfo = LvlInitStruct<VkValidationCacheCreateInfoEXT>();
+        cacheCreateInfo.initialDataSize = validation_cache_data.size();
+        cacheCreateInfo.pInitialData = validation_cache_data.data();
+        std::unique_ptr<ValidationCache> saved_cache(CastFromHandle<ValidationCache *>(ValidationCache::Create(&cacheCreateInfo)));
+        cache->Merge(saved_cache.get());
+    }
+
+    cache->Write(validation_cache_data);
+
+    if (!WriteFileAtomically(validation_cache_path, validation_cache_data.data(), validation_cache_data.size())) {
+        LogInfo(device, "UNASSIGNED-cache-write-error", "Cannot write shader validation cache at %s",
+                validation_cache_path.c_str());
     }
 }
 
@@ -6813,6 +6846,32 @@ bool CoreChecks::PreCallValidateCreatePipelineCache(VkDevice device, const VkPip
     return skip;
 }
 
+// Returns the result of validate(0) || .. || validate(count - 1). When the pipeline worker pool is enabled the calls are split
+// across its threads, each call's messages are held back, and they are reported in index order once all calls have completed,
+// so messages appear in the same order as with serial validation. Returning true from a callback therefore cannot cut short the
+// rest of its call's validation, as it can when validating serially.
+bool CoreChecks::ValidateInParallel(uint32_t count, const std::function<bool(uint32_t)> &validate) const {
+    bool skip = false;
+    if (!pipeline_worker_pool || count < 2) {
+        for (uint32_t i = 0; i < count; i++) {
+            skip |= validate(i);
+        }
+        return skip;
+    }
+
+    std::vector<std::vector<DeferredLogMsg>> messages(count);
+    std::vector<uint8_t> results(count, 0);
+    pipeline_worker_pool->ParallelFor(count, [&validate, &messages, &results](uint32_t i) {
+        LogMsgDeferral deferral(messages[i]);
+        results[i] = validate(i) ? 1 : 0;
+    });
+    for (uint32_t i = 0; i < count; i++) {
+        skip |= results[i] != 0;
+        skip |= ReportDeferredLogMsgs(report_data, messages[i]);
+    }
+    return skip;
+}
+
 bool CoreChecks::PreCallValidateCreateGraphicsPipelines(VkDevice device, VkPipelineCache pipelineCache, uint32_t count,
                                                         const VkGraphicsPipelineCreateInfo *pCreateInfos,
                                                         const VkAllocationCallbacks *pAllocator, VkPipeline *pPipelines,
@@ -6821,9 +6880,7 @@ bool CoreChecks::PreCallValidateCreateGraphicsPipelines(VkDevice device, VkPipel
                                                                      pPipelines, cgpl_state_data);
     create_graphics_pipeline_api_state *cgpl_state = reinterpret_cast<create_graphics_pipeline_api_state *>(cgpl_state_data);
 
-    for (uint32_t i = 0; i < count; i++) {
-        skip |= ValidatePipeline(cgpl_state->pipe_state, i);
-    }
+    skip |= ValidateInParallel(count, [this, cgpl_state](uint32_t i) { return ValidatePipeline(cgpl_state->pipe_state, i); });
 
     if (IsExtEnabled(device_extensions.vk_ext_vertex_attribute_divisor)) {
         skip |= ValidatePipelineVertexDivisors(cgpl_state->pipe_state, count, pCreateInfos);
@@ -6891,12 +6948,14 @@ bool CoreChecks::PreCallValidateCreateComputePipelines(VkDevice device, VkPipeli
                                                                     pPipelines, ccpl_state_data);
 
     auto *ccpl_state = reinterpret_cast<create_compute_pipeline_api_state *>(ccpl_state_data);
-    for (uint32_t i = 0; i < count; i++) {
+    skip |= ValidateInParallel(count, [this, ccpl_state, pCreateInfos](uint32_t i) {
+        bool pipeline_skip = false;
         // TODO: Add Compute Pipeline Verification
-        skip |= ValidateComputePipelineShaderState(ccpl_state->pipe_state[i].get());
-        skip |= ValidatePipelineCacheControlFlags(pCreateInfos->flags, i, "vkCreateComputePipelines",
-                                                  "VUID-VkComputePipelineCreateInfo-pipelineCreationCacheControl-02875");
-    }
+        pipeline_skip |= ValidateComputePipelineShaderState(ccpl_state->pipe_state[i].get());
+        pipeline_skip |= ValidatePipelineCacheControlFlags(pCreateInfos->flags, i, "vkCreateComputePipelines",
+                                                           "VUID-VkComputePipelineCreateInfo-pipelineCreationCacheControl-02875");
+        return pipeline_skip;
+    });
     return skip;
 }
 
@@ -178,6 +178,14 @@ class CoreChecks : public ValidationStateTracker {
     GlobalQFOTransferBarrierMap<QFOBufferTransferBarrier> qfo_release_buffer_barrier_map;
     VkValidationCacheEXT core_validation_cache = VK_NULL_HANDLE;
     std::string validation_cache_path;
+    // Serializes writes of core_validation_cache to validation_cache_path, and tracks how much of the cache there was when it was
+    // last written, or when writing it last failed
+    std::mutex validation_cache_save_lock;
+    std::atomic<size_t> validation_cache_save_count{0};
+    // Number of new cache entries after which the cache is written out before the device is destroyed
+    static constexpr size_t kValidationCacheSaveInterval = 1024;
+    // Validates the pipelines of large vkCreate*Pipelines calls in parallel
+    std::unique_ptr<WorkerPool> pipeline_worker_pool;
 
     CoreChecks() { container_type = LayerObjectTypeCoreValidation; }
 
@@ -600,6 +608,11 @@ class CoreChecks : public ValidationStateTracker {
                                     VkPipelineCreateFlags flags, bool isKHR) const;
     bool PreCallValidateCreateShaderModule(VkDevice device, const VkShaderModuleCreateInfo* pCreateInfo,
                                            const VkAllocationCallbacks* pAllocator, VkShaderModule* pShaderModule) const override;
+    void PostCallRecordCreateShaderModule(VkDevice device, const VkShaderModuleCreateInfo* pCreateInfo,
+                                          const VkAllocationCallbacks* pAllocator, VkShaderModule* pShaderModule, VkResult result,
+                                          void* csm_state) override;
+    void SaveValidationCache(bool wait);
+    bool ValidateInParallel(uint32_t count, const std::function<bool(uint32_t)>& validate) const;
     bool ValidatePipelineShaderStage(const PIPELINE_STATE* pipeline, const PipelineStageState& stage_state,
                                      bool check_point_size) const;
     bool ValidatePointListShaderState(const PIPELINE_STATE* pipeline, const SHADER_MODULE_STATE& module_state,
@@ -24,6 +24,14 @@
 #include "layer_chassis_dispatch.h"
 #include "cmd_buffer_state.h"
 
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 // Perform initializations that can be done at Create Device time.
 void DebugPrintf::CreateDevice(const VkDeviceCreateInfo *pCreateInfo) {
     if (enabled[gpu_validation]) {
@@ -45,6 +53,9 @@ void DebugPrintf::CreateDevice(const VkDeviceCreateInfo *pCreateInfo) {
     use_stdout = stdout_string.length() ? !stdout_string.compare("true") : false;
     if (getenv("DEBUG_PRINTF_TO_STDOUT")) use_stdout = true;
 
+    async_results = GpuGetOption("khronos_validation.printf_async_results", false) ||
+                    !GetEnvironment("VK_LAYER_PRINTF_ASYNC_RESULTS").empty();
+
     // GpuAssistedBase::CreateDevice will set up bindings
     VkDescriptorSetLayoutBinding binding = {3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1,
                                             VK_SHADER_STAGE_ALL_GRAPHICS | VK_SHADER_STAGE_MESH_BIT_NV |
@@ -69,6 +80,24 @@ void DebugPrintf::CreateDevice(const VkDeviceCreateInfo *pCreateInfo) {
         aborted = true;
         return;
     }
+
+    aggregate = GpuGetOption("khronos_validation.printf_aggregate", false) || !GetEnvironment("VK_LAYER_PRINTF_AGGREGATE").empty();
+
+    std::string binary_file = getLayerOption("khronos_validation.printf_binary_file");
+    if (binary_file.empty()) binary_file = GetEnvironment("VK_LAYER_PRINTF_BINARY_FILE");
+    if (!binary_file.empty()) {
+        std::string binary_size_string = getLayerOption("khronos_validation.printf_binary_file_size");
+        if (binary_size_string.empty()) binary_size_string = GetEnvironment("VK_LAYER_PRINTF_BINARY_FILE_SIZE");
+        const uint64_t capacity =
+            binary_size_string.empty() ? 64 * 1024 * 1024 : strtoull(binary_size_string.c_str(), nullptr, 10);
+        binary_sink = layer_data::make_unique<DPFBinarySink>();
+        if (!binary_sink->Open(binary_file, capacity)) {
+            ReportSetupProblem(device, ("Unable to create Debug Printf binary output file " + binary_file +
+                                        ".  Debug Printf messages will be logged as text.")
+                                           .c_str());
+            binary_sink.reset();
+        }
+    }
 }
 
 // Free the device memory and descriptor set associated with a command buffer.
@@ -163,7 +192,7 @@ vartype vartype_lookup(char intype) {
     }
 }
 
-std::vector<DPFSubstring> DebugPrintf::ParseFormatString(const std::string format_string) {
+std::vector<DPFSubstring> DebugPrintf::ParseFormatString(const std::string &format_string) {
     const char types[] = {'d', 'i', 'o', 'u', 'x', 'X', 'a', 'A', 'e', 'E', 'f', 'F', 'g', 'G', 'v', '\0'};
     std::vector<DPFSubstring> parsed_strings;
     size_t pos = 0;
@@ -200,6 +229,13 @@ std::vector<DPFSubstring> DebugPrintf::ParseFormatString(const std::string forma
             if (format_string[pos] == 'v') {
                 // Vector must be of size 2, 3, or 4
                 // and format %v<size><type>
+                if (pos + 2 >= format_string.length()) {
+                    // Truncated vector specifier, print the rest of the string as is
+                    substring.string = format_string.substr(begin);
+                    substring.needs_value = false;
+                    parsed_strings.push_back(substring);
+                    break;
+                }
                 specifier = format_string.substr(percent, pos - percent);
                 count = atoi(&format_string[pos + 1]);
                 pos += 2;
@@ -238,22 +274,186 @@ std::vector<DPFSubstring> DebugPrintf::ParseFormatString(const std::string forma
     return parsed_strings;
 }
 
-std::string DebugPrintf::FindFormatString(std::vector<uint32_t> pgm, uint32_t string_id) {
-    std::string format_string;
-    SHADER_MODULE_STATE module_state(pgm);
-    if (module_state.words.size() > 0) {
-        for (const auto &insn : module_state) {
-            if (insn.opcode() == spv::OpString) {
-                uint32_t offset = insn.offset();
-                if (pgm[offset + 1] == string_id) {
-                    format_string = reinterpret_cast<char *>(&pgm[offset + 2]);
-                    break;
-                }
+// Only strings used as a format are parsed, most OpStrings of a shader are file names and source text
+const std::vector<DPFSubstring> *DPFShaderDebugInfo::FindFormatSubstrings(uint32_t string_id) const {
+    std::lock_guard<std::mutex> guard(format_substrings_lock_);
+    auto it = format_substrings_.find(string_id);
+    if (it != format_substrings_.end()) {
+        return it->second.get();
+    }
+    const std::string *format_string = FindString(string_id);
+    if (!format_string) {
+        return nullptr;
+    }
+    std::unique_ptr<std::vector<DPFSubstring>> substrings(
+        new std::vector<DPFSubstring>(DebugPrintf::ParseFormatString(*format_string)));
+    for (auto &substring : *substrings) {
+        // Unsigned 64 bit values
+        static const std::pair<const char *, const char *> long_specifiers[] = {{"%ul", PRIx64}, {"%lu", PRIu64}, {"%lx", PRIx64}};
+        for (const auto &specifier : long_specifiers) {
+            const size_t ul_pos = substring.string.find(specifier.first);
+            if (ul_pos != std::string::npos) {
+                substring.string.replace(ul_pos + 1, 2, specifier.second);
+                substring.is_64bit = true;
+                break;
             }
         }
     }
+    const std::vector<DPFSubstring> *parsed = substrings.get();
+    format_substrings_.emplace(string_id, std::move(substrings));
+    return parsed;
+}
+
+std::shared_ptr<const GpuAssistedShaderDebugInfo> DebugPrintf::CreateShaderDebugInfo(const std::vector<uint32_t> &pgm) const {
+    return std::make_shared<const DPFShaderDebugInfo>(pgm);
+}
+
+DPFBinarySink::~DPFBinarySink() {
+#if defined(_WIN32)
+    if (header_) {
+        UnmapViewOfFile(header_);
+    }
+    if (mapping_handle_) {
+        CloseHandle(static_cast<HANDLE>(mapping_handle_));
+    }
+    if (file_handle_) {
+        CloseHandle(static_cast<HANDLE>(file_handle_));
+    }
+#else
+    if (header_) {
+        munmap(header_, mapped_size_);
+    }
+#endif
+}
 
-    return format_string;
+// Create the ring file, with a ring of capacity bytes, and the formats file next to it
+bool DPFBinarySink::Open(const std::string &path, uint64_t capacity) {
+    capacity &= ~uint64_t(3);  // Keep records word aligned
+    if (capacity < sizeof(DPFBinaryRecord) || capacity > std::numeric_limits<size_t>::max() - sizeof(DPFBinaryFileHeader)) {
+        return false;
+    }
+    mapped_size_ = static_cast<size_t>(sizeof(DPFBinaryFileHeader) + capacity);
+
+    void *data = nullptr;
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    file_handle_ = file;
+    const uint64_t file_size = mapped_size_;
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(file_size >> 32),
+                                        static_cast<DWORD>(file_size), nullptr);
+    if (!mapping) return false;
+    mapping_handle_ = mapping;
+    data = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, mapped_size_);
+    if (!data) return false;
+#else
+    const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    if (ftruncate(fd, static_cast<off_t>(mapped_size_)) != 0) {
+        close(fd);
+        return false;
+    }
+    data = mmap(nullptr, mapped_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return false;
+#endif
+    header_ = static_cast<DPFBinaryFileHeader *>(data);
+    ring_ = static_cast<uint8_t *>(data) + sizeof(DPFBinaryFileHeader);
+    memcpy(header_->magic, "VKDPFRNG", sizeof(header_->magic));
+    header_->version = kVersion;
+    header_->header_size = sizeof(DPFBinaryFileHeader);
+    header_->capacity = capacity;
+    header_->begin_offset = 0;
+    header_->end_offset = 0;
+    header_->dropped_records = 0;
+
+    formats_.open(path + ".formats", std::ios::binary | std::ios::trunc);
+    if (!formats_) return false;
+    const uint32_t version = kVersion;
+    formats_.write("VKDPFFMT", 8);
+    formats_.write(reinterpret_cast<const char *>(&version), sizeof(version));
+    formats_.flush();
+    return static_cast<bool>(formats_);
+}
+
+uint64_t DPFBinarySink::RecordSizeAt(uint64_t offset) const {
+    const uint64_t position = offset % header_->capacity;
+    const uint64_t remaining = header_->capacity - position;
+    if (remaining < 2 * sizeof(uint32_t)) return remaining;
+    uint32_t size;
+    memcpy(&size, ring_ + position, sizeof(size));
+    return size;
+}
+
+// Drop the oldest records until size more bytes fit in the ring
+void DPFBinarySink::Reserve(uint64_t size) {
+    while (header_->end_offset + size - header_->begin_offset > header_->capacity) {
+        header_->begin_offset += RecordSizeAt(header_->begin_offset);
+    }
+}
+
+void DPFBinarySink::WriteFormat(const DPFOutputRecord &record, const DPFShaderDebugInfo *debug_info) {
+    const uint64_t key = (static_cast<uint64_t>(record.shader_id) << 32) | record.format_string_id;
+    if (!written_formats_.insert(key).second) return;
+
+    static const std::vector<DPFSubstring> kNoSubstrings;
+    const std::vector<DPFSubstring> *substrings = debug_info ? debug_info->FindFormatSubstrings(record.format_string_id) : nullptr;
+    if (!substrings) substrings = &kNoSubstrings;
+
+    auto write_word = [this](uint32_t word) { formats_.write(reinterpret_cast<const char *>(&word), sizeof(word)); };
+    write_word(record.shader_id);
+    write_word(record.format_string_id);
+    write_word(static_cast<uint32_t>(substrings->size()));
+    for (const auto &substring : *substrings) {
+        const uint32_t length = static_cast<uint32_t>(substring.string.size());
+        write_word((substring.needs_value ? 1u : 0u) | (substring.is_64bit ? 2u : 0u));
+        write_word(substring.needs_value ? static_cast<uint32_t>(substring.type) : 0u);
+        write_word(length);
+        formats_.write(substring.string.data(), length);
+        static const char padding[sizeof(uint32_t)] = {};
+        formats_.write(padding, (sizeof(uint32_t) - length % sizeof(uint32_t)) % sizeof(uint32_t));
+    }
+    formats_.flush();
+}
+
+void DPFBinarySink::Write(const DPFOutputRecord &record, uint32_t count, const DPFShaderDebugInfo *debug_info) {
+    // The values follow the format string id
+    const uint32_t header_words = offsetof(DPFOutputRecord, values) / sizeof(uint32_t);
+    if (record.size < header_words) return;
+    const uint32_t value_words = record.size - header_words;
+    const DPFBinaryRecord binary_record = {static_cast<uint32_t>(sizeof(DPFBinaryRecord) + value_words * sizeof(uint32_t)),
+                                           count,
+                                           record.shader_id,
+                                           record.format_string_id,
+                                           record.stage,
+                                           record.stage_word_1,
+                                           record.stage_word_2,
+                                           record.stage_word_3};
+
+    std::lock_guard<std::mutex> guard(lock_);
+    WriteFormat(record, debug_info);
+
+    const uint64_t capacity = header_->capacity;
+    if (binary_record.size > capacity) {
+        header_->dropped_records++;
+        return;
+    }
+    const uint64_t remaining = capacity - header_->end_offset % capacity;
+    if (remaining < binary_record.size) {
+        // Pad to the end of the ring
+        Reserve(remaining);
+        if (remaining >= 2 * sizeof(uint32_t)) {
+            const uint32_t padding[2] = {static_cast<uint32_t>(remaining), 0};
+            memcpy(ring_ + header_->end_offset % capacity, padding, sizeof(padding));
+        }
+        header_->end_offset += remaining;
+    }
+    Reserve(binary_record.size);
+    uint8_t *dst = ring_ + header_->end_offset % capacity;
+    memcpy(dst, &binary_record, sizeof(binary_record));
+    memcpy(dst + sizeof(binary_record), &record.values, value_words * sizeof(uint32_t));
+    header_->end_offset += binary_record.size;
 }
 
 // GCC and clang don't like using variables as format strings in sprintf.
@@ -263,24 +463,25 @@ std::string DebugPrintf::FindFormatString(std::vector<uint32_t> pgm, uint32_t st
 #pragma GCC diagnostic ignored "-Wformat-security"
 #endif
 
-void snprintf_with_malloc(std::stringstream &shader_message, DPFSubstring substring, size_t needed, void *values) {
+void snprintf_with_malloc(std::stringstream &shader_message, const DPFSubstring &substring, size_t needed, const void *values,
+                          uint64_t longval) {
     char *buffer = static_cast<char *>(malloc((needed + 1) * sizeof(char)));  // Add 1 for terminator
-    if (substring.longval) {
-        snprintf(buffer, needed, substring.string.c_str(), substring.longval);
+    if (substring.is_64bit) {
+        snprintf(buffer, needed, substring.string.c_str(), longval);
     } else if (!substring.needs_value) {
         snprintf(buffer, needed, substring.string.c_str());
     } else {
         switch (substring.type) {
             case varunsigned:
-                needed = snprintf(buffer, needed, substring.string.c_str(), *static_cast<uint32_t *>(values) - 1);
+                needed = snprintf(buffer, needed, substring.string.c_str(), *static_cast<const uint32_t *>(values) - 1);
                 break;
 
             case varsigned:
-                needed = snprintf(buffer, needed, substring.string.c_str(), *static_cast<int32_t *>(values) - 1);
+                needed = snprintf(buffer, needed, substring.string.c_str(), *static_cast<const int32_t *>(values) - 1);
                 break;
 
             case varfloat:
-                needed = snprintf(buffer, needed, substring.string.c_str(), *static_cast<float *>(values) - 1);
+                needed = snprintf(buffer, needed, substring.string.c_str(), *static_cast<const float *>(values) - 1);
                 break;
         }
     }
@@ -304,107 +505,32 @@ void DebugPrintf::AnalyzeAndGenerateMessages(VkCommandBuffer command_buffer, VkQ
     uint32_t expect = debug_output_buffer[0];
     if (!expect) return;
 
+    // Records with the same shader, format string and values, in the order they were first written, and their count
+    std::vector<std::pair<const DPFOutputRecord *, uint32_t>> aggregated_records;
+    layer_data::unordered_map<std::string, size_t> aggregated_index;
+
     uint32_t index = 1;
     while (debug_output_buffer[index]) {
-        std::stringstream shader_message;
-        VkShaderModule shader_module_handle = VK_NULL_HANDLE;
-        VkPipeline pipeline_handle = VK_NULL_HANDLE;
-        std::vector<uint32_t> pgm;
-
-        DPFOutputRecord *debug_record = reinterpret_cast<DPFOutputRecord *>(&debug_output_buffer[index]);
-        // Lookup the VkShaderModule handle and SPIR-V code used to create the shader, using the unique shader ID value returned
-        // by the instrumented shader.
-        auto it = shader_map.find(debug_record->shader_id);
-        if (it != shader_map.end()) {
-            shader_module_handle = it->second.shader_module;
-            pipeline_handle = it->second.pipeline;
-            pgm = it->second.pgm;
-        }
-        // Search through the shader source for the printf format string for this invocation
-        auto format_string = FindFormatString(pgm, debug_record->format_string_id);
-        // Break the format string into strings with 1 or 0 value
-        auto format_substrings = ParseFormatString(format_string);
-        void *values = static_cast<void *>(&debug_record->values);
-        const uint32_t static_size = 1024;
-        // Sprintf each format substring into a temporary string then add that to the message
-        for (auto &substring : format_substrings) {
-            char temp_string[static_size];
-            size_t needed = 0;
-            std::vector<std::string> format_strings = { "%ul", "%lu", "%lx" };
-            size_t ul_pos = 0;
-            bool print_hex = true;
-            for (auto ul_string : format_strings) {
-                ul_pos = substring.string.find(ul_string);
-                if (ul_pos != std::string::npos) {
-                    if (ul_string == "%lu") print_hex = false;
-                    break;
-                }
-            }
-            if (ul_pos != std::string::npos) {
-                // Unsigned 64 bit value
-                substring.longval = *static_cast<uint64_t *>(values);
-                values = static_cast<uint64_t *>(values) + 1;
-                if (print_hex) {
-                    substring.string.replace(ul_pos + 1, 2, PRIx64);
-                } else {
-                    substring.string.replace(ul_pos + 1, 2, PRIu64);
-                }
-                needed = snprintf(temp_string, static_size, substring.string.c_str(), substring.longval);
+        const DPFOutputRecord *debug_record = reinterpret_cast<DPFOutputRecord *>(&debug_output_buffer[index]);
+        if (aggregate) {
+            // Everything from the format string id on, and the shader id
+            const size_t key_words = debug_record->size - offsetof(DPFOutputRecord, format_string_id) / sizeof(uint32_t);
+            std::string key(reinterpret_cast<const char *>(&debug_record->format_string_id), key_words * sizeof(uint32_t));
+            key.append(reinterpret_cast<const char *>(&debug_record->shader_id), sizeof(debug_record->shader_id));
+            auto inserted = aggregated_index.emplace(std::move(key), aggregated_records.size());
+            if (inserted.second) {
+                aggregated_records.emplace_back(debug_record, 1);
             } else {
-                if (substring.needs_value) {
-                    switch (substring.type) {
-                        case varunsigned:
-                            needed = snprintf(temp_string, static_size, substring.string.c_str(), *static_cast<uint32_t *>(values));
-                            break;
-
-                        case varsigned:
-                            needed = snprintf(temp_string, static_size, substring.string.c_str(), *static_cast<int32_t *>(values));
-                            break;
-
-                        case varfloat:
-                            needed = snprintf(temp_string, static_size, substring.string.c_str(), *static_cast<float *>(values));
-                            break;
-                    }
-                    values = static_cast<uint32_t *>(values) + 1;
-                } else {
-                    needed = snprintf(temp_string, static_size, substring.string.c_str());
-                }
-            }
-
-            if (needed < static_size) {
-                shader_message << temp_string;
-            } else {
-                // Static buffer not big enough for message, use malloc to get enough
-                snprintf_with_malloc(shader_message, substring, needed, values);
-            }
-        }
-
-        if (verbose) {
-            std::string stage_message;
-            std::string common_message;
-            std::string filename_message;
-            std::string source_message;
-            UtilGenerateStageMessage(&debug_output_buffer[index], stage_message);
-            UtilGenerateCommonMessage(report_data, command_buffer, &debug_output_buffer[index], shader_module_handle,
-                                      pipeline_handle, buffer_info.pipeline_bind_point, operation_index, common_message);
-            UtilGenerateSourceMessages(pgm, &debug_output_buffer[index], true, filename_message, source_message);
-            if (use_stdout) {
-                std::cout << "UNASSIGNED-DEBUG-PRINTF " << common_message.c_str() << " " << stage_message.c_str() << " "
-                          << shader_message.str().c_str() << " " << filename_message.c_str() << " " << source_message.c_str();
-            } else {
-                LogInfo(queue, "UNASSIGNED-DEBUG-PRINTF", "%s %s %s %s%s", common_message.c_str(), stage_message.c_str(),
-                        shader_message.str().c_str(), filename_message.c_str(), source_message.c_str());
+                aggregated_records[inserted.first->second].second++;
             }
         } else {
-            if (use_stdout) {
-                std::cout << shader_message.str();
-            } else {
-                // Don't let LogInfo process any '%'s in the string
-                LogInfo(device, "UNASSIGNED-DEBUG-PRINTF", "%s", shader_message.str().c_str());
-            }
+            GenerateMessage(command_buffer, queue, buffer_info, operation_index, debug_record, 1);
         }
         index += debug_record->size;
     }
+    for (const auto &record : aggregated_records) {
+        GenerateMessage(command_buffer, queue, buffer_info, operation_index, record.first, record.second);
+    }
     if ((index - 1) != expect) {
         LogWarning(device, "UNASSIGNED-DEBUG-PRINTF",
                    "WARNING - Debug Printf message was truncated, likely due to a buffer size that was too small for the message");
@@ -412,6 +538,105 @@ void DebugPrintf::AnalyzeAndGenerateMessages(VkCommandBuffer command_buffer, VkQ
     memset(debug_output_buffer, 0, 4 * (debug_output_buffer[0] + 1));
 }
 
+// Format one record, or several identical ones, or write it to the binary output
+void DebugPrintf::GenerateMessage(VkCommandBuffer command_buffer, VkQueue queue, const DPFBufferInfo &buffer_info,
+                                  uint32_t operation_index, const DPFOutputRecord *debug_record, uint32_t count) {
+    std::stringstream shader_message;
+    VkShaderModule shader_module_handle = VK_NULL_HANDLE;
+    VkPipeline pipeline_handle = VK_NULL_HANDLE;
+    std::shared_ptr<const GpuAssistedShaderDebugInfo> debug_info;
+
+    // Lookup the VkShaderModule handle and debug information of the shader, using the unique shader ID value returned
+    // by the instrumented shader.
+    auto it = shader_map.find(debug_record->shader_id);
+    if (it != shader_map.end()) {
+        shader_module_handle = it->second.shader_module;
+        pipeline_handle = it->second.pipeline;
+        debug_info = it->second.debug_info;
+    }
+    const auto *dpf_debug_info = static_cast<const DPFShaderDebugInfo *>(debug_info.get());
+    if (binary_sink) {
+        binary_sink->Write(*debug_record, count, dpf_debug_info);
+        return;
+    }
+    // The printf format string for this invocation, already broken into strings with 1 or 0 value
+    static const std::vector<DPFSubstring> kNoSubstrings;
+    const std::vector<DPFSubstring> *format_substrings =
+        dpf_debug_info ? dpf_debug_info->FindFormatSubstrings(debug_record->format_string_id) : nullptr;
+    if (!format_substrings) format_substrings = &kNoSubstrings;
+    if (count > 1) {
+        shader_message << "[" << count << " identical messages] ";
+    }
+    const void *values = static_cast<const void *>(&debug_record->values);
+    const uint32_t static_size = 1024;
+    // Sprintf each format substring into a temporary string then add that to the message
+    for (const auto &substring : *format_substrings) {
+        char temp_string[static_size];
+        size_t needed = 0;
+        uint64_t longval = 0;
+        if (substring.is_64bit) {
+            // Unsigned 64 bit value
+            longval = *static_cast<const uint64_t *>(values);
+            values = static_cast<const uint64_t *>(values) + 1;
+            needed = snprintf(temp_string, static_size, substring.string.c_str(), longval);
+        } else {
+            if (substring.needs_value) {
+                switch (substring.type) {
+                    case varunsigned:
+                        needed =
+                            snprintf(temp_string, static_size, substring.string.c_str(), *static_cast<const uint32_t *>(values));
+                        break;
+
+                    case varsigned:
+                        needed =
+                            snprintf(temp_string, static_size, substring.string.c_str(), *static_cast<const int32_t *>(values));
+                        break;
+
+                    case varfloat:
+                        needed = snprintf(temp_string, static_size, substring.string.c_str(), *static_cast<const float *>(values));
+                        break;
+                }
+                values = static_cast<const uint32_t *>(values) + 1;
+            } else {
+                needed = snprintf(temp_string, static_size, substring.string.c_str());
+            }
+        }
+
+        if (needed < static_size) {
+            shader_message << temp_string;
+        } else {
+            // Static buffer not big enough for message, use malloc to get enough
+            snprintf_with_malloc(shader_message, substring, needed, values, longval);
+        }
+    }
+
+    if (verbose) {
+        std::string stage_message;
+        std::string common_message;
+        std::string filename_message;
+        std::string source_message;
+        const uint32_t *record_words = reinterpret_cast<const uint32_t *>(debug_record);
+        UtilGenerateStageMessage(record_words, stage_message);
+        UtilGenerateCommonMessage(report_data, command_buffer, record_words, shader_module_handle, pipeline_handle,
+                                  buffer_info.pipeline_bind_point, operation_index, common_message);
+        UtilGenerateSourceMessages(debug_info.get(), record_words, true, filename_message, source_message);
+        if (use_stdout) {
+            std::cout << "UNASSIGNED-DEBUG-PRINTF " << common_message.c_str() << " " << stage_message.c_str() << " "
+                      << shader_message.str().c_str() << " " << filename_message.c_str() << " " << source_message.c_str();
+        } else {
+            LogInfo(queue, "UNASSIGNED-DEBUG-PRINTF", "%s %s %s %s%s", common_message.c_str(), stage_message.c_str(),
+                    shader_message.str().c_str(), filename_message.c_str(), source_message.c_str());
+        }
+    } else {
+        if (use_stdout) {
+            std::cout << shader_message.str();
+        } else {
+            // Don't let LogInfo process any '%'s in the string
+            LogInfo(device, "UNASSIGNED-DEBUG-PRINTF", "%s", shader_message.str().c_str());
+        }
+    }
+}
+
 // For the given command buffer, map its debug data buffers and read their contents for analysis.
 void debug_printf_state::CommandBuffer::Process(VkQueue queue) {
     auto *device_state = static_cast<DebugPrintf *>(dev_data);
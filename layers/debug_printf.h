@@ -20,6 +20,11 @@
 #pragma once
 
 #include "gpu_utils.h"
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+
 class DebugPrintf;
 
 struct DPFDeviceMemoryBlock {
@@ -42,7 +47,21 @@ struct DPFSubstring {
     std::string string;
     bool needs_value;
     vartype type;
-    uint64_t longval = 0;
+    bool is_64bit = false;  // string has been rewritten to print a 64 bit value
+};
+
+// Adds the printf format strings of a shader, broken into substrings the first time they are used, to its debug information
+class DPFShaderDebugInfo : public GpuAssistedShaderDebugInfo {
+  public:
+    explicit DPFShaderDebugInfo(const std::vector<uint32_t>& pgm) : GpuAssistedShaderDebugInfo(pgm) {}
+
+    // Returns nullptr if string_id is not an OpString of the shader
+    const std::vector<DPFSubstring>* FindFormatSubstrings(uint32_t string_id) const;
+
+  private:
+    mutable std::mutex format_substrings_lock_;
+    // Parsed substrings are never modified, so pointers to them stay valid without the lock
+    mutable layer_data::unordered_map<uint32_t, std::unique_ptr<const std::vector<DPFSubstring>>> format_substrings_;
 };
 
 struct DPFOutputRecord {
@@ -57,6 +76,60 @@ struct DPFOutputRecord {
     uint32_t values;
 };
 
+// Binary output, read by scripts/debug_printf_decode.py. Everything is in the byte order of the host.
+//
+// The ring file is a DPFBinaryFileHeader followed by a ring of records. Offsets count the bytes written since the file was
+// created, so a record is at (offset % capacity) in the ring. Records never straddle the end of the ring; a record with a
+// count of zero, or fewer than 8 bytes before the end of the ring, is padding.
+struct DPFBinaryFileHeader {
+    char magic[8];  // "VKDPFRNG"
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t capacity;
+    uint64_t begin_offset;  // The oldest record that has not been overwritten
+    uint64_t end_offset;    // Just past the newest record
+    uint64_t dropped_records;
+};
+
+struct DPFBinaryRecord {
+    uint32_t size;   // In bytes, including the values
+    uint32_t count;  // Number of identical records collapsed into this one
+    uint32_t shader_id;
+    uint32_t format_string_id;
+    uint32_t stage;
+    uint32_t stage_word_1;
+    uint32_t stage_word_2;
+    uint32_t stage_word_3;
+    // Followed by the raw printf values
+};
+
+// The formats file ("<ring file>.formats") starts with the magic "VKDPFFMT" and a version word, followed by one entry for each
+// format string the first time it is used:
+//   shader_id, format_string_id, substring count, then for each DPFSubstring:
+//   flags (bit 0: needs_value, bit 1: is_64bit), vartype, string length in bytes, string padded to a multiple of 4 bytes
+class DPFBinarySink {
+  public:
+    static const uint32_t kVersion = 1;
+
+    ~DPFBinarySink();
+    bool Open(const std::string& path, uint64_t capacity);
+    void Write(const DPFOutputRecord& record, uint32_t count, const DPFShaderDebugInfo* debug_info);
+
+  private:
+    uint64_t RecordSizeAt(uint64_t offset) const;
+    void Reserve(uint64_t size);
+    void WriteFormat(const DPFOutputRecord& record, const DPFShaderDebugInfo* debug_info);
+
+    std::mutex lock_;
+    DPFBinaryFileHeader* header_ = nullptr;
+    uint8_t* ring_ = nullptr;
+    size_t mapped_size_ = 0;
+    void* file_handle_ = nullptr;     // Windows only
+    void* mapping_handle_ = nullptr;  // Windows only
+    std::ofstream formats_;
+    layer_data::unordered_set<uint64_t> written_formats_;
+};
+
 namespace debug_printf_state {
 class CommandBuffer : public gpu_utils_state::CommandBuffer {
   public:
@@ -88,10 +161,12 @@ class DebugPrintf : public GpuAssistedBase {
     void PreCallRecordCreateShaderModule(VkDevice device, const VkShaderModuleCreateInfo* pCreateInfo,
                                          const VkAllocationCallbacks* pAllocator, VkShaderModule* pShaderModule,
                                          void* csm_state_data) override;
-    std::vector<DPFSubstring> ParseFormatString(std::string format_string);
-    std::string FindFormatString(std::vector<uint32_t> pgm, uint32_t string_id);
+    static std::vector<DPFSubstring> ParseFormatString(const std::string& format_string);
+    std::shared_ptr<const GpuAssistedShaderDebugInfo> CreateShaderDebugInfo(const std::vector<uint32_t>& pgm) const override;
     void AnalyzeAndGenerateMessages(VkCommandBuffer command_buffer, VkQueue queue, DPFBufferInfo &buffer_info,
                                     uint32_t operation_index, uint32_t* const debug_output_buffer);
+    void GenerateMessage(VkCommandBuffer command_buffer, VkQueue queue, const DPFBufferInfo& buffer_info, uint32_t operation_index,
+                         const DPFOutputRecord* debug_record, uint32_t count);
     void PreCallRecordCmdDraw(VkCommandBuffer commandBuffer, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex,
                               uint32_t firstInstance) override;
     void PreCallRecordCmdDrawMultiEXT(VkCommandBuffer commandBuffer, uint32_t drawCount, const VkMultiDrawInfoEXT* pVertexInfo,
@@ -183,4 +258,7 @@ class DebugPrintf : public GpuAssistedBase {
   private:
     bool verbose = false;
     bool use_stdout = false;
+    // Collapse records with the same shader, format string and values, within each draw, dispatch or trace rays
+    bool aggregate = false;
+    std::unique_ptr<DPFBinarySink> binary_sink;
 };
@@ -96,12 +96,14 @@ DEVICE_MEMORY_STATE::DEVICE_MEMORY_STATE(VkDeviceMemory mem, const VkMemoryAlloc
       import_handle_type_flags(GetImportHandleType(p_alloc_info)),
       unprotected((memory_type.propertyFlags & VK_MEMORY_PROPERTY_PROTECTED_BIT) == 0),
       multi_instance(IsMultiInstance(p_alloc_info, memory_heap, physical_device_count)),
+      host_coherent((memory_type.propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0),
       dedicated(std::move(dedicated_binding)),
       mapped_range{},
 #ifdef VK_USE_PLATFORM_METAL_EXT
       metal_buffer_export(GetMetalExport(p_alloc_info)),
 #endif                                 // VK_USE_PLATFORM_METAL_EXT
       p_driver_data(nullptr),
+      map_generation(0),
       fake_base_address(fake_address) {}
 
 VkDeviceSize BINDABLE::GetFakeBaseAddress() const {
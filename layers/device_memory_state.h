@@ -58,6 +58,7 @@ class DEVICE_MEMORY_STATE : public BASE_NODE {
     const VkExternalMemoryHandleTypeFlags import_handle_type_flags;
     const bool unprotected;     // can't be used for protected memory
     const bool multi_instance;  // Allocated from MULTI_INSTANCE heap or having more than one deviceMask bit set
+    const bool host_coherent;   // Host writes through a mapping are visible without vkFlushMappedMemoryRanges
     const layer_data::optional<DedicatedBinding> dedicated;
 
     MemRange mapped_range;
@@ -65,6 +66,9 @@ class DEVICE_MEMORY_STATE : public BASE_NODE {
     const bool metal_buffer_export;        // Can be used in a VkExportMetalBufferInfoEXT struct in a VkExportMetalObjectsEXT call
 #endif                                     // VK_USE_PLATFORM_METAL_EXT
     void *p_driver_data;             // Pointer to application's actual memory
+    // Incremented by every vkMapMemory and vkFlushMappedMemoryRanges, lets users of p_driver_data detect remapping and flushed
+    // host writes. Host writes to host_coherent memory need no flush, and so aren't detected.
+    std::atomic<uint64_t> map_generation;
     const VkDeviceSize fake_base_address;  // To allow a unified view of allocations, useful to Synchronization Validation
 
 
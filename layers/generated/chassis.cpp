@@ -33,11 +33,9 @@
 
 small_unordered_map<void*, ValidationObject*, 2> layer_data_map;
 
-// Global unique object identifier.
-std::atomic<uint64_t> global_unique_id(1ULL);
 // Map uniqueID to actual object handle. Accesses to the map itself are
 // internally synchronized.
-vl_concurrent_unordered_map<uint64_t, uint64_t, 4, HashedUint64> unique_id_mapping;
+vl_concurrent_slab_map unique_id_mapping;
 
 bool wrap_handles = true;
 
@@ -285,8 +283,9 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateInstance(const VkInstanceCreateInfo *pCreat
     CHECK_ENABLED local_enables {};
     CHECK_DISABLED local_disables {};
     bool lock_setting;
+    uint32_t thread_safety_sampling;
     ConfigAndEnvSettings config_and_env_settings_data {OBJECT_LAYER_DESCRIPTION, pCreateInfo->pNext, local_enables, local_disables,
-        report_data->filter_message_ids, &report_data->duplicate_message_limit, &lock_setting};
+        report_data->filter_message_ids, &report_data->duplicate_message_limit, &lock_setting, &thread_safety_sampling};
     ProcessConfigAndEnvSettings(&config_and_env_settings_data);
     layer_debug_messenger_actions(report_data, pAllocator, OBJECT_LAYER_DESCRIPTION);
 
@@ -345,6 +344,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateInstance(const VkInstanceCreateInfo *pCreat
     framework->disabled = local_disables;
     framework->enabled = local_enables;
     framework->fine_grained_locking = lock_setting;
+    framework->thread_safety_sampling = thread_safety_sampling;
 
     framework->instance = *pInstance;
     layer_init_instance_dispatch_table(*pInstance, &framework->instance_dispatch_table, fpGetInstanceProcAddr);
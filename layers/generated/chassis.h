@@ -52,22 +52,8 @@
 #include "vk_typemap_helper.h"
 
 
-extern std::atomic<uint64_t> global_unique_id;
-
-// To avoid re-hashing unique ids on each use, we precompute the hash and store the
-// hash's LSBs in the high 24 bits.
-struct HashedUint64 {
-    static const int HASHED_UINT64_SHIFT = 40;
-    size_t operator()(const uint64_t &t) const { return t >> HASHED_UINT64_SHIFT; }
-
-    static uint64_t hash(uint64_t id) {
-        uint64_t h = (uint64_t)layer_data::hash<uint64_t>()(id);
-        id |= h << HASHED_UINT64_SHIFT;
-        return id;
-    }
-};
-
-extern vl_concurrent_unordered_map<uint64_t, uint64_t, 4, HashedUint64> unique_id_mapping;
+// Map of wrapped handles (unique ids) to driver handles. Unique ids encode a slot index, so lookups don't hash or lock.
+extern vl_concurrent_slab_map unique_id_mapping;
 
 
 VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetPhysicalDeviceProcAddr(
@@ -3574,6 +3560,7 @@ class ValidationObject {
         CHECK_DISABLED disabled = {};
         CHECK_ENABLED enabled = {};
         bool fine_grained_locking{true};
+        uint32_t thread_safety_sampling{1};  // Thread safety checks only 1 in thread_safety_sampling objects
 
         VkInstance instance = VK_NULL_HANDLE;
         VkPhysicalDevice physical_device = VK_NULL_HANDLE;
@@ -3618,6 +3605,7 @@ class ValidationObject {
             enabled = framework->enabled;
             disabled = framework->disabled;
             fine_grained_locking = framework->fine_grained_locking;
+            thread_safety_sampling = framework->thread_safety_sampling;
             instance = inst;
         }
 
@@ -3633,6 +3621,7 @@ class ValidationObject {
                 disabled = inst_obj->disabled;
                 enabled = inst_obj->enabled;
                 fine_grained_locking = inst_obj->fine_grained_locking;
+                thread_safety_sampling = inst_obj->thread_safety_sampling;
                 instance_dispatch_table = inst_obj->instance_dispatch_table;
                 instance_extensions = inst_obj->instance_extensions;
                 device_extensions = dev_obj->device_extensions;
@@ -3824,17 +3813,13 @@ class ValidationObject {
         // Wrap a newly created handle with a new unique ID, and return the new ID.
         template <typename HandleType>
         HandleType WrapNew(HandleType newlyCreatedHandle) {
-            auto unique_id = global_unique_id++;
-            unique_id = HashedUint64::hash(unique_id);
-            unique_id_mapping.insert_or_assign(unique_id, reinterpret_cast<uint64_t const &>(newlyCreatedHandle));
+            auto unique_id = unique_id_mapping.insert(reinterpret_cast<uint64_t const &>(newlyCreatedHandle));
             return (HandleType)unique_id;
         }
 
         // Specialized handling for VkDisplayKHR. Adds an entry to enable reverse-lookup.
         VkDisplayKHR WrapDisplay(VkDisplayKHR newlyCreatedHandle, ValidationObject *map_data) {
-            auto unique_id = global_unique_id++;
-            unique_id = HashedUint64::hash(unique_id);
-            unique_id_mapping.insert_or_assign(unique_id, reinterpret_cast<uint64_t const &>(newlyCreatedHandle));
+            auto unique_id = unique_id_mapping.insert(reinterpret_cast<uint64_t const &>(newlyCreatedHandle));
             map_data->display_id_reverse_mapping.insert_or_assign(newlyCreatedHandle, unique_id);
             return (VkDisplayKHR)unique_id;
         }
@@ -764,8 +764,21 @@ const std::array<SyncStageAccessInfoType, 90> syncStageAccessInfoByStageAccessIn
 } };
 
 // Constants defining the mask of all read and write stage_access states
-// Bit order mask of stage_access bit for each stage
-const std::map<VkPipelineStageFlags2, SyncStageAccessFlags> syncStageAccessMaskByStageBit {
+// Entry of a table keyed by a single flag bit, expanded at compile time into a table indexed by bit position
+template <typename Value>
+struct SyncBitTableEntry {
+    VkFlags64 bit;
+    Value value;
+};
+
+// Value for the single flag bit, or none if the bit has no entry
+template <typename Value, size_t N>
+constexpr Value SyncBitTableLookup(const SyncBitTableEntry<Value> (&entries)[N], VkFlags64 bit, Value none, size_t i = 0) {
+    return (i == N) ? none : ((entries[i].bit == bit) ? entries[i].value : SyncBitTableLookup(entries, bit, none, i + 1));
+}
+
+// Bit order mask of stage_access bit for each stage, indexed by bit position
+static const SyncBitTableEntry<SyncStageAccessFlags> syncStageAccessMaskByStageBitEntries[] = {
     { VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT, (
         SYNC_DRAW_INDIRECT_INDIRECT_COMMAND_READ_BIT |
         SYNC_DRAW_INDIRECT_TRANSFORM_FEEDBACK_COUNTER_READ_BIT_EXT
@@ -898,9 +911,75 @@ const std::map<VkPipelineStageFlags2, SyncStageAccessFlags> syncStageAccessMaskB
     { VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT, SYNC_VERTEX_ATTRIBUTE_INPUT_VERTEX_ATTRIBUTE_READ_BIT},
     { VK_PIPELINE_STAGE_2_SUBPASS_SHADING_BIT_HUAWEI, SYNC_SUBPASS_SHADING_HUAWEI_INPUT_ATTACHMENT_READ_BIT},
 };
+const std::array<SyncStageAccessFlags, 64> syncStageAccessMaskByStageBit {{
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 0, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 1, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 2, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 3, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 4, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 5, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 6, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 7, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 8, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 9, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 10, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 11, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 12, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 13, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 14, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 15, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 16, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 17, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 18, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 19, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 20, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 21, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 22, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 23, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 24, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 25, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 26, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 27, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 28, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 29, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 30, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 31, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 32, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 33, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 34, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 35, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 36, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 37, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 38, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 39, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 40, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 41, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 42, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 43, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 44, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 45, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 46, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 47, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 48, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 49, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 50, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 51, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 52, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 53, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 54, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 55, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 56, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 57, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 58, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 59, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 60, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 61, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 62, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByStageBitEntries, VkFlags64(1) << 63, SyncStageAccessFlags(0)),
+}};
 
-// Bit order mask of stage_access bit for each access
-const std::map<VkAccessFlags2, SyncStageAccessFlags> syncStageAccessMaskByAccessBit {
+// Bit order mask of stage_access bit for each access, indexed by bit position
+static const SyncBitTableEntry<SyncStageAccessFlags> syncStageAccessMaskByAccessBitEntries[] = {
     { VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT, (
         SYNC_DRAW_INDIRECT_INDIRECT_COMMAND_READ_BIT |
         SYNC_ACCELERATION_STRUCTURE_BUILD_INDIRECT_COMMAND_READ_BIT
@@ -1015,158 +1094,75 @@ const std::map<VkAccessFlags2, SyncStageAccessFlags> syncStageAccessMaskByAccess
     { VK_ACCESS_2_MEMORY_READ_BIT, syncStageAccessReadMask},
     { VK_ACCESS_2_MEMORY_WRITE_BIT, syncStageAccessWriteMask},
 };
+const std::array<SyncStageAccessFlags, 64> syncStageAccessMaskByAccessBit {{
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 0, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 1, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 2, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 3, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 4, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 5, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 6, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 7, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 8, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 9, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 10, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 11, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 12, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 13, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 14, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 15, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 16, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 17, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 18, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 19, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 20, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 21, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 22, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 23, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 24, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 25, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 26, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 27, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 28, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 29, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 30, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 31, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 32, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 33, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 34, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 35, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 36, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 37, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 38, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 39, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 40, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 41, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 42, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 43, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 44, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 45, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 46, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 47, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 48, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 49, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 50, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 51, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 52, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 53, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 54, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 55, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 56, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 57, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 58, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 59, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 60, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 61, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 62, SyncStageAccessFlags(0)),
+    SyncBitTableLookup(syncStageAccessMaskByAccessBitEntries, VkFlags64(1) << 63, SyncStageAccessFlags(0)),
+}};
 
-// stage_access index for each stage and access
-const std::map<VkPipelineStageFlags2, std::map<VkAccessFlags2, SyncStageAccessIndex>> syncStageAccessIndexByStageAndAccess {
-    { VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, {
-        { VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR, SYNC_ACCELERATION_STRUCTURE_BUILD_ACCELERATION_STRUCTURE_READ },
-        { VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR, SYNC_ACCELERATION_STRUCTURE_BUILD_ACCELERATION_STRUCTURE_WRITE },
-        { VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT, SYNC_ACCELERATION_STRUCTURE_BUILD_INDIRECT_COMMAND_READ },
-        { VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, SYNC_ACCELERATION_STRUCTURE_BUILD_SHADER_SAMPLED_READ },
-        { VK_ACCESS_2_SHADER_STORAGE_READ_BIT, SYNC_ACCELERATION_STRUCTURE_BUILD_SHADER_STORAGE_READ },
-        { VK_ACCESS_2_TRANSFER_READ_BIT, SYNC_ACCELERATION_STRUCTURE_BUILD_TRANSFER_READ },
-        { VK_ACCESS_2_TRANSFER_WRITE_BIT, SYNC_ACCELERATION_STRUCTURE_BUILD_TRANSFER_WRITE },
-        { VK_ACCESS_2_UNIFORM_READ_BIT, SYNC_ACCELERATION_STRUCTURE_BUILD_UNIFORM_READ }
-    } },
-    { VK_PIPELINE_STAGE_2_BLIT_BIT, {
-        { VK_ACCESS_2_TRANSFER_READ_BIT, SYNC_BLIT_TRANSFER_READ },
-        { VK_ACCESS_2_TRANSFER_WRITE_BIT, SYNC_BLIT_TRANSFER_WRITE }
-    } },
-    { VK_PIPELINE_STAGE_2_CLEAR_BIT, {
-        { VK_ACCESS_2_TRANSFER_WRITE_BIT, SYNC_CLEAR_TRANSFER_WRITE }
-    } },
-    { VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, {
-        { VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT, SYNC_COLOR_ATTACHMENT_OUTPUT_COLOR_ATTACHMENT_READ },
-        { VK_ACCESS_2_COLOR_ATTACHMENT_READ_NONCOHERENT_BIT_EXT, SYNC_COLOR_ATTACHMENT_OUTPUT_COLOR_ATTACHMENT_READ_NONCOHERENT_EXT },
-        { VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT, SYNC_COLOR_ATTACHMENT_OUTPUT_COLOR_ATTACHMENT_WRITE }
-    } },
-    { VK_PIPELINE_STAGE_2_COMMAND_PREPROCESS_BIT_NV, {
-        { VK_ACCESS_2_COMMAND_PREPROCESS_READ_BIT_NV, SYNC_COMMAND_PREPROCESS_NV_COMMAND_PREPROCESS_READ_NV },
-        { VK_ACCESS_2_COMMAND_PREPROCESS_WRITE_BIT_NV, SYNC_COMMAND_PREPROCESS_NV_COMMAND_PREPROCESS_WRITE_NV }
-    } },
-    { VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, {
-        { VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR, SYNC_COMPUTE_SHADER_ACCELERATION_STRUCTURE_READ },
-        { VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, SYNC_COMPUTE_SHADER_SHADER_SAMPLED_READ },
-        { VK_ACCESS_2_SHADER_STORAGE_READ_BIT, SYNC_COMPUTE_SHADER_SHADER_STORAGE_READ },
-        { VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, SYNC_COMPUTE_SHADER_SHADER_STORAGE_WRITE },
-        { VK_ACCESS_2_UNIFORM_READ_BIT, SYNC_COMPUTE_SHADER_UNIFORM_READ }
-    } },
-    { VK_PIPELINE_STAGE_2_CONDITIONAL_RENDERING_BIT_EXT, {
-        { VK_ACCESS_2_CONDITIONAL_RENDERING_READ_BIT_EXT, SYNC_CONDITIONAL_RENDERING_EXT_CONDITIONAL_RENDERING_READ_EXT }
-    } },
-    { VK_PIPELINE_STAGE_2_COPY_BIT, {
-        { VK_ACCESS_2_TRANSFER_READ_BIT, SYNC_COPY_TRANSFER_READ },
-        { VK_ACCESS_2_TRANSFER_WRITE_BIT, SYNC_COPY_TRANSFER_WRITE }
-    } },
-    { VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT, {
-        { VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT, SYNC_DRAW_INDIRECT_INDIRECT_COMMAND_READ },
-        { VK_ACCESS_2_TRANSFORM_FEEDBACK_COUNTER_READ_BIT_EXT, SYNC_DRAW_INDIRECT_TRANSFORM_FEEDBACK_COUNTER_READ_EXT }
-    } },
-    { VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT, {
-        { VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT, SYNC_EARLY_FRAGMENT_TESTS_DEPTH_STENCIL_ATTACHMENT_READ },
-        { VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT, SYNC_EARLY_FRAGMENT_TESTS_DEPTH_STENCIL_ATTACHMENT_WRITE }
-    } },
-    { VK_PIPELINE_STAGE_2_FRAGMENT_DENSITY_PROCESS_BIT_EXT, {
-        { VK_ACCESS_2_FRAGMENT_DENSITY_MAP_READ_BIT_EXT, SYNC_FRAGMENT_DENSITY_PROCESS_EXT_FRAGMENT_DENSITY_MAP_READ_EXT }
-    } },
-    { VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, {
-        { VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR, SYNC_FRAGMENT_SHADER_ACCELERATION_STRUCTURE_READ },
-        { VK_ACCESS_2_INPUT_ATTACHMENT_READ_BIT, SYNC_FRAGMENT_SHADER_INPUT_ATTACHMENT_READ },
-        { VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, SYNC_FRAGMENT_SHADER_SHADER_SAMPLED_READ },
-        { VK_ACCESS_2_SHADER_STORAGE_READ_BIT, SYNC_FRAGMENT_SHADER_SHADER_STORAGE_READ },
-        { VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, SYNC_FRAGMENT_SHADER_SHADER_STORAGE_WRITE },
-        { VK_ACCESS_2_UNIFORM_READ_BIT, SYNC_FRAGMENT_SHADER_UNIFORM_READ }
-    } },
-    { VK_PIPELINE_STAGE_2_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_KHR, {
-        { VK_ACCESS_2_FRAGMENT_SHADING_RATE_ATTACHMENT_READ_BIT_KHR, SYNC_FRAGMENT_SHADING_RATE_ATTACHMENT_FRAGMENT_SHADING_RATE_ATTACHMENT_READ }
-    } },
-    { VK_PIPELINE_STAGE_2_GEOMETRY_SHADER_BIT, {
-        { VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR, SYNC_GEOMETRY_SHADER_ACCELERATION_STRUCTURE_READ },
-        { VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, SYNC_GEOMETRY_SHADER_SHADER_SAMPLED_READ },
-        { VK_ACCESS_2_SHADER_STORAGE_READ_BIT, SYNC_GEOMETRY_SHADER_SHADER_STORAGE_READ },
-        { VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, SYNC_GEOMETRY_SHADER_SHADER_STORAGE_WRITE },
-        { VK_ACCESS_2_UNIFORM_READ_BIT, SYNC_GEOMETRY_SHADER_UNIFORM_READ }
-    } },
-    { VK_PIPELINE_STAGE_2_HOST_BIT, {
-        { VK_ACCESS_2_HOST_READ_BIT, SYNC_HOST_HOST_READ },
-        { VK_ACCESS_2_HOST_WRITE_BIT, SYNC_HOST_HOST_WRITE }
-    } },
-    { VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT, {
-        { VK_ACCESS_2_INDEX_READ_BIT, SYNC_INDEX_INPUT_INDEX_READ }
-    } },
-    { VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT, {
-        { VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT, SYNC_LATE_FRAGMENT_TESTS_DEPTH_STENCIL_ATTACHMENT_READ },
-        { VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT, SYNC_LATE_FRAGMENT_TESTS_DEPTH_STENCIL_ATTACHMENT_WRITE }
-    } },
-    { VK_PIPELINE_STAGE_2_MESH_SHADER_BIT_NV, {
-        { VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR, SYNC_MESH_SHADER_NV_ACCELERATION_STRUCTURE_READ },
-        { VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, SYNC_MESH_SHADER_NV_SHADER_SAMPLED_READ },
-        { VK_ACCESS_2_SHADER_STORAGE_READ_BIT, SYNC_MESH_SHADER_NV_SHADER_STORAGE_READ },
-        { VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, SYNC_MESH_SHADER_NV_SHADER_STORAGE_WRITE },
-        { VK_ACCESS_2_UNIFORM_READ_BIT, SYNC_MESH_SHADER_NV_UNIFORM_READ }
-    } },
-    { VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR, {
-        { VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR, SYNC_RAY_TRACING_SHADER_ACCELERATION_STRUCTURE_READ },
-        { VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, SYNC_RAY_TRACING_SHADER_SHADER_SAMPLED_READ },
-        { VK_ACCESS_2_SHADER_STORAGE_READ_BIT, SYNC_RAY_TRACING_SHADER_SHADER_STORAGE_READ },
-        { VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, SYNC_RAY_TRACING_SHADER_SHADER_STORAGE_WRITE },
-        { VK_ACCESS_2_UNIFORM_READ_BIT, SYNC_RAY_TRACING_SHADER_UNIFORM_READ }
-    } },
-    { VK_PIPELINE_STAGE_2_RESOLVE_BIT, {
-        { VK_ACCESS_2_TRANSFER_READ_BIT, SYNC_RESOLVE_TRANSFER_READ },
-        { VK_ACCESS_2_TRANSFER_WRITE_BIT, SYNC_RESOLVE_TRANSFER_WRITE }
-    } },
-    { VK_PIPELINE_STAGE_2_SUBPASS_SHADING_BIT_HUAWEI, {
-        { VK_ACCESS_2_INPUT_ATTACHMENT_READ_BIT, SYNC_SUBPASS_SHADING_HUAWEI_INPUT_ATTACHMENT_READ }
-    } },
-    { VK_PIPELINE_STAGE_2_TASK_SHADER_BIT_NV, {
-        { VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR, SYNC_TASK_SHADER_NV_ACCELERATION_STRUCTURE_READ },
-        { VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, SYNC_TASK_SHADER_NV_SHADER_SAMPLED_READ },
-        { VK_ACCESS_2_SHADER_STORAGE_READ_BIT, SYNC_TASK_SHADER_NV_SHADER_STORAGE_READ },
-        { VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, SYNC_TASK_SHADER_NV_SHADER_STORAGE_WRITE },
-        { VK_ACCESS_2_UNIFORM_READ_BIT, SYNC_TASK_SHADER_NV_UNIFORM_READ }
-    } },
-    { VK_PIPELINE_STAGE_2_TESSELLATION_CONTROL_SHADER_BIT, {
-        { VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR, SYNC_TESSELLATION_CONTROL_SHADER_ACCELERATION_STRUCTURE_READ },
-        { VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, SYNC_TESSELLATION_CONTROL_SHADER_SHADER_SAMPLED_READ },
-        { VK_ACCESS_2_SHADER_STORAGE_READ_BIT, SYNC_TESSELLATION_CONTROL_SHADER_SHADER_STORAGE_READ },
-        { VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, SYNC_TESSELLATION_CONTROL_SHADER_SHADER_STORAGE_WRITE },
-        { VK_ACCESS_2_UNIFORM_READ_BIT, SYNC_TESSELLATION_CONTROL_SHADER_UNIFORM_READ }
-    } },
-    { VK_PIPELINE_STAGE_2_TESSELLATION_EVALUATION_SHADER_BIT, {
-        { VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR, SYNC_TESSELLATION_EVALUATION_SHADER_ACCELERATION_STRUCTURE_READ },
-        { VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, SYNC_TESSELLATION_EVALUATION_SHADER_SHADER_SAMPLED_READ },
-        { VK_ACCESS_2_SHADER_STORAGE_READ_BIT, SYNC_TESSELLATION_EVALUATION_SHADER_SHADER_STORAGE_READ },
-        { VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, SYNC_TESSELLATION_EVALUATION_SHADER_SHADER_STORAGE_WRITE },
-        { VK_ACCESS_2_UNIFORM_READ_BIT, SYNC_TESSELLATION_EVALUATION_SHADER_UNIFORM_READ }
-    } },
-    { VK_PIPELINE_STAGE_2_TRANSFORM_FEEDBACK_BIT_EXT, {
-        { VK_ACCESS_2_TRANSFORM_FEEDBACK_COUNTER_READ_BIT_EXT, SYNC_TRANSFORM_FEEDBACK_EXT_TRANSFORM_FEEDBACK_COUNTER_READ_EXT },
-        { VK_ACCESS_2_TRANSFORM_FEEDBACK_COUNTER_WRITE_BIT_EXT, SYNC_TRANSFORM_FEEDBACK_EXT_TRANSFORM_FEEDBACK_COUNTER_WRITE_EXT },
-        { VK_ACCESS_2_TRANSFORM_FEEDBACK_WRITE_BIT_EXT, SYNC_TRANSFORM_FEEDBACK_EXT_TRANSFORM_FEEDBACK_WRITE_EXT }
-    } },
-    { VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT, {
-        { VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT, SYNC_VERTEX_ATTRIBUTE_INPUT_VERTEX_ATTRIBUTE_READ }
-    } },
-    { VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT, {
-        { VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR, SYNC_VERTEX_SHADER_ACCELERATION_STRUCTURE_READ },
-        { VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, SYNC_VERTEX_SHADER_SHADER_SAMPLED_READ },
-        { VK_ACCESS_2_SHADER_STORAGE_READ_BIT, SYNC_VERTEX_SHADER_SHADER_STORAGE_READ },
-        { VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, SYNC_VERTEX_SHADER_SHADER_STORAGE_WRITE },
-        { VK_ACCESS_2_UNIFORM_READ_BIT, SYNC_VERTEX_SHADER_UNIFORM_READ }
-    } },
-    { VK_PIPELINE_STAGE_2_VIDEO_DECODE_BIT_KHR, {
-        { VK_ACCESS_2_VIDEO_DECODE_READ_BIT_KHR, SYNC_VIDEO_DECODE_VIDEO_DECODE_READ },
-        { VK_ACCESS_2_VIDEO_DECODE_WRITE_BIT_KHR, SYNC_VIDEO_DECODE_VIDEO_DECODE_WRITE }
-    } },
-    { VK_PIPELINE_STAGE_2_VIDEO_ENCODE_BIT_KHR, {
-        { VK_ACCESS_2_VIDEO_ENCODE_READ_BIT_KHR, SYNC_VIDEO_ENCODE_VIDEO_ENCODE_READ },
-        { VK_ACCESS_2_VIDEO_ENCODE_WRITE_BIT_KHR, SYNC_VIDEO_ENCODE_VIDEO_ENCODE_WRITE }
-    } },
-};
-
-// Direct VkPipelineStageFlags to valid VkAccessFlags lookup table
-const std::map<VkPipelineStageFlags2, VkAccessFlags2> syncDirectStageToAccessMask {
+// Direct VkPipelineStageFlags to valid VkAccessFlags lookup table, indexed by bit position
+static constexpr SyncBitTableEntry<VkAccessFlags2> syncDirectStageToAccessMaskEntries[] = {
     { VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT, (
         VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT |
         VK_ACCESS_2_TRANSFORM_FEEDBACK_COUNTER_READ_BIT_EXT
@@ -1299,9 +1295,75 @@ const std::map<VkPipelineStageFlags2, VkAccessFlags2> syncDirectStageToAccessMas
     { VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT, VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT},
     { VK_PIPELINE_STAGE_2_SUBPASS_SHADING_BIT_HUAWEI, VK_ACCESS_2_INPUT_ATTACHMENT_READ_BIT},
 };
+const std::array<VkAccessFlags2, 64> syncDirectStageToAccessMask {{
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 0, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 1, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 2, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 3, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 4, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 5, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 6, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 7, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 8, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 9, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 10, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 11, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 12, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 13, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 14, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 15, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 16, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 17, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 18, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 19, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 20, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 21, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 22, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 23, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 24, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 25, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 26, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 27, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 28, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 29, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 30, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 31, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 32, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 33, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 34, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 35, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 36, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 37, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 38, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 39, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 40, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 41, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 42, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 43, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 44, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 45, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 46, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 47, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 48, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 49, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 50, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 51, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 52, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 53, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 54, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 55, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 56, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 57, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 58, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 59, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 60, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 61, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 62, VkAccessFlags2(0)),
+    SyncBitTableLookup(syncDirectStageToAccessMaskEntries, VkFlags64(1) << 63, VkAccessFlags2(0)),
+}};
 
-// Pipeline stages corresponding to VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT for each VkQueueFlagBits
-const std::map<VkQueueFlagBits, VkPipelineStageFlags2> syncAllCommandStagesByQueueFlags {
+// Pipeline stages corresponding to VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT for each VkQueueFlagBits, indexed by bit position
+static constexpr SyncBitTableEntry<VkPipelineStageFlags2> syncAllCommandStagesByQueueFlagsEntries[] = {
     { VK_QUEUE_COMPUTE_BIT, (
         VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT |
         VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT |
@@ -1367,9 +1429,43 @@ const std::map<VkQueueFlagBits, VkPipelineStageFlags2> syncAllCommandStagesByQue
         VK_PIPELINE_STAGE_2_HOST_BIT
     )},
 };
+const std::array<VkPipelineStageFlags2, 32> syncAllCommandStagesByQueueFlags {{
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 0, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 1, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 2, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 3, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 4, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 5, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 6, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 7, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 8, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 9, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 10, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 11, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 12, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 13, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 14, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 15, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 16, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 17, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 18, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 19, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 20, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 21, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 22, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 23, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 24, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 25, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 26, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 27, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 28, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 29, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 30, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncAllCommandStagesByQueueFlagsEntries, VkFlags64(1) << 31, VkPipelineStageFlags2(0)),
+}};
 
-// Masks of logically earlier stage flags for a given stage flag
-const std::map<VkPipelineStageFlags2, VkPipelineStageFlags2> syncLogicallyEarlierStages {
+// Masks of logically earlier stage flags for a given stage flag, indexed by bit position
+static constexpr SyncBitTableEntry<VkPipelineStageFlags2> syncLogicallyEarlierStagesEntries[] = {
     { VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT},
     { VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT},
     { VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT, (
@@ -1561,9 +1657,75 @@ const std::map<VkPipelineStageFlags2, VkPipelineStageFlags2> syncLogicallyEarlie
         VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT
     )},
 };
+const std::array<VkPipelineStageFlags2, 64> syncLogicallyEarlierStages {{
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 0, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 1, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 2, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 3, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 4, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 5, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 6, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 7, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 8, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 9, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 10, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 11, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 12, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 13, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 14, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 15, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 16, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 17, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 18, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 19, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 20, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 21, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 22, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 23, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 24, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 25, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 26, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 27, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 28, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 29, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 30, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 31, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 32, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 33, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 34, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 35, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 36, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 37, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 38, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 39, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 40, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 41, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 42, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 43, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 44, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 45, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 46, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 47, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 48, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 49, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 50, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 51, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 52, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 53, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 54, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 55, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 56, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 57, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 58, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 59, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 60, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 61, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 62, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyEarlierStagesEntries, VkFlags64(1) << 63, VkPipelineStageFlags2(0)),
+}};
 
-// Masks of logically later stage flags for a given stage flag
-const std::map<VkPipelineStageFlags2, VkPipelineStageFlags2> syncLogicallyLaterStages {
+// Masks of logically later stage flags for a given stage flag, indexed by bit position
+static constexpr SyncBitTableEntry<VkPipelineStageFlags2> syncLogicallyLaterStagesEntries[] = {
     { VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, (
         VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT |
         VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT |
@@ -1753,9 +1915,75 @@ const std::map<VkPipelineStageFlags2, VkPipelineStageFlags2> syncLogicallyLaterS
     { VK_PIPELINE_STAGE_2_SUBPASS_SHADING_BIT_HUAWEI, VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT},
     { VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT, VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT},
 };
+const std::array<VkPipelineStageFlags2, 64> syncLogicallyLaterStages {{
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 0, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 1, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 2, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 3, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 4, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 5, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 6, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 7, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 8, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 9, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 10, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 11, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 12, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 13, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 14, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 15, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 16, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 17, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 18, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 19, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 20, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 21, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 22, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 23, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 24, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 25, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 26, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 27, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 28, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 29, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 30, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 31, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 32, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 33, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 34, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 35, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 36, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 37, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 38, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 39, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 40, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 41, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 42, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 43, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 44, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 45, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 46, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 47, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 48, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 49, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 50, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 51, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 52, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 53, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 54, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 55, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 56, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 57, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 58, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 59, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 60, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 61, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 62, VkPipelineStageFlags2(0)),
+    SyncBitTableLookup(syncLogicallyLaterStagesEntries, VkFlags64(1) << 63, VkPipelineStageFlags2(0)),
+}};
 
-// Lookup table of stage orderings
-const std::map<VkPipelineStageFlags2, int> syncStageOrder {
+// Lookup table of stage orderings, indexed by bit position
+static constexpr SyncBitTableEntry<int> syncStageOrderEntries[] = {
     { VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, 0},
     { VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT, 1},
     { VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT, 2},
@@ -1788,8 +2016,75 @@ const std::map<VkPipelineStageFlags2, int> syncStageOrder {
     { VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT, 29},
     { VK_PIPELINE_STAGE_2_HOST_BIT, 30},
 };
+const std::array<int, 64> syncStageOrder {{
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 0, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 1, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 2, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 3, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 4, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 5, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 6, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 7, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 8, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 9, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 10, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 11, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 12, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 13, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 14, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 15, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 16, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 17, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 18, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 19, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 20, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 21, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 22, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 23, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 24, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 25, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 26, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 27, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 28, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 29, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 30, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 31, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 32, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 33, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 34, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 35, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 36, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 37, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 38, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 39, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 40, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 41, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 42, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 43, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 44, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 45, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 46, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 47, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 48, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 49, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 50, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 51, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 52, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 53, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 54, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 55, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 56, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 57, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 58, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 59, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 60, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 61, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 62, -1),
+    SyncBitTableLookup(syncStageOrderEntries, VkFlags64(1) << 63, -1),
+}};
 
-const std::map<VkShaderStageFlagBits, SyncShaderStageAccess> syncStageAccessMaskByShaderStage {
+// Stage/access indices of the descriptor accesses for each VkShaderStageFlagBits, indexed by bit position
+static constexpr SyncBitTableEntry<SyncShaderStageAccess> syncStageAccessMaskByShaderStageEntries[] = {
     {VK_SHADER_STAGE_VERTEX_BIT, {
         SYNC_VERTEX_SHADER_SHADER_SAMPLED_READ, SYNC_VERTEX_SHADER_SHADER_STORAGE_READ, SYNC_VERTEX_SHADER_SHADER_STORAGE_WRITE, SYNC_VERTEX_SHADER_UNIFORM_READ}},
     {VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT, {
@@ -1819,3 +2114,37 @@ const std::map<VkShaderStageFlagBits, SyncShaderStageAccess> syncStageAccessMask
     {VK_SHADER_STAGE_MESH_BIT_NV, {
         SYNC_MESH_SHADER_NV_SHADER_SAMPLED_READ, SYNC_MESH_SHADER_NV_SHADER_STORAGE_READ, SYNC_MESH_SHADER_NV_SHADER_STORAGE_WRITE, SYNC_MESH_SHADER_NV_UNIFORM_READ}},
 };
+const std::array<SyncShaderStageAccess, 32> syncStageAccessMaskByShaderStage {{
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 0, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 1, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 2, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 3, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 4, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 5, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 6, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 7, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 8, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 9, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 10, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 11, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 12, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 13, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 14, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 15, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 16, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 17, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 18, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 19, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 20, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 21, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 22, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 23, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 24, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 25, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 26, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 27, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 28, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 29, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 30, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+    SyncBitTableLookup(syncStageAccessMaskByShaderStageEntries, VkFlags64(1) << 31, SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}),
+}};
@@ -34,10 +34,10 @@
 
 #include <array>
 #include <bitset>
-#include <map>
 #include <stdint.h>
 #include <vulkan/vulkan.h>
 #include "vk_layer_data.h"
+#include "vk_layer_utils.h"
 using SyncStageAccessFlags = std::bitset<128>;
 
 // clang-format off
@@ -337,29 +337,37 @@ static const SyncStageAccessFlags syncStageAccessWriteMask = ( //  Mask of all w
     SYNC_QUEUE_FAMILY_OWNERSHIP_TRANSFER_BIT
 );
 
-// Bit order mask of stage_access bit for each stage
-extern const std::map<VkPipelineStageFlags2, SyncStageAccessFlags> syncStageAccessMaskByStageBit;
+// Union of the table values for each bit set in mask
+template <typename Value, size_t N>
+Value SyncBitTableUnion(const std::array<Value, N> &table, VkFlags64 mask) {
+    Value result = Value();
+    if (N < 64) mask &= (VkFlags64(1) << (N % 64)) - 1;
+    for (; mask; mask &= mask - 1) {
+        result |= table[LeastSignificantBit(mask)];
+    }
+    return result;
+}
 
-// Bit order mask of stage_access bit for each access
-extern const std::map<VkAccessFlags2, SyncStageAccessFlags> syncStageAccessMaskByAccessBit;
+// Bit order mask of stage_access bit for each stage, indexed by bit position
+extern const std::array<SyncStageAccessFlags, 64> syncStageAccessMaskByStageBit;
 
-// stage_access index for each stage and access
-extern const std::map<VkPipelineStageFlags2, std::map<VkAccessFlags2, SyncStageAccessIndex>> syncStageAccessIndexByStageAndAccess;
+// Bit order mask of stage_access bit for each access, indexed by bit position
+extern const std::array<SyncStageAccessFlags, 64> syncStageAccessMaskByAccessBit;
 
-// Direct VkPipelineStageFlags to valid VkAccessFlags lookup table
-extern const std::map<VkPipelineStageFlags2, VkAccessFlags2> syncDirectStageToAccessMask;
+// Direct VkPipelineStageFlags to valid VkAccessFlags lookup table, indexed by bit position
+extern const std::array<VkAccessFlags2, 64> syncDirectStageToAccessMask;
 
-// Pipeline stages corresponding to VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT for each VkQueueFlagBits
-extern const std::map<VkQueueFlagBits, VkPipelineStageFlags2> syncAllCommandStagesByQueueFlags;
+// Pipeline stages corresponding to VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT for each VkQueueFlagBits, indexed by bit position
+extern const std::array<VkPipelineStageFlags2, 32> syncAllCommandStagesByQueueFlags;
 
-// Masks of logically earlier stage flags for a given stage flag
-extern const std::map<VkPipelineStageFlags2, VkPipelineStageFlags2> syncLogicallyEarlierStages;
+// Masks of logically earlier stage flags for a given stage flag, indexed by bit position
+extern const std::array<VkPipelineStageFlags2, 64> syncLogicallyEarlierStages;
 
-// Masks of logically later stage flags for a given stage flag
-extern const std::map<VkPipelineStageFlags2, VkPipelineStageFlags2> syncLogicallyLaterStages;
+// Masks of logically later stage flags for a given stage flag, indexed by bit position
+extern const std::array<VkPipelineStageFlags2, 64> syncLogicallyLaterStages;
 
-// Lookup table of stage orderings
-extern const std::map<VkPipelineStageFlags2, int> syncStageOrder;
+// Lookup table of stage orderings, indexed by bit position
+extern const std::array<int, 64> syncStageOrder;
 
 struct SyncShaderStageAccess {
     SyncStageAccessIndex sampled_read;
@@ -368,4 +376,5 @@ struct SyncShaderStageAccess {
     SyncStageAccessIndex uniform_read;
 };
 
-extern const std::map<VkShaderStageFlagBits, SyncShaderStageAccess> syncStageAccessMaskByShaderStage;
+// Stage/access indices of the descriptor accesses for each VkShaderStageFlagBits, indexed by bit position
+extern const std::array<SyncShaderStageAccess, 32> syncStageAccessMaskByShaderStage;
@@ -34,6 +34,17 @@ WriteLockGuard ThreadSafety::WriteLock() {
     return WriteLockGuard(validation_object_mutex, std::defer_lock);
 }
 
+thread_local std::vector<ObjectUsePin> ObjectUsePins::pins_;
+
+void ThreadSafety::InitDeviceValidationObject(bool add_obj, ValidationObject *inst_obj, ValidationObject *dev_obj) {
+    ValidationObject::InitDeviceValidationObject(add_obj, inst_obj, dev_obj);
+    if (add_obj && parent_instance && parent_instance->c_VkDevice.Sampled(device)) {
+        // Create the device's use data now, PostCallRecordCreateDevice on the instance will then find it already present
+        parent_instance->c_VkDevice.CreateObject(device);
+        device_use_data = parent_instance->c_VkDevice.FindObject(device);
+    }
+}
+
 void ThreadSafety::PreCallRecordAllocateCommandBuffers(VkDevice device, const VkCommandBufferAllocateInfo *pAllocateInfo,
                                                        VkCommandBuffer *pCommandBuffers) {
     StartReadObjectParentInstance(device, "vkAllocateCommandBuffers");
@@ -120,6 +120,45 @@ private:
 };
 
 
+// The use data found by a Start* call is pinned (per thread) until the matching Finish* call of the same API call, s.t.
+// Finish* need not look the object up again. Pins are keyed by the counter (or other lookup) the use data was found with.
+struct ObjectUsePin {
+    const void *key;
+    uint64_t object;
+    std::shared_ptr<ObjectUseData> use_data;
+};
+
+class ObjectUsePins {
+public:
+    // Every pin is still needed by a Finish* of a call in progress on this thread, so none is ever dropped. Once a call has
+    // used kMaxPins objects (e.g. the command buffers of a large vkFreeCommandBuffers), the rest are not pinned, and their
+    // Finish* look them up again.
+    static void Pin(const void *key, uint64_t object, std::shared_ptr<ObjectUseData> &&use_data) {
+        if (pins_.size() >= kMaxPins) {
+            return;
+        }
+        pins_.push_back(ObjectUsePin{key, object, std::move(use_data)});
+    }
+
+    // Returns null if there is no pin for the object
+    static std::shared_ptr<ObjectUseData> Unpin(const void *key, uint64_t object) {
+        std::shared_ptr<ObjectUseData> use_data;
+        for (auto it = pins_.end(); it != pins_.begin();) {
+            --it;
+            if ((it->key == key) && (it->object == object)) {
+                use_data = std::move(it->use_data);
+                pins_.erase(it);
+                break;
+            }
+        }
+        return use_data;
+    }
+
+private:
+    static constexpr size_t kMaxPins = 64;
+    static thread_local std::vector<ObjectUsePin> pins_;
+};
+
 template <typename T>
 class counter {
 public:
@@ -129,7 +168,22 @@ public:
 
     vl_concurrent_unordered_map<T, std::shared_ptr<ObjectUseData>, 6> object_table;
 
+    // With thread_safety_sampling, only the objects selected by their handle are tracked. The selection is the same for every
+    // call on every thread, so the Start* and Finish* of an object always agree, and a collision on a tracked object is still
+    // detected and reported with both threads.
+    bool Sampled(T object) const {
+        const uint32_t sampling = object_data->thread_safety_sampling;
+        if (sampling <= 1) {
+            return true;
+        }
+        const uint64_t hash = (uint64_t)(object) * 0x9E3779B97F4A7C15ULL;
+        return ((hash >> 32) % sampling) == 0;
+    }
+
     void CreateObject(T object) {
+        if (!Sampled(object)) {
+            return;
+        }
         object_table.insert(object, std::make_shared<ObjectUseData>());
     }
 
@@ -153,39 +207,51 @@ public:
         }
     }
 
+    // Find the use data of object, check and record the write, and return the use data for the matching FinishWrite
+    std::shared_ptr<ObjectUseData> StartWriteUse(T object, const char *api_name) {
+        if (object == VK_NULL_HANDLE || !Sampled(object)) {
+            return nullptr;
+        }
+        auto use_data = FindObject(object);
+        if (use_data) {
+            StartWrite(object, *use_data, api_name);
+        }
+        return use_data;
+    }
+
     void StartWrite(T object, const char *api_name) {
-        if (object == VK_NULL_HANDLE) {
-            return;
+        auto use_data = StartWriteUse(object, api_name);
+        if (use_data) {
+            ObjectUsePins::Pin(this, (uint64_t)(object), std::move(use_data));
         }
+    }
+
+    void StartWrite(T object, ObjectUseData &use_data, const char *api_name) {
         bool skip = false;
         loader_platform_thread_id tid = loader_platform_get_thread_id();
 
-        auto use_data = FindObject(object);
-        if (!use_data) {
-            return;
-        }
-        const ObjectUseData::WriteReadCount prevCount = use_data->AddWriter();
+        const ObjectUseData::WriteReadCount prevCount = use_data.AddWriter();
 
         if (prevCount.GetReadCount() == 0 && prevCount.GetWriteCount() == 0) {
             // There is no current use of the object.  Record writer thread.
-            use_data->thread = tid;
+            use_data.thread = tid;
         } else {
             if (prevCount.GetReadCount() == 0) {
                 assert(prevCount.GetWriteCount() != 0);
                 // There are no readers.  Two writers just collided.
-                if (use_data->thread != tid) {
+                if (use_data.thread != tid) {
                     skip |= object_data->LogError(object, kVUID_Threading_MultipleThreads,
                         "THREADING ERROR : %s(): object of type %s is simultaneously used in "
                         "thread 0x%" PRIx64 " and thread 0x%" PRIx64, api_name,
-                        typeName, (uint64_t)use_data->thread.load(std::memory_order_relaxed), (uint64_t)tid);
+                        typeName, (uint64_t)use_data.thread.load(std::memory_order_relaxed), (uint64_t)tid);
                     if (skip) {
                         // Wait for thread-safe access to object instead of skipping call.
-                        use_data->WaitForObjectIdle(true);
+                        use_data.WaitForObjectIdle(true);
                         // There is now no current use of the object.  Record writer thread.
-                        use_data->thread = tid;
+                        use_data.thread = tid;
                     } else {
                         // There is now no current use of the object.  Record writer thread.
-                        use_data->thread = tid;
+                        use_data.thread = tid;
                     }
                 } else {
                     // This is either safe multiple use in one call, or recursive use.
@@ -193,19 +259,19 @@ public:
                 }
             } else {
                 // There are readers.  This writer collided with them.
-                if (use_data->thread != tid) {
+                if (use_data.thread != tid) {
                     skip |= object_data->LogError(object, kVUID_Threading_MultipleThreads,
                         "THREADING ERROR : %s(): object of type %s is simultaneously used in "
                         "thread 0x%" PRIx64 " and thread 0x%" PRIx64, api_name,
-                        typeName, (uint64_t)use_data->thread.load(std::memory_order_relaxed), (uint64_t)tid);
+                        typeName, (uint64_t)use_data.thread.load(std::memory_order_relaxed), (uint64_t)tid);
                     if (skip) {
                         // Wait for thread-safe access to object instead of skipping call.
-                        use_data->WaitForObjectIdle(true);
+                        use_data.WaitForObjectIdle(true);
                         // There is now no current use of the object.  Record writer thread.
-                        use_data->thread = tid;
+                        use_data.thread = tid;
                     } else {
                         // Continue with an unsafe use of the object.
-                        use_data->thread = tid;
+                        use_data.thread = tid;
                     }
                 } else {
                     // This is either safe multiple use in one call, or recursive use.
@@ -216,56 +282,75 @@ public:
     }
 
     void FinishWrite(T object, const char *api_name) {
-        if (object == VK_NULL_HANDLE) {
+        if (object == VK_NULL_HANDLE || !Sampled(object)) {
             return;
         }
         // Object is no longer in use
-        auto use_data = FindObject(object);
+        auto use_data = ObjectUsePins::Unpin(this, (uint64_t)(object));
         if (!use_data) {
-            return;
+            use_data = FindObject(object);
+            if (!use_data) {
+                return;
+            }
         }
         use_data->RemoveWriter();
     }
 
+    // Find the use data of object, check and record the read, and return the use data for the matching FinishRead
+    std::shared_ptr<ObjectUseData> StartReadUse(T object, const char *api_name) {
+        if (object == VK_NULL_HANDLE || !Sampled(object)) {
+            return nullptr;
+        }
+        auto use_data = FindObject(object);
+        if (use_data) {
+            StartRead(object, *use_data, api_name);
+        }
+        return use_data;
+    }
+
     void StartRead(T object, const char *api_name) {
-        if (object == VK_NULL_HANDLE) {
-            return;
+        auto use_data = StartReadUse(object, api_name);
+        if (use_data) {
+            ObjectUsePins::Pin(this, (uint64_t)(object), std::move(use_data));
         }
+    }
+
+    void StartRead(T object, ObjectUseData &use_data, const char *api_name) {
         bool skip = false;
         loader_platform_thread_id tid = loader_platform_get_thread_id();
 
-        auto use_data = FindObject(object);
-        if (!use_data) {
-            return;
-        }
-        const ObjectUseData::WriteReadCount prevCount = use_data->AddReader();
+        const ObjectUseData::WriteReadCount prevCount = use_data.AddReader();
 
         if (prevCount.GetReadCount() == 0 && prevCount.GetWriteCount() == 0) {
             // There is no current use of the object.
-            use_data->thread = tid;
-        } else if (prevCount.GetWriteCount() > 0 && use_data->thread != tid) {
+            use_data.thread = tid;
+        } else if (prevCount.GetWriteCount() > 0 && use_data.thread != tid) {
             // There is a writer of the object.
             skip |= object_data->LogError(object, kVUID_Threading_MultipleThreads,
                 "THREADING ERROR : %s(): object of type %s is simultaneously used in "
                 "thread 0x%" PRIx64 " and thread 0x%" PRIx64, api_name,
-                typeName, (uint64_t)use_data->thread.load(std::memory_order_relaxed), (uint64_t)tid);
+                typeName, (uint64_t)use_data.thread.load(std::memory_order_relaxed), (uint64_t)tid);
             if (skip) {
                 // Wait for thread-safe access to object instead of skipping call.
-                use_data->WaitForObjectIdle(false);
-                use_data->thread = tid;
+                use_data.WaitForObjectIdle(false);
+                use_data.thread = tid;
             }
         } else {
             // There are other readers of the object.
         }
     }
+
     void FinishRead(T object, const char *api_name) {
-        if (object == VK_NULL_HANDLE) {
+        if (object == VK_NULL_HANDLE || !Sampled(object)) {
             return;
         }
 
-        auto use_data = FindObject(object);
+        auto use_data = ObjectUsePins::Unpin(this, (uint64_t)(object));
         if (!use_data) {
-            return;
+            use_data = FindObject(object);
+            if (!use_data) {
+                return;
+            }
         }
         use_data->RemoveReader();
     }
@@ -482,7 +567,6 @@ public:
         (parent_instance ? parent_instance : this)->c_##type.DestroyObject(object);             \
     }
 
-WRAPPER_PARENT_INSTANCE(VkDevice)
 WRAPPER_PARENT_INSTANCE(VkInstance)
 WRAPPER(VkQueue)
 #ifdef DISTINCT_NONDISPATCHABLE_HANDLES
@@ -546,13 +630,63 @@ WRAPPER_PARENT_INSTANCE(uint64_t)
         c_VkCommandBuffer.DestroyObject(object);
     }
 
-    // VkCommandBuffer needs check for implicit use of command pool
+    // The device's own use data is found once, as (nearly) every device level call uses the device. The device chassis object
+    // is itself found through the dispatch key, so this is the per dispatch key slot for the device use data.
+    std::shared_ptr<ObjectUseData> device_use_data;
+    void InitDeviceValidationObject(bool add_obj, ValidationObject *inst_obj, ValidationObject *dev_obj) override;
+
+    counter<VkDevice> &DeviceCounter() { return (parent_instance ? parent_instance : this)->c_VkDevice; }
+    void StartWriteObjectParentInstance(VkDevice object, const char *api_name) {
+        if (device_use_data && (object == device)) {
+            DeviceCounter().StartWrite(object, *device_use_data, api_name);
+        } else {
+            DeviceCounter().StartWrite(object, api_name);
+        }
+    }
+    void FinishWriteObjectParentInstance(VkDevice object, const char *api_name) {
+        if (device_use_data && (object == device)) {
+            device_use_data->RemoveWriter();
+        } else {
+            DeviceCounter().FinishWrite(object, api_name);
+        }
+    }
+    void StartReadObjectParentInstance(VkDevice object, const char *api_name) {
+        if (device_use_data && (object == device)) {
+            DeviceCounter().StartRead(object, *device_use_data, api_name);
+        } else {
+            DeviceCounter().StartRead(object, api_name);
+        }
+    }
+    void FinishReadObjectParentInstance(VkDevice object, const char *api_name) {
+        if (device_use_data && (object == device)) {
+            device_use_data->RemoveReader();
+        } else {
+            DeviceCounter().FinishRead(object, api_name);
+        }
+    }
+    void CreateObjectParentInstance(VkDevice object) { DeviceCounter().CreateObject(object); }
+    void DestroyObjectParentInstance(VkDevice object) { DeviceCounter().DestroyObject(object); }
+
+    counter<VkCommandPool> &CommandPoolCounter() {
+#ifdef DISTINCT_NONDISPATCHABLE_HANDLES
+        return c_VkCommandPool;
+#else
+        return c_uint64_t;
+#endif
+    }
+
+    // VkCommandBuffer needs check for implicit use of command pool. The pool use data is pinned against the command buffer (keyed
+    // by command_pool_map for writes and pool_command_buffers_map for content reads), s.t. the Finish* calls need not look up
+    // the pool again.
     void StartWriteObject(VkCommandBuffer object, const char *api_name, bool lockPool = true) {
         if (lockPool) {
             auto iter = command_pool_map.find(object);
             if (iter != command_pool_map.end()) {
                 VkCommandPool pool = iter->second;
-                StartWriteObject(pool, api_name);
+                auto pool_use_data = CommandPoolCounter().StartWriteUse(pool, api_name);
+                if (pool_use_data) {
+                    ObjectUsePins::Pin(&command_pool_map, (uint64_t)(object), std::move(pool_use_data));
+                }
             }
         }
         c_VkCommandBuffer.StartWrite(object, api_name);
@@ -560,6 +694,11 @@ WRAPPER_PARENT_INSTANCE(uint64_t)
     void FinishWriteObject(VkCommandBuffer object, const char *api_name, bool lockPool = true) {
         c_VkCommandBuffer.FinishWrite(object, api_name);
         if (lockPool) {
+            auto pool_use_data = ObjectUsePins::Unpin(&command_pool_map, (uint64_t)(object));
+            if (pool_use_data) {
+                pool_use_data->RemoveWriter();
+                return;
+            }
             auto iter = command_pool_map.find(object);
             if (iter != command_pool_map.end()) {
                 VkCommandPool pool = iter->second;
@@ -574,12 +713,20 @@ WRAPPER_PARENT_INSTANCE(uint64_t)
             // We set up a read guard against the "Contents" counter to catch conflict vs. vkResetCommandPool and vkDestroyCommandPool
             // while *not* establishing a read guard against the command pool counter itself to avoid false positive for
             // non-externally sync'd command buffers
-            c_VkCommandPoolContents.StartRead(pool, api_name);
+            auto pool_use_data = c_VkCommandPoolContents.StartReadUse(pool, api_name);
+            if (pool_use_data) {
+                ObjectUsePins::Pin(&pool_command_buffers_map, (uint64_t)(object), std::move(pool_use_data));
+            }
         }
         c_VkCommandBuffer.StartRead(object, api_name);
     }
     void FinishReadObject(VkCommandBuffer object, const char *api_name) {
         c_VkCommandBuffer.FinishRead(object, api_name);
+        auto pool_use_data = ObjectUsePins::Unpin(&pool_command_buffers_map, (uint64_t)(object));
+        if (pool_use_data) {
+            pool_use_data->RemoveReader();
+            return;
+        }
         auto iter = command_pool_map.find(object);
         if (iter != command_pool_map.end()) {
             VkCommandPool pool = iter->second;
@@ -346,6 +346,9 @@ void GpuAssistedBase::CreateDevice(const VkDeviceCreateInfo *pCreateInfo) {
 }
 
 void GpuAssistedBase::PreCallRecordDestroyDevice(VkDevice device, const VkAllocationCallbacks *pAllocator) {
+    ForEachShared<QUEUE_STATE>([](const std::shared_ptr<QUEUE_STATE> &queue_state) {
+        static_cast<gpu_utils_state::Queue *>(queue_state.get())->StopResultThread();
+    });
     if (debug_desc_layout) {
         DispatchDestroyDescriptorSetLayout(device, debug_desc_layout, NULL);
         debug_desc_layout = VK_NULL_HANDLE;
@@ -366,6 +369,7 @@ gpu_utils_state::Queue::Queue(GpuAssistedBase &state, VkQueue q, uint32_t index,
     : QUEUE_STATE(q, index, flags), state_(state) {}
 
 gpu_utils_state::Queue::~Queue() {
+    StopResultThread();
     if (barrier_command_buffer_) {
         DispatchFreeCommandBuffers(state_.device, barrier_command_pool_, 1, &barrier_command_buffer_);
         barrier_command_buffer_ = VK_NULL_HANDLE;
@@ -378,7 +382,7 @@ gpu_utils_state::Queue::~Queue() {
 
 // Submit a memory barrier on graphics queues.
 // Lazy-create and record the needed command buffer.
-void gpu_utils_state::Queue::SubmitBarrier() {
+bool gpu_utils_state::Queue::SubmitBarrier(VkFence fence) {
     if (barrier_command_pool_ == VK_NULL_HANDLE) {
         VkResult result = VK_SUCCESS;
 
@@ -388,43 +392,132 @@ void gpu_utils_state::Queue::SubmitBarrier() {
         if (result != VK_SUCCESS) {
             state_.ReportSetupProblem(state_.device, "Unable to create command pool for barrier CB.");
             barrier_command_pool_ = VK_NULL_HANDLE;
-            return;
-        }
-
-        auto buffer_alloc_info = LvlInitStruct<VkCommandBufferAllocateInfo>();
-        buffer_alloc_info.commandPool = barrier_command_pool_;
-        buffer_alloc_info.commandBufferCount = 1;
-        buffer_alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-        result = DispatchAllocateCommandBuffers(state_.device, &buffer_alloc_info, &barrier_command_buffer_);
-        if (result != VK_SUCCESS) {
-            state_.ReportSetupProblem(state_.device, "Unable to create barrier command buffer.");
-            DispatchDestroyCommandPool(state_.device, barrier_command_pool_, nullptr);
-            barrier_command_pool_ = VK_NULL_HANDLE;
-            barrier_command_buffer_ = VK_NULL_HANDLE;
-            return;
+        } else {
+            auto buffer_alloc_info = LvlInitStruct<VkCommandBufferAllocateInfo>();
+            buffer_alloc_info.commandPool = barrier_command_pool_;
+            buffer_alloc_info.commandBufferCount = 1;
+            buffer_alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            result = DispatchAllocateCommandBuffers(state_.device, &buffer_alloc_info, &barrier_command_buffer_);
+            if (result != VK_SUCCESS) {
+                state_.ReportSetupProblem(state_.device, "Unable to create barrier command buffer.");
+                DispatchDestroyCommandPool(state_.device, barrier_command_pool_, nullptr);
+                barrier_command_pool_ = VK_NULL_HANDLE;
+                barrier_command_buffer_ = VK_NULL_HANDLE;
+            }
         }
 
-        // Hook up command buffer dispatch
-        state_.vkSetDeviceLoaderData(state_.device, barrier_command_buffer_);
-
-        // Record a global memory barrier to force availability of device memory operations to the host domain.
-        auto command_buffer_begin_info = LvlInitStruct<VkCommandBufferBeginInfo>();
-        result = DispatchBeginCommandBuffer(barrier_command_buffer_, &command_buffer_begin_info);
-        if (result == VK_SUCCESS) {
-            auto memory_barrier = LvlInitStruct<VkMemoryBarrier>();
-            memory_barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
-            memory_barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
-            DispatchCmdPipelineBarrier(barrier_command_buffer_, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0,
-                                       1, &memory_barrier, 0, nullptr, 0, nullptr);
-            DispatchEndCommandBuffer(barrier_command_buffer_);
+        if (barrier_command_buffer_ != VK_NULL_HANDLE) {
+            // Hook up command buffer dispatch
+            state_.vkSetDeviceLoaderData(state_.device, barrier_command_buffer_);
+
+            // Record a global memory barrier to force availability of device memory operations to the host domain.
+            // With asynchronous result collection several submissions of the barrier can be pending at once.
+            auto command_buffer_begin_info = LvlInitStruct<VkCommandBufferBeginInfo>();
+            command_buffer_begin_info.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+            result = DispatchBeginCommandBuffer(barrier_command_buffer_, &command_buffer_begin_info);
+            if (result == VK_SUCCESS) {
+                auto memory_barrier = LvlInitStruct<VkMemoryBarrier>();
+                memory_barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+                memory_barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+                DispatchCmdPipelineBarrier(barrier_command_buffer_, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+                                           0, 1, &memory_barrier, 0, nullptr, 0, nullptr);
+                DispatchEndCommandBuffer(barrier_command_buffer_);
+            }
         }
     }
+    auto submit_info = LvlInitStruct<VkSubmitInfo>();
     if (barrier_command_buffer_ != VK_NULL_HANDLE) {
-        auto submit_info = LvlInitStruct<VkSubmitInfo>();
         submit_info.commandBufferCount = 1;
         submit_info.pCommandBuffers = &barrier_command_buffer_;
-        DispatchQueueSubmit(QUEUE_STATE::Queue(), 1, &submit_info, VK_NULL_HANDLE);
+    } else if (fence == VK_NULL_HANDLE) {
+        return false;
+    }
+    // Without the barrier an empty batch still signals fence once all previously submitted work has completed
+    return DispatchQueueSubmit(QUEUE_STATE::Queue(), 1, &submit_info, fence) == VK_SUCCESS;
+}
+
+void gpu_utils_state::Queue::QueueResults(VkFence app_fence, std::vector<VkCommandBuffer> &&command_buffers,
+                                          std::vector<VkCommandBuffer> &&secondary_command_buffers,
+                                          std::vector<std::pair<VkSemaphore, uint64_t>> &&signal_semaphores) {
+    PendingResults pending{VK_NULL_HANDLE, app_fence, std::move(command_buffers), std::move(secondary_command_buffers),
+                           std::move(signal_semaphores)};
+
+    std::unique_lock<std::mutex> lock(results_lock_);
+    if (!free_result_fences_.empty()) {
+        pending.fence = free_result_fences_.back();
+        free_result_fences_.pop_back();
+    } else {
+        auto fence_create_info = LvlInitStruct<VkFenceCreateInfo>();
+        if (DispatchCreateFence(state_.device, &fence_create_info, nullptr, &pending.fence) != VK_SUCCESS) {
+            state_.ReportSetupProblem(state_.device, "Unable to create fence for asynchronous result collection.");
+            return;
+        }
+    }
+    if (!SubmitBarrier(pending.fence)) {
+        free_result_fences_.push_back(pending.fence);
+        return;
+    }
+    pending_results_.emplace_back(std::move(pending));
+    if (!result_thread_.joinable()) {
+        result_thread_ = std::thread(&Queue::ResultThread, this);
     }
+    pending_results_cv_.notify_one();
+}
+
+void gpu_utils_state::Queue::WaitForResults(const std::function<bool(const PendingResults &)> &wait_for) {
+    std::unique_lock<std::mutex> lock(results_lock_);
+    results_processed_cv_.wait(lock,
+                               [&]() { return std::none_of(pending_results_.begin(), pending_results_.end(), wait_for); });
+}
+
+void gpu_utils_state::Queue::ResultThread() {
+    std::unique_lock<std::mutex> lock(results_lock_);
+    while (true) {
+        pending_results_cv_.wait(lock, [this]() { return result_thread_exit_ || !pending_results_.empty(); });
+        if (pending_results_.empty()) return;
+
+        // Only this thread removes entries, so the front stays valid while unlocked
+        const PendingResults &pending = pending_results_.front();
+        lock.unlock();
+        if (DispatchWaitForFences(state_.device, 1, &pending.fence, VK_TRUE, UINT64_MAX) == VK_SUCCESS) {
+            for (auto command_buffer : pending.command_buffers) {
+                // A simultaneous use command buffer submitted again to this queue before this submission was processed writes
+                // to the same output buffers, whose records are then processed once, along with those of the last submission
+                if (!ResubmittedBeforeProcessed(command_buffer)) {
+                    state_.ProcessCommandBuffer(QUEUE_STATE::Queue(), command_buffer);
+                }
+            }
+        }
+        DispatchResetFences(state_.device, 1, &pending.fence);
+        lock.lock();
+
+        free_result_fences_.push_back(pending.fence);
+        pending_results_.pop_front();
+        results_processed_cv_.notify_all();
+    }
+}
+
+// Called by the result thread while processing the front submission
+bool gpu_utils_state::Queue::ResubmittedBeforeProcessed(VkCommandBuffer command_buffer) {
+    std::unique_lock<std::mutex> lock(results_lock_);
+    return std::any_of(std::next(pending_results_.begin()), pending_results_.end(),
+                       [command_buffer](const PendingResults &pending) { return pending.Uses(command_buffer); });
+}
+
+// Processes everything still pending before returning
+void gpu_utils_state::Queue::StopResultThread() {
+    {
+        std::unique_lock<std::mutex> lock(results_lock_);
+        result_thread_exit_ = true;
+        pending_results_cv_.notify_one();
+    }
+    if (result_thread_.joinable()) {
+        result_thread_.join();
+    }
+    for (auto fence : free_result_fences_) {
+        DispatchDestroyFence(state_.device, fence, nullptr);
+    }
+    free_result_fences_.clear();
 }
 
 bool GpuAssistedBase::CommandBufferNeedsProcessing(VkCommandBuffer command_buffer) const {
@@ -471,6 +564,27 @@ void GpuAssistedBase::PostCallRecordQueueSubmit(VkQueue queue, uint32_t submitCo
     }
     if (!buffers_present) return;
 
+    if (async_results) {
+        std::vector<VkCommandBuffer> command_buffers;
+        std::vector<std::pair<VkSemaphore, uint64_t>> signal_semaphores;
+        for (uint32_t submit_idx = 0; submit_idx < submitCount; submit_idx++) {
+            const VkSubmitInfo *submit = &pSubmits[submit_idx];
+            command_buffers.insert(command_buffers.end(), submit->pCommandBuffers,
+                                   submit->pCommandBuffers + submit->commandBufferCount);
+            // Only timeline semaphores can be waited on by value
+            const auto *timeline_semaphore_submit = LvlFindInChain<VkTimelineSemaphoreSubmitInfo>(submit->pNext);
+            if (timeline_semaphore_submit && timeline_semaphore_submit->pSignalSemaphoreValues) {
+                const uint32_t count = std::min(submit->signalSemaphoreCount, timeline_semaphore_submit->signalSemaphoreValueCount);
+                for (uint32_t i = 0; i < count; i++) {
+                    signal_semaphores.emplace_back(submit->pSignalSemaphores[i],
+                                                   timeline_semaphore_submit->pSignalSemaphoreValues[i]);
+                }
+            }
+        }
+        QueuePendingResults(queue, fence, std::move(command_buffers), std::move(signal_semaphores));
+        return;
+    }
+
     SubmitBarrier(queue);
 
     DispatchQueueWaitIdle(queue);
@@ -496,6 +610,22 @@ void GpuAssistedBase::RecordQueueSubmit2(VkQueue queue, uint32_t submitCount, co
     }
     if (!buffers_present) return;
 
+    if (async_results) {
+        std::vector<VkCommandBuffer> command_buffers;
+        std::vector<std::pair<VkSemaphore, uint64_t>> signal_semaphores;
+        for (uint32_t submit_idx = 0; submit_idx < submitCount; submit_idx++) {
+            const VkSubmitInfo2 *submit = &pSubmits[submit_idx];
+            for (uint32_t i = 0; i < submit->commandBufferInfoCount; i++) {
+                command_buffers.push_back(submit->pCommandBufferInfos[i].commandBuffer);
+            }
+            for (uint32_t i = 0; i < submit->signalSemaphoreInfoCount; i++) {
+                signal_semaphores.emplace_back(submit->pSignalSemaphoreInfos[i].semaphore, submit->pSignalSemaphoreInfos[i].value);
+            }
+        }
+        QueuePendingResults(queue, fence, std::move(command_buffers), std::move(signal_semaphores));
+        return;
+    }
+
     SubmitBarrier(queue);
 
     DispatchQueueWaitIdle(queue);
@@ -520,6 +650,150 @@ void GpuAssistedBase::PostCallRecordQueueSubmit2(VkQueue queue, uint32_t submitC
     RecordQueueSubmit2(queue, submitCount, pSubmits, fence, result);
 }
 
+void GpuAssistedBase::QueuePendingResults(VkQueue queue, VkFence app_fence, std::vector<VkCommandBuffer> &&command_buffers,
+                                          std::vector<std::pair<VkSemaphore, uint64_t>> &&signal_semaphores) {
+    std::vector<VkCommandBuffer> secondary_command_buffers;
+    for (auto command_buffer : command_buffers) {
+        auto cb_node = GetRead<gpu_utils_state::CommandBuffer>(command_buffer);
+        for (const auto *secondary_cb : cb_node->linkedCommandBuffers) {
+            secondary_command_buffers.push_back(secondary_cb->commandBuffer());
+        }
+    }
+    auto queue_state = Get<gpu_utils_state::Queue>(queue);
+    if (queue_state) {
+        queue_state->QueueResults(app_fence, std::move(command_buffers), std::move(secondary_command_buffers),
+                                  std::move(signal_semaphores));
+    }
+}
+
+void GpuAssistedBase::WaitForPendingResults(const std::function<bool(const gpu_utils_state::PendingResults &)> &wait_for) {
+    if (!async_results) return;
+    ForEachShared<QUEUE_STATE>([&wait_for](const std::shared_ptr<QUEUE_STATE> &queue_state) {
+        static_cast<gpu_utils_state::Queue *>(queue_state.get())->WaitForResults(wait_for);
+    });
+}
+
+// Instrumentation output belongs to the command buffer state, so results must be processed before it is reset or freed
+void GpuAssistedBase::PreCallRecordBeginCommandBuffer(VkCommandBuffer commandBuffer, const VkCommandBufferBeginInfo *pBeginInfo) {
+    WaitForPendingResults(commandBuffer);
+    ValidationStateTracker::PreCallRecordBeginCommandBuffer(commandBuffer, pBeginInfo);
+}
+
+void GpuAssistedBase::PreCallRecordResetCommandBuffer(VkCommandBuffer commandBuffer, VkCommandBufferResetFlags flags) {
+    WaitForPendingResults(commandBuffer);
+    ValidationStateTracker::PreCallRecordResetCommandBuffer(commandBuffer, flags);
+}
+
+void GpuAssistedBase::PreCallRecordFreeCommandBuffers(VkDevice device, VkCommandPool commandPool, uint32_t commandBufferCount,
+                                                      const VkCommandBuffer *pCommandBuffers) {
+    for (uint32_t i = 0; i < commandBufferCount; i++) {
+        WaitForPendingResults(pCommandBuffers[i]);
+    }
+    ValidationStateTracker::PreCallRecordFreeCommandBuffers(device, commandPool, commandBufferCount, pCommandBuffers);
+}
+
+// Only submissions of the pool's command buffers are waited for, others may be blocked on work the application has yet to submit
+void GpuAssistedBase::WaitForPoolResults(VkCommandPool command_pool) {
+    if (!async_results) return;
+    auto pool_state = Get<COMMAND_POOL_STATE>(command_pool);
+    if (!pool_state || pool_state->commandBuffers.empty()) return;
+    // The application externally synchronizes the pool, so its command buffers can't change while waiting
+    const auto &pool_command_buffers = pool_state->commandBuffers;
+    auto in_pool = [&pool_command_buffers](VkCommandBuffer command_buffer) {
+        return pool_command_buffers.find(command_buffer) != pool_command_buffers.end();
+    };
+    WaitForPendingResults([&in_pool](const gpu_utils_state::PendingResults &pending) {
+        return std::any_of(pending.command_buffers.begin(), pending.command_buffers.end(), in_pool) ||
+               std::any_of(pending.secondary_command_buffers.begin(), pending.secondary_command_buffers.end(), in_pool);
+    });
+}
+
+void GpuAssistedBase::PreCallRecordResetCommandPool(VkDevice device, VkCommandPool commandPool, VkCommandPoolResetFlags flags) {
+    WaitForPoolResults(commandPool);
+    ValidationStateTracker::PreCallRecordResetCommandPool(device, commandPool, flags);
+}
+
+void GpuAssistedBase::PreCallRecordDestroyCommandPool(VkDevice device, VkCommandPool commandPool,
+                                                      const VkAllocationCallbacks *pAllocator) {
+    WaitForPoolResults(commandPool);
+    ValidationStateTracker::PreCallRecordDestroyCommandPool(device, commandPool, pAllocator);
+}
+
+// Once the application has waited for a submission, report its results before returning so they are seen in a predictable place
+void GpuAssistedBase::PostCallRecordQueueWaitIdle(VkQueue queue, VkResult result) {
+    ValidationStateTracker::PostCallRecordQueueWaitIdle(queue, result);
+    if (result != VK_SUCCESS) return;
+    auto queue_state = Get<gpu_utils_state::Queue>(queue);
+    if (async_results && queue_state) {
+        queue_state->WaitForResults([](const gpu_utils_state::PendingResults &) { return true; });
+    }
+}
+
+void GpuAssistedBase::PostCallRecordDeviceWaitIdle(VkDevice device, VkResult result) {
+    ValidationStateTracker::PostCallRecordDeviceWaitIdle(device, result);
+    if (result != VK_SUCCESS) return;
+    WaitForPendingResults([](const gpu_utils_state::PendingResults &) { return true; });
+}
+
+void GpuAssistedBase::PostCallRecordWaitForFences(VkDevice device, uint32_t fenceCount, const VkFence *pFences, VkBool32 waitAll,
+                                                  uint64_t timeout, VkResult result) {
+    ValidationStateTracker::PostCallRecordWaitForFences(device, fenceCount, pFences, waitAll, timeout, result);
+    if (result != VK_SUCCESS || (waitAll != VK_TRUE && fenceCount != 1)) return;
+    const VkFence *fences_end = pFences + fenceCount;
+    WaitForPendingResults([pFences, fences_end](const gpu_utils_state::PendingResults &pending) {
+        return pending.app_fence != VK_NULL_HANDLE && std::find(pFences, fences_end, pending.app_fence) != fences_end;
+    });
+}
+
+void GpuAssistedBase::PostCallRecordGetFenceStatus(VkDevice device, VkFence fence, VkResult result) {
+    ValidationStateTracker::PostCallRecordGetFenceStatus(device, fence, result);
+    if (result != VK_SUCCESS) return;
+    WaitForPendingResults([fence](const gpu_utils_state::PendingResults &pending) { return pending.app_fence == fence; });
+}
+
+// A timeline semaphore reaching a value signaled by a submission completes it just as its fence would
+void GpuAssistedBase::WaitForSemaphoreResults(const VkSemaphoreWaitInfo *pWaitInfo, VkResult result) {
+    if (result != VK_SUCCESS) return;
+    if ((pWaitInfo->flags & VK_SEMAPHORE_WAIT_ANY_BIT) && pWaitInfo->semaphoreCount != 1) return;
+    WaitForPendingResults([pWaitInfo](const gpu_utils_state::PendingResults &pending) {
+        for (uint32_t i = 0; i < pWaitInfo->semaphoreCount; i++) {
+            if (pending.Signals(pWaitInfo->pSemaphores[i], pWaitInfo->pValues[i])) return true;
+        }
+        return false;
+    });
+}
+
+void GpuAssistedBase::PostCallRecordWaitSemaphores(VkDevice device, const VkSemaphoreWaitInfo *pWaitInfo, uint64_t timeout,
+                                                   VkResult result) {
+    ValidationStateTracker::PostCallRecordWaitSemaphores(device, pWaitInfo, timeout, result);
+    WaitForSemaphoreResults(pWaitInfo, result);
+}
+
+void GpuAssistedBase::PostCallRecordWaitSemaphoresKHR(VkDevice device, const VkSemaphoreWaitInfo *pWaitInfo, uint64_t timeout,
+                                                      VkResult result) {
+    ValidationStateTracker::PostCallRecordWaitSemaphoresKHR(device, pWaitInfo, timeout, result);
+    WaitForSemaphoreResults(pWaitInfo, result);
+}
+
+void GpuAssistedBase::WaitForSemaphoreCounterResults(VkSemaphore semaphore, const uint64_t *pValue, VkResult result) {
+    if (result != VK_SUCCESS) return;
+    const uint64_t value = *pValue;
+    WaitForPendingResults(
+        [semaphore, value](const gpu_utils_state::PendingResults &pending) { return pending.Signals(semaphore, value); });
+}
+
+void GpuAssistedBase::PostCallRecordGetSemaphoreCounterValue(VkDevice device, VkSemaphore semaphore, uint64_t *pValue,
+                                                             VkResult result) {
+    ValidationStateTracker::PostCallRecordGetSemaphoreCounterValue(device, semaphore, pValue, result);
+    WaitForSemaphoreCounterResults(semaphore, pValue, result);
+}
+
+void GpuAssistedBase::PostCallRecordGetSemaphoreCounterValueKHR(VkDevice device, VkSemaphore semaphore, uint64_t *pValue,
+                                                                VkResult result) {
+    ValidationStateTracker::PostCallRecordGetSemaphoreCounterValueKHR(device, semaphore, pValue, result);
+    WaitForSemaphoreCounterResults(semaphore, pValue, result);
+}
+
 // Just gives a warning about a possible deadlock.
 bool GpuAssistedBase::ValidateCmdWaitEvents(VkCommandBuffer command_buffer, VkPipelineStageFlags2 src_stage_mask,
                                             CMD_TYPE cmd_type) const {
@@ -816,8 +1090,8 @@ void GpuAssistedBase::PreCallRecordPipelineCreations(uint32_t count, const Creat
         const auto &pipe = pipe_state[pipeline];
         new_pipeline_create_infos->push_back(pipe->GetCreateInfo<CreateInfo>());
 
+        bool replace_shaders = false;
         if (!pipe->IsGraphicsLibrary()) {
-            bool replace_shaders = false;
             if (pipe->active_slots.find(desc_set_bind_index) != pipe->active_slots.end()) {
                 replace_shaders = true;
             }
@@ -827,23 +1101,44 @@ void GpuAssistedBase::PreCallRecordPipelineCreations(uint32_t count, const Creat
             if (pipeline_layout->set_layouts.size() >= adjusted_max_desc_sets) {
                 replace_shaders = true;
             }
+        }
 
-            if (replace_shaders) {
-                for (uint32_t stage = 0; stage < stageCount; ++stage) {
-                    const auto module_state = Get<SHADER_MODULE_STATE>(pipe->GetShaderModuleByCIIndex<CreateInfo>(stage));
-
-                    VkShaderModule shader_module;
-                    auto create_info = LvlInitStruct<VkShaderModuleCreateInfo>();
-                    create_info.pCode = module_state->words.data();
-                    create_info.codeSize = module_state->words.size() * sizeof(uint32_t);
-                    VkResult result = DispatchCreateShaderModule(device, &create_info, pAllocator, &shader_module);
-                    if (result == VK_SUCCESS) {
-                        Accessor::SetShaderModule(&(*new_pipeline_create_infos)[pipeline], shader_module, stage);
-                    } else {
-                        ReportSetupProblem(device,
-                                           "Unable to replace instrumented shader with non-instrumented one.  "
-                                           "Device could become unstable.");
-                    }
+        if (replace_shaders) {
+            for (uint32_t stage = 0; stage < stageCount; ++stage) {
+                const auto module_state = Get<SHADER_MODULE_STATE>(pipe->GetShaderModuleByCIIndex<CreateInfo>(stage));
+
+                VkShaderModule shader_module;
+                auto create_info = LvlInitStruct<VkShaderModuleCreateInfo>();
+                create_info.pCode = module_state->words.data();
+                create_info.codeSize = module_state->words.size() * sizeof(uint32_t);
+                VkResult result = DispatchCreateShaderModule(device, &create_info, pAllocator, &shader_module);
+                if (result == VK_SUCCESS) {
+                    Accessor::SetShaderModule(&(*new_pipeline_create_infos)[pipeline], shader_module, stage);
+                } else {
+                    ReportSetupProblem(device,
+                                       "Unable to replace instrumented shader with non-instrumented one.  "
+                                       "Device could become unstable.");
+                }
+            }
+        } else {
+            // Substitute instrumented shaders for any whose instrumentation was deferred until they were used. This includes
+            // the stages of graphics pipeline libraries, whose shaders would otherwise be left uninstrumented.
+            for (uint32_t stage = 0; stage < stageCount; ++stage) {
+                const auto module_state = Get<SHADER_MODULE_STATE>(pipe->GetShaderModuleByCIIndex<CreateInfo>(stage));
+                std::vector<uint32_t> instrumented_pgm;
+                if (!module_state || !GetInstrumentedShader(*module_state, instrumented_pgm)) continue;
+
+                VkShaderModule shader_module;
+                auto create_info = LvlInitStruct<VkShaderModuleCreateInfo>();
+                create_info.pCode = instrumented_pgm.data();
+                create_info.codeSize = instrumented_pgm.size() * sizeof(uint32_t);
+                VkResult result = DispatchCreateShaderModule(device, &create_info, pAllocator, &shader_module);
+                if (result == VK_SUCCESS) {
+                    Accessor::SetShaderModule(&(*new_pipeline_create_infos)[pipeline], shader_module, stage);
+                } else {
+                    ReportSetupProblem(device,
+                                       "Unable to create instrumented shader module.  "
+                                       "Proceeding with non-instrumented shader.");
                 }
             }
         }
@@ -863,36 +1158,46 @@ void GpuAssistedBase::PostCallRecordPipelineCreations(const uint32_t count, cons
         bind_point != VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR) {
         return;
     }
+    using Accessor = CreatePipelineTraits<CreateInfo>;
     for (uint32_t pipeline = 0; pipeline < count; ++pipeline) {
+        // Destroy the non-instrumented or instrumented modules that were substituted for the application's own, whether or not
+        // the pipeline was created
+        auto *modified_ci = reinterpret_cast<const CreateInfo *>(modified_create_infos[pipeline].ptr());
+        for (uint32_t stage = 0; stage < Accessor::GetStageCount(pCreateInfos[pipeline]); ++stage) {
+            auto substituted_module = Accessor::GetShaderModule(*modified_ci, stage);
+            if (substituted_module != Accessor::GetShaderModule(pCreateInfos[pipeline], stage)) {
+                DispatchDestroyShaderModule(device, substituted_module, pAllocator);
+            }
+        }
+
         auto pipeline_state = Get<PIPELINE_STATE>(pPipelines[pipeline]);
         if (!pipeline_state || pipeline_state->IsGraphicsLibrary()) continue;
 
         const uint32_t stageCount = static_cast<uint32_t>(pipeline_state->stage_state.size());
         assert(stageCount > 0);
 
-        const auto pipeline_layout = pipeline_state->PipelineLayoutState();
         for (uint32_t stage = 0; stage < stageCount; ++stage) {
             assert((bind_point != VK_PIPELINE_BIND_POINT_COMPUTE) || (stage == 0));
             auto shader_module = pipeline_state->GetShaderModuleByCIIndex<CreateInfo>(stage);
             auto module_state = Get<SHADER_MODULE_STATE>(shader_module);
 
-            if (pipeline_state->active_slots.find(desc_set_bind_index) != pipeline_state->active_slots.end() ||
-                (pipeline_layout->set_layouts.size() >= adjusted_max_desc_sets)) {
-                auto *modified_ci = reinterpret_cast<const CreateInfo *>(modified_create_infos[pipeline].ptr());
-                auto uninstrumented_module = CreatePipelineTraits<CreateInfo>::GetShaderModule(*modified_ci, stage);
-                assert(uninstrumented_module != shader_module);
-                DispatchDestroyShaderModule(device, uninstrumented_module, pAllocator);
-            }
-
-            std::vector<unsigned int> code;
-            // Save the shader binary
+            // Index the shader's debug information
             // The core_validation ShaderModule tracker saves the binary too, but discards it when the ShaderModule
             // is destroyed.  Applications may destroy ShaderModules after they are placed in a pipeline and before
-            // the pipeline is used, so we have to keep another copy.
-            if (module_state && module_state->has_valid_spirv) code = module_state->words;
+            // the pipeline is used, so we have to keep what we need from it.
+            // Pipelines sharing an instrumented shader module share its index.
+            std::shared_ptr<const GpuAssistedShaderDebugInfo> debug_info;
+            const uint32_t shader_id = module_state->gpu_validation_shader_id;
+            auto tracked = shader_map.find(shader_id);
+            if (tracked != shader_map.end() && shader_id != std::numeric_limits<uint32_t>::max() &&
+                tracked->second.shader_module == shader_module) {
+                debug_info = tracked->second.debug_info;
+            }
+            if (!debug_info && module_state->has_valid_spirv) {
+                debug_info = CreateShaderDebugInfo(module_state->words);
+            }
 
-            shader_map.insert_or_assign(module_state->gpu_validation_shader_id, pipeline_state->pipeline(), shader_module,
-                                        std::move(code));
+            shader_map.insert_or_assign(shader_id, pipeline_state->pipeline(), shader_module, std::move(debug_info));
         }
     }
 }
@@ -1011,29 +1316,6 @@ void UtilGenerateCommonMessage(const debug_report_data *report_data, const VkCom
     msg = strm.str();
 }
 
-// Read the contents of the SPIR-V OpSource instruction and any following continuation instructions.
-// Split the single string into a vector of strings, one for each line, for easier processing.
-void ReadOpSource(const SHADER_MODULE_STATE &module_state, const uint32_t reported_file_id,
-                  std::vector<std::string> &opsource_lines) {
-    for (auto insn : module_state) {
-        if ((insn.opcode() == spv::OpSource) && (insn.len() >= 5) && (insn.word(3) == reported_file_id)) {
-            std::istringstream in_stream;
-            std::string cur_line;
-            in_stream.str((char *)&insn.word(4));
-            while (std::getline(in_stream, cur_line)) {
-                opsource_lines.push_back(cur_line);
-            }
-            while ((++insn).opcode() == spv::OpSourceContinued) {
-                in_stream.str((char *)&insn.word(1));
-                while (std::getline(in_stream, cur_line)) {
-                    opsource_lines.push_back(cur_line);
-                }
-            }
-            break;
-        }
-    }
-}
-
 // The task here is to search the OpSource content to find the #line directive with the
 // line number that is closest to, but still prior to the reported error line number and
 // still within the reported filename.
@@ -1109,63 +1391,117 @@ bool GetLineAndFilename(const std::string string, uint32_t *linenumber, std::str
 }
 #endif  // GCC_VERSION
 
+// Read a nul terminated literal string of at most word_count words
+static std::string ReadLiteralString(const std::vector<uint32_t> &pgm, size_t offset, size_t word_count) {
+    const char *begin = reinterpret_cast<const char *>(&pgm[offset]);
+    const char *end = begin + word_count * sizeof(uint32_t);
+    return std::string(begin, std::find(begin, end, '\0'));
+}
+
+// Split source text into lines. Each OpSource or OpSourceContinued operand is split separately.
+static void AppendSourceLines(const std::string &text, std::vector<std::string> &lines) {
+    std::istringstream in_stream(text);
+    std::string cur_line;
+    while (std::getline(in_stream, cur_line)) {
+        lines.push_back(cur_line);
+    }
+}
+
+GpuAssistedShaderDebugInfo::GpuAssistedShaderDebugInfo(const std::vector<uint32_t> &pgm) {
+    // SPIR-V can only be iterated in the forward direction due to its opcode/length encoding.
+    uint32_t instruction_index = 0;
+    uint32_t continued_file_id = 0;  // The OpSource that a following OpSourceContinued extends, if any
+    size_t offset = 5;               // Skip the header
+    while (offset < pgm.size()) {
+        const uint32_t opcode = pgm[offset] & 0x0ffffu;
+        const uint32_t length = pgm[offset] >> 16;
+        if (length == 0 || offset + length > pgm.size()) break;
+
+        if (opcode == spv::OpLine && length >= 4) {
+            lines_.push_back({instruction_index, pgm[offset + 1], pgm[offset + 2], pgm[offset + 3]});
+        } else if (opcode == spv::OpString && length >= 3) {
+            strings_.emplace(pgm[offset + 1], ReadLiteralString(pgm, offset + 2, length - 2));
+        }
+
+        if (opcode == spv::OpSource && length >= 5 && source_files_.find(pgm[offset + 3]) == source_files_.end()) {
+            // Only the first OpSource for a file is used
+            continued_file_id = pgm[offset + 3];
+            AppendSourceLines(ReadLiteralString(pgm, offset + 4, length - 4), source_files_[continued_file_id].lines);
+        } else if (opcode == spv::OpSourceContinued && continued_file_id != 0 && length >= 2) {
+            AppendSourceLines(ReadLiteralString(pgm, offset + 1, length - 1), source_files_[continued_file_id].lines);
+        } else {
+            continued_file_id = 0;
+        }
+
+        offset += length;
+        instruction_index++;
+    }
+
+    for (auto &entry : source_files_) {
+        SourceFile &source_file = entry.second;
+        for (size_t i = 0; i < source_file.lines.size(); ++i) {
+            LineDirective directive{i, 0, {}};
+            if (GetLineAndFilename(source_file.lines[i], &directive.line_number, directive.filename)) {
+                source_file.directives.emplace_back(std::move(directive));
+            }
+        }
+    }
+}
+
+const GpuAssistedShaderDebugInfo::LineInfo *GpuAssistedShaderDebugInfo::FindLine(uint32_t instruction_index) const {
+    auto it = std::upper_bound(lines_.begin(), lines_.end(), instruction_index,
+                               [](uint32_t index, const LineInfo &line) { return index < line.instruction_index; });
+    return (it == lines_.begin()) ? nullptr : &*(it - 1);
+}
+
+const std::string *GpuAssistedShaderDebugInfo::FindString(uint32_t string_id) const {
+    auto it = strings_.find(string_id);
+    return (it == strings_.end()) ? nullptr : &it->second;
+}
+
+const GpuAssistedShaderDebugInfo::SourceFile *GpuAssistedShaderDebugInfo::FindSourceFile(uint32_t file_id) const {
+    auto it = source_files_.find(file_id);
+    return (it == source_files_.end()) ? nullptr : &it->second;
+}
+
 // Extract the filename, line number, and column number from the correct OpLine and build a message string from it.
 // Scan the source (from OpSource) to find the line of source at the reported line number and place it in another message string.
-void UtilGenerateSourceMessages(const std::vector<uint32_t> &pgm, const uint32_t *debug_record, bool from_printf,
+void UtilGenerateSourceMessages(const GpuAssistedShaderDebugInfo *debug_info, const uint32_t *debug_record, bool from_printf,
                                 std::string &filename_msg, std::string &source_msg) {
     using namespace spvtools;
     std::ostringstream filename_stream;
     std::ostringstream source_stream;
-    SHADER_MODULE_STATE shader(pgm);
     // Find the OpLine just before the failing instruction indicated by the debug info.
-    // SPIR-V can only be iterated in the forward direction due to its opcode/length encoding.
-    uint32_t instruction_index = 0;
-    uint32_t reported_file_id = 0;
-    uint32_t reported_line_number = 0;
-    uint32_t reported_column_number = 0;
-    if (shader.words.size() > 0) {
-        for (const auto &insn : shader) {
-            if (insn.opcode() == spv::OpLine) {
-                reported_file_id = insn.word(1);
-                reported_line_number = insn.word(2);
-                reported_column_number = insn.word(3);
-            }
-            if (instruction_index == debug_record[kInstCommonOutInstructionIdx]) {
-                break;
-            }
-            instruction_index++;
-        }
-    }
+    const GpuAssistedShaderDebugInfo::LineInfo *line_info =
+        debug_info ? debug_info->FindLine(debug_record[kInstCommonOutInstructionIdx]) : nullptr;
+    const uint32_t reported_file_id = line_info ? line_info->file_id : 0;
+    const uint32_t reported_line_number = line_info ? line_info->line_number : 0;
+    const uint32_t reported_column_number = line_info ? line_info->column_number : 0;
     // Create message with file information obtained from the OpString pointed to by the discovered OpLine.
     std::string reported_filename;
     if (reported_file_id == 0) {
         filename_stream
             << "Unable to find SPIR-V OpLine for source information.  Build shader with debug info to get source information.";
     } else {
-        bool found_opstring = false;
         std::string prefix;
         if (from_printf) {
             prefix = "Debug shader printf message generated ";
         } else {
             prefix = "Shader validation error occurred ";
         }
-        for (const auto &insn : shader) {
-            if ((insn.opcode() == spv::OpString) && (insn.len() >= 3) && (insn.word(1) == reported_file_id)) {
-                found_opstring = true;
-                reported_filename = (char *)&insn.word(2);
-                if (reported_filename.empty()) {
-                    filename_stream << prefix << "at line " << reported_line_number;
-                } else {
-                    filename_stream << prefix << "in file " << reported_filename << " at line " << reported_line_number;
-                }
-                if (reported_column_number > 0) {
-                    filename_stream << ", column " << reported_column_number;
-                }
-                filename_stream << ".";
-                break;
+        const std::string *opstring = debug_info->FindString(reported_file_id);
+        if (opstring) {
+            reported_filename = *opstring;
+            if (reported_filename.empty()) {
+                filename_stream << prefix << "at line " << reported_line_number;
+            } else {
+                filename_stream << prefix << "in file " << reported_filename << " at line " << reported_line_number;
             }
-        }
-        if (!found_opstring) {
+            if (reported_column_number > 0) {
+                filename_stream << ", column " << reported_column_number;
+            }
+            filename_stream << ".";
+        } else {
             filename_stream << "Unable to find SPIR-V OpString for file id " << reported_file_id << " from OpLine instruction."
                             << std::endl;
             filename_stream << "File ID = " << reported_file_id << ", Line Number = " << reported_line_number
@@ -1176,32 +1512,27 @@ void UtilGenerateSourceMessages(const std::vector<uint32_t> &pgm, const uint32_t
 
     // Create message to display source code line containing error.
     if ((reported_file_id != 0)) {
-        // Read the source code and split it up into separate lines.
-        std::vector<std::string> opsource_lines;
-        ReadOpSource(shader, reported_file_id, opsource_lines);
+        // The source code, already split up into separate lines.
+        const GpuAssistedShaderDebugInfo::SourceFile *source_file = debug_info->FindSourceFile(reported_file_id);
         // Find the line in the OpSource content that corresponds to the reported error file and line.
-        if (!opsource_lines.empty()) {
+        if (source_file && !source_file->lines.empty()) {
+            const std::vector<std::string> &opsource_lines = source_file->lines;
             uint32_t saved_line_number = 0;
             std::string current_filename = reported_filename;  // current "preprocessor" filename state.
             std::vector<std::string>::size_type saved_opsource_offset = 0;
             bool found_best_line = false;
-            for (auto it = opsource_lines.begin(); it != opsource_lines.end(); ++it) {
-                uint32_t parsed_line_number;
-                std::string parsed_filename;
-                bool found_line = GetLineAndFilename(*it, &parsed_line_number, parsed_filename);
-                if (!found_line) continue;
-
-                bool found_filename = parsed_filename.size() > 0;
+            for (const auto &directive : source_file->directives) {
+                bool found_filename = directive.filename.size() > 0;
                 if (found_filename) {
-                    current_filename = parsed_filename;
+                    current_filename = directive.filename;
                 }
                 if ((!found_filename) || (current_filename == reported_filename)) {
                     // Update the candidate best line directive, if the current one is prior and closer to the reported line
-                    if (reported_line_number >= parsed_line_number) {
+                    if (reported_line_number >= directive.line_number) {
                         if (!found_best_line ||
-                            (reported_line_number - parsed_line_number <= reported_line_number - saved_line_number)) {
-                            saved_line_number = parsed_line_number;
-                            saved_opsource_offset = std::distance(opsource_lines.begin(), it);
+                            (reported_line_number - directive.line_number <= reported_line_number - saved_line_number)) {
+                            saved_line_number = directive.line_number;
+                            saved_opsource_offset = directive.source_line_index;
                             found_best_line = true;
                         }
                     }
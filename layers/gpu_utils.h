@@ -24,6 +24,11 @@
 #include "vk_mem_alloc.h"
 #include "queue_state.h"
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <thread>
+
 class GpuAssistedBase;
 
 static const VkShaderStageFlags kShaderStageAllRayTracing =
@@ -55,16 +60,57 @@ class UtilDescriptorSetManager {
 };
 
 namespace gpu_utils_state {
+// A submission whose instrumentation output is processed by the queue's result thread once fence signals
+struct PendingResults {
+    VkFence fence;      // Layer owned, signaled after a barrier making the output available to the host
+    VkFence app_fence;  // Fence passed to the submit, if any
+    std::vector<VkCommandBuffer> command_buffers;
+    std::vector<VkCommandBuffer> secondary_command_buffers;
+    std::vector<std::pair<VkSemaphore, uint64_t>> signal_semaphores;  // Semaphores signaled by the submit, with their values
+
+    bool Uses(VkCommandBuffer command_buffer) const {
+        return std::find(command_buffers.begin(), command_buffers.end(), command_buffer) != command_buffers.end() ||
+               std::find(secondary_command_buffers.begin(), secondary_command_buffers.end(), command_buffer) !=
+                   secondary_command_buffers.end();
+    }
+    bool Signals(VkSemaphore semaphore, uint64_t value) const {
+        return std::any_of(signal_semaphores.begin(), signal_semaphores.end(),
+                           [semaphore, value](const std::pair<VkSemaphore, uint64_t> &signal) {
+                               return signal.first == semaphore && signal.second <= value;
+                           });
+    }
+};
+
 class Queue : public QUEUE_STATE {
   public:
     Queue(GpuAssistedBase &state, VkQueue q, uint32_t index, VkDeviceQueueCreateFlags flags);
     virtual ~Queue();
-    void SubmitBarrier();
+    // Returns false if nothing could be submitted, in which case fence will not be signaled
+    bool SubmitBarrier(VkFence fence = VK_NULL_HANDLE);
+
+    // Submits a barrier signaling a layer owned fence and processes the command buffers once it signals. Each queue processes
+    // its submissions in order on its own thread, so a submission blocked on another queue never delays this one.
+    void QueueResults(VkFence app_fence, std::vector<VkCommandBuffer> &&command_buffers,
+                      std::vector<VkCommandBuffer> &&secondary_command_buffers,
+                      std::vector<std::pair<VkSemaphore, uint64_t>> &&signal_semaphores);
+    void WaitForResults(const std::function<bool(const PendingResults &)> &wait_for);
+    void StopResultThread();
 
   private:
+    void ResultThread();
+    bool ResubmittedBeforeProcessed(VkCommandBuffer command_buffer);
+
     GpuAssistedBase &state_;
     VkCommandPool barrier_command_pool_{VK_NULL_HANDLE};
     VkCommandBuffer barrier_command_buffer_{VK_NULL_HANDLE};
+
+    std::mutex results_lock_;
+    std::condition_variable pending_results_cv_;
+    std::condition_variable results_processed_cv_;
+    std::deque<PendingResults> pending_results_;
+    std::vector<VkFence> free_result_fences_;
+    std::thread result_thread_;
+    bool result_thread_exit_ = false;
 };
 
 class CommandBuffer : public CMD_BUFFER_STATE {
@@ -86,19 +132,60 @@ void UtilGenerateCommonMessage(const debug_report_data *report_data, const VkCom
                                const uint32_t *debug_record, const VkShaderModule shader_module_handle,
                                const VkPipeline pipeline_handle, const VkPipelineBindPoint pipeline_bind_point,
                                const uint32_t operation_index, std::string &msg);
-void UtilGenerateSourceMessages(const std::vector<uint32_t> &pgm, const uint32_t *debug_record, bool from_printf,
+
+// The source level debug information of a shader, indexed once when the shader is tracked so that generating the message for a
+// debug record does not walk or copy the SPIR-V.
+class GpuAssistedShaderDebugInfo {
+  public:
+    // The OpLine in effect from instruction_index onwards
+    struct LineInfo {
+        uint32_t instruction_index;
+        uint32_t file_id;
+        uint32_t line_number;
+        uint32_t column_number;
+    };
+    // A #line directive in the source text of an OpSource
+    struct LineDirective {
+        size_t source_line_index;
+        uint32_t line_number;
+        std::string filename;
+    };
+    struct SourceFile {
+        std::vector<std::string> lines;
+        std::vector<LineDirective> directives;
+    };
+
+    explicit GpuAssistedShaderDebugInfo(const std::vector<uint32_t> &pgm);
+    virtual ~GpuAssistedShaderDebugInfo() {}
+
+    // Return nullptr if the shader has no such debug information
+    const LineInfo *FindLine(uint32_t instruction_index) const;
+    const std::string *FindString(uint32_t string_id) const;
+    const SourceFile *FindSourceFile(uint32_t file_id) const;
+
+    const layer_data::unordered_map<uint32_t, std::string> &GetStrings() const { return strings_; }
+
+  private:
+    std::vector<LineInfo> lines_;  // Sorted by instruction_index
+    layer_data::unordered_map<uint32_t, std::string> strings_;
+    layer_data::unordered_map<uint32_t, SourceFile> source_files_;
+};
+
+void UtilGenerateSourceMessages(const GpuAssistedShaderDebugInfo *debug_info, const uint32_t *debug_record, bool from_printf,
                                 std::string &filename_msg, std::string &source_msg);
 
 struct GpuAssistedShaderTracker {
     VkPipeline pipeline;
     VkShaderModule shader_module;
-    std::vector<uint32_t> pgm;
+    // Shared by every pipeline using the shader module, and immutable so messages can be generated while it is untracked
+    std::shared_ptr<const GpuAssistedShaderDebugInfo> debug_info;
 };
 
 class GpuAssistedBase : public ValidationStateTracker {
   public:
     ReadLockGuard ReadLock() override;
     WriteLockGuard WriteLock() override;
+    void ProcessCommandBuffer(VkQueue queue, VkCommandBuffer command_buffer);
     void PreCallRecordCreateDevice(VkPhysicalDevice physicalDevice, const VkDeviceCreateInfo *pCreateInfo,
                                    const VkAllocationCallbacks *pAllocator, VkDevice *pDevice, void *modified_create_info) override;
     void CreateDevice(const VkDeviceCreateInfo *pCreateInfo) override;
@@ -111,6 +198,27 @@ class GpuAssistedBase : public ValidationStateTracker {
                                        VkResult result) override;
     void PostCallRecordQueueSubmit2(VkQueue queue, uint32_t submitCount, const VkSubmitInfo2 *pSubmits, VkFence fence,
                                     VkResult result) override;
+    void PostCallRecordQueueWaitIdle(VkQueue queue, VkResult result) override;
+    void PostCallRecordDeviceWaitIdle(VkDevice device, VkResult result) override;
+    void PostCallRecordWaitForFences(VkDevice device, uint32_t fenceCount, const VkFence *pFences, VkBool32 waitAll,
+                                     uint64_t timeout, VkResult result) override;
+    void PostCallRecordGetFenceStatus(VkDevice device, VkFence fence, VkResult result) override;
+    void WaitForSemaphoreResults(const VkSemaphoreWaitInfo *pWaitInfo, VkResult result);
+    void PostCallRecordWaitSemaphores(VkDevice device, const VkSemaphoreWaitInfo *pWaitInfo, uint64_t timeout,
+                                      VkResult result) override;
+    void PostCallRecordWaitSemaphoresKHR(VkDevice device, const VkSemaphoreWaitInfo *pWaitInfo, uint64_t timeout,
+                                         VkResult result) override;
+    void WaitForSemaphoreCounterResults(VkSemaphore semaphore, const uint64_t *pValue, VkResult result);
+    void PostCallRecordGetSemaphoreCounterValue(VkDevice device, VkSemaphore semaphore, uint64_t *pValue, VkResult result) override;
+    void PostCallRecordGetSemaphoreCounterValueKHR(VkDevice device, VkSemaphore semaphore, uint64_t *pValue,
+                                                   VkResult result) override;
+    void PreCallRecordBeginCommandBuffer(VkCommandBuffer commandBuffer, const VkCommandBufferBeginInfo *pBeginInfo) override;
+    void PreCallRecordResetCommandBuffer(VkCommandBuffer commandBuffer, VkCommandBufferResetFlags flags) override;
+    void PreCallRecordResetCommandPool(VkDevice device, VkCommandPool commandPool, VkCommandPoolResetFlags flags) override;
+    void PreCallRecordFreeCommandBuffers(VkDevice device, VkCommandPool commandPool, uint32_t commandBufferCount,
+                                         const VkCommandBuffer *pCommandBuffers) override;
+    void PreCallRecordDestroyCommandPool(VkDevice device, VkCommandPool commandPool,
+                                         const VkAllocationCallbacks *pAllocator) override;
     bool ValidateCmdWaitEvents(VkCommandBuffer command_buffer, VkPipelineStageFlags2 src_stage_mask, CMD_TYPE cmd_type) const;
     bool PreCallValidateCmdWaitEvents(VkCommandBuffer commandBuffer, uint32_t eventCount, const VkEvent *pEvents,
                                       VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask,
@@ -174,6 +282,7 @@ class GpuAssistedBase : public ValidationStateTracker {
             logit += " VMA statistics = ";
             logit += stats_string;
             vmaFreeStatsString(vmaAllocator, stats_string);
+            AppendAllocationStats(logit);
         }
         LogError(object, setup_vuid, "Setup Error. Detail: (%s)", logit.c_str());
     }
@@ -185,7 +294,15 @@ class GpuAssistedBase : public ValidationStateTracker {
 
   protected:
     bool CommandBufferNeedsProcessing(VkCommandBuffer command_buffer) const;
-    void ProcessCommandBuffer(VkQueue queue, VkCommandBuffer command_buffer);
+    void QueuePendingResults(VkQueue queue, VkFence app_fence, std::vector<VkCommandBuffer> &&command_buffers,
+                             std::vector<std::pair<VkSemaphore, uint64_t>> &&signal_semaphores);
+    // Blocks until the results of every pending submission for which wait_for returns true have been processed
+    void WaitForPendingResults(const std::function<bool(const gpu_utils_state::PendingResults &)> &wait_for);
+    void WaitForPendingResults(VkCommandBuffer command_buffer) {
+        WaitForPendingResults(
+            [command_buffer](const gpu_utils_state::PendingResults &pending) { return pending.Uses(command_buffer); });
+    }
+    void WaitForPoolResults(VkCommandPool command_pool);
 
     void SubmitBarrier(VkQueue queue) {
         auto queue_state = Get<gpu_utils_state::Queue>(queue);
@@ -207,6 +324,15 @@ class GpuAssistedBase : public ValidationStateTracker {
     void PostCallRecordPipelineCreations(const uint32_t count, const CreateInfo *pCreateInfos,
                                          const VkAllocationCallbacks *pAllocator, VkPipeline *pPipelines,
                                          const VkPipelineBindPoint bind_point, const SafeCreateInfo &modified_create_infos);
+    // Returns the instrumented SPIR-V of a shader module that was not instrumented when it was created, or false if the module
+    // is to be used as created
+    virtual bool GetInstrumentedShader(const SHADER_MODULE_STATE &module_state, std::vector<uint32_t> &pgm) { return false; }
+    // Add statistics about memory the layer suballocates itself to the VMA statistics of a setup problem
+    virtual void AppendAllocationStats(std::string &stats) const {}
+    // Index the debug information of a shader used by a pipeline
+    virtual std::shared_ptr<const GpuAssistedShaderDebugInfo> CreateShaderDebugInfo(const std::vector<uint32_t> &pgm) const {
+        return std::make_shared<const GpuAssistedShaderDebugInfo>(pgm);
+    }
 
   public:
     bool aborted = false;
@@ -224,5 +350,7 @@ class GpuAssistedBase : public ValidationStateTracker {
     std::unique_ptr<UtilDescriptorSetManager> desc_set_manager;
     vl_concurrent_unordered_map<uint32_t, GpuAssistedShaderTracker> shader_map;
     std::vector<VkDescriptorSetLayoutBinding> bindings_;
+    // Process instrumentation output on a per queue thread once submissions complete, rather than waiting for the queue to be idle
+    bool async_results = false;
 };
 
@@ -243,6 +243,8 @@ void GpuAssisted::CreateDevice(const VkDeviceCreateInfo *pCreateInfo) {
 
     bool validate_descriptor_indexing = GpuGetOption("khronos_validation.gpuav_descriptor_indexing", true);
     validate_draw_indirect = GpuGetOption("khronos_validation.validate_draw_indirect", true);
+    async_results = GpuGetOption("khronos_validation.gpuav_async_results", false) ||
+                    !GetEnvironment("VK_LAYER_GPUAV_ASYNC_RESULTS").empty();
 
     if (phys_dev_props.apiVersion < VK_API_VERSION_1_1) {
         ReportSetupProblem(device, "GPU-Assisted validation requires Vulkan 1.1 or later.  GPU-Assisted Validation disabled.");
@@ -289,6 +291,26 @@ void GpuAssisted::CreateDevice(const VkDeviceCreateInfo *pCreateInfo) {
             ReportSetupProblem(device, "Unable to create VMA memory pool");
         }
     }
+    // Suballocations are bound as storage buffers, and the BDA input buffer is read as 64 bit words
+    block_pool.Init(vmaAllocator, output_buffer_pool,
+                    std::max<VkDeviceSize>(phys_dev_props.limits.minStorageBufferOffsetAlignment, sizeof(uint64_t)));
+
+    std::string cache_dir = getLayerOption("khronos_validation.gpuav_shader_cache_dir");
+    if (cache_dir.empty()) cache_dir = GetEnvironment("VK_LAYER_GPUAV_SHADER_CACHE_DIR");
+    if (!cache_dir.empty()) {
+        instrumented_shader_cache_path = cache_dir + "/gpuav_shader_cache.bin";
+        if (!instrumented_shader_cache.Load(instrumented_shader_cache_path)) {
+            LogInfo(device, "UNASSIGNED-cache-file-error",
+                    "Cannot open instrumented shader cache at %s for reading (it may not exist yet)",
+                    instrumented_shader_cache_path.c_str());
+        }
+    }
+
+    deferred_instrumentation = GpuGetOption("khronos_validation.gpuav_deferred_instrumentation", false) ||
+                               !GetEnvironment("VK_LAYER_GPUAV_DEFERRED_INSTRUMENTATION").empty();
+    if (deferred_instrumentation) {
+        instrumentation_thread = std::thread(&GpuAssisted::InstrumentationThread, this);
+    }
 
     CreateAccelerationStructureBuildValidationState();
 }
@@ -307,13 +329,26 @@ void GpuAssistedPreDrawValidationState::Destroy(VkDevice device) {
     }
 }
 
+GpuAssisted::~GpuAssisted() { StopInstrumentationThread(); }
+
 // Clean up device-related resources
 void GpuAssisted::PreCallRecordDestroyDevice(VkDevice device, const VkAllocationCallbacks *pAllocator) {
+    StopInstrumentationThread();
     DestroyAccelerationStructureBuildValidationState();
     pre_draw_validation_state.Destroy(device);
+    // The state tracker frees the command buffers the application did not free only after the pools are destroyed
+    ForEachShared<CMD_BUFFER_STATE>([this](const std::shared_ptr<CMD_BUFFER_STATE> &cb_state) {
+        auto guard = cb_state->WriteLock();
+        static_cast<gpuav_state::CommandBuffer *>(cb_state.get())->buffer_allocator.Reset(block_pool);
+    });
+    block_pool.Destroy();
     if (output_buffer_pool) {
         vmaDestroyPool(vmaAllocator, output_buffer_pool);
     }
+    if (!instrumented_shader_cache_path.empty() && !instrumented_shader_cache.Save(instrumented_shader_cache_path)) {
+        LogInfo(device, "UNASSIGNED-cache-write-error", "Cannot write instrumented shader cache at %s",
+                instrumented_shader_cache_path.c_str());
+    }
     GpuAssistedBase::PreCallRecordDestroyDevice(device, pAllocator);
 }
 
@@ -931,15 +966,8 @@ void GpuAssisted::PostCallRecordBindAccelerationStructureMemoryNV(VkDevice devic
     }
 }
 
-// Free the device memory and descriptor set(s) associated with a command buffer.
+// Free the descriptor set(s) associated with a command buffer. Its memory is returned with the blocks of its allocator.
 void GpuAssisted::DestroyBuffer(GpuAssistedBufferInfo &buffer_info) {
-    vmaDestroyBuffer(vmaAllocator, buffer_info.output_mem_block.buffer, buffer_info.output_mem_block.allocation);
-    if (buffer_info.di_input_mem_block.buffer) {
-        vmaDestroyBuffer(vmaAllocator, buffer_info.di_input_mem_block.buffer, buffer_info.di_input_mem_block.allocation);
-    }
-    if (buffer_info.bda_input_mem_block.buffer) {
-        vmaDestroyBuffer(vmaAllocator, buffer_info.bda_input_mem_block.buffer, buffer_info.bda_input_mem_block.allocation);
-    }
     if (buffer_info.desc_set != VK_NULL_HANDLE) {
         desc_set_manager->PutBackDescriptorSet(buffer_info.desc_pool, buffer_info.desc_set);
     }
@@ -956,6 +984,121 @@ void GpuAssisted::DestroyBuffer(GpuAssistedAccelerationStructureBuildValidationB
     }
 }
 
+void GpuAssistedBlockPool::Init(VmaAllocator allocator, VmaPool pool, VkDeviceSize alignment) {
+    allocator_ = allocator;
+    pool_ = pool;
+    alignment_ = alignment;
+}
+
+VkResult GpuAssistedBlockPool::Acquire(VkDeviceSize min_size, Block &block) {
+    auto guard = std::unique_lock<std::mutex>(lock_);
+    if (min_size <= kBlockSize && !free_blocks_.empty()) {
+        block = free_blocks_.back();
+        free_blocks_.pop_back();
+        block_reuse_count_++;
+        return VK_SUCCESS;
+    }
+
+    auto buffer_info = LvlInitStruct<VkBufferCreateInfo>();
+    buffer_info.size = min_size > kBlockSize ? min_size : kBlockSize;
+    buffer_info.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    VmaAllocationCreateInfo alloc_info = {};
+    alloc_info.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    alloc_info.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    alloc_info.pool = pool_;
+    VmaAllocationInfo allocation_info = {};
+    VkResult result = vmaCreateBuffer(allocator_, &buffer_info, &alloc_info, &block.buffer, &block.allocation, &allocation_info);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    block.data = static_cast<uint8_t *>(allocation_info.pMappedData);
+    block.size = buffer_info.size;
+    block_allocation_count_++;
+    live_block_count_++;
+    return VK_SUCCESS;
+}
+
+void GpuAssistedBlockPool::DestroyBlock(const Block &block) {
+    vmaDestroyBuffer(allocator_, block.buffer, block.allocation);
+    live_block_count_--;
+}
+
+void GpuAssistedBlockPool::Release(std::vector<Block> &blocks) {
+    auto guard = std::unique_lock<std::mutex>(lock_);
+    for (const auto &block : blocks) {
+        if (!destroyed_ && block.size == kBlockSize && free_blocks_.size() < kMaxFreeBlocks) {
+            free_blocks_.push_back(block);
+        } else {
+            DestroyBlock(block);
+        }
+    }
+    blocks.clear();
+}
+
+void GpuAssistedBlockPool::Destroy() {
+    auto guard = std::unique_lock<std::mutex>(lock_);
+    for (const auto &block : free_blocks_) {
+        DestroyBlock(block);
+    }
+    free_blocks_.clear();
+    destroyed_ = true;
+}
+
+std::string GpuAssistedBlockPool::GetStats() const {
+    auto guard = std::unique_lock<std::mutex>(lock_);
+    return "Suballocation blocks = { allocated: " + std::to_string(block_allocation_count_) +
+           ", reused: " + std::to_string(block_reuse_count_) + ", live: " + std::to_string(live_block_count_) +
+           ", free: " + std::to_string(free_blocks_.size()) +
+           ", suballocations: " + std::to_string(suballocation_count_.load()) + " }";
+}
+
+VkResult GpuAssistedLinearAllocator::Allocate(GpuAssistedBlockPool &pool, VkDeviceSize size,
+                                              GpuAssistedDeviceMemoryBlock &mem_block) {
+    const VkDeviceSize alignment = pool.Alignment();
+    const VkDeviceSize aligned_size = (size + alignment - 1) / alignment * alignment;
+    GpuAssistedBlockPool::Block *block = nullptr;
+    VkDeviceSize offset = 0;
+    if (aligned_size > GpuAssistedBlockPool::kBlockSize / 4) {
+        GpuAssistedBlockPool::Block large_block = {};
+        VkResult result = pool.Acquire(aligned_size, large_block);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+        large_blocks_.push_back(large_block);
+        block = &large_blocks_.back();
+    } else {
+        if (blocks_.empty() || used_ + aligned_size > blocks_.back().size) {
+            GpuAssistedBlockPool::Block new_block = {};
+            VkResult result = pool.Acquire(GpuAssistedBlockPool::kBlockSize, new_block);
+            if (result != VK_SUCCESS) {
+                return result;
+            }
+            blocks_.push_back(new_block);
+            used_ = 0;
+        }
+        block = &blocks_.back();
+        offset = used_;
+        used_ += aligned_size;
+    }
+    mem_block.buffer = block->buffer;
+    mem_block.offset = offset;
+    mem_block.size = size;
+    mem_block.data = block->data + offset;
+    pool.CountSuballocation();
+    return VK_SUCCESS;
+}
+
+void GpuAssistedLinearAllocator::Reset(GpuAssistedBlockPool &pool) {
+    pool.Release(blocks_);
+    pool.Release(large_blocks_);
+    used_ = 0;
+}
+
+void GpuAssisted::AppendAllocationStats(std::string &stats) const {
+    stats += " ";
+    stats += block_pool.GetStats();
+}
+
 void GpuAssisted::PostCallRecordGetPhysicalDeviceProperties(VkPhysicalDevice physicalDevice,
                                                             VkPhysicalDeviceProperties *pPhysicalDeviceProperties) {
     // There is an implicit layer that can cause this call to return 0 for maxBoundDescriptorSets - Ignore such calls
@@ -993,9 +1136,136 @@ void GpuAssisted::PreCallRecordDestroyRenderPass(VkDevice device, VkRenderPass r
     ValidationStateTracker::PreCallRecordDestroyRenderPass(device, renderPass, pAllocator);
 }
 
-// Call the SPIR-V Optimizer to run the instrumentation pass on the shader.
-bool GpuAssisted::InstrumentShader(const VkShaderModuleCreateInfo *pCreateInfo, std::vector<uint32_t> &new_pgm,
-                                   uint32_t *unique_shader_id) {
+constexpr uint32_t GpuAssistedShaderCache::kPlaceholderShaderId;
+constexpr uint32_t GpuAssistedShaderCache::kFormatVersion;
+
+uint64_t GpuAssistedShaderCache::MakeKey(const VkShaderModuleCreateInfo *pCreateInfo, uint64_t options_key,
+                                        const std::vector<uint32_t> &instrumentation_options) {
+    const uint64_t seed = XXH64(instrumentation_options.data(), instrumentation_options.size() * sizeof(uint32_t), options_key);
+    return XXH64(pCreateInfo->pCode, pCreateInfo->codeSize, seed);
+}
+
+std::vector<uint32_t> GpuAssistedShaderCache::FindIntConstants(const uint32_t *code, size_t word_count, uint32_t value) {
+    std::vector<uint32_t> offsets;
+    layer_data::unordered_set<uint32_t> int32_types;
+    size_t offset = 5;  // Skip the module header
+    while (offset < word_count) {
+        const uint32_t length = code[offset] >> 16;
+        const uint32_t opcode = code[offset] & 0xffff;
+        if (length == 0 || length > word_count - offset) break;
+        // Types and constants are all declared before the first function
+        if (opcode == spv::OpFunction) break;
+        if (opcode == spv::OpTypeInt && length == 4 && code[offset + 2] == 32) {
+            int32_types.insert(code[offset + 1]);
+        } else if ((opcode == spv::OpConstant || opcode == spv::OpSpecConstant) && length == 4 &&
+                   int32_types.count(code[offset + 1]) && code[offset + 3] == value) {
+            offsets.push_back(static_cast<uint32_t>(offset + 3));
+        }
+        offset += length;
+    }
+    return offsets;
+}
+
+bool GpuAssistedShaderCache::Find(uint64_t key, uint32_t shader_id, std::vector<uint32_t> &pgm) const {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) return false;
+    pgm = it->second.pgm;
+    for (const auto offset : it->second.shader_id_offsets) {
+        pgm[offset] = shader_id;
+    }
+    return true;
+}
+
+void GpuAssistedShaderCache::Insert(uint64_t key, const std::vector<uint32_t> &pgm, std::vector<uint32_t> shader_id_offsets) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (entries_.emplace(key, Entry{pgm, std::move(shader_id_offsets)}).second) {
+        modified_ = true;
+    }
+}
+
+// The cache file holds kFormatVersion, a hash of the SPIRV-Tools commit and the number of entries, followed by the entries. Each
+// entry is its 64-bit key, the size in words of its binary and of its shader id offsets, the binary, then the offsets.
+static constexpr size_t kShaderCacheHeaderWords = 4;
+static constexpr size_t kShaderCacheEntryHeaderWords = 4;
+
+bool GpuAssistedShaderCache::Load(const std::string &path) {
+    std::vector<char> file_data;
+    if (!ReadBinaryFile(path, file_data)) return false;
+    std::vector<uint32_t> data(file_data.size() / sizeof(uint32_t));
+    if (data.size() < kShaderCacheHeaderWords) return false;
+    memcpy(data.data(), file_data.data(), data.size() * sizeof(uint32_t));
+
+    const uint64_t tools_hash = XXH64(SPIRV_TOOLS_COMMIT_ID, strlen(SPIRV_TOOLS_COMMIT_ID), 0);
+    if (data[0] != kFormatVersion || data[1] != static_cast<uint32_t>(tools_hash) ||
+        data[2] != static_cast<uint32_t>(tools_hash >> 32)) {
+        return false;
+    }
+    const uint32_t entry_count = data[3];
+
+    std::lock_guard<std::mutex> guard(lock_);
+    size_t pos = kShaderCacheHeaderWords;
+    for (uint32_t i = 0; i < entry_count && data.size() - pos >= kShaderCacheEntryHeaderWords; i++) {
+        const uint64_t key = data[pos] | (static_cast<uint64_t>(data[pos + 1]) << 32);
+        const size_t pgm_size = data[pos + 2];
+        const size_t offset_count = data[pos + 3];
+        pos += kShaderCacheEntryHeaderWords;
+        if (pgm_size > data.size() - pos || offset_count > data.size() - pos - pgm_size) break;
+
+        Entry entry;
+        entry.pgm.assign(data.begin() + pos, data.begin() + pos + pgm_size);
+        pos += pgm_size;
+        entry.shader_id_offsets.assign(data.begin() + pos, data.begin() + pos + offset_count);
+        pos += offset_count;
+        bool offsets_valid = true;
+        for (const auto offset : entry.shader_id_offsets) {
+            offsets_valid &= offset < pgm_size;
+        }
+        if (offsets_valid) {
+            entries_.emplace(key, std::move(entry));
+        }
+    }
+    return true;
+}
+
+bool GpuAssistedShaderCache::Save(const std::string &path) {
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (!modified_) return true;
+    }
+    Load(path);
+
+    std::vector<uint32_t> data;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        size_t size = kShaderCacheHeaderWords;
+        for (const auto &entry : entries_) {
+            size += kShaderCacheEntryHeaderWords + entry.second.pgm.size() + entry.second.shader_id_offsets.size();
+        }
+        data.reserve(size);
+
+        const uint64_t tools_hash = XXH64(SPIRV_TOOLS_COMMIT_ID, strlen(SPIRV_TOOLS_COMMIT_ID), 0);
+        data.push_back(kFormatVersion);
+        data.push_back(static_cast<uint32_t>(tools_hash));
+        data.push_back(static_cast<uint32_t>(tools_hash >> 32));
+        data.push_back(static_cast<uint32_t>(entries_.size()));
+        for (const auto &entry : entries_) {
+            data.push_back(static_cast<uint32_t>(entry.first));
+            data.push_back(static_cast<uint32_t>(entry.first >> 32));
+            data.push_back(static_cast<uint32_t>(entry.second.pgm.size()));
+            data.push_back(static_cast<uint32_t>(entry.second.shader_id_offsets.size()));
+            data.insert(data.end(), entry.second.pgm.begin(), entry.second.pgm.end());
+            data.insert(data.end(), entry.second.shader_id_offsets.begin(), entry.second.shader_id_offsets.end());
+        }
+        modified_ = false;
+    }
+    return WriteFileAtomically(path, data.data(), data.size() * sizeof(uint32_t));
+}
+
+// Call the SPIR-V Optimizer to run the instrumentation pass on the shader. shader_id is written to the error records of the
+// instrumented shader, to identify it in the shader_map.
+bool GpuAssisted::InstrumentShader(const VkShaderModuleCreateInfo *pCreateInfo, uint32_t shader_id,
+                                   std::vector<uint32_t> &new_pgm) {
     if (aborted) return false;
     if (pCreateInfo->pCode[0] != spv::MagicNumber) return false;
 
@@ -1013,38 +1283,63 @@ bool GpuAssisted::InstrumentShader(const VkShaderModuleCreateInfo *pCreateInfo,
         }
     };
 
-    // Load original shader SPIR-V
     uint32_t num_words = static_cast<uint32_t>(pCreateInfo->codeSize / 4);
+    using namespace spvtools;
+    spv_target_env target_env = PickSpirvEnv(api_version, IsExtEnabled(device_extensions.vk_khr_spirv_1_4));
+    spvtools::ValidatorOptions val_options;
+    const uint32_t option_bits = AdjustValidatorOptions(device_extensions, enabled_features, val_options);
+    const bool buffer_address_checks = (IsExtEnabled(device_extensions.vk_ext_buffer_device_address) ||
+                                        IsExtEnabled(device_extensions.vk_khr_buffer_device_address)) &&
+                                       shaderInt64 && enabled_features.core12.bufferDeviceAddress;
+
+    // Look for a previous instrumentation of the same module. The result is only reusable if the module does not already contain
+    // the placeholder shader id as a constant, which the instrumentation passes would share with their own.
+    const bool use_cache =
+        GpuAssistedShaderCache::FindIntConstants(pCreateInfo->pCode, num_words, GpuAssistedShaderCache::kPlaceholderShaderId)
+            .empty();
+    uint64_t cache_key = 0;
+    if (use_cache) {
+        const std::vector<uint32_t> instrumentation_options = {desc_set_bind_index, descriptor_indexing, buffer_oob_enabled,
+                                                               buffer_address_checks};
+        cache_key = GpuAssistedShaderCache::MakeKey(pCreateInfo, ValidationCache::MakeOptionsKey(target_env, option_bits),
+                                                    instrumentation_options);
+        if (instrumented_shader_cache.Find(cache_key, shader_id, new_pgm)) {
+            return true;
+        }
+    }
+
+    // Load original shader SPIR-V
     new_pgm.clear();
     new_pgm.reserve(num_words);
     new_pgm.insert(new_pgm.end(), &pCreateInfo->pCode[0], &pCreateInfo->pCode[num_words]);
 
     // Call the optimizer to instrument the shader.
-    // Use the unique_shader_module_id as a shader ID so we can look up its handle later in the shader_map.
+    // When caching, the placeholder is used as the shader ID and replaced once the shader has been added to the cache.
     // If descriptor indexing is enabled, enable length checks and updated descriptor checks
-    using namespace spvtools;
-    spv_target_env target_env = PickSpirvEnv(api_version, IsExtEnabled(device_extensions.vk_khr_spirv_1_4));
-    spvtools::ValidatorOptions val_options;
-    AdjustValidatorOptions(device_extensions, enabled_features, val_options);
+    const uint32_t instrumentation_id = use_cache ? GpuAssistedShaderCache::kPlaceholderShaderId : shader_id;
     spvtools::OptimizerOptions opt_options;
     opt_options.set_run_validator(true);
     opt_options.set_validator_options(val_options);
     Optimizer optimizer(target_env);
     optimizer.SetMessageConsumer(gpu_console_message_consumer);
-    optimizer.RegisterPass(CreateInstBindlessCheckPass(desc_set_bind_index, unique_shader_module_id, descriptor_indexing,
+    optimizer.RegisterPass(CreateInstBindlessCheckPass(desc_set_bind_index, instrumentation_id, descriptor_indexing,
                                                        descriptor_indexing, buffer_oob_enabled, buffer_oob_enabled));
     // Call CreateAggressiveDCEPass with preserve_interface == true
     optimizer.RegisterPass(CreateAggressiveDCEPass(true));
-    if ((IsExtEnabled(device_extensions.vk_ext_buffer_device_address) ||
-         IsExtEnabled(device_extensions.vk_khr_buffer_device_address)) &&
-        shaderInt64 && enabled_features.core12.bufferDeviceAddress) {
-        optimizer.RegisterPass(CreateInstBuffAddrCheckPass(desc_set_bind_index, unique_shader_module_id));
+    if (buffer_address_checks) {
+        optimizer.RegisterPass(CreateInstBuffAddrCheckPass(desc_set_bind_index, instrumentation_id));
     }
     bool pass = optimizer.Run(new_pgm.data(), new_pgm.size(), &new_pgm, opt_options);
     if (!pass) {
         ReportSetupProblem(device, "Failure to instrument shader.  Proceeding with non-instrumented shader.");
+    } else if (use_cache) {
+        const auto shader_id_offsets =
+            GpuAssistedShaderCache::FindIntConstants(new_pgm.data(), new_pgm.size(), instrumentation_id);
+        instrumented_shader_cache.Insert(cache_key, new_pgm, shader_id_offsets);
+        for (const auto offset : shader_id_offsets) {
+            new_pgm[offset] = shader_id;
+        }
     }
-    *unique_shader_id = unique_shader_module_id++;
     return pass;
 }
 // Create the instrumented shader data to provide to the driver.
@@ -1052,14 +1347,102 @@ void GpuAssisted::PreCallRecordCreateShaderModule(VkDevice device, const VkShade
                                                   const VkAllocationCallbacks *pAllocator, VkShaderModule *pShaderModule,
                                                   void *csm_state_data) {
     create_shader_module_api_state *csm_state = reinterpret_cast<create_shader_module_api_state *>(csm_state_data);
-    bool pass = InstrumentShader(pCreateInfo, csm_state->instrumented_pgm, &csm_state->unique_shader_id);
-    if (pass) {
+    // Use the unique_shader_module_id as a shader ID so we can look up its handle later in the shader_map.
+    csm_state->unique_shader_id = unique_shader_module_id++;
+    if (deferred_instrumentation) {
+        // Create the module as it is, and queue it for instrumentation
+        if (!aborted && pCreateInfo->pCode[0] == spv::MagicNumber) {
+            auto shader = std::make_shared<GpuAssistedDeferredShader>();
+            shader->pgm.assign(pCreateInfo->pCode, pCreateInfo->pCode + pCreateInfo->codeSize / sizeof(uint32_t));
+            std::lock_guard<std::mutex> guard(deferred_shader_lock);
+            deferred_shaders.emplace(csm_state->unique_shader_id, std::move(shader));
+            instrumentation_queue.push_back(csm_state->unique_shader_id);
+            deferred_shader_cv.notify_all();
+        }
+    } else if (InstrumentShader(pCreateInfo, csm_state->unique_shader_id, csm_state->instrumented_pgm)) {
         csm_state->instrumented_create_info.pCode = csm_state->instrumented_pgm.data();
         csm_state->instrumented_create_info.codeSize = csm_state->instrumented_pgm.size() * sizeof(uint32_t);
     }
     ValidationStateTracker::PreCallRecordCreateShaderModule(device, pCreateInfo, pAllocator, pShaderModule, csm_state_data);
 }
 
+void GpuAssisted::PreCallRecordDestroyShaderModule(VkDevice device, VkShaderModule shaderModule,
+                                                   const VkAllocationCallbacks *pAllocator) {
+    if (deferred_instrumentation) {
+        auto module_state = Get<SHADER_MODULE_STATE>(shaderModule);
+        if (module_state) {
+            std::lock_guard<std::mutex> guard(deferred_shader_lock);
+            deferred_shaders.erase(module_state->gpu_validation_shader_id);
+        }
+    }
+    ValidationStateTracker::PreCallRecordDestroyShaderModule(device, shaderModule, pAllocator);
+}
+
+// Instrument a queued shader. Called with guard locked, which is released while instrumenting. shader is held by value, as the
+// shader module may be destroyed meanwhile.
+void GpuAssisted::InstrumentDeferredShader(uint32_t shader_id, std::shared_ptr<GpuAssistedDeferredShader> shader,
+                                           std::unique_lock<std::mutex> &guard) {
+    assert(shader->state == GpuAssistedDeferredShader::kQueued);
+    shader->state = GpuAssistedDeferredShader::kInstrumenting;
+    guard.unlock();
+
+    auto create_info = LvlInitStruct<VkShaderModuleCreateInfo>();
+    create_info.pCode = shader->pgm.data();
+    create_info.codeSize = shader->pgm.size() * sizeof(uint32_t);
+    std::vector<uint32_t> instrumented_pgm;
+    const bool pass = InstrumentShader(&create_info, shader_id, instrumented_pgm);
+
+    guard.lock();
+    if (pass) {
+        shader->pgm = std::move(instrumented_pgm);
+    }
+    shader->instrumented = pass;
+    shader->state = GpuAssistedDeferredShader::kDone;
+    deferred_shader_cv.notify_all();
+}
+
+bool GpuAssisted::GetInstrumentedShader(const SHADER_MODULE_STATE &module_state, std::vector<uint32_t> &pgm) {
+    if (!deferred_instrumentation) return false;
+    std::unique_lock<std::mutex> guard(deferred_shader_lock);
+    auto it = deferred_shaders.find(module_state.gpu_validation_shader_id);
+    if (it == deferred_shaders.end()) return false;
+    const auto shader = it->second;
+    // Don't wait for the background thread to reach this shader
+    if (shader->state == GpuAssistedDeferredShader::kQueued) {
+        InstrumentDeferredShader(module_state.gpu_validation_shader_id, shader, guard);
+    }
+    deferred_shader_cv.wait(guard, [&shader] { return shader->state == GpuAssistedDeferredShader::kDone; });
+    if (!shader->instrumented) return false;
+    pgm = shader->pgm;
+    return true;
+}
+
+// Instruments queued shader modules ahead of their use in pipelines
+void GpuAssisted::InstrumentationThread() {
+    std::unique_lock<std::mutex> guard(deferred_shader_lock);
+    while (true) {
+        deferred_shader_cv.wait(guard, [this] { return instrumentation_thread_exit || !instrumentation_queue.empty(); });
+        if (instrumentation_thread_exit) return;
+        const uint32_t shader_id = instrumentation_queue.front();
+        instrumentation_queue.pop_front();
+        // Skip shaders that have been destroyed, or were instrumented when a pipeline was created with them
+        auto it = deferred_shaders.find(shader_id);
+        if (it != deferred_shaders.end() && it->second->state == GpuAssistedDeferredShader::kQueued) {
+            InstrumentDeferredShader(shader_id, it->second, guard);
+        }
+    }
+}
+
+void GpuAssisted::StopInstrumentationThread() {
+    if (!instrumentation_thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> guard(deferred_shader_lock);
+        instrumentation_thread_exit = true;
+    }
+    deferred_shader_cv.notify_all();
+    instrumentation_thread.join();
+}
+
 static const int kInstErrorPreDrawValidate = spvtools::kInstErrorMax + 1;
 static const int kPreDrawValidateSubError = spvtools::kInstValidationOutError + 1;
 // Generate the part of the message describing the violation.
@@ -1193,23 +1576,23 @@ void GpuAssisted::AnalyzeAndGenerateMessages(VkCommandBuffer command_buffer, VkQ
     std::string vuid_msg;
     VkShaderModule shader_module_handle = VK_NULL_HANDLE;
     VkPipeline pipeline_handle = VK_NULL_HANDLE;
-    std::vector<uint32_t> pgm;
+    std::shared_ptr<const GpuAssistedShaderDebugInfo> debug_info;
     // The first record starts at this offset after the total_words.
     const uint32_t *debug_record = &debug_output_buffer[kDebugOutputDataOffset];
-    // Lookup the VkShaderModule handle and SPIR-V code used to create the shader, using the unique shader ID value returned
+    // Lookup the VkShaderModule handle and debug information of the shader, using the unique shader ID value returned
     // by the instrumented shader.
     auto it = shader_map.find(debug_record[kInstCommonOutShaderId]);
     if (it != shader_map.end()) {
         shader_module_handle = it->second.shader_module;
         pipeline_handle = it->second.pipeline;
-        pgm = it->second.pgm;
+        debug_info = it->second.debug_info;
     }
     bool gen_full_message = GenerateValidationMessage(debug_record, validation_message, vuid_msg, buffer_info, this);
     if (gen_full_message) {
         UtilGenerateStageMessage(debug_record, stage_message);
         UtilGenerateCommonMessage(report_data, command_buffer, debug_record, shader_module_handle, pipeline_handle,
             buffer_info.pipeline_bind_point, operation_index, common_message);
-        UtilGenerateSourceMessages(pgm, debug_record, false, filename_message, source_message);
+        UtilGenerateSourceMessages(debug_info.get(), debug_record, false, filename_message, source_message);
         LogError(queue, vuid_msg.c_str(), "%s %s %s %s%s", validation_message.c_str(), common_message.c_str(), stage_message.c_str(),
             filename_message.c_str(), source_message.c_str());
     }
@@ -1232,8 +1615,6 @@ void gpuav_state::CommandBuffer::Process(VkQueue queue) {
         uint32_t ray_trace_index = 0;
 
         for (auto &buffer_info : gpu_buffer_list) {
-            char *data;
-
             uint32_t operation_index = 0;
             if (buffer_info.pipeline_bind_point == VK_PIPELINE_BIND_POINT_GRAPHICS) {
                 operation_index = draw_index;
@@ -1248,11 +1629,8 @@ void gpuav_state::CommandBuffer::Process(VkQueue queue) {
                 assert(false);
             }
 
-            VkResult result = vmaMapMemory(device_state->vmaAllocator, buffer_info.output_mem_block.allocation, (void **)&data);
-            if (result == VK_SUCCESS) {
-                device_state->AnalyzeAndGenerateMessages(commandBuffer(), queue, buffer_info, operation_index, (uint32_t *)data);
-                vmaUnmapMemory(device_state->vmaAllocator, buffer_info.output_mem_block.allocation);
-            }
+            device_state->AnalyzeAndGenerateMessages(commandBuffer(), queue, buffer_info, operation_index,
+                                                     static_cast<uint32_t *>(buffer_info.output_mem_block.data));
         }
     }
     ProcessAccelerationStructure(queue);
@@ -1327,18 +1705,13 @@ void GpuAssisted::SetBindingState(uint32_t *data, uint32_t index, const cvdescri
     }
 }
 
-// For the given command buffer, map its debug data buffers and update the status of any update after bind descriptors
+// For the given command buffer, update the status of any update after bind descriptors in its debug data buffers
 void GpuAssisted::UpdateInstrumentationBuffer(gpuav_state::CommandBuffer *cb_node) {
-    uint32_t *data;
     for (auto &buffer_info : cb_node->gpuav_buffer_list) {
         if (buffer_info.di_input_mem_block.update_at_submit.size() > 0) {
-            VkResult result =
-                vmaMapMemory(vmaAllocator, buffer_info.di_input_mem_block.allocation, reinterpret_cast<void **>(&data));
-            if (result == VK_SUCCESS) {
-                for (const auto &update : buffer_info.di_input_mem_block.update_at_submit) {
-                    SetBindingState(data, update.first, update.second);
-                }
-                vmaUnmapMemory(vmaAllocator, buffer_info.di_input_mem_block.allocation);
+            auto *data = static_cast<uint32_t *>(buffer_info.di_input_mem_block.data);
+            for (const auto &update : buffer_info.di_input_mem_block.update_at_submit) {
+                SetBindingState(data, update.first, update.second);
             }
         }
     }
@@ -1724,8 +2097,8 @@ void GpuAssisted::AllocatePreDrawValidationResources(GpuAssistedDeviceMemoryBloc
     VkDescriptorBufferInfo buffer_infos[buffer_count] = {};
     // Error output buffer
     buffer_infos[0].buffer = output_block.buffer;
-    buffer_infos[0].offset = 0;
-    buffer_infos[0].range = VK_WHOLE_SIZE;
+    buffer_infos[0].offset = output_block.offset;
+    buffer_infos[0].range = output_block.size;
     if (cdi_state->count_buffer) {
         // Count buffer
         buffer_infos[1].buffer = cdi_state->count_buffer;
@@ -1788,15 +2161,9 @@ void GpuAssisted::AllocateValidationResources(const VkCommandBuffer cmd_buffer,
     VkDescriptorBufferInfo output_desc_buffer_info = {};
     output_desc_buffer_info.range = output_buffer_size;
 
-    // Allocate memory for the output block that the gpu will use to return any error information
+    // Suballocate memory for the output block that the gpu will use to return any error information
     GpuAssistedDeviceMemoryBlock output_block = {};
-    VkBufferCreateInfo buffer_info = LvlInitStruct<VkBufferCreateInfo>();
-    buffer_info.size = output_buffer_size;
-    buffer_info.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
-    VmaAllocationCreateInfo alloc_info = {};
-    alloc_info.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-    alloc_info.pool = output_buffer_pool;
-    result = vmaCreateBuffer(vmaAllocator, &buffer_info, &alloc_info, &output_block.buffer, &output_block.allocation, nullptr);
+    result = cb_node->buffer_allocator.Allocate(block_pool, output_buffer_size, output_block);
     if (result != VK_SUCCESS) {
         ReportSetupProblem(device, "Unable to allocate device memory.  Device could become unstable.", true);
         aborted = true;
@@ -1804,12 +2171,8 @@ void GpuAssisted::AllocateValidationResources(const VkCommandBuffer cmd_buffer,
     }
 
     // Clear the output block to zeros so that only error information from the gpu will be present
-    uint32_t *data_ptr;
-    result = vmaMapMemory(vmaAllocator, output_block.allocation, reinterpret_cast<void **>(&data_ptr));
-    if (result == VK_SUCCESS) {
-        memset(data_ptr, 0, output_buffer_size);
-        vmaUnmapMemory(vmaAllocator, output_block.allocation);
-    }
+    uint32_t *data_ptr = static_cast<uint32_t *>(output_block.data);
+    memset(data_ptr, 0, output_buffer_size);
 
     GpuAssistedDeviceMemoryBlock di_input_block = {}, bda_input_block = {};
     VkDescriptorBufferInfo di_input_desc_buffer_info = {};
@@ -1949,10 +2312,7 @@ void GpuAssisted::AllocateValidationResources(const VkCommandBuffer cmd_buffer,
             } else {
                 words_needed = 1 + number_of_sets + binding_count + descriptor_count;
             }
-            buffer_info.size = words_needed * 4;
-            alloc_info.pool = VK_NULL_HANDLE;
-            result = vmaCreateBuffer(vmaAllocator, &buffer_info, &alloc_info, &di_input_block.buffer, &di_input_block.allocation,
-                                     nullptr);
+            result = cb_node->buffer_allocator.Allocate(block_pool, words_needed * 4, di_input_block);
             if (result != VK_SUCCESS) {
                 ReportSetupProblem(device, "Unable to allocate device memory.  Device could become unstable.", true);
                 aborted = true;
@@ -1962,8 +2322,8 @@ void GpuAssisted::AllocateValidationResources(const VkCommandBuffer cmd_buffer,
             // Populate input buffer first with the sizes of every descriptor in every set, then with whether
             // each element of each descriptor has been written or not.  See gpu_validation.md for a more thourough
             // outline of the input buffer format
-            result = vmaMapMemory(vmaAllocator, di_input_block.allocation, reinterpret_cast<void **>(&data_ptr));
-            memset(data_ptr, 0, static_cast<size_t>(buffer_info.size));
+            data_ptr = static_cast<uint32_t *>(di_input_block.data);
+            memset(data_ptr, 0, static_cast<size_t>(di_input_block.size));
 
             // Descriptor indexing needs the number of descriptors at each binding.
             if (descriptor_indexing) {
@@ -2065,11 +2425,10 @@ void GpuAssisted::AllocateValidationResources(const VkCommandBuffer cmd_buffer,
                     }
                 }
             }
-            vmaUnmapMemory(vmaAllocator, di_input_block.allocation);
 
             di_input_desc_buffer_info.range = (words_needed * 4);
             di_input_desc_buffer_info.buffer = di_input_block.buffer;
-            di_input_desc_buffer_info.offset = 0;
+            di_input_desc_buffer_info.offset = di_input_block.offset;
 
             desc_writes[1] = LvlInitStruct<VkWriteDescriptorSet>();
             desc_writes[1].dstBinding = 1;
@@ -2100,20 +2459,16 @@ void GpuAssisted::AllocateValidationResources(const VkCommandBuffer cmd_buffer,
 
             uint32_t num_buffers = static_cast<uint32_t>(address_ranges.size());
             uint32_t words_needed = (num_buffers + 3) + (num_buffers + 2);
-            buffer_info.size = words_needed * 8;  // 64 bit words
-            alloc_info.pool = VK_NULL_HANDLE;
-            result = vmaCreateBuffer(vmaAllocator, &buffer_info, &alloc_info, &bda_input_block.buffer, &bda_input_block.allocation,
-                                     nullptr);
+            result = cb_node->buffer_allocator.Allocate(block_pool, words_needed * 8, bda_input_block);  // 64 bit words
             if (result != VK_SUCCESS) {
                 ReportSetupProblem(device, "Unable to allocate device memory.  Device could become unstable.", true);
                 aborted = true;
                 return;
             }
-            uint64_t *bda_data;
-            result = vmaMapMemory(vmaAllocator, bda_input_block.allocation, reinterpret_cast<void **>(&bda_data));
+            uint64_t *bda_data = static_cast<uint64_t *>(bda_input_block.data);
             uint32_t address_index = 1;
             uint32_t size_index = 3 + num_buffers;
-            memset(bda_data, 0, static_cast<size_t>(buffer_info.size));
+            memset(bda_data, 0, static_cast<size_t>(bda_input_block.size));
             bda_data[0] = size_index;       // Start of buffer sizes
             bda_data[address_index++] = 0;  // NULL address
             bda_data[size_index++] = 0;
@@ -2124,11 +2479,10 @@ void GpuAssisted::AllocateValidationResources(const VkCommandBuffer cmd_buffer,
             }
             bda_data[address_index] = UINTPTR_MAX;
             bda_data[size_index] = 0;
-            vmaUnmapMemory(vmaAllocator, bda_input_block.allocation);
 
             bda_input_desc_buffer_info.range = (words_needed * 8);
             bda_input_desc_buffer_info.buffer = bda_input_block.buffer;
-            bda_input_desc_buffer_info.offset = 0;
+            bda_input_desc_buffer_info.offset = bda_input_block.offset;
 
             desc_writes[desc_count] = LvlInitStruct<VkWriteDescriptorSet>();
             desc_writes[desc_count].dstBinding = 2;
@@ -2142,7 +2496,7 @@ void GpuAssisted::AllocateValidationResources(const VkCommandBuffer cmd_buffer,
 
     // Write the descriptor
     output_desc_buffer_info.buffer = output_block.buffer;
-    output_desc_buffer_info.offset = 0;
+    output_desc_buffer_info.offset = output_block.offset;
 
     desc_writes[0] = LvlInitStruct<VkWriteDescriptorSet>();
     desc_writes[0].descriptorCount = 1;
@@ -2169,12 +2523,6 @@ void GpuAssisted::AllocateValidationResources(const VkCommandBuffer cmd_buffer,
         ReportSetupProblem(device, "Unable to find pipeline state");
         aborted = true;
     }
-    if (aborted) {
-        vmaDestroyBuffer(vmaAllocator, di_input_block.buffer, di_input_block.allocation);
-        vmaDestroyBuffer(vmaAllocator, bda_input_block.buffer, bda_input_block.allocation);
-        vmaDestroyBuffer(vmaAllocator, output_block.buffer, output_block.allocation);
-        return;
-    }
 }
 
 std::shared_ptr<CMD_BUFFER_STATE> GpuAssisted::CreateCmdBufferState(VkCommandBuffer cb,
@@ -2191,6 +2539,7 @@ void gpuav_state::CommandBuffer::Reset() {
     CMD_BUFFER_STATE::Reset();
     auto gpuav = static_cast<GpuAssisted *>(dev_data);
     // Free the device memory and descriptor set(s) associated with a command buffer.
+    buffer_allocator.Reset(gpuav->block_pool);
     if (gpuav->aborted) {
         return;
     }
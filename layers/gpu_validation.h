@@ -22,14 +22,77 @@
 
 #include "gpu_utils.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
 class GpuAssisted;
 
+// A range of a GpuAssistedBlockPool block, which stays mapped for the lifetime of the block
 struct GpuAssistedDeviceMemoryBlock {
     VkBuffer buffer;
-    VmaAllocation allocation;
+    VkDeviceSize offset;
+    VkDeviceSize size;
+    void* data;
     layer_data::unordered_map<uint32_t, const cvdescriptorset::DescriptorBinding*> update_at_submit;
 };
 
+// Large host visible buffers from which the output and input buffers of instrumented commands are suballocated, so that
+// recording a command does not allocate device memory. A command buffer keeps its blocks until it is reset or freed, which only
+// happens once its submissions have completed and their results have been processed, and the blocks are then put on a free list
+// to be reused by any command buffer.
+class GpuAssistedBlockPool {
+  public:
+    struct Block {
+        VkBuffer buffer;
+        VmaAllocation allocation;
+        uint8_t* data;
+        VkDeviceSize size;
+    };
+    static constexpr VkDeviceSize kBlockSize = 1024 * 1024;
+    // Free blocks beyond this many are destroyed rather than kept
+    static constexpr size_t kMaxFreeBlocks = 32;
+
+    void Init(VmaAllocator allocator, VmaPool pool, VkDeviceSize alignment);
+    // Blocks of kBlockSize are taken from the free list when possible, larger blocks are always allocated
+    VkResult Acquire(VkDeviceSize min_size, Block& block);
+    void Release(std::vector<Block>& blocks);
+    // Destroys the free blocks. Blocks released afterwards are destroyed immediately.
+    void Destroy();
+    VkDeviceSize Alignment() const { return alignment_; }
+    void CountSuballocation() { suballocation_count_++; }
+    std::string GetStats() const;
+
+  private:
+    void DestroyBlock(const Block& block);
+
+    mutable std::mutex lock_;
+    VmaAllocator allocator_ = VK_NULL_HANDLE;
+    VmaPool pool_ = VK_NULL_HANDLE;
+    VkDeviceSize alignment_ = 1;
+    bool destroyed_ = false;
+    std::vector<Block> free_blocks_;
+    uint64_t block_allocation_count_ = 0;
+    uint64_t block_reuse_count_ = 0;
+    uint64_t live_block_count_ = 0;
+    std::atomic<uint64_t> suballocation_count_{0};
+};
+
+// Suballocates the memory used by one command buffer linearly from the blocks of a GpuAssistedBlockPool
+class GpuAssistedLinearAllocator {
+  public:
+    VkResult Allocate(GpuAssistedBlockPool& pool, VkDeviceSize size, GpuAssistedDeviceMemoryBlock& mem_block);
+    // Return every block to the pool. Memory allocated since the last reset must no longer be in use.
+    void Reset(GpuAssistedBlockPool& pool);
+
+  private:
+    std::vector<GpuAssistedBlockPool::Block> blocks_;
+    VkDeviceSize used_ = 0;  // Bytes allocated from blocks_.back()
+    // Blocks allocated for a single request larger than GpuAssistedBlockPool::kBlockSize / 4
+    std::vector<GpuAssistedBlockPool::Block> large_blocks_;
+};
+
 struct GpuAssistedPreDrawResources {
     VkDescriptorPool desc_pool = VK_NULL_HANDLE;
     VkDescriptorSet desc_set = VK_NULL_HANDLE;
@@ -117,11 +180,56 @@ struct GpuAssistedCmdDrawIndirectState {
     VkDeviceSize count_buffer_offset;
 };
 
+// Instrumented SPIR-V, keyed by a hash of the original module and of everything that affects how it is instrumented. Modules are
+// instrumented with kPlaceholderShaderId instead of their unique shader id, and the offsets of the words holding it are stored
+// with the binary, so that every module created from an entry is given its own id.
+class GpuAssistedShaderCache {
+  public:
+    static constexpr uint32_t kPlaceholderShaderId = 0x7c5e0a1d;
+    static constexpr uint32_t kFormatVersion = 1;
+
+    static uint64_t MakeKey(const VkShaderModuleCreateInfo* pCreateInfo, uint64_t options_key,
+                            const std::vector<uint32_t>& instrumentation_options);
+    // Returns the offsets of the literal words of all 32-bit integer constants in code that are equal to value
+    static std::vector<uint32_t> FindIntConstants(const uint32_t* code, size_t word_count, uint32_t value);
+
+    // On a hit, pgm is set to the instrumented binary with shader_id in place of the placeholder
+    bool Find(uint64_t key, uint32_t shader_id, std::vector<uint32_t>& pgm) const;
+    void Insert(uint64_t key, const std::vector<uint32_t>& pgm, std::vector<uint32_t> shader_id_offsets);
+
+    // Add the entries saved at path that are not already in the cache
+    bool Load(const std::string& path);
+    // Write the cache to path, if entries have been inserted since it was last loaded or saved. Entries saved by other processes
+    // in the meantime are kept.
+    bool Save(const std::string& path);
+
+  private:
+    struct Entry {
+        std::vector<uint32_t> pgm;
+        std::vector<uint32_t> shader_id_offsets;
+    };
+
+    mutable std::mutex lock_;
+    layer_data::unordered_map<uint64_t, Entry> entries_;
+    bool modified_ = false;
+};
+
+// A shader module whose instrumentation is deferred until it is used in a pipeline. It is queued for instrumentation on a
+// background thread when created, and instrumented on the pipeline creating thread if that is reached first.
+struct GpuAssistedDeferredShader {
+    enum State { kQueued, kInstrumenting, kDone };
+    State state = kQueued;
+    bool instrumented = false;
+    // The original SPIR-V, replaced by the instrumented SPIR-V once instrumented
+    std::vector<uint32_t> pgm;
+};
+
 namespace gpuav_state {
 class CommandBuffer : public gpu_utils_state::CommandBuffer {
   public:
     std::vector<GpuAssistedBufferInfo> gpuav_buffer_list;
     std::vector<GpuAssistedAccelerationStructureBuildValidationBufferInfo> as_validation_buffers;
+    GpuAssistedLinearAllocator buffer_allocator;
 
     CommandBuffer(GpuAssisted* ga, VkCommandBuffer cb, const VkCommandBufferAllocateInfo* pCreateInfo,
                   const COMMAND_POOL_STATE* pool);
@@ -147,6 +255,7 @@ class GpuAssisted : public GpuAssistedBase {
         desired_features.fragmentStoresAndAtomics = true;
         desired_features.shaderInt64 = true;
     }
+    ~GpuAssisted();
 
     bool CheckForDescriptorIndexing(DeviceFeatures enabled_features) const;
     void CreateDevice(const VkDeviceCreateInfo* pCreateInfo) override;
@@ -164,10 +273,12 @@ class GpuAssisted : public GpuAssistedBase {
                                                       VkBuffer scratch, VkDeviceSize scratchOffset) override;
     void ProcessAccelerationStructureBuildValidationBuffer(VkQueue queue, gpuav_state::CommandBuffer* cb_node);
     void PreCallRecordDestroyRenderPass(VkDevice device, VkRenderPass renderPass, const VkAllocationCallbacks *pAllocator) override;
-    bool InstrumentShader(const VkShaderModuleCreateInfo* pCreateInfo, std::vector<uint32_t>& new_pgm, uint32_t* unique_shader_id);
+    bool InstrumentShader(const VkShaderModuleCreateInfo* pCreateInfo, uint32_t shader_id, std::vector<uint32_t>& new_pgm);
     void PreCallRecordCreateShaderModule(VkDevice device, const VkShaderModuleCreateInfo* pCreateInfo,
                                          const VkAllocationCallbacks* pAllocator, VkShaderModule* pShaderModule,
                                          void* csm_state_data) override;
+    void PreCallRecordDestroyShaderModule(VkDevice device, VkShaderModule shaderModule,
+                                          const VkAllocationCallbacks* pAllocator) override;
     void AnalyzeAndGenerateMessages(VkCommandBuffer command_buffer, VkQueue queue, GpuAssistedBufferInfo &buffer_info,
         uint32_t operation_index, uint32_t* const debug_output_buffer);
 
@@ -274,9 +385,19 @@ class GpuAssisted : public GpuAssistedBase {
     void DestroyBuffer(GpuAssistedBufferInfo& buffer_info);
     void DestroyBuffer(GpuAssistedAccelerationStructureBuildValidationBufferInfo& buffer_info);
 
+    GpuAssistedBlockPool block_pool;
+
+  protected:
+    void AppendAllocationStats(std::string& stats) const override;
+    bool GetInstrumentedShader(const SHADER_MODULE_STATE& module_state, std::vector<uint32_t>& pgm) override;
+
   private:
     void PreRecordCommandBuffer(VkCommandBuffer command_buffer);
     VkPipeline GetValidationPipeline(VkRenderPass rp);
+    void InstrumentDeferredShader(uint32_t shader_id, std::shared_ptr<GpuAssistedDeferredShader> shader,
+                                  std::unique_lock<std::mutex>& guard);
+    void InstrumentationThread();
+    void StopInstrumentationThread();
 
     VkBool32 shaderInt64;
     bool buffer_oob_enabled;
@@ -286,4 +407,16 @@ class GpuAssisted : public GpuAssistedBase {
     GpuAssistedPreDrawValidationState pre_draw_validation_state;
 
     bool descriptor_indexing = false;
+
+    GpuAssistedShaderCache instrumented_shader_cache;
+    std::string instrumented_shader_cache_path;
+
+    // Shader modules that are instrumented when first used in a pipeline, rather than when created, indexed by shader id
+    bool deferred_instrumentation = false;
+    std::mutex deferred_shader_lock;
+    std::condition_variable deferred_shader_cv;
+    layer_data::unordered_map<uint32_t, std::shared_ptr<GpuAssistedDeferredShader>> deferred_shaders;
+    std::deque<uint32_t> instrumentation_queue;
+    std::thread instrumentation_thread;
+    bool instrumentation_thread_exit = false;
 };
@@ -327,6 +327,17 @@ static bool SetBool(std::string &config_string, std::string &env_string, bool de
     return result;
 }
 
+static uint32_t SetUint32(std::string &config_string, std::string &env_string, uint32_t default_val) {
+    uint32_t result = default_val;
+
+    const std::string &setting = env_string.empty() ? config_string : env_string;
+    if (!setting.empty()) {
+        int radix = ((setting.find("0x") == 0) ? 16 : 10);
+        result = static_cast<uint32_t>(std::strtoul(setting.c_str(), nullptr, radix));
+    }
+    return result;
+}
+
 // Process enables and disables set though the vk_layer_settings.txt config file or through an environment variable
 void ProcessConfigAndEnvSettings(ConfigAndEnvSettings *settings_data) {
     const auto layer_settings_ext = FindSettingsInChain(settings_data->pnext_chain);
@@ -382,12 +393,14 @@ void ProcessConfigAndEnvSettings(ConfigAndEnvSettings *settings_data) {
     std::string filter_msg_key(settings_data->layer_description);
     std::string message_limit(settings_data->layer_description);
     std::string fine_grained_locking(settings_data->layer_description);
+    std::string thread_safety_sampling(settings_data->layer_description);
     enable_key.append(".enables");
     disable_key.append(".disables");
     stypes_key.append(".custom_stype_list");
     filter_msg_key.append(".message_id_filter");
     message_limit.append(".duplicate_message_limit");
     fine_grained_locking.append(".fine_grained_locking");
+    thread_safety_sampling.append(".thread_safety_sampling");
     std::string list_of_config_enables = getLayerOption(enable_key.c_str());
     std::string list_of_env_enables = GetEnvironment("VK_LAYER_ENABLES");
     std::string list_of_config_disables = getLayerOption(disable_key.c_str());
@@ -400,6 +413,8 @@ void ProcessConfigAndEnvSettings(ConfigAndEnvSettings *settings_data) {
     std::string env_message_limit = GetEnvironment("VK_LAYER_DUPLICATE_MESSAGE_LIMIT");
     std::string config_fine_grained_locking = getLayerOption(fine_grained_locking.c_str());
     std::string env_fine_grained_locking = GetEnvironment("VK_LAYER_FINE_GRAINED_LOCKING");
+    std::string config_thread_safety_sampling = getLayerOption(thread_safety_sampling.c_str());
+    std::string env_thread_safety_sampling = GetEnvironment("VK_LAYER_THREAD_SAFETY_SAMPLING");
 
 #if defined(_WIN32)
     std::string env_delimiter = ";";
@@ -423,4 +438,7 @@ void ProcessConfigAndEnvSettings(ConfigAndEnvSettings *settings_data) {
         *settings_data->duplicate_message_limit = config_limit_setting;
     }
     *settings_data->fine_grained_locking = SetBool(config_fine_grained_locking, env_fine_grained_locking, true);
+    // Zero checks every object, as does one
+    *settings_data->thread_safety_sampling =
+        std::max(SetUint32(config_thread_safety_sampling, env_thread_safety_sampling, 1U), 1U);
 }
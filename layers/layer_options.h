@@ -34,6 +34,7 @@ typedef struct {
     std::vector<uint32_t> &message_filter_list;
     int32_t *duplicate_message_limit;
     bool *fine_grained_locking;
+    uint32_t *thread_safety_sampling;
 } ConfigAndEnvSettings;
 
 static const layer_data::unordered_map<std::string, VkValidationFeatureDisableEXT> VkValFeatureDisableLookup = {
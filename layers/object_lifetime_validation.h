@@ -52,10 +52,50 @@ struct ObjTrackState {
     VulkanObjectType object_type;                                  // Object type identifier
     ObjectStatusFlags status;                                      // Object state
     uint64_t parent_object;                                        // Parent object
-    std::unique_ptr<layer_data::unordered_set<uint64_t> > child_objects;  // Child objects (used for VkDescriptorPool only)
+    // Intrusive list of child objects (used for VkDescriptorPool only). pprev_sibling points at the link that points at this
+    // node, i.e. at the parent's first_child or at the previous sibling's next_sibling.
+    ObjTrackState *first_child;
+    ObjTrackState *next_sibling;
+    ObjTrackState **pprev_sibling;
 };
 
-typedef vl_concurrent_unordered_map<uint64_t, std::shared_ptr<ObjTrackState>, 6> object_map_type;
+// Slab storage for the ObjTrackState nodes of one object type. Freed nodes are recycled through a free list, so creating and
+// destroying objects at a steady rate does not allocate. Slabs are only released with the pool, so a node pointer obtained
+// from an object map remains dereferenceable even if another thread (incorrectly) destroys the object concurrently.
+class ObjTrackStatePool {
+  public:
+    ObjTrackState *Allocate() {
+        std::lock_guard<std::mutex> guard(lock_);
+        ObjTrackState *node = free_list_;
+        if (node) {
+            free_list_ = node->next_sibling;
+        } else {
+            if (slab_used_ == kSlabSize) {
+                slabs_.emplace_back(new ObjTrackState[kSlabSize]);
+                slab_used_ = 0;
+            }
+            node = &slabs_.back()[slab_used_++];
+        }
+        *node = ObjTrackState();
+        return node;
+    }
+
+    void Free(ObjTrackState *node) {
+        assert(node && !node->first_child && !node->pprev_sibling);
+        std::lock_guard<std::mutex> guard(lock_);
+        node->next_sibling = free_list_;
+        free_list_ = node;
+    }
+
+  private:
+    static constexpr size_t kSlabSize = 256;
+    std::mutex lock_;
+    std::vector<std::unique_ptr<ObjTrackState[]>> slabs_;
+    size_t slab_used_ = kSlabSize;
+    ObjTrackState *free_list_ = nullptr;  // Linked through next_sibling
+};
+
+typedef vl_concurrent_unordered_map<uint64_t, ObjTrackState *, 6> object_map_type;
 
 class ObjectLifetimes : public ValidationObject {
   public:
@@ -71,6 +111,8 @@ class ObjectLifetimes : public ValidationObject {
 
     std::atomic<uint64_t> num_objects[kVulkanObjectTypeMax + 1];
     std::atomic<uint64_t> num_total_objects;
+    // Per object type storage for the ObjTrackState nodes referenced by object_map and swapchainImageMap
+    ObjTrackStatePool object_pool[kVulkanObjectTypeMax + 1];
     // Vector of unordered_maps per object type to hold ObjTrackState info
     object_map_type object_map[kVulkanObjectTypeMax + 1];
     // Special-case map for swapchain images
@@ -90,10 +132,11 @@ class ObjectLifetimes : public ValidationObject {
     }
 
     template <typename T1>
-    void InsertObject(object_map_type &map, T1 object, VulkanObjectType object_type, std::shared_ptr<ObjTrackState> pNode) {
+    bool InsertObject(object_map_type &map, T1 object, VulkanObjectType object_type, ObjTrackState *pNode) {
         uint64_t object_handle = HandleToUint64(object);
         bool inserted = map.insert(object_handle, pNode);
         if (!inserted) {
+            object_pool[object_type].Free(pNode);
             // The object should not already exist. If we couldn't add it to the map, there was probably
             // a race condition in the app. Report an error and move on.
             (void)LogError(object, kVUID_ObjectTracker_Info,
@@ -102,7 +145,18 @@ class ObjectLifetimes : public ValidationObject {
                            "race condition in the application.",
                            object_string[object_type], object_handle);
         }
+        return inserted;
+    }
+
+    ObjTrackState *NewObjTrackState(VulkanObjectType object_type) {
+        auto node = object_pool[object_type].Allocate();
+        node->object_type = object_type;
+        return node;
     }
+    void LinkChildObject(ObjTrackState &parent, ObjTrackState &child);
+    void UnlinkChildObjects(ObjTrackState &parent);
+    void DestroyChildObjects(ObjTrackState &parent, VulkanObjectType child_type);
+    void FreeObjTrackState(ObjTrackState *node);
 
     bool ReportUndestroyedInstanceObjects(VkInstance instance, const std::string &error_code) const;
     bool ReportUndestroyedDeviceObjects(VkDevice device, const std::string &error_code) const;
@@ -199,17 +253,13 @@ class ObjectLifetimes : public ValidationObject {
         uint64_t object_handle = HandleToUint64(object);
         bool custom_allocator = (pAllocator != nullptr);
         if (!object_map[object_type].contains(object_handle)) {
-            auto pNewObjNode = std::make_shared<ObjTrackState>();
-            pNewObjNode->object_type = object_type;
+            auto pNewObjNode = NewObjTrackState(object_type);
             pNewObjNode->status = custom_allocator ? OBJSTATUS_CUSTOM_ALLOCATOR : OBJSTATUS_NONE;
             pNewObjNode->handle = object_handle;
 
-            InsertObject(object_map[object_type], object, object_type, pNewObjNode);
-            num_objects[object_type]++;
-            num_total_objects++;
-
-            if (object_type == kVulkanObjectTypeDescriptorPool) {
-                pNewObjNode->child_objects.reset(new layer_data::unordered_set<uint64_t>);
+            if (InsertObject(object_map[object_type], object, object_type, pNewObjNode)) {
+                num_objects[object_type]++;
+                num_total_objects++;
             }
         }
     }
@@ -234,6 +284,8 @@ class ObjectLifetimes : public ValidationObject {
         assert(num_objects[item->second->object_type] > 0);
 
         num_objects[item->second->object_type]--;
+
+        FreeObjTrackState(item->second);
     }
 
     template <typename T1>
@@ -35,17 +35,61 @@ VulkanTypedHandle ObjTrackStateTypedHandle(const ObjTrackState &track_state) {
     return typed_handle;
 }
 
+void ObjectLifetimes::LinkChildObject(ObjTrackState &parent, ObjTrackState &child) {
+    assert(!child.pprev_sibling);
+    child.next_sibling = parent.first_child;
+    if (child.next_sibling) {
+        child.next_sibling->pprev_sibling = &child.next_sibling;
+    }
+    child.pprev_sibling = &parent.first_child;
+    parent.first_child = &child;
+}
+
+// Detach all children from parent without destroying them
+void ObjectLifetimes::UnlinkChildObjects(ObjTrackState &parent) {
+    ObjTrackState *child = parent.first_child;
+    parent.first_child = nullptr;
+    while (child) {
+        ObjTrackState *next = child->next_sibling;
+        child->next_sibling = nullptr;
+        child->pprev_sibling = nullptr;
+        child = next;
+    }
+}
+
+// Destroy all children of parent, walking its intrusive child list
+void ObjectLifetimes::DestroyChildObjects(ObjTrackState &parent, VulkanObjectType child_type) {
+    ObjTrackState *child = parent.first_child;
+    parent.first_child = nullptr;
+    while (child) {
+        ObjTrackState *next = child->next_sibling;
+        child->next_sibling = nullptr;
+        child->pprev_sibling = nullptr;
+        DestroyObjectSilently(child->handle, child_type);
+        child = next;
+    }
+}
+
+// Return a node that has been removed from its object map to its pool
+void ObjectLifetimes::FreeObjTrackState(ObjTrackState *node) {
+    if (node->pprev_sibling) {
+        *node->pprev_sibling = node->next_sibling;
+        if (node->next_sibling) {
+            node->next_sibling->pprev_sibling = node->pprev_sibling;
+        }
+        node->next_sibling = nullptr;
+        node->pprev_sibling = nullptr;
+    }
+    UnlinkChildObjects(*node);
+    object_pool[node->object_type].Free(node);
+}
+
 // Destroy memRef lists and free all memory
 void ObjectLifetimes::DestroyQueueDataStructures() {
     // Destroy the items in the queue map
     auto snapshot = object_map[kVulkanObjectTypeQueue].snapshot();
     for (const auto &queue : snapshot) {
-        uint32_t obj_index = queue.second->object_type;
-        assert(num_total_objects > 0);
-        num_total_objects--;
-        assert(num_objects[obj_index] > 0);
-        num_objects[obj_index]--;
-        object_map[kVulkanObjectTypeQueue].erase(queue.first);
+        DestroyObjectSilently(queue.first, kVulkanObjectTypeQueue);
     }
 }
 
@@ -85,8 +129,7 @@ bool ObjectLifetimes::ValidateAnonymousObject(uint64_t object, VkObjectType core
 
 void ObjectLifetimes::AllocateCommandBuffer(const VkCommandPool command_pool, const VkCommandBuffer command_buffer,
                                             VkCommandBufferLevel level) {
-    auto new_obj_node = std::make_shared<ObjTrackState>();
-    new_obj_node->object_type = kVulkanObjectTypeCommandBuffer;
+    auto new_obj_node = NewObjTrackState(kVulkanObjectTypeCommandBuffer);
     new_obj_node->handle = HandleToUint64(command_buffer);
     new_obj_node->parent_object = HandleToUint64(command_pool);
     if (level == VK_COMMAND_BUFFER_LEVEL_SECONDARY) {
@@ -94,9 +137,10 @@ void ObjectLifetimes::AllocateCommandBuffer(const VkCommandPool command_pool, co
     } else {
         new_obj_node->status = OBJSTATUS_NONE;
     }
-    InsertObject(object_map[kVulkanObjectTypeCommandBuffer], command_buffer, kVulkanObjectTypeCommandBuffer, new_obj_node);
-    num_objects[kVulkanObjectTypeCommandBuffer]++;
-    num_total_objects++;
+    if (InsertObject(object_map[kVulkanObjectTypeCommandBuffer], command_buffer, kVulkanObjectTypeCommandBuffer, new_obj_node)) {
+        num_objects[kVulkanObjectTypeCommandBuffer]++;
+        num_total_objects++;
+    }
 }
 
 bool ObjectLifetimes::ValidateCommandBuffer(VkCommandPool command_pool, VkCommandBuffer command_buffer) const {
@@ -125,18 +169,19 @@ bool ObjectLifetimes::ValidateCommandBuffer(VkCommandPool command_pool, VkComman
 }
 
 void ObjectLifetimes::AllocateDescriptorSet(VkDescriptorPool descriptor_pool, VkDescriptorSet descriptor_set) {
-    auto new_obj_node = std::make_shared<ObjTrackState>();
-    new_obj_node->object_type = kVulkanObjectTypeDescriptorSet;
+    auto new_obj_node = NewObjTrackState(kVulkanObjectTypeDescriptorSet);
     new_obj_node->status = OBJSTATUS_NONE;
     new_obj_node->handle = HandleToUint64(descriptor_set);
     new_obj_node->parent_object = HandleToUint64(descriptor_pool);
-    InsertObject(object_map[kVulkanObjectTypeDescriptorSet], descriptor_set, kVulkanObjectTypeDescriptorSet, new_obj_node);
+    if (!InsertObject(object_map[kVulkanObjectTypeDescriptorSet], descriptor_set, kVulkanObjectTypeDescriptorSet, new_obj_node)) {
+        return;
+    }
     num_objects[kVulkanObjectTypeDescriptorSet]++;
     num_total_objects++;
 
     auto itr = object_map[kVulkanObjectTypeDescriptorPool].find(HandleToUint64(descriptor_pool));
     if (itr != object_map[kVulkanObjectTypeDescriptorPool].end()) {
-        itr->second->child_objects->insert(HandleToUint64(descriptor_set));
+        LinkChildObject(*itr->second, *new_obj_node);
     }
 }
 
@@ -240,11 +285,13 @@ bool ObjectLifetimes::PreCallValidateCmdPushDescriptorSetKHR(VkCommandBuffer com
 }
 
 void ObjectLifetimes::CreateQueue(VkQueue vkObj) {
-    std::shared_ptr<ObjTrackState> p_obj_node = NULL;
+    ObjTrackState *p_obj_node = nullptr;
     auto queue_item = object_map[kVulkanObjectTypeQueue].find(HandleToUint64(vkObj));
     if (queue_item == object_map[kVulkanObjectTypeQueue].end()) {
-        p_obj_node = std::make_shared<ObjTrackState>();
-        InsertObject(object_map[kVulkanObjectTypeQueue], vkObj, kVulkanObjectTypeQueue, p_obj_node);
+        p_obj_node = NewObjTrackState(kVulkanObjectTypeQueue);
+        if (!InsertObject(object_map[kVulkanObjectTypeQueue], vkObj, kVulkanObjectTypeQueue, p_obj_node)) {
+            return;
+        }
         num_objects[kVulkanObjectTypeQueue]++;
         num_total_objects++;
     } else {
@@ -257,8 +304,7 @@ void ObjectLifetimes::CreateQueue(VkQueue vkObj) {
 
 void ObjectLifetimes::CreateSwapchainImageObject(VkImage swapchain_image, VkSwapchainKHR swapchain) {
     if (!swapchainImageMap.contains(HandleToUint64(swapchain_image))) {
-        auto new_obj_node = std::make_shared<ObjTrackState>();
-        new_obj_node->object_type = kVulkanObjectTypeImage;
+        auto new_obj_node = NewObjTrackState(kVulkanObjectTypeImage);
         new_obj_node->status = OBJSTATUS_NONE;
         new_obj_node->handle = HandleToUint64(swapchain_image);
         new_obj_node->parent_object = HandleToUint64(swapchain);
@@ -457,10 +503,9 @@ bool ObjectLifetimes::PreCallValidateResetDescriptorPool(VkDevice device, VkDesc
 
     auto itr = object_map[kVulkanObjectTypeDescriptorPool].find(HandleToUint64(descriptorPool));
     if (itr != object_map[kVulkanObjectTypeDescriptorPool].end()) {
-        auto pool_node = itr->second;
-        for (auto set : *pool_node->child_objects) {
-            skip |= ValidateDestroyObject((VkDescriptorSet)set, kVulkanObjectTypeDescriptorSet, nullptr, kVUIDUndefined,
-                                          kVUIDUndefined);
+        for (auto set = itr->second->first_child; set; set = set->next_sibling) {
+            skip |= ValidateDestroyObject(CastFromUint64<VkDescriptorSet>(set->handle), kVulkanObjectTypeDescriptorSet, nullptr,
+                                          kVUIDUndefined, kVUIDUndefined);
         }
     }
     return skip;
@@ -473,11 +518,7 @@ void ObjectLifetimes::PreCallRecordResetDescriptorPool(VkDevice device, VkDescri
     // our descriptorSet map.
     auto itr = object_map[kVulkanObjectTypeDescriptorPool].find(HandleToUint64(descriptorPool));
     if (itr != object_map[kVulkanObjectTypeDescriptorPool].end()) {
-        auto pool_node = itr->second;
-        for (auto set : *pool_node->child_objects) {
-            RecordDestroyObject((VkDescriptorSet)set, kVulkanObjectTypeDescriptorSet);
-        }
-        pool_node->child_objects->clear();
+        DestroyChildObjects(*itr->second, kVulkanObjectTypeDescriptorSet);
     }
 }
 
@@ -712,9 +753,12 @@ void ObjectLifetimes::PreCallRecordDestroySwapchainKHR(VkDevice device, VkSwapch
     RecordDestroyObject(swapchain, kVulkanObjectTypeSwapchainKHR);
 
     auto snapshot = swapchainImageMap.snapshot(
-        [swapchain](std::shared_ptr<ObjTrackState> pNode) { return pNode->parent_object == HandleToUint64(swapchain); });
+        [swapchain](ObjTrackState *pNode) { return pNode->parent_object == HandleToUint64(swapchain); });
     for (const auto &itr : snapshot) {
-        swapchainImageMap.erase(itr.first);
+        auto item = swapchainImageMap.pop(itr.first);
+        if (item != swapchainImageMap.end()) {
+            FreeObjTrackState(item->second);
+        }
     }
 }
 
@@ -737,16 +781,9 @@ bool ObjectLifetimes::PreCallValidateFreeDescriptorSets(VkDevice device, VkDescr
 void ObjectLifetimes::PreCallRecordFreeDescriptorSets(VkDevice device, VkDescriptorPool descriptorPool, uint32_t descriptorSetCount,
                                                       const VkDescriptorSet *pDescriptorSets) {
     auto lock = WriteSharedLock();
-    std::shared_ptr<ObjTrackState> pool_node = nullptr;
-    auto itr = object_map[kVulkanObjectTypeDescriptorPool].find(HandleToUint64(descriptorPool));
-    if (itr != object_map[kVulkanObjectTypeDescriptorPool].end()) {
-        pool_node = itr->second;
-    }
+    // Destroying a descriptor set also unlinks it from its pool's child list
     for (uint32_t i = 0; i < descriptorSetCount; i++) {
         RecordDestroyObject(pDescriptorSets[i], kVulkanObjectTypeDescriptorSet);
-        if (pool_node) {
-            pool_node->child_objects->erase(HandleToUint64(pDescriptorSets[i]));
-        }
     }
 }
 
@@ -761,10 +798,9 @@ bool ObjectLifetimes::PreCallValidateDestroyDescriptorPool(VkDevice device, VkDe
 
     auto itr = object_map[kVulkanObjectTypeDescriptorPool].find(HandleToUint64(descriptorPool));
     if (itr != object_map[kVulkanObjectTypeDescriptorPool].end()) {
-        auto pool_node = itr->second;
-        for (auto set : *pool_node->child_objects) {
-            skip |= ValidateDestroyObject((VkDescriptorSet)set, kVulkanObjectTypeDescriptorSet, nullptr, kVUIDUndefined,
-                                          kVUIDUndefined);
+        for (auto set = itr->second->first_child; set; set = set->next_sibling) {
+            skip |= ValidateDestroyObject(CastFromUint64<VkDescriptorSet>(set->handle), kVulkanObjectTypeDescriptorSet, nullptr,
+                                          kVUIDUndefined, kVUIDUndefined);
         }
     }
     skip |= ValidateDestroyObject(descriptorPool, kVulkanObjectTypeDescriptorPool, pAllocator,
@@ -777,11 +813,7 @@ void ObjectLifetimes::PreCallRecordDestroyDescriptorPool(VkDevice device, VkDesc
     auto lock = WriteSharedLock();
     auto itr = object_map[kVulkanObjectTypeDescriptorPool].find(HandleToUint64(descriptorPool));
     if (itr != object_map[kVulkanObjectTypeDescriptorPool].end()) {
-        auto pool_node = itr->second;
-        for (auto set : *pool_node->child_objects) {
-            RecordDestroyObject((VkDescriptorSet)set, kVulkanObjectTypeDescriptorSet);
-        }
-        pool_node->child_objects->clear();
+        DestroyChildObjects(*itr->second, kVulkanObjectTypeDescriptorSet);
     }
     RecordDestroyObject(descriptorPool, kVulkanObjectTypeDescriptorPool);
 }
@@ -794,7 +826,7 @@ bool ObjectLifetimes::PreCallValidateDestroyCommandPool(VkDevice device, VkComma
                            "VUID-vkDestroyCommandPool-commandPool-parent");
 
     auto snapshot = object_map[kVulkanObjectTypeCommandBuffer].snapshot(
-        [commandPool](std::shared_ptr<ObjTrackState> pNode) { return pNode->parent_object == HandleToUint64(commandPool); });
+        [commandPool](ObjTrackState *pNode) { return pNode->parent_object == HandleToUint64(commandPool); });
     for (const auto &itr : snapshot) {
         auto node = itr.second;
         skip |= ValidateCommandBuffer(commandPool, reinterpret_cast<VkCommandBuffer>(itr.first));
@@ -809,7 +841,7 @@ bool ObjectLifetimes::PreCallValidateDestroyCommandPool(VkDevice device, VkComma
 void ObjectLifetimes::PreCallRecordDestroyCommandPool(VkDevice device, VkCommandPool commandPool,
                                                       const VkAllocationCallbacks *pAllocator) {
     auto snapshot = object_map[kVulkanObjectTypeCommandBuffer].snapshot(
-        [commandPool](std::shared_ptr<ObjTrackState> pNode) { return pNode->parent_object == HandleToUint64(commandPool); });
+        [commandPool](ObjTrackState *pNode) { return pNode->parent_object == HandleToUint64(commandPool); });
     // A CommandPool's cmd buffers are implicitly deleted when pool is deleted. Remove this pool's cmdBuffers from cmd buffer map.
     for (const auto &itr : snapshot) {
         RecordDestroyObject(reinterpret_cast<VkCommandBuffer>(itr.first), kVulkanObjectTypeCommandBuffer);
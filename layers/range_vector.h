@@ -24,10 +24,15 @@
 #define RANGE_VECTOR_H_
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <type_traits>
 #include <utility>
+#include <vector>
 #include <cstdint>
 #include "vk_layer_data.h"
 
@@ -169,6 +174,62 @@ struct split_op_keep_upper {
 
 enum class value_precedence { prefer_source, prefer_dest };
 
+// The key of the entry an iterator references. Uses the iterator's key() when available, s.t. maps with copy on write entries
+// (flat_range_map) can be searched and walked through non-const iterators without copying the entries visited.
+template <typename Iterator>
+auto iterator_key_impl(const Iterator &it, int) -> decltype(it.key()) {
+    return it.key();
+}
+template <typename Iterator>
+auto iterator_key_impl(const Iterator &it, long) -> decltype((it->first)) {
+    return it->first;
+}
+template <typename Iterator>
+auto iterator_key(const Iterator &it) -> decltype(iterator_key_impl(it, 0)) {
+    return iterator_key_impl(it, 0);
+}
+
+// The entry an iterator references, for reading only. Uses the iterator's value() when available, for the same reason.
+template <typename Iterator>
+auto iterator_value_impl(const Iterator &it, int) -> decltype(it.value()) {
+    return it.value();
+}
+template <typename Iterator>
+auto iterator_value_impl(const Iterator &it, long) -> decltype((*it)) {
+    return *it;
+}
+template <typename Iterator>
+auto iterator_value(const Iterator &it) -> decltype(iterator_value_impl(it, 0)) {
+    return iterator_value_impl(it, 0);
+}
+
+// Replace the contents of "to" with "from", sharing the entries if the map supports it
+template <typename Map>
+auto share_map_impl(Map &to, const Map &from, int) -> decltype(to.share(from)) {
+    return to.share(from);
+}
+template <typename Map>
+void share_map_impl(Map &to, const Map &from, long) {
+    to = from;
+}
+
+template <typename Key, typename T, typename RangeKey>
+class flat_range_map;
+
+// Erase [first, last) from the ImplMap, one entry at a time unless the ImplMap can do better
+template <typename ImplMap, typename Iterator>
+Iterator impl_map_erase(ImplMap &map, Iterator first, const Iterator &last) {
+    while (first != last) {
+        first = map.erase(first);
+    }
+    return first;
+}
+// The flat map closes the gap left by the entries with a single move
+template <typename Key, typename T, typename RangeKey, typename Iterator>
+Iterator impl_map_erase(flat_range_map<Key, T, RangeKey> &map, Iterator first, const Iterator &last) {
+    return map.erase(first, last);
+}
+
 // The range based sparse map implemented on the ImplMap
 template <typename Key, typename T, typename RangeKey = range<Key>, typename ImplMap = std::map<RangeKey, T>>
 class range_map {
@@ -204,7 +265,7 @@ class range_map {
                 auto prev = lower;
                 --prev;
                 // If the previous entry includes begin (and we know key.begin > prev.begin) then prev is actually lower
-                if (key.begin < prev->first.end) {
+                if (key.begin < iterator_key(prev).end) {
                     lower = prev;
                 }
             }
@@ -229,7 +290,7 @@ class range_map {
                 auto prev = upper;
                 --prev;
                 // We know key.end  is >= prev.begin, the only question is whether it's ==
-                if (prev->first.begin == key.end) {
+                if (iterator_key(prev).begin == key.end) {
                     upper = prev;
                 }
             }
@@ -275,11 +336,42 @@ class range_map {
     }
 
     template <typename SplitOp>
-    ImplIterator split_impl(const ImplIterator &split_it, const index_type &index, const SplitOp &) {
+    ImplIterator split_impl(const ImplIterator &split_it, const index_type &index, const SplitOp &split_op) {
+        return split_impl(split_it, index, split_op, 0);
+    }
+
+    // ImplMaps able to rekey an entry in place split it without erasing and reinserting it, and so without moving the others
+    template <typename SplitOp, typename Map = ImplMap>
+    auto split_impl(const ImplIterator &split_it, const index_type &index, const SplitOp &, int)
+        -> decltype(std::declval<Map &>().rekey(split_it, std::declval<const key_type &>())) {
+        if (!iterator_key(split_it).includes(index)) return split_it;
+
+        const auto range = iterator_key(split_it);
+        const key_type lower_range(range.begin, index);
+        const key_type upper_range(index, range.end);
+        if (lower_range.empty()) {
+            return SplitOp::keep_upper() ? split_it : impl_map_.erase(split_it);
+        }
+        if (!SplitOp::keep_lower()) {
+            return impl_map_.rekey(split_it, upper_range);
+        }
+        auto lower_it = impl_map_.rekey(split_it, lower_range);
+        if (SplitOp::keep_upper()) {
+            auto next_it = lower_it;
+            ++next_it;
+            RANGE_ASSERT(impl_map_.find(upper_range) == impl_map_.end());
+            impl_map_.emplace_hint(next_it, std::make_pair(upper_range, iterator_value(lower_it).second));
+        }
+        return lower_it;
+    }
+
+    template <typename SplitOp>
+    ImplIterator split_impl(const ImplIterator &split_it, const index_type &index, const SplitOp &, long) {
         // Make sure contains the split point
-        if (!split_it->first.includes(index)) return split_it;  // If we don't have a valid split point, just return the iterator
+        // If we don't have a valid split point, just return the iterator
+        if (!iterator_key(split_it).includes(index)) return split_it;
 
-        const auto range = split_it->first;
+        const auto range = iterator_key(split_it);
         key_type lower_range(range.begin, index);
         if (lower_range.empty() && SplitOp::keep_upper()) {
             return split_it;  // this is a noop we're keeping the upper half which is the same as split_it;
@@ -334,7 +426,7 @@ class range_map {
         RANGE_ASSERT(lower == lower_bound_impl(bounds));
 
         // Trim/infil the beginning if needed
-        const auto first_begin = pos->first.begin;
+        const auto first_begin = iterator_key(pos).begin;
         if (bounds.begin > first_begin && split_bounds) {
             pos = split_impl(pos, bounds.begin, split_op_keep_both());
             lower = pos;
@@ -348,8 +440,8 @@ class range_map {
 
         // in the trim case pos starts one before lower_bound, but that allows trimming a single entry range in loop.
         // NOTE that the loop is trimming and infilling at pos + 1
-        while (!at_impl_end(pos) && pos->first.begin < bounds.end) {
-            auto last_end = pos->first.end;
+        while (!at_impl_end(pos) && iterator_key(pos).begin < bounds.end) {
+            auto last_end = iterator_key(pos).end;
             // check for in-fill
             ++pos;
             if (at_impl_end(pos)) {
@@ -359,18 +451,18 @@ class range_map {
                     ++pos;  // advances to impl_end, as we're at upper boundary
                     RANGE_ASSERT(at_impl_end(pos));
                 }
-            } else if (pos->first.begin != last_end) {
+            } else if (iterator_key(pos).begin != last_end) {
                 // we have a gap between last entry and current... fill, but not beyond bounds
-                if (bounds.includes(pos->first.begin)) {
-                    pos = impl_insert(pos, last_end, pos->first.begin, value);
+                if (bounds.includes(iterator_key(pos).begin)) {
+                    pos = impl_insert(pos, last_end, iterator_key(pos).begin, value);
                     //  don't further advance pos, because we may need to split the next entry and thus can't skip it.
                 } else if (last_end < bounds.end) {
                     // Non-zero length final gap in-bounds
                     pos = impl_insert(pos, last_end, bounds.end, value);
                     ++pos;  // advances back to the out of bounds entry which we inserted just before
-                    RANGE_ASSERT(!bounds.includes(pos->first.begin));
+                    RANGE_ASSERT(!bounds.includes(iterator_key(pos).begin));
                 }
-            } else if (pos->first.includes(bounds.end)) {
+            } else if (iterator_key(pos).includes(bounds.end)) {
                 if (split_bounds) {
                     // extends past the end of the bounds range, snip to only include the bounded section
                     // NOTE: this splits pos, but the upper half of the split should now be considered upper_bound
@@ -379,7 +471,7 @@ class range_map {
                 }
                 // advance to the upper haf of the split which will be upper_bound  or to next which will both be out of bounds
                 ++pos;
-                RANGE_ASSERT(!bounds.includes(pos->first.begin));
+                RANGE_ASSERT(!bounds.includes(iterator_key(pos).begin));
             }
         }
         // Return the current position which should be the upper_bound for bounds
@@ -394,10 +486,10 @@ class range_map {
 
         // Trim/infil the beginning if needed
         auto current = lower;
-        const auto first_begin = current->first.begin;
+        const auto first_begin = iterator_key(current).begin;
         if (bounds.begin > first_begin) {
             // Preserve the portion of lower bound excluded from bounds
-            if (current->first.end <= bounds.end) {
+            if (iterator_key(current).end <= bounds.end) {
                 // If current ends within the erased bound we can discard the the upper portion of current
                 current = split_impl(current, bounds.begin, split_op_keep_lower());
             } else {
@@ -409,12 +501,14 @@ class range_map {
             RANGE_ASSERT(current == lower_bound_impl(bounds));
         }
 
-        // Loop over completely contained entries and erase them
-        while (!at_impl_end(current) && (current->first.end <= bounds.end)) {
-            current = impl_erase(current);
+        // Erase the completely contained entries together, s.t. ImplMaps storing their entries contiguously close the gap once
+        auto contained_end = current;
+        while (!at_impl_end(contained_end) && (iterator_key(contained_end).end <= bounds.end)) {
+            ++contained_end;
         }
+        current = impl_map_erase(impl_map_, current, contained_end);
 
-        if (!at_impl_end(current) && current->first.includes(bounds.end)) {
+        if (!at_impl_end(current) && iterator_key(current).includes(bounds.end)) {
             // last entry extends past the end of the bounds range, snip to only erase the bounded section
             current = split_impl(current, bounds.end, split_op_keep_upper());
         }
@@ -450,6 +544,8 @@ class range_map {
 
         ValueType &operator*() const { return *pos_; }
         ValueType *operator->() const { return &*pos_; }
+        const key_type &key() const { return iterator_key(pos_); }
+        const ValueType &value() const { return iterator_value(pos_); }
 
         iterator_impl &operator++() {
             ++pos_;
@@ -495,19 +591,19 @@ class range_map {
     template <typename That, typename Iterator>
     static bool is_contiguous_impl(That *const that, const key_type &range, const Iterator &lower) {
         // Search range or intersection is empty
-        if (lower == that->impl_end() || lower->first.excludes(range)) return false;
+        if (lower == that->impl_end() || iterator_key(lower).excludes(range)) return false;
 
-        if (lower->first.includes(range)) {
+        if (iterator_key(lower).includes(range)) {
             return true;  // there is one entry that contains the whole key range
         }
 
         bool contiguous = true;
-        for (auto pos = lower; contiguous && pos != that->impl_end() && range.includes(pos->first.begin); ++pos) {
+        for (auto pos = lower; contiguous && pos != that->impl_end() && range.includes(iterator_key(pos).begin); ++pos) {
             // if current doesn't cover the rest of the key range, check to see that the next is extant and abuts
-            if (pos->first.end < range.end) {
+            if (iterator_key(pos).end < range.end) {
                 auto next = pos;
                 ++next;
-                contiguous = (next != that->impl_end()) && pos->first.is_prior_to(next->first);
+                contiguous = (next != that->impl_end()) && iterator_key(pos).is_prior_to(iterator_key(next));
             }
         }
         return contiguous;
@@ -526,22 +622,14 @@ class range_map {
         return iterator(impl_erase(pos.pos_));
     }
 
-    iterator erase(range<iterator> bounds) {
-        auto current = bounds.begin.pos_;
-        while (current != bounds.end.pos_) {
-            RANGE_ASSERT(!at_impl_end(current));
-            current = impl_map_.erase(current);
-        }
-        RANGE_ASSERT(current == bounds.end.pos_);
-        return current;
-    }
+    iterator erase(range<iterator> bounds) { return iterator(impl_map_erase(impl_map_, bounds.begin.pos_, bounds.end.pos_)); }
 
     iterator erase(iterator first, iterator last) { return erase(range<iterator>(first, last)); }
 
     iterator erase_range(const key_type &bounds) {
         auto lower = lower_bound_impl(bounds);
 
-        if (at_impl_end(lower) || !bounds.intersects(lower->first)) {
+        if (at_impl_end(lower) || !bounds.intersects(iterator_key(lower))) {
             // There is nothing in this range lower bound is above bound
             return iterator(lower);
         }
@@ -557,7 +645,7 @@ class range_map {
 
     iterator find(const index_type &index) {
         auto lower = lower_bound(range<index_type>(index, index + 1));
-        if (!at_end(lower) && lower->first.includes(index)) {
+        if (!at_end(lower) && iterator_key(lower).includes(index)) {
             return lower;
         }
         return end();
@@ -565,7 +653,7 @@ class range_map {
 
     const_iterator find(const index_type &index) const {
         auto lower = lower_bound(key_type(index, index + 1));
-        if (!at_end(lower) && lower->first.includes(index)) {
+        if (!at_end(lower) && iterator_key(lower).includes(index)) {
             return lower;
         }
         return end();
@@ -596,7 +684,7 @@ class range_map {
         // Look for range conflicts (and an insertion point, which makes the lower_bound *not* wasted work)
         // we don't have to check upper if just check that lower doesn't intersect (which it would if lower != upper)
         auto lower = lower_bound_impl(key);
-        if (at_impl_end(lower) || !lower->first.intersects(key)) {
+        if (at_impl_end(lower) || !iterator_key(lower).intersects(key)) {
             // range is not even paritally overlapped, and lower is strictly > than key
             auto impl_insert = impl_map_.emplace_hint(lower, value);
             // auto impl_insert = impl_map_.emplace(value);
@@ -613,15 +701,15 @@ class range_map {
         if (impl_map_.empty()) {
             hint_open = true;
         } else if (impl_next == impl_map_.cbegin()) {
-            hint_open = value.first.strictly_less(impl_next->first);
+            hint_open = value.first.strictly_less(iterator_key(impl_next));
         } else if (impl_next == impl_map_.cend()) {
             auto impl_prev = impl_next;
             --impl_prev;
-            hint_open = value.first.strictly_greater(impl_prev->first);
+            hint_open = value.first.strictly_greater(iterator_key(impl_prev));
         } else {
             auto impl_prev = impl_next;
             --impl_prev;
-            hint_open = value.first.strictly_greater(impl_prev->first) && value.first.strictly_less(impl_next->first);
+            hint_open = value.first.strictly_greater(iterator_key(impl_prev)) && value.first.strictly_less(iterator_key(impl_next));
         }
 
         if (!hint_open) {
@@ -665,6 +753,9 @@ class range_map {
     bool empty() const { return impl_map_.empty(); }
     size_type size() const { return impl_map_.size(); }
 
+    // Replace the contents with those of from. If ImplMap supports it, the entries are shared and only copied when written.
+    void share(const range_map &from) { share_map_impl(impl_map_, from.impl_map_, 0); }
+
     // For configuration/debug use // Use with caution...
     ImplMap &get_implementation_map() { return impl_map_; }
     const ImplMap &get_implementation_map() const { return impl_map_; }
@@ -1352,6 +1443,367 @@ class small_range_map {
     std::array<bool, N> in_use_;
 };
 
+// A sorted, contiguous array based ordered map for range keys for use as the range map "ImplMap" as an alternate to std::map
+//
+// Lookups are a binary search over a packed array of (key, node) slots instead of a walk down the nodes of a tree, and in-order
+// traversal is a linear walk of that same array. The values themselves live in nodes which are never moved once constructed, so
+// insert and erase only shift the (small) slots.
+//
+// Iterators identify an entry by its key, caching the slot index and re-resolving it (by key) only when an insert or erase has
+// shifted it. They remain valid until that entry is erased, matching the std::map guarantees range_map and
+// cached_lower_bound_impl rely on.
+//
+// A map can share() the contents of another, copying only the slots. The nodes are reference counted and copied on write:
+// dereferencing a non-const iterator gives the map its own copy of a shared node, while key(), value() and const access never
+// do. Nodes are allocated from a reference counted pool, which a map adopts from the map it shares from, s.t. every node a map
+// holds comes from the pool it holds.
+template <typename Key, typename T, typename RangeKey = range<Key>>
+class flat_range_map {
+  public:
+    using mapped_type = T;
+    using key_type = RangeKey;
+    using value_type = std::pair<const key_type, mapped_type>;
+    using index_type = typename key_type::index_type;
+    using size_type = size_t;
+
+  private:
+    struct Node {
+        value_type value;
+        std::atomic<uint32_t> refs;  // number of maps holding the node
+        template <typename Value>
+        Node(Value &&value_) : value(std::forward<Value>(value_)), refs(1) {}
+    };
+    struct Slot {
+        key_type key;
+        Node *node;
+    };
+
+  public:
+    template <typename Map_, typename Value_>
+    struct IteratorImpl {
+      public:
+        using Map = Map_;
+        using Value = Value_;
+        friend flat_range_map;
+        Value *operator->() const { return &map_->value_at(resolve_slot()); }
+        Value &operator*() const { return map_->value_at(resolve_slot()); }
+        // The key and entry for reading, never causing a shared entry to be copied
+        const key_type &key() const { return key_; }
+        const Value &value() const { return static_cast<const Map *>(map_)->value_at(resolve_slot()); }
+        IteratorImpl &operator++() {
+            set_slot(resolve_slot() + 1);
+            return *this;
+        }
+        IteratorImpl &operator--() {
+            // Decrementing end() gives the last entry, as with std::map
+            set_slot(at_end_ ? map_->slots_.size() - 1 : resolve_slot() - 1);
+            return *this;
+        }
+        IteratorImpl &operator=(const IteratorImpl &other) {
+            map_ = other.map_;
+            key_ = other.key_;
+            slot_ = other.slot_;
+            at_end_ = other.at_end_;
+            return *this;
+        }
+        // all ends are equal
+        bool operator==(const IteratorImpl &other) const {
+            return (at_end_ == other.at_end_) && (at_end_ || (key_ == other.key_));
+        }
+        bool operator!=(const IteratorImpl &other) const { return !(*this == other); }
+
+        // At end()
+        IteratorImpl() : map_(nullptr), key_(), slot_(0), at_end_(true) {}
+        IteratorImpl(const IteratorImpl &other)
+            : map_(other.map_), key_(other.key_), slot_(other.slot_), at_end_(other.at_end_) {}
+
+        // Raw getters to allow for const_iterator conversion below
+        Map *get_map() const { return map_; }
+        size_t get_slot() const { return slot_; }
+        bool at_end() const { return at_end_; }
+
+      protected:
+        IteratorImpl(Map *map, size_t slot) : map_(map), key_(), slot_(0), at_end_(true) { set_slot(slot); }
+        IteratorImpl(Map *map, const key_type &key, size_t slot, bool at_end)
+            : map_(map), key_(key), slot_(slot), at_end_(at_end) {}
+
+      private:
+        void set_slot(size_t slot) {
+            slot_ = slot;
+            at_end_ = slot >= map_->slots_.size();
+            if (!at_end_) key_ = map_->slots_[slot].key;
+        }
+        size_t resolve_slot() const {
+            RANGE_ASSERT(!at_end_);
+            slot_ = map_->slot_of(key_, slot_);
+            return slot_;
+        }
+
+        Map *map_;
+        key_type key_;
+        mutable size_t slot_;  // the slot key_ was last seen at, only a hint after the map is changed
+        bool at_end_;
+    };
+    using iterator = IteratorImpl<flat_range_map, value_type>;
+
+    // The const iterator must be derived to allow the conversion from iterator, which iterator doesn't support
+    class const_iterator : public IteratorImpl<const flat_range_map, const value_type> {
+        using Base = IteratorImpl<const flat_range_map, const value_type>;
+        friend flat_range_map;
+
+      public:
+        const_iterator(const iterator &it) : Base(it.get_map(), it.key(), it.get_slot(), it.at_end()) {}
+        const_iterator() : Base() {}
+
+      private:
+        const_iterator(const flat_range_map *map, size_t slot) : Base(map, slot) {}
+    };
+
+    iterator begin() { return iterator(this, 0); }
+    const_iterator cbegin() const { return const_iterator(this, 0); }
+    const_iterator begin() const { return cbegin(); }
+    iterator end() { return iterator(this, slots_.size()); }
+    const_iterator cend() const { return const_iterator(this, slots_.size()); }
+    const_iterator end() const { return cend(); }
+
+    void clear() {
+        for (auto &slot : slots_) {
+            release_node(slot.node);
+        }
+        slots_.clear();
+    }
+
+    // Find entry with an exact key match (uncommon use case)
+    iterator find(const key_type &key) { return iterator(this, find_slot(key)); }
+    const_iterator find(const key_type &key) const { return const_iterator(this, find_slot(key)); }
+
+    iterator lower_bound(const key_type &key) { return iterator(this, lower_bound_slot(key)); }
+    const_iterator lower_bound(const key_type &key) const { return const_iterator(this, lower_bound_slot(key)); }
+
+    iterator upper_bound(const key_type &key) { return iterator(this, upper_bound_slot(key)); }
+    const_iterator upper_bound(const key_type &key) const { return const_iterator(this, upper_bound_slot(key)); }
+
+    size_type size() const { return slots_.size(); }
+    bool empty() const { return slots_.empty(); }
+    // Heap bytes held for the slots and the node pool, which may be shared with other maps. Not safe against concurrent updates.
+    size_t allocated_bytes() const {
+        return slots_.capacity() * sizeof(Slot) + (pool_ ? pool_->size * sizeof(NodeStorage) : 0);
+    }
+
+    iterator erase(const const_iterator &pos) {
+        RANGE_ASSERT(!pos.at_end_ && (pos.map_ == this));
+        const size_t slot = pos.resolve_slot();
+        release_node(slots_[slot].node);
+        slots_.erase(slots_.begin() + slot);
+        return iterator(this, slot);
+    }
+    iterator erase(const iterator &pos) { return erase(const_iterator(pos)); }
+    iterator erase(const const_iterator &first, const const_iterator &last) {
+        RANGE_ASSERT((first.at_end_ || first.map_ == this) && (last.at_end_ || last.map_ == this));
+        const size_t first_slot = first.at_end_ ? slots_.size() : first.resolve_slot();
+        const size_t last_slot = last.at_end_ ? slots_.size() : last.resolve_slot();
+        RANGE_ASSERT(first_slot <= last_slot);
+        for (size_t slot = first_slot; slot < last_slot; ++slot) {
+            release_node(slots_[slot].node);
+        }
+        slots_.erase(slots_.begin() + first_slot, slots_.begin() + last_slot);
+        return iterator(this, first_slot);
+    }
+    iterator erase(const iterator &first, const iterator &last) { return erase(const_iterator(first), const_iterator(last)); }
+
+    // Give the entry at pos a new key, which must keep it between its neighbors
+    iterator rekey(const iterator &pos, const key_type &key) {
+        RANGE_ASSERT(!pos.at_end_ && (pos.map_ == this));
+        const size_t slot = pos.resolve_slot();
+        RANGE_ASSERT((slot == 0) || (slots_[slot - 1].key < key));
+        RANGE_ASSERT((slot + 1 == slots_.size()) || (key < slots_[slot + 1].key));
+        Node *&node = slots_[slot].node;
+        Node *rekeyed = (node->refs.load(std::memory_order_acquire) > 1)
+                            ? new_node(std::make_pair(key, node->value.second))
+                            : new_node(std::make_pair(key, std::move(node->value.second)));
+        release_node(node);
+        node = rekeyed;
+        slots_[slot].key = key;
+        return iterator(this, slot);
+    }
+
+    // Unlike std::map, the key must not already be present (which range_map guarantees)
+    template <typename Value>
+    iterator emplace_hint(const const_iterator &hint, Value &&value) {
+        RANGE_ASSERT(hint.map_ == this || hint.at_end_);
+        const key_type &key = value.first;
+        size_t slot = hint.at_end_ ? slots_.size() : hint.resolve_slot();
+        const bool hint_open =
+            ((slot == 0) || (slots_[slot - 1].key < key)) && ((slot == slots_.size()) || (key < slots_[slot].key));
+        if (!hint_open) {
+            // Hint was unhelpful, fall back to the search
+            slot = lower_bound_slot(key);
+        }
+        RANGE_ASSERT((slot == slots_.size()) || (key < slots_[slot].key));
+
+        Node *node = new_node(std::forward<Value>(value));
+        slots_.insert(slots_.begin() + slot, Slot{node->value.first, node});
+        return iterator(this, slot);
+    }
+    template <typename Value>
+    iterator emplace_hint(const iterator &hint, Value &&value) {
+        return emplace_hint(const_iterator(hint), std::forward<Value>(value));
+    }
+    iterator insert(const const_iterator &hint, const value_type &value) { return emplace_hint(hint, value); }
+    iterator insert(const iterator &hint, const value_type &value) { return emplace_hint(const_iterator(hint), value); }
+
+    // Replace the contents with those of from, sharing the nodes until either map writes to them. The cost is that of copying
+    // the slots, independent of the size of the mapped values. From must not be changed concurrently.
+    void share(const flat_range_map &from) {
+        if (this == &from) return;
+        clear();
+        if (!from.pool_) return;  // from has never held an entry
+        // The maps now allocate from and release to the same pool, possibly from different threads
+        from.pool_->shared.store(true);
+        pool_ = from.pool_;
+        slots_.reserve(from.slots_.size());
+        for (const auto &slot : from.slots_) {
+            slot.node->refs.fetch_add(1, std::memory_order_relaxed);
+            slots_.emplace_back(slot);
+        }
+    }
+
+    flat_range_map() {}
+    flat_range_map(const flat_range_map &other) { copy_from(other); }
+    flat_range_map(flat_range_map &&other) { swap(other); }
+    flat_range_map &operator=(const flat_range_map &other) {
+        if (this != &other) {
+            clear();
+            copy_from(other);
+        }
+        return *this;
+    }
+    flat_range_map &operator=(flat_range_map &&other) {
+        if (this != &other) {
+            clear();
+            swap(other);
+        }
+        return *this;
+    }
+    ~flat_range_map() { clear(); }
+
+    void swap(flat_range_map &other) {
+        slots_.swap(other.slots_);
+        pool_.swap(other.pool_);
+    }
+
+  private:
+    template <typename, typename>
+    friend struct IteratorImpl;
+    friend const_iterator;
+
+    // Uninitialized, address stable storage for the nodes, threaded onto a free list when not in use
+    union NodeStorage {
+        NodeStorage *next_free;
+        typename std::aligned_storage<sizeof(Node), alignof(Node)>::type data;
+    };
+    // Node storage of the maps holding it. Only locked once shared, as the maps sharing nodes can be updated concurrently.
+    struct NodePool {
+        std::vector<std::unique_ptr<NodeStorage[]>> blocks;
+        NodeStorage *free_list = nullptr;
+        size_t size = 0;
+        std::atomic<bool> shared{false};
+        std::mutex lock;
+
+        void *allocate() {
+            if (!free_list) {
+                // Grow geometrically, keeping the first allocation small as many maps hold only a handful of ranges.
+                const size_t count = (size < 4) ? 4 : ((size > 256) ? 256 : size);
+                std::unique_ptr<NodeStorage[]> block(new NodeStorage[count]);
+                for (size_t i = 0; i < count; ++i) {
+                    block[i].next_free = (i + 1 < count) ? &block[i + 1] : nullptr;
+                }
+                free_list = block.get();
+                blocks.emplace_back(std::move(block));
+                size += count;
+            }
+            NodeStorage *storage = free_list;
+            free_list = storage->next_free;
+            return &storage->data;
+        }
+        void deallocate(void *data) {
+            NodeStorage *storage = reinterpret_cast<NodeStorage *>(data);
+            storage->next_free = free_list;
+            free_list = storage;
+        }
+    };
+
+    const value_type &value_at(size_t slot) const { return slots_[slot].node->value; }
+    value_type &value_at(size_t slot) {
+        Node *&node = slots_[slot].node;
+        if (node->refs.load(std::memory_order_acquire) > 1) {
+            // Copy on write, the other holders of the node keep the original
+            Node *copy = new_node(node->value);
+            release_node(node);
+            node = copy;
+        }
+        return node->value;
+    }
+
+    // The slot cached in an iterator is only a hint once the map has been updated, keys are unique so search if it moved
+    size_t slot_of(const key_type &key, size_t hint) const {
+        if ((hint < slots_.size()) && (slots_[hint].key == key)) return hint;
+        const size_t slot = lower_bound_slot(key);
+        RANGE_ASSERT((slot < slots_.size()) && (slots_[slot].key == key));
+        return slot;
+    }
+
+    size_t lower_bound_slot(const key_type &key) const {
+        auto lower = std::lower_bound(slots_.cbegin(), slots_.cend(), key,
+                                      [](const Slot &slot, const key_type &key) { return slot.key < key; });
+        return static_cast<size_t>(lower - slots_.cbegin());
+    }
+    size_t upper_bound_slot(const key_type &key) const {
+        auto upper = std::upper_bound(slots_.cbegin(), slots_.cend(), key,
+                                      [](const key_type &key, const Slot &slot) { return key < slot.key; });
+        return static_cast<size_t>(upper - slots_.cbegin());
+    }
+    size_t find_slot(const key_type &key) const {
+        const size_t slot = lower_bound_slot(key);
+        if ((slot < slots_.size()) && !(key < slots_[slot].key)) return slot;
+        return slots_.size();
+    }
+
+    template <typename Value>
+    Node *new_node(Value &&value) {
+        if (!pool_) pool_ = std::make_shared<NodePool>();
+        void *storage;
+        if (pool_->shared.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> guard(pool_->lock);
+            storage = pool_->allocate();
+        } else {
+            storage = pool_->allocate();
+        }
+        return new (storage) Node(std::forward<Value>(value));
+    }
+    void release_node(Node *node) {
+        if (node->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+        node->~Node();
+        if (pool_->shared.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> guard(pool_->lock);
+            pool_->deallocate(node);
+        } else {
+            pool_->deallocate(node);
+        }
+    }
+
+    void copy_from(const flat_range_map &other) {
+        slots_.reserve(other.slots_.size());
+        for (const auto &slot : other.slots_) {
+            Node *node = new_node(slot.node->value);
+            slots_.emplace_back(Slot{node->value.first, node});
+        }
+    }
+
+    std::vector<Slot> slots_;
+    std::shared_ptr<NodePool> pool_;  // created with the first node
+};
+
 // Forward index iterator, tracking an index value and the appropos lower bound
 // returns an index_type, lower_bound pair.  Supports ++,  offset, and seek affecting the index,
 // lower bound updates as needed. As the index may specify a range for which no entry exist, dereferenced
@@ -1404,13 +1856,13 @@ class cached_lower_bound_impl {
     inline iterator lower_bound(const index_type &index) { return map_->lower_bound(key_type(index, index + 1)); }
     inline bool at_end(const iterator &it) const { return it == end_; }
 
-    bool is_lower_than(const index_type &index, const iterator &it) { return at_end(it) || (index < it->first.end); }
+    bool is_lower_than(const index_type &index, const iterator &it) { return at_end(it) || (index < iterator_key(it).end); }
 
   public:
     // The cached lower bound knows the parent map, and thus can tell us this...
     inline bool at_end() const { return at_end(lower_bound_); }
     // includes(index) is a convenience function to test if the index would be in the currently cached lower bound
-    bool includes(const index_type &index) const { return !at_end() && lower_bound_->first.includes(index); }
+    bool includes(const index_type &index) const { return !at_end() && iterator_key(lower_bound_).includes(index); }
 
     // The return is const because we are sharing the internal state directly.
     const value_type &operator*() const { return pos_; }
@@ -1488,7 +1940,7 @@ class cached_lower_bound_impl {
     // Allow a hint for a *valid* lower bound for current index
     // TODO: if the fail-over becomes a hot-spot, the hint logic could be far more clever (looking at previous/next...)
     cached_lower_bound_impl &invalidate(const iterator &hint) {
-        if ((hint != end_) && hint->first.includes(index_)) {
+        if ((hint != end_) && iterator_key(hint).includes(index_)) {
             auto index = index_;  // by copy set modifies in place
             set_value(index, hint);
         } else {
@@ -1502,11 +1954,11 @@ class cached_lower_bound_impl {
     index_type distance_to_edge() {
         if (valid_) {
             // Distance to edge of
-            return lower_bound_->first.end - index_;
+            return iterator_key(lower_bound_).end - index_;
         } else if (at_end()) {
             return index_type(0);
         } else {
-            return lower_bound_->first.begin - index_;
+            return iterator_key(lower_bound_).begin - index_;
         }
     }
 
@@ -1528,7 +1980,7 @@ class cached_lower_bound_impl {
 template <typename CachedLowerBound, typename MappedType = typename CachedLowerBound::mapped_type>
 const MappedType &evaluate(const CachedLowerBound &clb, const MappedType &default_value) {
     if (clb->valid) {
-        return clb->lower_bound->second;
+        return iterator_value(clb->lower_bound).second;
     }
     return default_value;
 }
@@ -1537,7 +1989,7 @@ const MappedType &evaluate(const CachedLowerBound &clb, const MappedType &defaul
 template <typename Iterator, typename Map, typename Range>
 Iterator split(Iterator in, Map &map, const Range &range) {
     assert(in != map.end());  // Not designed for use with invalid iterators...
-    const auto in_range = in->first;
+    const auto in_range = iterator_key(in);
     const auto split_range = in_range & range;
 
     if (split_range.empty()) return map.end();
@@ -1682,7 +2134,7 @@ class parallel_iterator {
     }
 
     parallel_iterator &trim_A() {
-        if (pos_A_->valid && (range_ != pos_A_->lower_bound->first)) {
+        if (pos_A_->valid && (range_ != iterator_key(pos_A_->lower_bound))) {
             split(pos_A_->lower_bound, pos_A_.map(), range_);
             invalidate_A();
         }
@@ -1703,7 +2155,7 @@ bool splice(DstRangeMap &to, const SrcRangeMap &from, SourceIterator begin, Sour
     using Key = typename SrcRangeMap::key_type;
     using CachedLowerBound = cached_lower_bound_impl<DstRangeMap>;
     using ConstCachedLowerBound = cached_lower_bound_impl<const SrcRangeMap>;
-    ParallelIterator par_it(to, from, begin->first.begin);
+    ParallelIterator par_it(to, from, iterator_key(begin).begin);
     bool updated = false;
     while (par_it->range.non_empty() && par_it->pos_B->lower_bound != end) {
         const Key &range = par_it->range;
@@ -1715,14 +2167,14 @@ bool splice(DstRangeMap &to, const SrcRangeMap &from, SourceIterator begin, Sour
             // Because of how the parallel iterator walk, "to" is valid over the whole range or it isn't (ranges don't span
             // transitions between map entries or between valid and invalid ranges)
             if (to_lb->valid) {
-                if (write_it->first == range) {
+                if (iterator_key(write_it) == range) {
                     // if the source and destination ranges match we can overwrite everything
                     updated |= updater.update(write_it->second, read_it->second);
                 } else {
                     // otherwise we need to split the destination range.
-                    auto value_to_update = write_it->second; // intentional copy
+                    auto value_to_update = iterator_value(write_it).second; // intentional copy
                     updated |= updater.update(value_to_update, read_it->second);
-                    auto intersected_range = write_it->first & range;
+                    auto intersected_range = iterator_key(write_it) & range;
                     to.overwrite_range(to_lb->lower_bound, std::make_pair(intersected_range, value_to_update));
                     par_it.invalidate_A();  // we've changed map 'to' behind to_lb's back... let it know.
                 }
@@ -1797,7 +2249,7 @@ bool update_range_value(Map &map, const Range &range, MapValue &&value, value_pr
             // Fill in the leading space (or in the case of pos at end the trailing space
             const auto start = pos->index;
             auto it = pos->lower_bound;
-            const auto limit = (it != map.end()) ? std::min(it->first.begin, range.end) : range.end;
+            const auto limit = (it != map.end()) ? std::min(iterator_key(it).begin, range.end) : range.end;
             map.insert(it, std::make_pair(Range(start, limit), value));
             // We inserted before pos->lower_bound, so pos->lower_bound isn't invalid, but the associated index *is* and seek
             // will fix this (and move the state to valid)
@@ -1806,7 +2258,7 @@ bool update_range_value(Map &map, const Range &range, MapValue &&value, value_pr
         }
         // Note that after the "fill" operation pos may have become valid so we check again
         if (pos->valid) {
-            if ((precedence == value_precedence::prefer_source) && (pos->lower_bound->second != value)) {
+            if ((precedence == value_precedence::prefer_source) && (iterator_value(pos->lower_bound).second != value)) {
                 // We've found a place where we're changing the value, at this point might as well simply over write the range
                 // and be done with it. (save on later merge operations....)
                 pos.seek(range.begin);
@@ -1817,7 +2269,7 @@ bool update_range_value(Map &map, const Range &range, MapValue &&value, value_pr
                 // "prefer_dest" means don't overwrite existing values, so we'll skip this interval.
                 // Point just past the end of this section,  if it's within the given range, it will get filled next iteration
                 // ++pos could move us past the end of range (which would exit the loop) so we don't use it.
-                pos.seek(pos->lower_bound->first.end);
+                pos.seek(iterator_key(pos->lower_bound).end);
             }
         }
     }
@@ -2616,20 +2616,12 @@ bool CoreChecks::ValidatePipelineShaderStage(const PIPELINE_STATE *pipeline, con
     if (module_state.HasSpecConstants()) {
         // both spirv-opt and spirv-val will use the same flags
         spvtools::ValidatorOptions options;
-        AdjustValidatorOptions(device_extensions, enabled_features, options);
-
-        // setup the call back if the optimizer fails
+        const uint32_t option_bits = AdjustValidatorOptions(device_extensions, enabled_features, options);
         spv_target_env spirv_environment = PickSpirvEnv(api_version, IsExtEnabled(device_extensions.vk_khr_spirv_1_4));
-        spvtools::Optimizer optimizer(spirv_environment);
-        spvtools::MessageConsumer consumer = [&skip, &module_state, &stage_state, this](
-                                                 spv_message_level_t level, const char *source, const spv_position_t &position,
-                                                 const char *message) {
-            skip |= LogError(device, "VUID-VkPipelineShaderStageCreateInfo-module-parameter",
-                             "%s does not contain valid spirv for stage %s. %s",
-                             report_data->FormatHandle(module_state.vk_shader_module()).c_str(),
-                             string_VkShaderStageFlagBits(stage_state.stage_flag), message);
-        };
-        optimizer.SetMessageConsumer(consumer);
+
+        std::unordered_map<uint32_t, std::vector<uint32_t>> id_value_map;  // note: this must be std:: to work with spvtools
+        // (constantID, size, value) of each applied map entry, identifying the specialization in the validation cache
+        std::vector<uint32_t> specialization_words;
 
         // The app might be using the default spec constant values, but if they pass values at runtime to the pipeline then need to
         // use those values to apply to the spec constants
@@ -2638,7 +2630,6 @@ bool CoreChecks::ValidatePipelineShaderStage(const PIPELINE_STATE *pipeline, con
             // Gather the specialization-constant values.
             auto const &specialization_info = pStage->pSpecializationInfo;
             auto const &specialization_data = reinterpret_cast<uint8_t const *>(specialization_info->pData);
-            std::unordered_map<uint32_t, std::vector<uint32_t>> id_value_map;  // note: this must be std:: to work with spvtools
             id_value_map.reserve(specialization_info->mapEntryCount);
             for (auto i = 0u; i < specialization_info->mapEntryCount; ++i) {
                 auto const &map_entry = specialization_info->pMapEntries[i];
@@ -2685,128 +2676,168 @@ bool CoreChecks::ValidatePipelineShaderStage(const PIPELINE_STATE *pipeline, con
                     const uint8_t *const end_in_p = start_in_p + map_entry.size;
 
                     std::copy(start_in_p, end_in_p, out_p);
+                    specialization_words.push_back(map_entry.constantID);
+                    specialization_words.push_back(static_cast<uint32_t>(map_entry.size));
+                    specialization_words.insert(specialization_words.end(), entry_data.begin(), entry_data.end());
                     id_value_map.emplace(map_entry.constantID, std::move(entry_data));
                 }
             }
-
-            // This pass takes the runtime spec const values and applies it into the SPIR-V
-            // will turn a spec constant like
-            //     OpSpecConstant %uint 1
-            // to a use the value passed in instead (for example if the value is 32) so now it looks like
-            //     OpSpecConstant %uint 32
-            optimizer.RegisterPass(spvtools::CreateSetSpecConstantDefaultValuePass(id_value_map));
         }
 
-        // This pass will turn OpSpecConstant into a OpConstant (also OpSpecConstantTrue/OpSpecConstantFalse)
-        optimizer.RegisterPass(spvtools::CreateFreezeSpecConstantValuePass());
-        // Using the new frozen OpConstant all OpSpecConstantComposite can be resolved turning them into OpConstantComposite
-        // This is need incase a shdaer looks like:
-        //
-        //     layout(constant_id = 0) const uint x = 64;
-        //     shared uint arr[x > 64 ? 64 : x];
-        //
-        // this will generate branch/switch statements that we want to leverage spirv-opt to apply to make parsing easier
-        optimizer.RegisterPass(spvtools::CreateFoldSpecConstantOpAndCompositePass());
-
-        // Apply the specialization-constant values and revalidate the shader module is valid.
-        std::vector<uint32_t> specialized_spirv;
-        auto const optimized =
-            optimizer.Run(module_state.words.data(), module_state.words.size(), &specialized_spirv, options, false);
-        if (optimized) {
-            spv_context ctx = spvContextCreate(spirv_environment);
-            spv_const_binary_t binary{specialized_spirv.data(), specialized_spirv.size()};
-            spv_diagnostic diag = nullptr;
-            auto const spv_valid = spvValidateWithOptions(ctx, options, &binary, &diag);
-            if (spv_valid != SPV_SUCCESS) {
-                skip |= LogError(device, "VUID-VkPipelineShaderStageCreateInfo-pSpecializationInfo-06719",
-                                 "After specialization was applied, %s does not contain valid spirv for stage %s.",
+        // Specializations that were applied and validated before, by any pipeline, don't need to go through spirv-opt again
+        auto cache = CastFromHandle<ValidationCache *>(core_validation_cache);
+        uint64_t specialization_hash = 0;
+        ValidationCache::SpecializedShaderInfo cached_info;
+        if (cache) {
+            const uint64_t options_key = ValidationCache::MakeOptionsKey(spirv_environment, option_bits);
+            specialization_hash = ValidationCache::MakeSpecializationHash(module_state, specialization_words, options_key);
+        }
+        if (cache && cache->FindSpecialization(specialization_hash, cached_info)) {
+            local_size_x = cached_info.local_size_x;
+            local_size_y = cached_info.local_size_y;
+            local_size_z = cached_info.local_size_z;
+            total_shared_size = cached_info.total_shared_size;
+        } else {
+            // setup the call back if the optimizer fails
+            bool specialization_valid = true;
+            spvtools::Optimizer optimizer(spirv_environment);
+            spvtools::MessageConsumer consumer = [&skip, &specialization_valid, &module_state, &stage_state, this](
+                                                     spv_message_level_t level, const char *source, const spv_position_t &position,
+                                                     const char *message) {
+                specialization_valid = false;
+                skip |= LogError(device, "VUID-VkPipelineShaderStageCreateInfo-module-parameter",
+                                 "%s does not contain valid spirv for stage %s. %s",
                                  report_data->FormatHandle(module_state.vk_shader_module()).c_str(),
-                                 string_VkShaderStageFlagBits(stage_state.stage_flag));
-            }
-
-            // The new optimized SPIR-V will NOT match the original SHADER_MODULE_STATE object parsing, so a new SHADER_MODULE_STATE
-            // object is needed. This an issue due to each pipeline being able to reuse the same shader module but with different
-            // spec constant values.
-            SHADER_MODULE_STATE spec_mod(specialized_spirv);
+                                 string_VkShaderStageFlagBits(stage_state.stage_flag), message);
+            };
+            optimizer.SetMessageConsumer(consumer);
+
+            if (!id_value_map.empty()) {
+                // This pass takes the runtime spec const values and applies it into the SPIR-V
+                // will turn a spec constant like
+                //     OpSpecConstant %uint 1
+                // to a use the value passed in instead (for example if the value is 32) so now it looks like
+                //     OpSpecConstant %uint 32
+                optimizer.RegisterPass(spvtools::CreateSetSpecConstantDefaultValuePass(id_value_map));
+            }
+
+            // This pass will turn OpSpecConstant into a OpConstant (also OpSpecConstantTrue/OpSpecConstantFalse)
+            optimizer.RegisterPass(spvtools::CreateFreezeSpecConstantValuePass());
+            // Using the new frozen OpConstant all OpSpecConstantComposite can be resolved turning them into OpConstantComposite
+            // This is need incase a shdaer looks like:
+            //
+            //     layout(constant_id = 0) const uint x = 64;
+            //     shared uint arr[x > 64 ? 64 : x];
+            //
+            // this will generate branch/switch statements that we want to leverage spirv-opt to apply to make parsing easier
+            optimizer.RegisterPass(spvtools::CreateFoldSpecConstantOpAndCompositePass());
+
+            // Apply the specialization-constant values and revalidate the shader module is valid.
+            std::vector<uint32_t> specialized_spirv;
+            auto const optimized =
+                optimizer.Run(module_state.words.data(), module_state.words.size(), &specialized_spirv, options, false);
+            if (optimized) {
+                spv_context ctx = spvContextCreate(spirv_environment);
+                spv_const_binary_t binary{specialized_spirv.data(), specialized_spirv.size()};
+                spv_diagnostic diag = nullptr;
+                auto const spv_valid = spvValidateWithOptions(ctx, options, &binary, &diag);
+                if (spv_valid != SPV_SUCCESS) {
+                    specialization_valid = false;
+                    skip |= LogError(device, "VUID-VkPipelineShaderStageCreateInfo-pSpecializationInfo-06719",
+                                     "After specialization was applied, %s does not contain valid spirv for stage %s.",
+                                     report_data->FormatHandle(module_state.vk_shader_module()).c_str(),
+                                     string_VkShaderStageFlagBits(stage_state.stage_flag));
+                }
 
-            // According to https://github.com/KhronosGroup/Vulkan-Docs/issues/1671 anything labeled as "static use" (such as if an
-            // input is used or not) don't have to be checked post spec constants freezing since the device compiler is not
-            // guaranteed to run things such as dead-code elimination. The following checks are things that don't follow under
-            // "static use" rules and need to be validated still.
-            auto specialized_it = spec_mod.begin();
+                // The new optimized SPIR-V will NOT match the original SHADER_MODULE_STATE object parsing, so a new
+                // SHADER_MODULE_STATE object is needed. This an issue due to each pipeline being able to reuse the same shader
+                // module but with different spec constant values.
+                SHADER_MODULE_STATE spec_mod(specialized_spirv);
+
+                // According to https://github.com/KhronosGroup/Vulkan-Docs/issues/1671 anything labeled as "static use" (such as if
+                // an input is used or not) don't have to be checked post spec constants freezing since the device compiler is not
+                // guaranteed to run things such as dead-code elimination. The following checks are things that don't follow under
+                // "static use" rules and need to be validated still.
+                auto specialized_it = spec_mod.begin();
+
+                // see ValidateComputeSharedMemory() for details why we might track max block size
+                layer_data::unordered_set<uint32_t> aliased_id;
+                bool find_max_block = false;
+
+                uint32_t workgroup_size_id = 0;  // result id can't be zero
+                uint32_t local_size_id_x = 0;
+                uint32_t local_size_id_y = 0;
+                uint32_t local_size_id_z = 0;
+
+                // make single interation through new shader
+                while (specialized_it != spec_mod.end()) {
+                    const uint32_t opcode = specialized_it.opcode();
+
+                    if (opcode == spv::OpExecutionModeId && specialized_it.word(2) == spv::ExecutionModeLocalSizeId) {
+                        local_size_id_x = specialized_it.word(3);
+                        local_size_id_y = specialized_it.word(4);
+                        local_size_id_z = specialized_it.word(5);
+                    }
 
-            // see ValidateComputeSharedMemory() for details why we might track max block size
-            layer_data::unordered_set<uint32_t> aliased_id;
-            bool find_max_block = false;
+                    if (opcode == spv::OpDecorate) {
+                        // Validate applied WorkgroupSize is still below maxComputeWorkGroupSize limit
+                        if (specialized_it.word(2) == spv::DecorationBuiltIn &&
+                            specialized_it.word(3) == spv::BuiltInWorkgroupSize) {
+                            // Will be a OpConstantComposite and always have the OpDecorate section
+                            workgroup_size_id = specialized_it.word(1);
+                        }
+                        if (specialized_it.word(2) == spv::DecorationAliased) {
+                            aliased_id.emplace(specialized_it.word(1));
+                        }
+                    }
 
-            uint32_t workgroup_size_id = 0;  // result id can't be zero
-            uint32_t local_size_id_x = 0;
-            uint32_t local_size_id_y = 0;
-            uint32_t local_size_id_z = 0;
+                    if (opcode == spv::OpConstantComposite && workgroup_size_id == specialized_it.word(2)) {
+                        // VUID-WorkgroupSize-WorkgroupSize-04427 makes sure this is a OpTypeVector of int32 so this can be assuemd
+                        local_size_x = spec_mod.get_def(specialized_it.word(3)).word(3);
+                        local_size_y = spec_mod.get_def(specialized_it.word(4)).word(3);
+                        local_size_z = spec_mod.get_def(specialized_it.word(5)).word(3);
+                    }
 
-            // make single interation through new shader
-            while (specialized_it != spec_mod.end()) {
-                const uint32_t opcode = specialized_it.opcode();
+                    if (opcode == spv::OpVariable && specialized_it.word(3) == spv::StorageClassWorkgroup) {
+                        if (aliased_id.find(specialized_it.word(2)) != aliased_id.end()) {
+                            find_max_block = true;
+                        }
 
-                if (opcode == spv::OpExecutionModeId && specialized_it.word(2) == spv::ExecutionModeLocalSizeId) {
-                    local_size_id_x = specialized_it.word(3);
-                    local_size_id_y = specialized_it.word(4);
-                    local_size_id_z = specialized_it.word(5);
-                }
+                        const uint32_t result_type_id = specialized_it.word(1);
+                        const auto result_type = spec_mod.get_def(result_type_id);
+                        const auto type = spec_mod.get_def(result_type.word(3));
+                        const uint32_t variable_shared_size = spec_mod.GetTypeBitsSize(type) / 8;
 
-                if (opcode == spv::OpDecorate) {
-                    // Validate applied WorkgroupSize is still below maxComputeWorkGroupSize limit
-                    if (specialized_it.word(2) == spv::DecorationBuiltIn && specialized_it.word(3) == spv::BuiltInWorkgroupSize) {
-                        // Will be a OpConstantComposite and always have the OpDecorate section
-                        workgroup_size_id = specialized_it.word(1);
-                    }
-                    if (specialized_it.word(2) == spv::DecorationAliased) {
-                        aliased_id.emplace(specialized_it.word(1));
+                        if (find_max_block) {
+                            total_shared_size = std::max(total_shared_size, variable_shared_size);
+                        } else {
+                            total_shared_size += variable_shared_size;
+                        }
                     }
-                }
 
-                if (opcode == spv::OpConstantComposite && workgroup_size_id == specialized_it.word(2)) {
-                    // VUID-WorkgroupSize-WorkgroupSize-04427 makes sure this is a OpTypeVector of int32 so this can be assuemd
-                    local_size_x = spec_mod.get_def(specialized_it.word(3)).word(3);
-                    local_size_y = spec_mod.get_def(specialized_it.word(4)).word(3);
-                    local_size_z = spec_mod.get_def(specialized_it.word(5)).word(3);
+                    ++specialized_it;
                 }
 
-                if (opcode == spv::OpVariable && specialized_it.word(3) == spv::StorageClassWorkgroup) {
-                    if (aliased_id.find(specialized_it.word(2)) != aliased_id.end()) {
-                        find_max_block = true;
-                    }
-
-                    const uint32_t result_type_id = specialized_it.word(1);
-                    const auto result_type = spec_mod.get_def(result_type_id);
-                    const auto type = spec_mod.get_def(result_type.word(3));
-                    const uint32_t variable_shared_size = spec_mod.GetTypeBitsSize(type) / 8;
-
-                    if (find_max_block) {
-                        total_shared_size = std::max(total_shared_size, variable_shared_size);
-                    } else {
-                        total_shared_size += variable_shared_size;
-                    }
+                // if after no WorkgroupSize is found, then can apply any possible LocalSizeId due to precedence order
+                if (local_size_x == 0 && local_size_id_x != 0) {
+                    local_size_x = spec_mod.get_def(local_size_id_x).word(3);
+                    local_size_y = spec_mod.get_def(local_size_id_y).word(3);
+                    local_size_z = spec_mod.get_def(local_size_id_z).word(3);
                 }
 
-                ++specialized_it;
-            }
+                spvDiagnosticDestroy(diag);
+                spvContextDestroy(ctx);
 
-            // if after no WorkgroupSize is found, then can apply any possible LocalSizeId due to precedence order
-            if (local_size_x == 0 && local_size_id_x != 0) {
-                local_size_x = spec_mod.get_def(local_size_id_x).word(3);
-                local_size_y = spec_mod.get_def(local_size_id_y).word(3);
-                local_size_z = spec_mod.get_def(local_size_id_z).word(3);
+                if (cache && specialization_valid) {
+                    cache->InsertSpecialization(specialization_hash, {local_size_x, local_size_y, local_size_z, total_shared_size});
+                }
+            } else {
+                // Should never get here, but better then asserting
+                skip |= LogError(device, "VUID-VkPipelineShaderStageCreateInfo-pSpecializationInfo-06719",
+                                 "%s module (stage %s) attempted to apply specialization constants with spirv-opt but failed.",
+                                 report_data->FormatHandle(module_state.vk_shader_module()).c_str(),
+                                 string_VkShaderStageFlagBits(stage_state.stage_flag));
             }
-
-            spvDiagnosticDestroy(diag);
-            spvContextDestroy(ctx);
-        } else {
-            // Should never get here, but better then asserting
-            skip |= LogError(device, "VUID-VkPipelineShaderStageCreateInfo-pSpecializationInfo-06719",
-                             "%s module (stage %s) attempted to apply specialization constants with spirv-opt but failed.",
-                             report_data->FormatHandle(module_state.vk_shader_module()).c_str(),
-                             string_VkShaderStageFlagBits(stage_state.stage_flag));
         }
     }
 
@@ -3396,7 +3427,15 @@ bool CoreChecks::ValidateRayTracingPipeline(PIPELINE_STATE *pipeline, const safe
     return skip;
 }
 
-uint32_t ValidationCache::MakeShaderHash(VkShaderModuleCreateInfo const *smci) { return XXH32(smci->pCode, smci->codeSize, 0); }
+uint64_t ValidationCache::MakeShaderHash(VkShaderModuleCreateInfo const *smci, uint64_t options_key) {
+    return XXH64(smci->pCode, smci->codeSize, options_key);
+}
+
+uint64_t ValidationCache::MakeSpecializationHash(const SHADER_MODULE_STATE &module_state,
+                                                 const std::vector<uint32_t> &specialization_words, uint64_t options_key) {
+    const uint64_t module_hash = XXH64(module_state.words.data(), module_state.words.size() * sizeof(uint32_t), options_key);
+    return XXH64(specialization_words.data(), specialization_words.size() * sizeof(uint32_t), module_hash);
+}
 
 static ValidationCache *GetValidationCacheInfo(VkShaderModuleCreateInfo const *pCreateInfo) {
     const auto validation_cache_ci = LvlFindInChain<VkShaderModuleValidationCacheCreateInfoEXT>(pCreateInfo->pNext);
@@ -3422,23 +3461,24 @@ bool CoreChecks::PreCallValidateCreateShaderModule(VkDevice device, const VkShad
                          "SPIR-V module not valid: Codesize must be a multiple of 4 but is " PRINTF_SIZE_T_SPECIFIER ".",
                          pCreateInfo->codeSize);
     } else {
+        spv_target_env spirv_environment = PickSpirvEnv(api_version, IsExtEnabled(device_extensions.vk_khr_spirv_1_4));
+        spvtools::ValidatorOptions options;
+        const uint32_t option_bits = AdjustValidatorOptions(device_extensions, enabled_features, options);
+
         auto cache = GetValidationCacheInfo(pCreateInfo);
-        uint32_t hash = 0;
+        uint64_t hash = 0;
         // If app isn't using a shader validation cache, use the default one from CoreChecks
         if (!cache) cache = CastFromHandle<ValidationCache *>(core_validation_cache);
         if (cache) {
-            hash = ValidationCache::MakeShaderHash(pCreateInfo);
+            hash = ValidationCache::MakeShaderHash(pCreateInfo, ValidationCache::MakeOptionsKey(spirv_environment, option_bits));
             if (cache->Contains(hash)) return false;
         }
 
         // Use SPIRV-Tools validator to try and catch any issues with the module itself. If specialization constants are present,
         // the default values will be used during validation.
-        spv_target_env spirv_environment = PickSpirvEnv(api_version, IsExtEnabled(device_extensions.vk_khr_spirv_1_4));
         spv_context ctx = spvContextCreate(spirv_environment);
         spv_const_binary_t binary{pCreateInfo->pCode, pCreateInfo->codeSize / sizeof(uint32_t)};
         spv_diagnostic diag = nullptr;
-        spvtools::ValidatorOptions options;
-        AdjustValidatorOptions(device_extensions, enabled_features, options);
         spv_valid = spvValidateWithOptions(ctx, options, &binary, &diag);
         if (spv_valid != SPV_SUCCESS) {
             if (!have_glsl_shader || (pCreateInfo->pCode[0] == spv::MagicNumber)) {
@@ -3615,13 +3655,16 @@ spv_target_env PickSpirvEnv(uint32_t api_version, bool spirv_1_4) {
 }
 
 // Some Vulkan extensions/features are just all done in spirv-val behind optional settings
-void AdjustValidatorOptions(const DeviceExtensions &device_extensions, const DeviceFeatures &enabled_features,
-                            spvtools::ValidatorOptions &options) {
+// Returns a bit per option set, so that callers can key cached validation results by the options used
+uint32_t AdjustValidatorOptions(const DeviceExtensions &device_extensions, const DeviceFeatures &enabled_features,
+                                spvtools::ValidatorOptions &options) {
+    uint32_t option_bits = 0;
     // VK_KHR_relaxed_block_layout never had a feature bit so just enabling the extension allows relaxed layout
     // Was promotoed in Vulkan 1.1 so anyone using Vulkan 1.1 also gets this for free
     if (IsExtEnabled(device_extensions.vk_khr_relaxed_block_layout)) {
         // --relax-block-layout
         options.SetRelaxBlockLayout(true);
+        option_bits |= 1u << 0;
     }
 
     // The rest of the settings are controlled from a feature bit, which are set correctly in the state tracking. Regardless of
@@ -3630,17 +3673,22 @@ void AdjustValidatorOptions(const DeviceExtensions &device_extensions, const Dev
     if (enabled_features.core12.uniformBufferStandardLayout == VK_TRUE) {
         // --uniform-buffer-standard-layout
         options.SetUniformBufferStandardLayout(true);
+        option_bits |= 1u << 1;
     }
     if (enabled_features.core12.scalarBlockLayout == VK_TRUE) {
         // --scalar-block-layout
         options.SetScalarBlockLayout(true);
+        option_bits |= 1u << 2;
     }
     if (enabled_features.workgroup_memory_explicit_layout_features.workgroupMemoryExplicitLayoutScalarBlockLayout) {
         // --workgroup-scalar-block-layout
         options.SetWorkgroupScalarBlockLayout(true);
+        option_bits |= 1u << 3;
     }
     if (enabled_features.core13.maintenance4) {
         // --allow-localsizeid
         options.SetAllowLocalSizeId(true);
+        option_bits |= 1u << 4;
     }
+    return option_bits;
 }
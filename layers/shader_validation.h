@@ -47,8 +47,23 @@ class ValidationCache {
         return VkValidationCacheEXT(cache);
     }
 
+    // Values derived from a shader module after its specialization constants have been applied
+    struct SpecializedShaderInfo {
+        uint32_t local_size_x;
+        uint32_t local_size_y;
+        uint32_t local_size_z;
+        uint32_t total_shared_size;
+    };
+
+    // 4 bytes for header size + 4 bytes for version number + UUID, followed by 4 bytes for the layer's own format version and 4
+    // bytes for the number of shader hashes. The shader hashes are followed by the specialization entries. Caches written with a
+    // different header size (such as the 32-bit hash format) are discarded.
+    static constexpr size_t kHeaderSize = 2 * sizeof(uint32_t) + VK_UUID_SIZE + 2 * sizeof(uint32_t);
+    static constexpr uint32_t kFormatVersion = 3;  // 64-bit hashes and specialization entries
+    static constexpr size_t kSpecializationEntrySize = sizeof(uint64_t) + sizeof(SpecializedShaderInfo);
+
     void Load(VkValidationCacheCreateInfoEXT const *pCreateInfo) {
-        const auto headerSize = 2 * sizeof(uint32_t) + VK_UUID_SIZE;
+        const auto headerSize = kHeaderSize;
         auto size = headerSize;
         if (!pCreateInfo->pInitialData || pCreateInfo->initialDataSize < size) return;
 
@@ -58,45 +73,44 @@ class ValidationCache {
         uint8_t expected_uuid[VK_UUID_SIZE];
         Sha1ToVkUuid(SPIRV_TOOLS_COMMIT_ID, expected_uuid);
         if (memcmp(&data[2], expected_uuid, VK_UUID_SIZE) != 0) return;  // different version
+        data = (uint32_t const *)(reinterpret_cast<uint8_t const *>(data) + 2 * sizeof(uint32_t) + VK_UUID_SIZE);
+        if (data[0] != kFormatVersion) return;
+        const uint32_t shader_hash_count = data[1];
 
-        data = (uint32_t const *)(reinterpret_cast<uint8_t const *>(data) + headerSize);
+        auto entries = reinterpret_cast<uint8_t const *>(pCreateInfo->pInitialData) + headerSize;
 
         auto guard = WriteLock();
-        for (; size < pCreateInfo->initialDataSize; data++, size += sizeof(uint32_t)) {
-            good_shader_hashes_.insert(*data);
+        for (uint32_t i = 0; i < shader_hash_count && size + sizeof(uint64_t) <= pCreateInfo->initialDataSize;
+             i++, entries += sizeof(uint64_t), size += sizeof(uint64_t)) {
+            uint64_t hash;
+            memcpy(&hash, entries, sizeof(hash));
+            good_shader_hashes_.insert(hash);
+        }
+        for (; size + kSpecializationEntrySize <= pCreateInfo->initialDataSize;
+             entries += kSpecializationEntrySize, size += kSpecializationEntrySize) {
+            uint64_t hash;
+            SpecializedShaderInfo info;
+            memcpy(&hash, entries, sizeof(hash));
+            memcpy(&info, entries + sizeof(hash), sizeof(info));
+            good_specializations_.emplace(hash, info);
         }
     }
 
     void Write(size_t *pDataSize, void *pData) {
-        const auto headerSize = 2 * sizeof(uint32_t) + VK_UUID_SIZE;  // 4 bytes for header size + 4 bytes for version number + UUID
+        auto guard = ReadLock();
         if (!pData) {
-            *pDataSize = headerSize + good_shader_hashes_.size() * sizeof(uint32_t);
+            *pDataSize = DataSize();
             return;
         }
+        WriteData(pDataSize, pData);
+    }
 
-        if (*pDataSize < headerSize) {
-            *pDataSize = 0;
-            return;  // Too small for even the header!
-        }
-
-        uint32_t *out = (uint32_t *)pData;
-        size_t actualSize = headerSize;
-
-        // Write the header
-        *out++ = headerSize;
-        *out++ = VK_VALIDATION_CACHE_HEADER_VERSION_ONE_EXT;
-        Sha1ToVkUuid(SPIRV_TOOLS_COMMIT_ID, reinterpret_cast<uint8_t *>(out));
-        out = (uint32_t *)(reinterpret_cast<uint8_t *>(out) + VK_UUID_SIZE);
-
-        {
-            auto guard = ReadLock();
-            for (auto it = good_shader_hashes_.begin(); it != good_shader_hashes_.end() && actualSize < *pDataSize;
-                 it++, out++, actualSize += sizeof(uint32_t)) {
-                *out = *it;
-            }
-        }
-
-        *pDataSize = actualSize;
+    // Serializes the whole cache, sizing data and filling it under one lock so entries inserted meanwhile can't be cut off
+    void Write(std::vector<char> &data) {
+        auto guard = ReadLock();
+        size_t data_size = DataSize();
+        data.resize(data_size);
+        WriteData(&data_size, data.data());
     }
 
     void Merge(ValidationCache const *other) {
@@ -108,25 +122,101 @@ class ValidationCache {
         auto guard = WriteLock();
         good_shader_hashes_.reserve(good_shader_hashes_.size() + other->good_shader_hashes_.size());
         for (auto h : other->good_shader_hashes_) good_shader_hashes_.insert(h);
+        for (const auto &entry : other->good_specializations_) good_specializations_.insert(entry);
+    }
+
+    // Identifies the target environment and validator options a module is validated with, as a module valid under one set of
+    // options may not be under another. option_bits is the value returned by AdjustValidatorOptions().
+    static uint64_t MakeOptionsKey(spv_target_env spirv_environment, uint32_t option_bits) {
+        return (static_cast<uint64_t>(spirv_environment) << 32) | option_bits;
     }
 
-    static uint32_t MakeShaderHash(VkShaderModuleCreateInfo const *smci);
+    static uint64_t MakeShaderHash(VkShaderModuleCreateInfo const *smci, uint64_t options_key);
+
+    // specialization_words holds the (constantID, size, value words) of each map entry applied to module_state
+    static uint64_t MakeSpecializationHash(const SHADER_MODULE_STATE &module_state,
+                                           const std::vector<uint32_t> &specialization_words, uint64_t options_key);
 
-    bool Contains(uint32_t hash) {
+    bool Contains(uint64_t hash) {
         auto guard = ReadLock();
         return good_shader_hashes_.count(hash) != 0;
     }
 
-    void Insert(uint32_t hash) {
+    void Insert(uint64_t hash) {
         auto guard = WriteLock();
-        good_shader_hashes_.insert(hash);
+        if (good_shader_hashes_.insert(hash).second) {
+            inserted_count_++;
+        }
     }
 
+    bool FindSpecialization(uint64_t hash, SpecializedShaderInfo &info) const {
+        auto guard = ReadLock();
+        auto it = good_specializations_.find(hash);
+        if (it == good_specializations_.end()) return false;
+        info = it->second;
+        return true;
+    }
+
+    void InsertSpecialization(uint64_t hash, const SpecializedShaderInfo &info) {
+        auto guard = WriteLock();
+        if (good_specializations_.emplace(hash, info).second) {
+            inserted_count_++;
+        }
+    }
+
+    // Number of entries added by Insert() and InsertSpecialization() since creation, used to decide when to save the cache
+    size_t InsertedCount() const { return inserted_count_; }
+
   private:
     ValidationCache() {}
     ReadLockGuard ReadLock() const { return ReadLockGuard(lock_); }
     WriteLockGuard WriteLock() { return WriteLockGuard(lock_); }
 
+    // DataSize() and WriteData() must be called with the lock held
+    size_t DataSize() const {
+        return kHeaderSize + good_shader_hashes_.size() * sizeof(uint64_t) +
+               good_specializations_.size() * kSpecializationEntrySize;
+    }
+
+    void WriteData(size_t *pDataSize, void *pData) {
+        const auto headerSize = kHeaderSize;
+        if (*pDataSize < headerSize) {
+            *pDataSize = 0;
+            return;  // Too small for even the header!
+        }
+
+        uint32_t *out = (uint32_t *)pData;
+        size_t actualSize = headerSize;
+
+        // Write the header
+        *out++ = headerSize;
+        *out++ = VK_VALIDATION_CACHE_HEADER_VERSION_ONE_EXT;
+        Sha1ToVkUuid(SPIRV_TOOLS_COMMIT_ID, reinterpret_cast<uint8_t *>(out));
+        out = (uint32_t *)(reinterpret_cast<uint8_t *>(out) + VK_UUID_SIZE);
+        *out++ = kFormatVersion;
+        uint32_t *shader_hash_count = out++;
+        *shader_hash_count = 0;
+
+        auto entries = reinterpret_cast<uint8_t *>(out);
+        for (auto it = good_shader_hashes_.begin(); it != good_shader_hashes_.end() && actualSize + sizeof(uint64_t) <= *pDataSize;
+             it++, entries += sizeof(uint64_t), actualSize += sizeof(uint64_t)) {
+            const uint64_t hash = *it;
+            memcpy(entries, &hash, sizeof(hash));
+            (*shader_hash_count)++;
+        }
+        // Only write specializations once all shader hashes fit, so that a reader sees the right entry sizes
+        if (*shader_hash_count == good_shader_hashes_.size()) {
+            for (auto it = good_specializations_.begin();
+                 it != good_specializations_.end() && actualSize + kSpecializationEntrySize <= *pDataSize;
+                 it++, entries += kSpecializationEntrySize, actualSize += kSpecializationEntrySize) {
+                memcpy(entries, &it->first, sizeof(it->first));
+                memcpy(entries + sizeof(it->first), &it->second, sizeof(it->second));
+            }
+        }
+
+        *pDataSize = actualSize;
+    }
+
     void Sha1ToVkUuid(const char *sha1_str, uint8_t *uuid) {
         // Convert sha1_str from a hex string to binary. We only need VK_UUID_SIZE bytes of
         // output, so pad with zeroes if the input string is shorter than that, and truncate
@@ -150,13 +240,16 @@ class ValidationCache {
     // we don't store negative results, as we would have to also store what was
     // wrong with them; also, we expect they will get fixed, so we're less
     // likely to see them again.
-    layer_data::unordered_set<uint32_t> good_shader_hashes_;
+    layer_data::unordered_set<uint64_t> good_shader_hashes_;
+    // hashes of (shader module, specialization) pairs that passed validation after specialization, and what was derived from them
+    layer_data::unordered_map<uint64_t, SpecializedShaderInfo> good_specializations_;
+    std::atomic<size_t> inserted_count_{0};
     mutable ReadWriteLock lock_;
 };
 
 spv_target_env PickSpirvEnv(uint32_t api_version, bool spirv_1_4);
 
-void AdjustValidatorOptions(const DeviceExtensions &device_extensions, const DeviceFeatures &enabled_features,
-                            spvtools::ValidatorOptions &options);
+uint32_t AdjustValidatorOptions(const DeviceExtensions &device_extensions, const DeviceFeatures &enabled_features,
+                                spvtools::ValidatorOptions &options);
 
 #endif  // VULKAN_SHADER_VALIDATION_H
@@ -1684,6 +1684,7 @@ void ValidationStateTracker::PostCallRecordQueueBindSparse(VkQueue queue, uint32
                 if (buffer_state) {
                     buffer_state->BindMemory(buffer_state.get(), mem_state, sparse_binding.memoryOffset,
                                              sparse_binding.resourceOffset, sparse_binding.size);
+                    buffer_state->InvalidateIndexBufferScans();
                 }
             }
         }
@@ -1771,6 +1772,7 @@ void ValidationStateTracker::RecordMappedMemory(VkDeviceMemory mem, VkDeviceSize
         mem_info->mapped_range.offset = offset;
         mem_info->mapped_range.size = size;
         mem_info->p_driver_data = *ppData;
+        mem_info->map_generation++;
     }
 }
 
@@ -1901,6 +1903,7 @@ void ValidationStateTracker::UpdateBindBufferMemoryState(VkBuffer buffer, VkDevi
         if (mem_state) {
             buffer_state->BindMemory(buffer_state.get(), mem_state, memoryOffset, 0u, buffer_state->requirements.size);
         }
+        buffer_state->InvalidateIndexBufferScans();
     }
 }
 
@@ -3349,6 +3352,30 @@ void ValidationStateTracker::PreCallRecordUnmapMemory(VkDevice device, VkDeviceM
     }
 }
 
+void ValidationStateTracker::PostCallRecordFlushMappedMemoryRanges(VkDevice device, uint32_t memoryRangeCount,
+                                                                   const VkMappedMemoryRange *pMemoryRanges, VkResult result) {
+    if (VK_SUCCESS != result) return;
+    // The flushed host writes may have changed anything derived from the mapped contents
+    for (uint32_t i = 0; i < memoryRangeCount; ++i) {
+        auto mem_info = Get<DEVICE_MEMORY_STATE>(pMemoryRanges[i].memory);
+        if (mem_info) {
+            mem_info->map_generation++;
+        }
+    }
+}
+
+void ValidationStateTracker::PostCallRecordInvalidateMappedMemoryRanges(VkDevice device, uint32_t memoryRangeCount,
+                                                                        const VkMappedMemoryRange *pMemoryRanges, VkResult result) {
+    if (VK_SUCCESS != result) return;
+    // Device writes to the invalidated ranges are now visible to the host through the mapping
+    for (uint32_t i = 0; i < memoryRangeCount; ++i) {
+        auto mem_info = Get<DEVICE_MEMORY_STATE>(pMemoryRanges[i].memory);
+        if (mem_info) {
+            mem_info->map_generation++;
+        }
+    }
+}
+
 void ValidationStateTracker::UpdateBindImageMemoryState(const VkBindImageMemoryInfo &bindInfo) {
     auto image_state = Get<IMAGE_STATE>(bindInfo.image);
     if (image_state) {
@@ -126,8 +126,8 @@ struct create_buffer_api_state {
     VkBufferCreateInfo modified_create_info;
 };
 
-#define VALSTATETRACK_MAP_AND_TRAITS_IMPL(handle_type, state_type, map_member, instance_scope) \
-    vl_concurrent_unordered_map<handle_type, std::shared_ptr<state_type>> map_member; \
+#define VALSTATETRACK_MAP_AND_TRAITS_IMPL(handle_type, state_type, map_member, instance_scope, map_type) \
+    map_type<handle_type, std::shared_ptr<state_type>> map_member; \
     template <typename Dummy> \
     struct MapTraits<state_type, Dummy> { \
         static constexpr bool kInstanceScope = instance_scope; \
@@ -136,9 +136,12 @@ struct create_buffer_api_state {
     };
 
 #define VALSTATETRACK_MAP_AND_TRAITS(handle_type, state_type, map_member) \
-    VALSTATETRACK_MAP_AND_TRAITS_IMPL(handle_type, state_type, map_member, false)
+    VALSTATETRACK_MAP_AND_TRAITS_IMPL(handle_type, state_type, map_member, false, vl_concurrent_unordered_map)
 #define VALSTATETRACK_MAP_AND_TRAITS_INSTANCE_SCOPE(handle_type, state_type, map_member) \
-    VALSTATETRACK_MAP_AND_TRAITS_IMPL(handle_type, state_type, map_member, true)
+    VALSTATETRACK_MAP_AND_TRAITS_IMPL(handle_type, state_type, map_member, true, vl_concurrent_unordered_map)
+// Maps which are looked up on every recorded command, but rarely modified, use lock free lookups.
+#define VALSTATETRACK_MAP_AND_TRAITS_READ_MOSTLY(handle_type, state_type, map_member) \
+    VALSTATETRACK_MAP_AND_TRAITS_IMPL(handle_type, state_type, map_member, false, vl_concurrent_read_mostly_map)
 
 namespace state_object {
 // Traits for State function resolution.  Specializations defined in the macros below.
@@ -399,6 +402,20 @@ class ValidationStateTracker : public ValidationObject {
         return std::static_pointer_cast<State>(std::move(found_it->second));
     };
 
+    // GetBorrowed() returns a non-owning pointer, avoiding the reference counting of Get(). The state object is only
+    // guaranteed to stay alive while its handle cannot be destroyed, i.e. for the duration of an intercepted API call
+    // which uses the handle (destruction must be externally synchronized with the call by the application). The pointer
+    // must not be stored beyond the call, use Get() for that.
+    template <typename State, typename Traits = typename state_object::Traits<State>>
+    State* GetBorrowed(typename Traits::HandleType handle) {
+        return static_cast<State*>(GetStateMap<State>().find_borrowed(handle));
+    }
+
+    template <typename State, typename Traits = typename state_object::Traits<State>>
+    const State* GetBorrowed(typename Traits::HandleType handle) const {
+        return static_cast<const State*>(GetStateMap<State>().find_borrowed(handle));
+    }
+
     // GetRead() and GetWrite() return an already locked state object. Currently this is only supported by
     // CMD_BUFFER_STATE, because it has public ReadLock() and WriteLock() methods.
     // NOTE: Calling base class hook methods with a CMD_BUFFER_STATE lock held will lead to deadlock. Instead,
@@ -428,6 +445,29 @@ class ValidationStateTracker : public ValidationObject {
         }
     };
 
+    // Locked variants of GetBorrowed(), with the same lifetime restrictions.
+    template <typename State, typename Traits = typename state_object::Traits<State>,
+              typename ReadLockedType = LockedBorrowedPtr<const State, ReadLockGuard>>
+    ReadLockedType GetReadBorrowed(typename Traits::HandleType handle) const {
+        auto ptr = GetBorrowed<State>(handle);
+        if (ptr) {
+            return ReadLockedType(ptr, ptr->ReadLock());
+        } else {
+            return ReadLockedType();
+        }
+    };
+
+    template <typename State, typename Traits = typename state_object::Traits<State>,
+              typename WriteLockedType = LockedBorrowedPtr<State, WriteLockGuard>>
+    WriteLockedType GetWriteBorrowed(typename Traits::HandleType handle) {
+        auto ptr = GetBorrowed<State>(handle);
+        if (ptr) {
+            return WriteLockedType(ptr, ptr->WriteLock());
+        } else {
+            return WriteLockedType();
+        }
+    };
+
     // When needing to share ownership, control over constness of access with another object (i.e. adding references while
     // not modifying the contents of the ValidationStateTracker)
     template <typename State, typename Traits = state_object::Traits<State>>
@@ -884,6 +924,10 @@ class ValidationStateTracker : public ValidationObject {
     void PostCallRecordMapMemory(VkDevice device, VkDeviceMemory mem, VkDeviceSize offset, VkDeviceSize size, VkFlags flags,
                                  void** ppData, VkResult result) override;
     void PreCallRecordUnmapMemory(VkDevice device, VkDeviceMemory mem) override;
+    void PostCallRecordFlushMappedMemoryRanges(VkDevice device, uint32_t memoryRangeCount, const VkMappedMemoryRange* pMemoryRanges,
+                                               VkResult result) override;
+    void PostCallRecordInvalidateMappedMemoryRanges(VkDevice device, uint32_t memoryRangeCount,
+                                                    const VkMappedMemoryRange* pMemoryRanges, VkResult result) override;
 
     // Recorded Commands
     void PreCallRecordCmdBeginDebugUtilsLabelEXT(VkCommandBuffer commandBuffer, const VkDebugUtilsLabelEXT* pLabelInfo) override;
@@ -1419,24 +1463,24 @@ class ValidationStateTracker : public ValidationObject {
   private:
     VALSTATETRACK_MAP_AND_TRAITS(VkQueue, QUEUE_STATE, queue_map_)
     VALSTATETRACK_MAP_AND_TRAITS(VkAccelerationStructureNV, ACCELERATION_STRUCTURE_STATE, acceleration_structure_nv_map_)
-    VALSTATETRACK_MAP_AND_TRAITS(VkRenderPass, RENDER_PASS_STATE, render_pass_map_)
-    VALSTATETRACK_MAP_AND_TRAITS(VkDescriptorSetLayout, cvdescriptorset::DescriptorSetLayout, descriptor_set_layout_map_)
-    VALSTATETRACK_MAP_AND_TRAITS(VkSampler, SAMPLER_STATE, sampler_map_)
-    VALSTATETRACK_MAP_AND_TRAITS(VkImageView, IMAGE_VIEW_STATE, image_view_map_)
-    VALSTATETRACK_MAP_AND_TRAITS(VkImage, IMAGE_STATE, image_map_)
-    VALSTATETRACK_MAP_AND_TRAITS(VkBufferView, BUFFER_VIEW_STATE, buffer_view_map_)
-    VALSTATETRACK_MAP_AND_TRAITS(VkBuffer, BUFFER_STATE, buffer_map_)
-    VALSTATETRACK_MAP_AND_TRAITS(VkPipeline, PIPELINE_STATE, pipeline_map_)
+    VALSTATETRACK_MAP_AND_TRAITS_READ_MOSTLY(VkRenderPass, RENDER_PASS_STATE, render_pass_map_)
+    VALSTATETRACK_MAP_AND_TRAITS_READ_MOSTLY(VkDescriptorSetLayout, cvdescriptorset::DescriptorSetLayout, descriptor_set_layout_map_)
+    VALSTATETRACK_MAP_AND_TRAITS_READ_MOSTLY(VkSampler, SAMPLER_STATE, sampler_map_)
+    VALSTATETRACK_MAP_AND_TRAITS_READ_MOSTLY(VkImageView, IMAGE_VIEW_STATE, image_view_map_)
+    VALSTATETRACK_MAP_AND_TRAITS_READ_MOSTLY(VkImage, IMAGE_STATE, image_map_)
+    VALSTATETRACK_MAP_AND_TRAITS_READ_MOSTLY(VkBufferView, BUFFER_VIEW_STATE, buffer_view_map_)
+    VALSTATETRACK_MAP_AND_TRAITS_READ_MOSTLY(VkBuffer, BUFFER_STATE, buffer_map_)
+    VALSTATETRACK_MAP_AND_TRAITS_READ_MOSTLY(VkPipeline, PIPELINE_STATE, pipeline_map_)
     VALSTATETRACK_MAP_AND_TRAITS(VkDeviceMemory, DEVICE_MEMORY_STATE, mem_obj_map_)
-    VALSTATETRACK_MAP_AND_TRAITS(VkFramebuffer, FRAMEBUFFER_STATE, frame_buffer_map_)
+    VALSTATETRACK_MAP_AND_TRAITS_READ_MOSTLY(VkFramebuffer, FRAMEBUFFER_STATE, frame_buffer_map_)
     VALSTATETRACK_MAP_AND_TRAITS(VkShaderModule, SHADER_MODULE_STATE, shader_module_map_)
     VALSTATETRACK_MAP_AND_TRAITS(VkDescriptorUpdateTemplate, UPDATE_TEMPLATE_STATE, desc_template_map_)
     VALSTATETRACK_MAP_AND_TRAITS(VkSwapchainKHR, SWAPCHAIN_NODE, swapchain_map_)
     VALSTATETRACK_MAP_AND_TRAITS(VkDescriptorPool, DESCRIPTOR_POOL_STATE, descriptor_pool_map_)
     VALSTATETRACK_MAP_AND_TRAITS(VkDescriptorSet, cvdescriptorset::DescriptorSet, descriptor_set_map_)
-    VALSTATETRACK_MAP_AND_TRAITS(VkCommandBuffer, CMD_BUFFER_STATE, command_buffer_map_)
+    VALSTATETRACK_MAP_AND_TRAITS_READ_MOSTLY(VkCommandBuffer, CMD_BUFFER_STATE, command_buffer_map_)
     VALSTATETRACK_MAP_AND_TRAITS(VkCommandPool, COMMAND_POOL_STATE, command_pool_map_)
-    VALSTATETRACK_MAP_AND_TRAITS(VkPipelineLayout, PIPELINE_LAYOUT_STATE, pipeline_layout_map_)
+    VALSTATETRACK_MAP_AND_TRAITS_READ_MOSTLY(VkPipelineLayout, PIPELINE_LAYOUT_STATE, pipeline_layout_map_)
     VALSTATETRACK_MAP_AND_TRAITS(VkFence, FENCE_STATE, fence_map_)
     VALSTATETRACK_MAP_AND_TRAITS(VkQueryPool, QUERY_POOL_STATE, query_pool_map_)
     VALSTATETRACK_MAP_AND_TRAITS(VkSemaphore, SEMAPHORE_STATE, semaphore_map_)
@@ -63,19 +63,15 @@ VkPipelineStageFlags2KHR ExpandPipelineStages(VkPipelineStageFlags2KHR stage_mas
 
     if (VK_PIPELINE_STAGE_ALL_COMMANDS_BIT & stage_mask) {
         expanded &= ~VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
-        for (const auto &all_commands : syncAllCommandStagesByQueueFlags) {
-            if (all_commands.first & queue_flags) {
-                expanded |= all_commands.second & ~disabled_feature_mask;
-            }
-        }
+        expanded |= SyncBitTableUnion(syncAllCommandStagesByQueueFlags, queue_flags) & ~disabled_feature_mask;
     }
     if (VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT & stage_mask) {
         expanded &= ~VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT;
         // Make sure we don't pull in the HOST stage from expansion, but keep it if set by the caller.
         // The syncAllCommandStagesByQueueFlags table includes HOST for all queue types since it is
         // allowed but it shouldn't be part of ALL_GRAPHICS
-        expanded |=
-            syncAllCommandStagesByQueueFlags.at(VK_QUEUE_GRAPHICS_BIT) & ~disabled_feature_mask & ~VK_PIPELINE_STAGE_HOST_BIT;
+        expanded |= syncAllCommandStagesByQueueFlags[LeastSignificantBit(VK_QUEUE_GRAPHICS_BIT)] & ~disabled_feature_mask &
+                    ~VK_PIPELINE_STAGE_HOST_BIT;
     }
     if (VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT_KHR & stage_mask) {
         expanded &= ~VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT_KHR;
@@ -116,18 +112,7 @@ VkAccessFlags2KHR ExpandAccessFlags(VkAccessFlags2KHR access_mask) {
 }
 
 VkAccessFlags2KHR CompatibleAccessMask(VkPipelineStageFlags2KHR stage_mask) {
-    VkAccessFlags2KHR result = 0;
-    stage_mask = ExpandPipelineStages(stage_mask);
-    for (size_t i = 0; i < kNumPipelineStageBits; i++) {
-        VkPipelineStageFlags2KHR bit = 1ULL << i;
-        if (stage_mask & bit) {
-            auto access_rec = syncDirectStageToAccessMask.find(bit);
-            if (access_rec != syncDirectStageToAccessMask.end()) {
-                result |= access_rec->second;
-                continue;
-            }
-        }
-    }
+    VkAccessFlags2KHR result = SyncBitTableUnion(syncDirectStageToAccessMask, ExpandPipelineStages(stage_mask));
 
     // put the meta-access bits back on
     if (result & kShaderReadExpandBits) {
@@ -141,35 +126,20 @@ VkAccessFlags2KHR CompatibleAccessMask(VkPipelineStageFlags2KHR stage_mask) {
     return result;
 }
 
-VkPipelineStageFlags2KHR RelatedPipelineStages(VkPipelineStageFlags2KHR stage_mask,
-                                               const std::map<VkPipelineStageFlags2KHR, VkPipelineStageFlags2KHR> &map) {
-    VkPipelineStageFlags2KHR unscanned = stage_mask;
-    VkPipelineStageFlags2KHR related = 0;
-    for (const auto &entry : map) {
-        const auto &stage = entry.first;
-        if (stage & unscanned) {
-            related = related | entry.second;
-            unscanned = unscanned & ~stage;
-            if (!unscanned) break;
-        }
-    }
-    return related;
-}
-
 VkPipelineStageFlags2KHR WithEarlierPipelineStages(VkPipelineStageFlags2KHR stage_mask) {
-    return stage_mask | RelatedPipelineStages(stage_mask, syncLogicallyEarlierStages);
+    return stage_mask | SyncBitTableUnion(syncLogicallyEarlierStages, stage_mask);
 }
 
 VkPipelineStageFlags2KHR WithLaterPipelineStages(VkPipelineStageFlags2KHR stage_mask) {
-    return stage_mask | RelatedPipelineStages(stage_mask, syncLogicallyLaterStages);
+    return stage_mask | SyncBitTableUnion(syncLogicallyLaterStages, stage_mask);
 }
 
 int GetGraphicsPipelineStageLogicalOrdinal(VkPipelineStageFlags2KHR flag) {
-    const auto &rec = syncStageOrder.find(flag);
-    if (rec == syncStageOrder.end()) {
+    // Only single stage bits have an ordinal
+    if (!flag || (flag & (flag - 1))) {
         return -1;
     }
-    return rec->second;
+    return syncStageOrder[LeastSignificantBit(flag)];
 }
 
 // The following two functions technically have O(N^2) complexity, but it's for a value of O that's largely
@@ -19,6 +19,9 @@
  * Author: Jeremy Gebben <jeremyg@lunarg.com>
  */
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <limits>
 #include <vector>
 #include <memory>
@@ -626,22 +629,20 @@ SyncStageAccessIndex GetSyncStageAccessIndexsByDescriptorSet(VkDescriptorType de
         assert(stage_flag == VK_SHADER_STAGE_FRAGMENT_BIT);
         return SYNC_FRAGMENT_SHADER_INPUT_ATTACHMENT_READ;
     }
-    auto stage_access = syncStageAccessMaskByShaderStage.find(stage_flag);
-    if (stage_access == syncStageAccessMaskByShaderStage.end()) {
-        assert(0);
-    }
+    const auto &stage_access = syncStageAccessMaskByShaderStage[LeastSignificantBit(stage_flag) & 31];
+    assert(stage_access.uniform_read != SYNC_ACCESS_INDEX_NONE);
     if (descriptor_type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER || descriptor_type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC) {
-        return stage_access->second.uniform_read;
+        return stage_access.uniform_read;
     }
 
     // If the desriptorSet is writable, we don't need to care SHADER_READ. SHADER_WRITE is enough.
     // Because if write hazard happens, read hazard might or might not happen.
     // But if write hazard doesn't happen, read hazard is impossible to happen.
     if (descriptor_data.is_writable) {
-        return stage_access->second.storage_write;
+        return stage_access.storage_write;
     }
     // TODO: sampled_read
-    return stage_access->second.storage_read;
+    return stage_access.storage_read;
 }
 
 bool IsImageLayoutDepthWritable(VkImageLayout image_layout) {
@@ -991,7 +992,7 @@ static void ResolveMapToEntry(ResourceAccessRangeMap *dest, ResourceAccessRangeM
     auto at = entry;
     for (auto pos = first; pos != last; ++pos) {
         // Every member of the input iterator range must fit within the remaining portion of entry
-        assert(at->first.includes(pos->first));
+        assert(at.key().includes(pos->first));
         assert(at != dest->end());
         // Trim up at to the same size as the entry to resolve
         at = sparse_container::split(at, *dest, pos->first);
@@ -1061,6 +1062,14 @@ void AccessContext::ResolveAccessRange(AccessAddressType type, const ResourceAcc
                 // If we didn't find anything in the current range, and we aren't reccuring... we infill if required
                 auto inserted = resolve_map->insert(current->pos_A->lower_bound, std::make_pair(current->range, *infill_state));
                 current.invalidate_A(inserted);  // Update the parallel iterator to point at the correct segment after insert
+            } else if (!infill_state) {
+                // Nothing to resolve until the next source entry, so seek to it rather than stepping through each of the
+                // resolve_map entries in between. Keeps resolving a small context into a large one proportional to the small one.
+                if (current->pos_B.at_end()) break;
+                const ResourceAccessRangeIndex next_source = current->pos_B->lower_bound->first.begin;
+                if (!range.includes(next_source)) break;
+                current.seek(next_source);
+                continue;
             }
         }
         if (current->range.non_empty()) {
@@ -1364,6 +1373,20 @@ bool AccessContext::ValidateResolveOperations(const CommandExecutionContext &exe
 
 void AccessContext::AddAsyncContext(const AccessContext *context) { async_.emplace_back(context); }
 
+void AccessContext::ShareAccessStateMaps(const AccessContext &from) {
+    for (const auto address_type : kAddressTypes) {
+        GetAccessStateMap(address_type).share(from.GetAccessStateMap(address_type));
+    }
+}
+
+void AccessContext::GatherReferencedTags(ResourceUsageTagSet &used) const {
+    for (const auto address_type : kAddressTypes) {
+        for (const auto &entry : GetAccessStateMap(address_type)) {
+            entry.second.GatherReferencedTags(used);
+        }
+    }
+}
+
 class HazardDetector {
     SyncStageAccessIndex usage_index_;
 
@@ -1611,25 +1634,12 @@ HazardResult AccessContext::DetectImageBarrierHazard(const SyncImageMemoryBarrie
                                     image_barrier.barrier.src_access_scope, image_barrier.range, kDetectAll);
 }
 
-template <typename Flags, typename Map>
-SyncStageAccessFlags AccessScopeImpl(Flags flag_mask, const Map &map) {
-    SyncStageAccessFlags scope = 0;
-    for (const auto &bit_scope : map) {
-        if (flag_mask < bit_scope.first) break;
-
-        if (flag_mask & bit_scope.first) {
-            scope |= bit_scope.second;
-        }
-    }
-    return scope;
-}
-
 SyncStageAccessFlags SyncStageAccess::AccessScopeByStage(VkPipelineStageFlags2KHR stages) {
-    return AccessScopeImpl(stages, syncStageAccessMaskByStageBit);
+    return SyncBitTableUnion(syncStageAccessMaskByStageBit, stages);
 }
 
 SyncStageAccessFlags SyncStageAccess::AccessScopeByAccess(VkAccessFlags2KHR accesses) {
-    return AccessScopeImpl(sync_utils::ExpandAccessFlags(accesses), syncStageAccessMaskByAccessBit);
+    return SyncBitTableUnion(syncStageAccessMaskByAccessBit, sync_utils::ExpandAccessFlags(accesses));
 }
 
 // Getting from stage mask and access mask to stage/access masks is something we need to be good at...
@@ -1646,21 +1656,21 @@ void UpdateMemoryAccessState(ResourceAccessRangeMap *accesses, const ResourceAcc
     //       that do incrementalupdates
     assert(accesses);
     auto pos = accesses->lower_bound(range);
-    if (pos == accesses->end() || !pos->first.intersects(range)) {
+    if (pos == accesses->end() || !pos.key().intersects(range)) {
         // The range is empty, fill it with a default value.
         pos = action.Infill(accesses, pos, range);
-    } else if (range.begin < pos->first.begin) {
+    } else if (range.begin < pos.key().begin) {
         // Leading empty space, infill
-        pos = action.Infill(accesses, pos, ResourceAccessRange(range.begin, pos->first.begin));
-    } else if (pos->first.begin < range.begin) {
+        pos = action.Infill(accesses, pos, ResourceAccessRange(range.begin, pos.key().begin));
+    } else if (pos.key().begin < range.begin) {
         // Trim the beginning if needed
         pos = accesses->split(pos, range.begin, sparse_container::split_op_keep_both());
         ++pos;
     }
 
     const auto the_end = accesses->end();
-    while ((pos != the_end) && pos->first.intersects(range)) {
-        if (pos->first.end > range.end) {
+    while ((pos != the_end) && pos.key().intersects(range)) {
+        if (pos.key().end > range.end) {
             pos = accesses->split(pos, range.end, sparse_container::split_op_keep_both());
         }
 
@@ -1669,10 +1679,10 @@ void UpdateMemoryAccessState(ResourceAccessRangeMap *accesses, const ResourceAcc
 
         auto next = pos;
         ++next;
-        if ((pos->first.end < range.end) && (next != the_end) && !next->first.is_subsequent_to(pos->first)) {
+        if ((pos.key().end < range.end) && (next != the_end) && !next.key().is_subsequent_to(pos.key())) {
             // Need to infill if next is disjoint
-            VkDeviceSize limit = (next == the_end) ? range.end : std::min(range.end, next->first.begin);
-            ResourceAccessRange new_range(pos->first.end, limit);
+            VkDeviceSize limit = (next == the_end) ? range.end : std::min(range.end, next.key().begin);
+            ResourceAccessRange new_range(pos.key().end, limit);
             next = action.Infill(accesses, next, new_range);
         }
         pos = next;
@@ -3004,11 +3014,11 @@ HazardResult ResourceAccessState::DetectHazard(SyncStageAccessIndex usage_index)
         //
         // Look for casus belli for WAR
         if (last_reads.size()) {
-            for (const auto &read_access : last_reads) {
-                if (IsReadHazard(usage_stage, read_access)) {
-                    hazard.Set(this, usage_index, WRITE_AFTER_READ, read_access.access, read_access.tag);
-                    break;
-                }
+            const auto read_hazards = last_reads.ReadHazards(usage_stage);
+            if (read_hazards) {
+                const auto read_index = ReadStates::First(read_hazards);
+                hazard.Set(this, usage_index, WRITE_AFTER_READ, FlagBit(last_reads.Accesses()[read_index]),
+                           last_reads.Tags()[read_index]);
             }
         } else if (last_write.any() && IsWriteHazard(usage)) {
             // Write-After-Write check -- if we have a previous write to test against
@@ -3066,12 +3076,12 @@ HazardResult ResourceAccessState::DetectHazard(SyncStageAccessIndex usage_index,
             }
             // If we're tracking any reads that aren't ordered against the current write, got to check 'em all.
             if ((ordered_stages & last_read_stages) != last_read_stages) {
-                for (const auto &read_access : last_reads) {
-                    if (read_access.stage & ordered_stages) continue;  // but we can skip the ordered ones
-                    if (IsReadHazard(usage_stage, read_access)) {
-                        hazard.Set(this, usage_index, WRITE_AFTER_READ, read_access.access, read_access.tag);
-                        break;
-                    }
+                // but we can skip the ordered ones
+                const auto read_hazards = last_reads.ReadHazards(usage_stage, ordered_stages);
+                if (read_hazards) {
+                    const auto read_index = ReadStates::First(read_hazards);
+                    hazard.Set(this, usage_index, WRITE_AFTER_READ, FlagBit(last_reads.Accesses()[read_index]),
+                               last_reads.Tags()[read_index]);
                 }
             }
         } else if (last_write.any() && !(last_write_is_ordered && usage_write_is_ordered)) {
@@ -3161,11 +3171,11 @@ HazardResult ResourceAccessState::DetectAsyncHazard(SyncStageAccessIndex usage_i
             hazard.Set(this, usage_index, WRITE_RACING_WRITE, last_write, write_tag);
         } else if (last_reads.size() > 0) {
             // Any reads during the other subpass will conflict with this write, so we need to check them all.
-            for (const auto &read_access : last_reads) {
-                if (read_access.tag >= start_tag) {
-                    hazard.Set(this, usage_index, WRITE_RACING_READ, read_access.access, read_access.tag);
-                    break;
-                }
+            const auto racing_reads = last_reads.TaggedAtOrAfter(start_tag);
+            if (racing_reads) {
+                const auto read_index = ReadStates::First(racing_reads);
+                hazard.Set(this, usage_index, WRITE_RACING_READ, FlagBit(last_reads.Accesses()[read_index]),
+                           last_reads.Tags()[read_index]);
             }
         }
     }
@@ -3199,11 +3209,14 @@ HazardResult ResourceAccessState::DetectBarrierHazard(SyncStageAccessIndex usage
     // See DetectHazard(SyncStagetAccessIndex) above for more details.
     if (last_reads.size()) {
         // Look at the reads if any
-        for (const auto &read_access : last_reads) {
-            if (read_access.IsReadBarrierHazard(queue_id, src_exec_scope)) {
-                hazard.Set(this, usage_index, WRITE_AFTER_READ, read_access.access, read_access.tag);
-                break;
-            }
+        // If the read stage is not in the src sync scope
+        // *AND* not execution chained with an existing sync barrier (that's the or)
+        // then the barrier access is unsafe (R/W after R)
+        const auto read_hazards = ~last_reads.InQueueScopeOrChain(queue_id, src_exec_scope) & last_reads.All();
+        if (read_hazards) {
+            const auto read_index = ReadStates::First(read_hazards);
+            hazard.Set(this, usage_index, WRITE_AFTER_READ, FlagBit(last_reads.Accesses()[read_index]),
+                       last_reads.Tags()[read_index]);
         }
     } else if (last_write.any() && IsWriteBarrierHazard(queue_id, src_exec_scope, src_access_scope)) {
         hazard.Set(this, usage_index, WRITE_AFTER_WRITE, last_write, write_tag);
@@ -3235,27 +3248,27 @@ HazardResult ResourceAccessState::DetectBarrierHazard(SyncStageAccessIndex usage
             //  * The current read state is a superset of the scoped one
             //  * The stage order is the same.
             assert(last_reads.size() >= scope_read_count);
+            // If the read stage is not in the src sync scope
+            // *AND* not execution chained with an existing sync barrier (that's the or)
+            // then the barrier access is unsafe (R/W after R)
+            const auto scope_read_safe = scope_reads.InQueueScopeOrChain(event_queue, src_exec_scope);
+            const ResourceUsageTag *current_tags = last_reads.Tags();
             for (ReadStates::size_type read_idx = 0; read_idx < scope_read_count; ++read_idx) {
-                const ReadState &scope_read = scope_reads[read_idx];
-                const ReadState &current_read = last_reads[read_idx];
-                assert(scope_read.stage == current_read.stage);
-                if (current_read.tag > event_tag) {
+                assert(scope_reads.Stages()[read_idx] == last_reads.Stages()[read_idx]);
+                if (current_tags[read_idx] > event_tag) {
                     // The read is more recent than the set event scope, thus no barrier from the wait/ILT.
-                    hazard.Set(this, usage_index, WRITE_AFTER_READ, current_read.access, current_read.tag);
-                } else {
+                    hazard.Set(this, usage_index, WRITE_AFTER_READ, FlagBit(last_reads.Accesses()[read_idx]),
+                               current_tags[read_idx]);
+                } else if (0 == (scope_read_safe & (ReadStates::ReadMask(1) << read_idx))) {
                     // The read is in the events first synchronization scope, so we use a barrier hazard check
-                    // If the read stage is not in the src sync scope
-                    // *AND* not execution chained with an existing sync barrier (that's the or)
-                    // then the barrier access is unsafe (R/W after R)
-                    if (scope_read.IsReadBarrierHazard(event_queue, src_exec_scope)) {
-                        hazard.Set(this, usage_index, WRITE_AFTER_READ, scope_read.access, scope_read.tag);
-                        break;
-                    }
+                    hazard.Set(this, usage_index, WRITE_AFTER_READ, FlagBit(scope_reads.Accesses()[read_idx]),
+                               scope_reads.Tags()[read_idx]);
+                    break;
                 }
             }
             if (!hazard.IsHazard() && (last_reads.size() > scope_read_count)) {
-                const ReadState &current_read = last_reads[scope_read_count];
-                hazard.Set(this, usage_index, WRITE_AFTER_READ, current_read.access, current_read.tag);
+                hazard.Set(this, usage_index, WRITE_AFTER_READ, FlagBit(last_reads.Accesses()[scope_read_count]),
+                           current_tags[scope_read_count]);
             }
         } else if (last_write.any()) {
             // if there are no reads, the write is either the reason the access is in the event scope... they are a hazard
@@ -3290,35 +3303,38 @@ void ResourceAccessState::Resolve(const ResourceAccessState &other) {
         // Merge the read states
         const auto pre_merge_count = last_reads.size();
         const auto pre_merge_stages = last_read_stages;
-        for (uint32_t other_read_index = 0; other_read_index < other.last_reads.size(); other_read_index++) {
-            auto &other_read = other.last_reads[other_read_index];
-            if (pre_merge_stages & other_read.stage) {
+        const ReadStates &other_reads = other.last_reads;
+        for (uint32_t other_read_index = 0; other_read_index < other_reads.size(); other_read_index++) {
+            const auto other_stage = other_reads.Stages()[other_read_index];
+            if (pre_merge_stages & other_stage) {
                 // Merge in the barriers for read stages that exist in *both* this and other
                 // TODO: This is N^2 with stages... perhaps the ReadStates should be sorted by stage index.
                 //       but we should wait on profiling data for that.
+                const VkPipelineStageFlags2KHR *my_stages = last_reads.Stages();
                 for (uint32_t my_read_index = 0; my_read_index < pre_merge_count; my_read_index++) {
-                    auto &my_read = last_reads[my_read_index];
-                    if (other_read.stage == my_read.stage) {
-                        if (my_read.tag < other_read.tag) {
+                    if (other_stage == my_stages[my_read_index]) {
+                        ResourceUsageTag &my_tag = last_reads.Tags()[my_read_index];
+                        const ResourceUsageTag other_tag = other_reads.Tags()[other_read_index];
+                        if (my_tag < other_tag) {
                             // Other is more recent, copy in the state
-                            my_read.access = other_read.access;
-                            my_read.tag = other_read.tag;
-                            my_read.queue = other_read.queue;
-                            my_read.pending_dep_chain = other_read.pending_dep_chain;
+                            last_reads.Accesses()[my_read_index] = other_reads.Accesses()[other_read_index];
+                            my_tag = other_tag;
+                            last_reads.Queues()[my_read_index] = other_reads.Queues()[other_read_index];
+                            last_reads.PendingDepChains()[my_read_index] = other_reads.PendingDepChains()[other_read_index];
                             // TODO: Phase 2 -- review the state merge logic to avoid false positive from overwriting the barriers
                             //                  May require tracking more than one access per stage.
-                            my_read.barriers = other_read.barriers;
-                            my_read.sync_stages = other_read.sync_stages;
-                            if (my_read.stage == VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT_KHR) {
+                            last_reads.Barriers()[my_read_index] = other_reads.Barriers()[other_read_index];
+                            last_reads.SyncStages()[my_read_index] = other_reads.SyncStages()[other_read_index];
+                            if (other_stage == VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT_KHR) {
                                 // Since I'm overwriting the fragement stage read, also update the input attachment info
                                 // as this is the only stage that affects it.
                                 input_attachment_read = other.input_attachment_read;
                             }
-                        } else if (other_read.tag == my_read.tag) {
+                        } else if (other_tag == my_tag) {
                             // The read tags match so merge the barriers
-                            my_read.barriers |= other_read.barriers;
-                            my_read.sync_stages |= other_read.sync_stages;
-                            my_read.pending_dep_chain |= other_read.pending_dep_chain;
+                            last_reads.Barriers()[my_read_index] |= other_reads.Barriers()[other_read_index];
+                            last_reads.SyncStages()[my_read_index] |= other_reads.SyncStages()[other_read_index];
+                            last_reads.PendingDepChains()[my_read_index] |= other_reads.PendingDepChains()[other_read_index];
                         }
 
                         break;
@@ -3326,9 +3342,9 @@ void ResourceAccessState::Resolve(const ResourceAccessState &other) {
                 }
             } else {
                 // The other read stage doesn't exist in this, so add it.
-                last_reads.emplace_back(other_read);
-                last_read_stages |= other_read.stage;
-                if (other_read.stage == VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT_KHR) {
+                last_reads.Append(other_reads, other_read_index);
+                last_read_stages |= other_stage;
+                if (other_stage == VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT_KHR) {
                     input_attachment_read = other.input_attachment_read;
                 }
             }
@@ -3368,28 +3384,33 @@ void ResourceAccessState::Update(SyncStageAccessIndex usage_index, SyncOrdering
         // Mulitple outstanding reads may be of interest and do dependency chains independently
         // However, for purposes of barrier tracking, only one read per pipeline stage matters
         const auto usage_stage = PipelineStageBit(usage_index);
+        const auto read_count = last_reads.size();
+        const VkPipelineStageFlags2KHR *stages = last_reads.Stages();
+        const VkPipelineStageFlags2KHR *barriers = last_reads.Barriers();
+        VkPipelineStageFlags2KHR *sync_stages = last_reads.SyncStages();
         if (usage_stage & last_read_stages) {
-            const auto not_usage_stage = ~usage_stage;
-            for (auto &read_access : last_reads) {
-                if (read_access.stage == usage_stage) {
-                    read_access.Set(usage_stage, usage_bit, 0, tag);
-                } else if (read_access.barriers & usage_stage) {
+            ReadStates::size_type usage_read = 0;
+            for (ReadStates::size_type i = 0; i < read_count; ++i) {
+                if (barriers[i] & usage_stage) {
                     // If the current access is barriered to this stage, mark it as "known to happen after"
-                    read_access.sync_stages |= usage_stage;
+                    sync_stages[i] |= usage_stage;
                 } else {
                     // If the current access is *NOT* barriered to this stage it needs to be cleared.
                     // Note: this is possible because semaphores can *clear* effective barriers, so the assumption
                     //       that sync_stages is a subset of barriers may not apply.
-                    read_access.sync_stages &= not_usage_stage;
+                    sync_stages[i] &= ~usage_stage;
                 }
+                if (stages[i] == usage_stage) usage_read = i;
             }
+            // The read from the usage stage is replaced, including its sync_stages
+            last_reads.Set(usage_read, usage_stage, usage_index, 0, tag);
         } else {
-            for (auto &read_access : last_reads) {
-                if (read_access.barriers & usage_stage) {
-                    read_access.sync_stages |= usage_stage;
+            for (ReadStates::size_type i = 0; i < read_count; ++i) {
+                if (barriers[i] & usage_stage) {
+                    sync_stages[i] |= usage_stage;
                 }
             }
-            last_reads.emplace_back(usage_stage, usage_bit, 0, tag);
+            last_reads.Append(usage_stage, usage_index, 0, tag);
             last_read_stages |= usage_stage;
         }
 
@@ -3459,24 +3480,13 @@ void ResourceAccessState::ApplyBarrier(ScopeOps &&scope, const SyncBarrier &barr
     if (!pending_layout_transition) {
         // Once we're dealing with a layout transition (which is modelled as a *write*) then the last reads/chains
         // don't need to be tracked as we're just going to clear them.
-        VkPipelineStageFlags2 stages_in_scope = VK_PIPELINE_STAGE_2_NONE;
-
-        for (auto &read_access : last_reads) {
-            // The | implements the "dependency chain" logic for this access, as the barriers field stores the second sync scope
-            if (scope.ReadInScope(barrier, read_access)) {
-                // We'll apply the barrier in the next loop, because it's DRY'r to do it one place.
-                stages_in_scope |= read_access.stage;
-            }
-        }
+        // The scope test includes the "dependency chain" logic for each read, as the barriers field stores the second sync scope
+        const VkPipelineStageFlags2 stages_in_scope = last_reads.StagesOf(scope.ReadsInScope(barrier, last_reads));
 
-        for (auto &read_access : last_reads) {
-            if (0 != ((read_access.stage | read_access.sync_stages) & stages_in_scope)) {
-                // If this stage, or any stage known to be synchronized after it are in scope, apply the barrier to this read
-                // NOTE: Forwarding barriers to known prior stages changes the sync_stages from shallow to deep, because the
-                //       barriers used to determine sync_stages have been propagated to all known earlier stages
-                read_access.pending_dep_chain |= barrier.dst_exec_scope.exec_scope;
-            }
-        }
+        // If this stage, or any stage known to be synchronized after it are in scope, apply the barrier to this read
+        // NOTE: Forwarding barriers to known prior stages changes the sync_stages from shallow to deep, because the
+        //       barriers used to determine sync_stages have been propagated to all known earlier stages
+        last_reads.PendDepChain(stages_in_scope, barrier.dst_exec_scope.exec_scope);
     }
 }
 
@@ -3492,11 +3502,7 @@ void ResourceAccessState::ApplyPendingBarriers(const ResourceUsageTag tag) {
 
     // Apply the accumulate execution barriers (and thus update chaining information)
     // for layout transition, last_reads is reset by SetWrite, so this will be skipped.
-    for (auto &read_access : last_reads) {
-        read_access.barriers |= read_access.pending_dep_chain;
-        read_execution_barriers |= read_access.barriers;
-        read_access.pending_dep_chain = 0;
-    }
+    read_execution_barriers |= last_reads.ApplyPendingDepChains();
 
     // We OR in the accumulated write chain and barriers even in the case of a layout transition as SetWrite zeros them.
     write_dependency_chain |= pending_write_dep_chain;
@@ -3510,14 +3516,12 @@ void ResourceAccessState::ApplySemaphore(const SemaphoreScope &signal, const Sem
     // Semaphores only guarantee the first scope of the signal is before the second scope of the wait.
     // If any access isn't in the first scope, there are no guarantees, thus those barriers are cleared
     assert(signal.queue != wait.queue);
-    for (auto &read_access : last_reads) {
-        if (read_access.ReadInQueueScopeOrChain(signal.queue, signal.exec_scope)) {
-            // Deflects WAR on wait queue
-            read_access.barriers = wait.exec_scope;
-        } else {
-            // Leave sync stages alone. Update method will clear unsynchronized stages on subsequent reads as needed.
-            read_access.barriers = VK_PIPELINE_STAGE_2_NONE;
-        }
+    const auto reads_in_scope = last_reads.InQueueScopeOrChain(signal.queue, signal.exec_scope);
+    VkPipelineStageFlags2KHR *barriers = last_reads.Barriers();
+    for (ReadStates::size_type i = 0; i < last_reads.size(); ++i) {
+        // In scope deflects WAR on wait queue.  Otherwise, leave sync stages alone, the Update method will clear
+        // unsynchronized stages on subsequent reads as needed.
+        barriers[i] = ((reads_in_scope >> i) & 1) ? wait.exec_scope : VK_PIPELINE_STAGE_2_NONE;
     }
     if (WriteInQueueSourceScopeOrChain(signal.queue, signal.exec_scope, signal.valid_accesses)) {
         // Will deflect RAW wait queue, WAW needs a chained barrier on wait queue
@@ -3545,20 +3549,25 @@ bool ResourceAccessState::ApplyQueueTagWait(Pred &&queue_tag_test) {
 
     // Use the predicate to build a mask of the read stages we are synchronizing
     // Use the sync_stages to also detect reads known to be before any synchronized reads (first pass)
-    for (auto &read_access : last_reads) {
-        if (queue_tag_test(read_access.queue, read_access.tag)) {
+    const auto read_count = last_reads.size();
+    const VkPipelineStageFlags2KHR *stages = last_reads.Stages();
+    const VkPipelineStageFlags2KHR *sync_stages = last_reads.SyncStages();
+    const QueueId *queues = last_reads.Queues();
+    const ResourceUsageTag *tags = last_reads.Tags();
+    for (ReadStates::size_type i = 0; i < read_count; ++i) {
+        if (queue_tag_test(queues[i], tags[i])) {
             // If we know this stage is before any stage we syncing, or if the predicate tells us that we are waited for..
-            sync_reads |= read_access.stage;
+            sync_reads |= stages[i];
         }
     }
 
     // Now that we know the reads directly in scopejust need to go over the list again to pick up the "known earlier" stages.
     // NOTE: sync_stages is "deep" catching all stages synchronized after it because we forward barriers
     uint32_t unsync_count = 0;
-    for (auto &read_access : last_reads) {
-        if (0 != ((read_access.stage | read_access.sync_stages) & sync_reads)) {
+    for (ReadStates::size_type i = 0; i < read_count; ++i) {
+        if (0 != ((stages[i] | sync_stages[i]) & sync_reads)) {
             // This is redundant in the "stage" case, but avoids a second branch to get an accurate count
-            sync_reads |= read_access.stage;
+            sync_reads |= stages[i];
         } else {
             ++unsync_count;
         }
@@ -3566,18 +3575,9 @@ bool ResourceAccessState::ApplyQueueTagWait(Pred &&queue_tag_test) {
 
     if (unsync_count) {
         if (sync_reads) {
-            // When have some remaining unsynchronized reads, we have to rewrite the last_reads array.
-            ReadStates unsync_reads;
-            unsync_reads.reserve(unsync_count);
-            VkPipelineStageFlags2KHR unsync_read_stages = VK_PIPELINE_STAGE_2_NONE;
-            for (auto &read_access : last_reads) {
-                if (0 == (read_access.stage & sync_reads)) {
-                    unsync_reads.emplace_back(read_access);
-                    unsync_read_stages |= read_access.stage;
-                }
-            }
-            last_read_stages = unsync_read_stages;
-            last_reads = std::move(unsync_reads);
+            // When have some remaining unsynchronized reads, we have to compact the last_reads columns.
+            last_reads.EraseStages(sync_reads);
+            last_read_stages &= ~sync_reads;
         }
     } else {
         // Nothing remains (or it was empty to begin with)
@@ -3605,10 +3605,34 @@ bool ResourceAccessState::FirstAccessInTagRange(const ResourceUsageRange &tag_ra
     return tag_range.intersects(first_access_range);
 }
 
+void ResourceUsageTagSet::Normalize() {
+    std::sort(tags_.begin(), tags_.end());
+    tags_.erase(std::unique(tags_.begin(), tags_.end()), tags_.end());
+}
+
+std::pair<ResourceUsageTagSet::const_iterator, ResourceUsageTagSet::const_iterator> ResourceUsageTagSet::InRange(
+    const ResourceUsageRange &range) const {
+    const auto first = std::lower_bound(tags_.cbegin(), tags_.cend(), range.begin);
+    const auto second = std::lower_bound(first, tags_.cend(), range.end);
+    return std::make_pair(first, second);
+}
+
+void ResourceAccessState::GatherReferencedTags(ResourceUsageTagSet &used) const {
+    if (last_write.any()) used.insert(write_tag);
+    const ResourceUsageTag *read_tags = last_reads.Tags();
+    for (ReadStates::size_type i = 0; i < last_reads.size(); ++i) {
+        used.insert(read_tags[i]);
+    }
+    for (const auto &first : first_accesses_) {
+        used.insert(first.tag);
+    }
+}
+
 void ResourceAccessState::OffsetTag(ResourceUsageTag offset) {
     if (last_write.any()) write_tag += offset;
-    for (auto &read_access : last_reads) {
-        read_access.tag += offset;
+    ResourceUsageTag *read_tags = last_reads.Tags();
+    for (ReadStates::size_type i = 0; i < last_reads.size(); ++i) {
+        read_tags[i] += offset;
     }
     for (auto &first : first_accesses_) {
         first.tag += offset;
@@ -3636,9 +3660,9 @@ ResourceAccessState::ResourceAccessState()
 VkPipelineStageFlags2KHR ResourceAccessState::GetReadBarriers(const SyncStageAccessFlags &usage_bit) const {
     VkPipelineStageFlags2KHR barriers = 0U;
 
-    for (const auto &read_access : last_reads) {
-        if ((read_access.access & usage_bit).any()) {
-            barriers = read_access.barriers;
+    for (ReadStates::size_type i = 0; i < last_reads.size(); ++i) {
+        if ((FlagBit(last_reads.Accesses()[i]) & usage_bit).any()) {
+            barriers = last_reads.Barriers()[i];
             break;
         }
     }
@@ -3647,9 +3671,10 @@ VkPipelineStageFlags2KHR ResourceAccessState::GetReadBarriers(const SyncStageAcc
 }
 
 void ResourceAccessState::SetQueueId(QueueId id) {
-    for (auto &read_access : last_reads) {
-        if (read_access.queue == QueueSyncState::kQueueIdInvalid) {
-            read_access.queue = id;
+    QueueId *read_queues = last_reads.Queues();
+    for (ReadStates::size_type i = 0; i < last_reads.size(); ++i) {
+        if (read_queues[i] == QueueSyncState::kQueueIdInvalid) {
+            read_queues[i] = id;
         }
     }
     if (last_write.any() && (write_queue == QueueSyncState::kQueueIdInvalid)) {
@@ -3706,11 +3731,7 @@ VkPipelineStageFlags2 ResourceAccessState::GetOrderedStages(QueueId queue_id, co
     // At apply queue submission order limits on the effect of ordering
     VkPipelineStageFlags2 non_qso_stages = VK_PIPELINE_STAGE_2_NONE;
     if (queue_id != QueueSyncState::kQueueIdInvalid) {
-        for (const auto &read_access : last_reads) {
-            if (read_access.queue != queue_id) {
-                non_qso_stages |= read_access.stage;
-            }
-        }
+        non_qso_stages = last_reads.StagesOf(last_reads.NotOnQueue(queue_id));
     }
     // Whether the stage are in the ordering scope only matters if the current write is ordered
     const VkPipelineStageFlags2 read_stages_in_qso = last_read_stages & ~non_qso_stages;
@@ -3751,32 +3772,242 @@ void ResourceAccessState::TouchupFirstForLayoutTransition(ResourceUsageTag tag,
     }
 }
 
-ResourceAccessState::ReadState::ReadState(VkPipelineStageFlags2KHR stage_, SyncStageAccessFlags access_,
-                                          VkPipelineStageFlags2KHR barriers_, ResourceUsageTag tag_)
-    : stage(stage_),
-      access(access_),
-      barriers(barriers_),
-      sync_stages(VK_PIPELINE_STAGE_2_NONE),
-      tag(tag_),
-      queue(QueueSyncState::kQueueIdInvalid),
-      pending_dep_chain(VK_PIPELINE_STAGE_2_NONE) {}
+bool ResourceAccessState::ReadStates::operator==(const ReadStates &rhs) const {
+    if (size_ != rhs.size_) return false;
+    const auto stages_bytes = size_ * sizeof(VkPipelineStageFlags2KHR);
+    return (0 == memcmp(Stages(), rhs.Stages(), stages_bytes)) && (0 == memcmp(Barriers(), rhs.Barriers(), stages_bytes)) &&
+           (0 == memcmp(Accesses(), rhs.Accesses(), size_ * sizeof(SyncStageAccessIndex))) &&
+           (0 == memcmp(Tags(), rhs.Tags(), size_ * sizeof(ResourceUsageTag)));
+}
 
-void ResourceAccessState::ReadState::Set(VkPipelineStageFlags2KHR stage_, const SyncStageAccessFlags &access_,
-                                         VkPipelineStageFlags2KHR barriers_, ResourceUsageTag tag_) {
-    stage = stage_;
-    access = access_;
-    barriers = barriers_;
-    sync_stages = VK_PIPELINE_STAGE_2_NONE;
-    tag = tag_;
-    pending_dep_chain = VK_PIPELINE_STAGE_2_NONE;  // If this is a new read, we aren't applying a barrier set.
+ResourceAccessState::ReadStates::size_type ResourceAccessState::ReadStates::Append(VkPipelineStageFlags2KHR stage,
+                                                                                  SyncStageAccessIndex access,
+                                                                                  VkPipelineStageFlags2KHR barriers,
+                                                                                  ResourceUsageTag tag) {
+    // At most one read per stage, so the read masks can never overflow
+    assert(size_ < 64);
+    if (size_ == capacity_) Reserve(2 * capacity_, true);
+    const size_type index = size_++;
+    Queues()[index] = QueueSyncState::kQueueIdInvalid;
+    Set(index, stage, access, barriers, tag);
+    return index;
+}
+
+ResourceAccessState::ReadStates::size_type ResourceAccessState::ReadStates::Append(const ReadStates &other,
+                                                                                  size_type other_index) {
+    const size_type index = Append(other.Stages()[other_index], other.Accesses()[other_index], other.Barriers()[other_index],
+                                   other.Tags()[other_index]);
+    SyncStages()[index] = other.SyncStages()[other_index];
+    PendingDepChains()[index] = other.PendingDepChains()[other_index];
+    Queues()[index] = other.Queues()[other_index];
+    return index;
+}
+
+void ResourceAccessState::ReadStates::Set(size_type index, VkPipelineStageFlags2KHR stage, SyncStageAccessIndex access,
+                                          VkPipelineStageFlags2KHR barriers, ResourceUsageTag tag) {
+    assert(index < size_);
+    Stages()[index] = stage;
+    Accesses()[index] = access;
+    Barriers()[index] = barriers;
+    SyncStages()[index] = VK_PIPELINE_STAGE_2_NONE;
+    Tags()[index] = tag;
+    PendingDepChains()[index] = VK_PIPELINE_STAGE_2_NONE;  // If this is a new read, we aren't applying a barrier set.
+}
+
+void ResourceAccessState::ReadStates::EraseStages(VkPipelineStageFlags2KHR stages) {
+    VkPipelineStageFlags2KHR *stage = Stages();
+    SyncStageAccessIndex *access = Accesses();
+    VkPipelineStageFlags2KHR *barriers = Barriers();
+    VkPipelineStageFlags2KHR *sync_stages = SyncStages();
+    VkPipelineStageFlags2KHR *pending_dep_chain = PendingDepChains();
+    ResourceUsageTag *tag = Tags();
+    QueueId *queue = Queues();
+    size_type kept = 0;
+    for (size_type i = 0; i < size_; ++i) {
+        if (0 != (stage[i] & stages)) continue;
+        if (kept != i) {
+            stage[kept] = stage[i];
+            access[kept] = access[i];
+            barriers[kept] = barriers[i];
+            sync_stages[kept] = sync_stages[i];
+            pending_dep_chain[kept] = pending_dep_chain[i];
+            tag[kept] = tag[i];
+            queue[kept] = queue[i];
+        }
+        ++kept;
+    }
+    size_ = kept;
+}
+
+VkPipelineStageFlags2KHR ResourceAccessState::ReadStates::StagesOf(ReadMask reads) const {
+    const VkPipelineStageFlags2KHR *stage = Stages();
+    VkPipelineStageFlags2KHR stages = VK_PIPELINE_STAGE_2_NONE;
+    for (size_type i = 0; i < size_; ++i) {
+        stages |= stage[i] & (VkPipelineStageFlags2KHR(0) - ((reads >> i) & 1));
+    }
+    return stages;
+}
+
+ResourceAccessState::ReadStates::ReadMask ResourceAccessState::ReadStates::ReadHazards(
+    VkPipelineStageFlags2KHR usage_stages, VkPipelineStageFlags2KHR skip_stages) const {
+    const VkPipelineStageFlags2KHR *stage = Stages();
+    const VkPipelineStageFlags2KHR *barriers = Barriers();
+    ReadMask reads = 0;
+    for (size_type i = 0; i < size_; ++i) {
+        reads |= ReadMask((0 == (stage[i] & skip_stages)) && (0 != (usage_stages & ~barriers[i]))) << i;
+    }
+    return reads;
+}
+
+ResourceAccessState::ReadStates::ReadMask ResourceAccessState::ReadStates::TaggedAtOrAfter(ResourceUsageTag tag) const {
+    const ResourceUsageTag *tags = Tags();
+    ReadMask reads = 0;
+    for (size_type i = 0; i < size_; ++i) {
+        reads |= ReadMask(tags[i] >= tag) << i;
+    }
+    return reads;
+}
+
+ResourceAccessState::ReadStates::ReadMask ResourceAccessState::ReadStates::NotOnQueue(QueueId queue) const {
+    const QueueId *queues = Queues();
+    ReadMask reads = 0;
+    for (size_type i = 0; i < size_; ++i) {
+        reads |= ReadMask(queues[i] != queue) << i;
+    }
+    return reads;
+}
+
+ResourceAccessState::ReadStates::ReadMask ResourceAccessState::ReadStates::InScopeOrChain(
+    VkPipelineStageFlags2KHR exec_scope) const {
+    const VkPipelineStageFlags2KHR *stage = Stages();
+    const VkPipelineStageFlags2KHR *barriers = Barriers();
+    ReadMask reads = 0;
+    for (size_type i = 0; i < size_; ++i) {
+        reads |= ReadMask(0 != (exec_scope & (stage[i] | barriers[i]))) << i;
+    }
+    return reads;
 }
 
 // Scope test including "queue submission order" effects.  Specifically, accesses from a different queue are not
 // considered to be in "queue submission order" with barriers, events, or semaphore signalling, but any barriers
 // that have bee applied (via semaphore) to those accesses can be chained off of.
-bool ResourceAccessState::ReadState::ReadInQueueScopeOrChain(QueueId scope_queue, VkPipelineStageFlags2 exec_scope) const {
-    VkPipelineStageFlags2 effective_stages = barriers | ((scope_queue == queue) ? stage : VK_PIPELINE_STAGE_2_NONE);
-    return (exec_scope & effective_stages) != 0;
+ResourceAccessState::ReadStates::ReadMask ResourceAccessState::ReadStates::InQueueScopeOrChain(
+    QueueId scope_queue, VkPipelineStageFlags2KHR exec_scope) const {
+    const VkPipelineStageFlags2KHR *stage = Stages();
+    const VkPipelineStageFlags2KHR *barriers = Barriers();
+    const QueueId *queues = Queues();
+    ReadMask reads = 0;
+    for (size_type i = 0; i < size_; ++i) {
+        const VkPipelineStageFlags2KHR queue_ordered_stage = stage[i] & (VkPipelineStageFlags2KHR(0) - (queues[i] == scope_queue));
+        reads |= ReadMask(0 != (exec_scope & (queue_ordered_stage | barriers[i]))) << i;
+    }
+    return reads;
+}
+
+ResourceAccessState::ReadStates::ReadMask ResourceAccessState::ReadStates::InEventScope(VkPipelineStageFlags2KHR exec_scope,
+                                                                                       QueueId scope_queue,
+                                                                                       ResourceUsageTag scope_tag) const {
+    // If this read is the same one we included in the set event and in scope, then apply the execution barrier...
+    // NOTE: That's not really correct... this read stage might *not* have been included in the setevent, and the barriers
+    // representing the chain might have changed since then (that would be an odd usage), so as a first approximation
+    // we'll assume the barriers *haven't* been changed since (if the tag hasn't), and while this could be a false
+    // positive in the case of Set; SomeBarrier; Wait; we'll live with it until we can add more state to the first scope
+    // capture (the specific write and read stages that *were* in scope at the moment of SetEvents.
+    const ResourceUsageTag *tags = Tags();
+    ReadMask before_event = 0;
+    for (size_type i = 0; i < size_; ++i) {
+        before_event |= ReadMask(tags[i] < scope_tag) << i;
+    }
+    return before_event & InQueueScopeOrChain(scope_queue, exec_scope);
+}
+
+void ResourceAccessState::ReadStates::PendDepChain(VkPipelineStageFlags2KHR stages_in_scope,
+                                                   VkPipelineStageFlags2KHR dst_exec_scope) {
+    const VkPipelineStageFlags2KHR *stage = Stages();
+    const VkPipelineStageFlags2KHR *sync_stages = SyncStages();
+    VkPipelineStageFlags2KHR *pending_dep_chain = PendingDepChains();
+    for (size_type i = 0; i < size_; ++i) {
+        const bool in_scope = 0 != ((stage[i] | sync_stages[i]) & stages_in_scope);
+        pending_dep_chain[i] |= dst_exec_scope & (VkPipelineStageFlags2KHR(0) - in_scope);
+    }
+}
+
+VkPipelineStageFlags2KHR ResourceAccessState::ReadStates::ApplyPendingDepChains() {
+    VkPipelineStageFlags2KHR *barriers = Barriers();
+    VkPipelineStageFlags2KHR *pending_dep_chain = PendingDepChains();
+    VkPipelineStageFlags2KHR all_barriers = VK_PIPELINE_STAGE_2_NONE;
+    for (size_type i = 0; i < size_; ++i) {
+        barriers[i] |= pending_dep_chain[i];
+        all_barriers |= barriers[i];
+        pending_dep_chain[i] = VK_PIPELINE_STAGE_2_NONE;
+    }
+    return all_barriers;
+}
+
+void ResourceAccessState::ReadStates::Reserve(size_type new_capacity, bool preserve) {
+    if (new_capacity <= capacity_) return;
+    std::unique_ptr<uint8_t[]> new_store(new uint8_t[new_capacity * kReadBytes]);
+    if (preserve && size_) {
+        // The column offsets scale with capacity, so each column moves separately
+        const uint8_t *data = Data();
+        const size_t column_bytes[] = {sizeof(VkPipelineStageFlags2KHR), sizeof(VkPipelineStageFlags2KHR),
+                                       sizeof(VkPipelineStageFlags2KHR), sizeof(VkPipelineStageFlags2KHR),
+                                       sizeof(ResourceUsageTag),         sizeof(QueueId),
+                                       sizeof(SyncStageAccessIndex)};
+        const size_t columns[] = {kStageColumn,           kBarriersColumn, kSyncStagesColumn, kPendingDepChainColumn,
+                                  kTagColumn,             kQueueColumn,    kAccessColumn};
+        for (size_t c = 0; c < sizeof(columns) / sizeof(columns[0]); ++c) {
+            memcpy(new_store.get() + columns[c] * new_capacity, data + columns[c] * capacity_, size_ * column_bytes[c]);
+        }
+    }
+    heap_ = std::move(new_store);
+    capacity_ = new_capacity;
+}
+
+void ResourceAccessState::ReadStates::CopyColumns(const ReadStates &from, size_type count) {
+    assert(count <= capacity_);
+    memcpy(Stages(), from.Stages(), count * sizeof(VkPipelineStageFlags2KHR));
+    memcpy(Accesses(), from.Accesses(), count * sizeof(SyncStageAccessIndex));
+    memcpy(Barriers(), from.Barriers(), count * sizeof(VkPipelineStageFlags2KHR));
+    memcpy(SyncStages(), from.SyncStages(), count * sizeof(VkPipelineStageFlags2KHR));
+    memcpy(PendingDepChains(), from.PendingDepChains(), count * sizeof(VkPipelineStageFlags2KHR));
+    memcpy(Tags(), from.Tags(), count * sizeof(ResourceUsageTag));
+    memcpy(Queues(), from.Queues(), count * sizeof(QueueId));
+}
+
+void ResourceAccessState::ReadStates::CopyFrom(const ReadStates &other) {
+    size_ = 0;
+    Reserve(other.size_, false);
+    CopyColumns(other, other.size_);
+    size_ = other.size_;
+}
+
+void ResourceAccessState::ReadStates::MoveFrom(ReadStates &other) {
+    if (other.heap_) {
+        heap_ = std::move(other.heap_);
+        capacity_ = other.capacity_;
+        size_ = other.size_;
+        other.capacity_ = kInlineReads;
+        other.size_ = 0;
+    } else {
+        CopyFrom(other);
+    }
+}
+
+ReadLockGuard SyncValidator::ReadLock() {
+    if (fine_grained_locking) {
+        return ReadLockGuard(validation_object_mutex, std::defer_lock);
+    } else {
+        return ReadLockGuard(validation_object_mutex);
+    }
+}
+
+WriteLockGuard SyncValidator::WriteLock() {
+    if (fine_grained_locking) {
+        return WriteLockGuard(validation_object_mutex, std::defer_lock);
+    } else {
+        return WriteLockGuard(validation_object_mutex);
+    }
 }
 
 ResourceUsageRange SyncValidator::ReserveGlobalTagRange(size_t tag_count) const {
@@ -3865,6 +4096,31 @@ QueueBatchContext::BatchSet SyncValidator::GetQueueLastBatchSnapshot(Predicate &
     return GetQueueBatchSnapshotImpl<QueueBatchContext::BatchSet>(queue_sync_states_, std::forward<Predicate>(pred));
 }
 
+void SyncValidator::TrimAccessLog() {
+    // Gathering the referenced tags walks every access state of every retained batch, so compaction is deferred until the log
+    // has doubled since the last one, keeping the cost proportional to the number of records logged. With a record limit below
+    // the minimum, compaction runs before the limit is first reached, so that records still referenced are not dropped.
+    constexpr size_t kMinCompactionRecords = 1U << 16;
+    size_t min_compaction_records = kMinCompactionRecords;
+    if (access_log_record_limit_) min_compaction_records = std::min(min_compaction_records, access_log_record_limit_);
+    size_t record_count = global_access_log_.RecordCount();
+    if (access_log_compaction_ && (record_count >= 2 * std::max(access_log_compacted_size_, min_compaction_records / 2))) {
+        ResourceUsageTagSet used;
+        for (const auto &batch : GetQueueBatchSnapshot()) {
+            batch->GatherReferencedTags(used);
+        }
+        used.Normalize();
+        global_access_log_.Compact(used);
+        record_count = global_access_log_.RecordCount();
+        access_log_compacted_size_ = record_count;
+    }
+
+    if (access_log_record_limit_ && (record_count > access_log_record_limit_)) {
+        global_access_log_.LimitRecords(access_log_record_limit_);
+        access_log_compacted_size_ = std::min(access_log_compacted_size_, access_log_record_limit_);
+    }
+}
+
 QueueBatchContext::BatchSet SyncValidator::GetQueueBatchSnapshot() {
     QueueBatchContext::BatchSet snapshot = GetQueueLastBatchSnapshot();
     auto append = [&snapshot](const std::shared_ptr<QueueBatchContext> batch) {
@@ -3956,46 +4212,66 @@ std::shared_ptr<CommandBufferAccessContext> SyncValidator::AccessContextFactory(
 }
 
 std::shared_ptr<CommandBufferAccessContext> SyncValidator::GetAccessContextShared(VkCommandBuffer command_buffer) {
-    return GetMappedInsert(cb_access_state, command_buffer,
-                           [this, command_buffer]() { return AccessContextFactory(command_buffer); });
+    auto found = cb_access_state.find(command_buffer);
+    if (found != cb_access_state.end()) {
+        return found->second;
+    }
+    auto access_context = AccessContextFactory(command_buffer);
+    if (!cb_access_state.insert(command_buffer, access_context)) {
+        // Lost a (benign) race with another thread creating the context, use the one that got there first
+        access_context = cb_access_state.find(command_buffer)->second;
+    }
+    return access_context;
 }
 
 std::shared_ptr<const CommandBufferAccessContext> SyncValidator::GetAccessContextShared(VkCommandBuffer command_buffer) const {
-    return GetMapped(cb_access_state, command_buffer, []() { return std::shared_ptr<CommandBufferAccessContext>(); });
+    auto found = cb_access_state.find(command_buffer);
+    if (found != cb_access_state.end()) {
+        return found->second;
+    }
+    return std::shared_ptr<const CommandBufferAccessContext>();
 }
 
-const CommandBufferAccessContext *SyncValidator::GetAccessContext(VkCommandBuffer command_buffer) const {
-    return GetMappedPlainFromShared(cb_access_state, command_buffer);
+SyncValidator::AccessContextReadPtr SyncValidator::GetAccessContext(VkCommandBuffer command_buffer) const {
+    auto access_context = GetAccessContextShared(command_buffer);
+    if (!access_context) return AccessContextReadPtr();
+    auto guard = access_context->ReadLock();
+    return AccessContextReadPtr(std::move(access_context), std::move(guard));
 }
 
-CommandBufferAccessContext *SyncValidator::GetAccessContext(VkCommandBuffer command_buffer) {
-    return GetAccessContextShared(command_buffer).get();
+SyncValidator::AccessContextWritePtr SyncValidator::GetAccessContext(VkCommandBuffer command_buffer) {
+    auto access_context = GetAccessContextShared(command_buffer);
+    auto guard = access_context->WriteLock();
+    return AccessContextWritePtr(std::move(access_context), std::move(guard));
 }
 
-CommandBufferAccessContext *SyncValidator::GetAccessContextNoInsert(VkCommandBuffer command_buffer) {
-    return GetMappedPlainFromShared(cb_access_state, command_buffer);
+SyncValidator::AccessContextWritePtr SyncValidator::GetAccessContextNoInsert(VkCommandBuffer command_buffer) {
+    auto found = cb_access_state.find(command_buffer);
+    if (found == cb_access_state.end()) return AccessContextWritePtr();
+    auto guard = found->second->WriteLock();
+    return AccessContextWritePtr(std::move(found->second), std::move(guard));
 }
 
 void SyncValidator::ResetCommandBufferCallback(VkCommandBuffer command_buffer) {
-    auto *access_context = GetAccessContextNoInsert(command_buffer);
+    auto access_context = GetAccessContextNoInsert(command_buffer);
     if (access_context) {
         access_context->Reset();
     }
 }
 
 void SyncValidator::FreeCommandBufferCallback(VkCommandBuffer command_buffer) {
-    auto access_found = cb_access_state.find(command_buffer);
+    auto access_found = cb_access_state.pop(command_buffer);
     if (access_found != cb_access_state.end()) {
+        auto guard = access_found->second->WriteLock();
         access_found->second->Reset();
         access_found->second->MarkDestroyed();
-        cb_access_state.erase(access_found);
     }
 }
 
 bool SyncValidator::PreCallValidateCmdCopyBuffer(VkCommandBuffer commandBuffer, VkBuffer srcBuffer, VkBuffer dstBuffer,
                                                  uint32_t regionCount, const VkBufferCopy *pRegions) const {
     bool skip = false;
-    const auto *cb_context = GetAccessContext(commandBuffer);
+    const auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
     if (!cb_context) return skip;
     const auto *context = cb_context->GetCurrentAccessContext();
@@ -4033,7 +4309,7 @@ bool SyncValidator::PreCallValidateCmdCopyBuffer(VkCommandBuffer commandBuffer,
 
 void SyncValidator::PreCallRecordCmdCopyBuffer(VkCommandBuffer commandBuffer, VkBuffer srcBuffer, VkBuffer dstBuffer,
                                                uint32_t regionCount, const VkBufferCopy *pRegions) {
-    auto *cb_context = GetAccessContext(commandBuffer);
+    auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
     const auto tag = cb_context->NextCommandTag(CMD_COPYBUFFER);
     auto *context = cb_context->GetCurrentAccessContext();
@@ -4056,7 +4332,8 @@ void SyncValidator::PreCallRecordCmdCopyBuffer(VkCommandBuffer commandBuffer, Vk
 
 void SyncValidator::PreCallRecordDestroyEvent(VkDevice device, VkEvent event, const VkAllocationCallbacks *pAllocator) {
     // Clear out events from the command buffer contexts
-    for (auto &cb_context : cb_access_state) {
+    for (auto &cb_context : cb_access_state.snapshot()) {
+        auto guard = cb_context.second->WriteLock();
         cb_context.second->RecordDestroyEvent(event);
     }
 }
@@ -4064,7 +4341,7 @@ void SyncValidator::PreCallRecordDestroyEvent(VkDevice device, VkEvent event, co
 bool SyncValidator::ValidateCmdCopyBuffer2(VkCommandBuffer commandBuffer, const VkCopyBufferInfo2 *pCopyBufferInfos,
                                            CMD_TYPE cmd_type) const {
     bool skip = false;
-    const auto *cb_context = GetAccessContext(commandBuffer);
+    const auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
     if (!cb_context) return skip;
     const auto *context = cb_context->GetCurrentAccessContext();
@@ -4113,7 +4390,7 @@ bool SyncValidator::PreCallValidateCmdCopyBuffer2(VkCommandBuffer commandBuffer,
 }
 
 void SyncValidator::RecordCmdCopyBuffer2(VkCommandBuffer commandBuffer, const VkCopyBufferInfo2KHR *pCopyBufferInfos, CMD_TYPE cmd_type) {
-    auto *cb_context = GetAccessContext(commandBuffer);
+    auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
     const auto tag = cb_context->NextCommandTag(cmd_type);
     auto *context = cb_context->GetCurrentAccessContext();
@@ -4146,7 +4423,7 @@ bool SyncValidator::PreCallValidateCmdCopyImage(VkCommandBuffer commandBuffer, V
                                                 VkImage dstImage, VkImageLayout dstImageLayout, uint32_t regionCount,
                                                 const VkImageCopy *pRegions) const {
     bool skip = false;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -4188,7 +4465,7 @@ bool SyncValidator::PreCallValidateCmdCopyImage(VkCommandBuffer commandBuffer, V
 void SyncValidator::PreCallRecordCmdCopyImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout srcImageLayout,
                                               VkImage dstImage, VkImageLayout dstImageLayout, uint32_t regionCount,
                                               const VkImageCopy *pRegions) {
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     const auto tag = cb_access_context->NextCommandTag(CMD_COPYIMAGE);
     auto *context = cb_access_context->GetCurrentAccessContext();
@@ -4213,7 +4490,7 @@ void SyncValidator::PreCallRecordCmdCopyImage(VkCommandBuffer commandBuffer, VkI
 bool SyncValidator::ValidateCmdCopyImage2(VkCommandBuffer commandBuffer, const VkCopyImageInfo2 *pCopyImageInfo,
                                           CMD_TYPE cmd_type) const {
     bool skip = false;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -4263,7 +4540,7 @@ bool SyncValidator::PreCallValidateCmdCopyImage2(VkCommandBuffer commandBuffer,
 }
 
 void SyncValidator::RecordCmdCopyImage2(VkCommandBuffer commandBuffer, const VkCopyImageInfo2KHR *pCopyImageInfo, CMD_TYPE cmd_type) {
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     const auto tag = cb_access_context->NextCommandTag(cmd_type);
     auto *context = cb_access_context->GetCurrentAccessContext();
@@ -4301,7 +4578,7 @@ bool SyncValidator::PreCallValidateCmdPipelineBarrier(VkCommandBuffer commandBuf
                                                       uint32_t imageMemoryBarrierCount,
                                                       const VkImageMemoryBarrier *pImageMemoryBarriers) const {
     bool skip = false;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -4320,7 +4597,7 @@ void SyncValidator::PreCallRecordCmdPipelineBarrier(VkCommandBuffer commandBuffe
                                                     const VkBufferMemoryBarrier *pBufferMemoryBarriers,
                                                     uint32_t imageMemoryBarrierCount,
                                                     const VkImageMemoryBarrier *pImageMemoryBarriers) {
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return;
 
@@ -4333,7 +4610,7 @@ void SyncValidator::PreCallRecordCmdPipelineBarrier(VkCommandBuffer commandBuffe
 bool SyncValidator::PreCallValidateCmdPipelineBarrier2KHR(VkCommandBuffer commandBuffer,
                                                           const VkDependencyInfoKHR *pDependencyInfo) const {
     bool skip = false;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -4345,7 +4622,7 @@ bool SyncValidator::PreCallValidateCmdPipelineBarrier2KHR(VkCommandBuffer comman
 bool SyncValidator::PreCallValidateCmdPipelineBarrier2(VkCommandBuffer commandBuffer,
                                                        const VkDependencyInfo *pDependencyInfo) const {
     bool skip = false;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -4355,7 +4632,7 @@ bool SyncValidator::PreCallValidateCmdPipelineBarrier2(VkCommandBuffer commandBu
 }
 
 void SyncValidator::PreCallRecordCmdPipelineBarrier2KHR(VkCommandBuffer commandBuffer, const VkDependencyInfoKHR *pDependencyInfo) {
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return;
 
@@ -4364,7 +4641,7 @@ void SyncValidator::PreCallRecordCmdPipelineBarrier2KHR(VkCommandBuffer commandB
 }
 
 void SyncValidator::PreCallRecordCmdPipelineBarrier2(VkCommandBuffer commandBuffer, const VkDependencyInfo *pDependencyInfo) {
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return;
 
@@ -4382,6 +4659,19 @@ void SyncValidator::CreateDevice(const VkDeviceCreateInfo *pCreateInfo) {
     SetCommandBufferResetCallback([this](VkCommandBuffer command_buffer) -> void { ResetCommandBufferCallback(command_buffer); });
     SetCommandBufferFreeCallback([this](VkCommandBuffer command_buffer) -> void { FreeCommandBufferCallback(command_buffer); });
 
+    std::string compaction_string = getLayerOption("khronos_validation.syncval_access_log_compaction");
+    if (compaction_string.empty()) compaction_string = GetEnvironment("VK_LAYER_SYNCVAL_ACCESS_LOG_COMPACTION");
+    std::transform(compaction_string.begin(), compaction_string.end(), compaction_string.begin(), ::tolower);
+    access_log_compaction_ = compaction_string.length() ? !compaction_string.compare("true") : true;
+    // The limit is set in MiB of usage records, computed in 64 bits as limits of 4 GiB and more overflow a 32-bit size_t
+    std::string limit_string = getLayerOption("khronos_validation.syncval_access_log_limit");
+    if (limit_string.empty()) limit_string = GetEnvironment("VK_LAYER_SYNCVAL_ACCESS_LOG_LIMIT");
+    const uint64_t limit_mib = limit_string.length() ? strtoull(limit_string.c_str(), nullptr, 10) : 0;
+    const uint64_t limit_records = std::min(limit_mib, std::numeric_limits<uint64_t>::max() >> 20) * 1024 * 1024 /
+                                   sizeof(ResourceUsageRecord);
+    access_log_record_limit_ =
+        static_cast<size_t>(std::min(limit_records, static_cast<uint64_t>(std::numeric_limits<size_t>::max())));
+
     QueueId queue_id = QueueSyncState::kQueueIdBase;
     ForEachShared<QUEUE_STATE>([this, &queue_id](const std::shared_ptr<QUEUE_STATE> &queue_state) {
         auto queue_flags = physical_device_state->queue_family_properties[queue_state->queueFamilyIndex].queueFlags;
@@ -4598,7 +4888,7 @@ bool SyncValidator::ValidateCmdCopyBufferToImage(VkCommandBuffer commandBuffer,
                                                  VkImageLayout dstImageLayout, uint32_t regionCount, const RegionType *pRegions,
                                                  CMD_TYPE cmd_type) const {
     bool skip = false;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -4667,7 +4957,7 @@ template <typename RegionType>
 void SyncValidator::RecordCmdCopyBufferToImage(VkCommandBuffer commandBuffer, VkBuffer srcBuffer, VkImage dstImage,
                                                VkImageLayout dstImageLayout, uint32_t regionCount, const RegionType *pRegions,
                                                CMD_TYPE cmd_type) {
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
 
     const auto tag = cb_access_context->NextCommandTag(cmd_type);
@@ -4719,7 +5009,7 @@ bool SyncValidator::ValidateCmdCopyImageToBuffer(VkCommandBuffer commandBuffer,
                                                  VkBuffer dstBuffer, uint32_t regionCount, const RegionType *pRegions,
                                                  CMD_TYPE cmd_type) const {
     bool skip = false;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -4784,7 +5074,7 @@ template <typename RegionType>
 void SyncValidator::RecordCmdCopyImageToBuffer(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout srcImageLayout,
                                                VkBuffer dstBuffer, uint32_t regionCount, const RegionType *pRegions,
                                                CMD_TYPE cmd_type) {
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
 
     const auto tag = cb_access_context->NextCommandTag(cmd_type);
@@ -4837,7 +5127,7 @@ bool SyncValidator::ValidateCmdBlitImage(VkCommandBuffer commandBuffer, VkImage
                                          VkImage dstImage, VkImageLayout dstImageLayout, uint32_t regionCount,
                                          const RegionType *pRegions, VkFilter filter, CMD_TYPE cmd_type) const {
     bool skip = false;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -4915,9 +5205,10 @@ bool SyncValidator::PreCallValidateCmdBlitImage2(VkCommandBuffer commandBuffer,
 template <typename RegionType>
 void SyncValidator::RecordCmdBlitImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout srcImageLayout,
                                        VkImage dstImage, VkImageLayout dstImageLayout, uint32_t regionCount,
-                                       const RegionType *pRegions, VkFilter filter, ResourceUsageTag tag) {
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+                                       const RegionType *pRegions, VkFilter filter, CMD_TYPE cmd_type) {
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
+    const auto tag = cb_access_context->NextCommandTag(cmd_type);
     auto *context = cb_access_context->GetCurrentAccessContext();
     assert(context);
 
@@ -4952,32 +5243,24 @@ void SyncValidator::RecordCmdBlitImage(VkCommandBuffer commandBuffer, VkImage sr
 void SyncValidator::PreCallRecordCmdBlitImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout srcImageLayout,
                                               VkImage dstImage, VkImageLayout dstImageLayout, uint32_t regionCount,
                                               const VkImageBlit *pRegions, VkFilter filter) {
-    auto *cb_access_context = GetAccessContext(commandBuffer);
-    assert(cb_access_context);
-    const auto tag = cb_access_context->NextCommandTag(CMD_BLITIMAGE);
     StateTracker::PreCallRecordCmdBlitImage(commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount,
                                             pRegions, filter);
-    RecordCmdBlitImage(commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, pRegions, filter, tag);
+    RecordCmdBlitImage(commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, pRegions, filter,
+                       CMD_BLITIMAGE);
 }
 
 void SyncValidator::PreCallRecordCmdBlitImage2KHR(VkCommandBuffer commandBuffer, const VkBlitImageInfo2KHR *pBlitImageInfo) {
     StateTracker::PreCallRecordCmdBlitImage2KHR(commandBuffer, pBlitImageInfo);
-    auto *cb_access_context = GetAccessContext(commandBuffer);
-    assert(cb_access_context);
-    const auto tag = cb_access_context->NextCommandTag(CMD_BLITIMAGE2KHR);
     RecordCmdBlitImage(commandBuffer, pBlitImageInfo->srcImage, pBlitImageInfo->srcImageLayout, pBlitImageInfo->dstImage,
                        pBlitImageInfo->dstImageLayout, pBlitImageInfo->regionCount, pBlitImageInfo->pRegions,
-                       pBlitImageInfo->filter, tag);
+                       pBlitImageInfo->filter, CMD_BLITIMAGE2KHR);
 }
 
 void SyncValidator::PreCallRecordCmdBlitImage2(VkCommandBuffer commandBuffer, const VkBlitImageInfo2 *pBlitImageInfo) {
     StateTracker::PreCallRecordCmdBlitImage2KHR(commandBuffer, pBlitImageInfo);
-    auto *cb_access_context = GetAccessContext(commandBuffer);
-    assert(cb_access_context);
-    const auto tag = cb_access_context->NextCommandTag(CMD_BLITIMAGE2);
     RecordCmdBlitImage(commandBuffer, pBlitImageInfo->srcImage, pBlitImageInfo->srcImageLayout, pBlitImageInfo->dstImage,
         pBlitImageInfo->dstImageLayout, pBlitImageInfo->regionCount, pBlitImageInfo->pRegions,
-        pBlitImageInfo->filter, tag);
+        pBlitImageInfo->filter, CMD_BLITIMAGE2);
 }
 
 bool SyncValidator::ValidateIndirectBuffer(const CommandBufferAccessContext &cb_context, const AccessContext &context,
@@ -5059,7 +5342,7 @@ void SyncValidator::RecordCountBuffer(AccessContext &context, const ResourceUsag
 
 bool SyncValidator::PreCallValidateCmdDispatch(VkCommandBuffer commandBuffer, uint32_t x, uint32_t y, uint32_t z) const {
     bool skip = false;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -5069,7 +5352,7 @@ bool SyncValidator::PreCallValidateCmdDispatch(VkCommandBuffer commandBuffer, ui
 
 void SyncValidator::PreCallRecordCmdDispatch(VkCommandBuffer commandBuffer, uint32_t x, uint32_t y, uint32_t z) {
     StateTracker::PreCallRecordCmdDispatch(commandBuffer, x, y, z);
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     const auto tag = cb_access_context->NextCommandTag(CMD_DISPATCH);
 
@@ -5078,7 +5361,7 @@ void SyncValidator::PreCallRecordCmdDispatch(VkCommandBuffer commandBuffer, uint
 
 bool SyncValidator::PreCallValidateCmdDispatchIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset) const {
     bool skip = false;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -5094,7 +5377,7 @@ bool SyncValidator::PreCallValidateCmdDispatchIndirect(VkCommandBuffer commandBu
 
 void SyncValidator::PreCallRecordCmdDispatchIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset) {
     StateTracker::PreCallRecordCmdDispatchIndirect(commandBuffer, buffer, offset);
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     const auto tag = cb_access_context->NextCommandTag(CMD_DISPATCHINDIRECT);
     auto *context = cb_access_context->GetCurrentAccessContext();
@@ -5107,7 +5390,7 @@ void SyncValidator::PreCallRecordCmdDispatchIndirect(VkCommandBuffer commandBuff
 bool SyncValidator::PreCallValidateCmdDraw(VkCommandBuffer commandBuffer, uint32_t vertexCount, uint32_t instanceCount,
                                            uint32_t firstVertex, uint32_t firstInstance) const {
     bool skip = false;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -5120,7 +5403,7 @@ bool SyncValidator::PreCallValidateCmdDraw(VkCommandBuffer commandBuffer, uint32
 void SyncValidator::PreCallRecordCmdDraw(VkCommandBuffer commandBuffer, uint32_t vertexCount, uint32_t instanceCount,
                                          uint32_t firstVertex, uint32_t firstInstance) {
     StateTracker::PreCallRecordCmdDraw(commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     const auto tag = cb_access_context->NextCommandTag(CMD_DRAW);
 
@@ -5132,7 +5415,7 @@ void SyncValidator::PreCallRecordCmdDraw(VkCommandBuffer commandBuffer, uint32_t
 bool SyncValidator::PreCallValidateCmdDrawIndexed(VkCommandBuffer commandBuffer, uint32_t indexCount, uint32_t instanceCount,
                                                   uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) const {
     bool skip = false;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -5145,7 +5428,7 @@ bool SyncValidator::PreCallValidateCmdDrawIndexed(VkCommandBuffer commandBuffer,
 void SyncValidator::PreCallRecordCmdDrawIndexed(VkCommandBuffer commandBuffer, uint32_t indexCount, uint32_t instanceCount,
                                                 uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) {
     StateTracker::PreCallRecordCmdDrawIndexed(commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     const auto tag = cb_access_context->NextCommandTag(CMD_DRAWINDEXED);
 
@@ -5159,7 +5442,7 @@ bool SyncValidator::PreCallValidateCmdDrawIndirect(VkCommandBuffer commandBuffer
     bool skip = false;
     if (drawCount == 0) return skip;
 
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -5183,7 +5466,7 @@ void SyncValidator::PreCallRecordCmdDrawIndirect(VkCommandBuffer commandBuffer,
                                                  uint32_t drawCount, uint32_t stride) {
     StateTracker::PreCallRecordCmdDrawIndirect(commandBuffer, buffer, offset, drawCount, stride);
     if (drawCount == 0) return;
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     const auto tag = cb_access_context->NextCommandTag(CMD_DRAWINDIRECT);
     auto *context = cb_access_context->GetCurrentAccessContext();
@@ -5203,7 +5486,7 @@ bool SyncValidator::PreCallValidateCmdDrawIndexedIndirect(VkCommandBuffer comman
                                                           uint32_t drawCount, uint32_t stride) const {
     bool skip = false;
     if (drawCount == 0) return skip;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -5226,7 +5509,7 @@ bool SyncValidator::PreCallValidateCmdDrawIndexedIndirect(VkCommandBuffer comman
 void SyncValidator::PreCallRecordCmdDrawIndexedIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset,
                                                         uint32_t drawCount, uint32_t stride) {
     StateTracker::PreCallRecordCmdDrawIndexedIndirect(commandBuffer, buffer, offset, drawCount, stride);
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     const auto tag = cb_access_context->NextCommandTag(CMD_DRAWINDEXEDINDIRECT);
     auto *context = cb_access_context->GetCurrentAccessContext();
@@ -5246,7 +5529,7 @@ bool SyncValidator::ValidateCmdDrawIndirectCount(VkCommandBuffer commandBuffer,
                                                  VkBuffer countBuffer, VkDeviceSize countBufferOffset, uint32_t maxDrawCount,
                                                  uint32_t stride, CMD_TYPE cmd_type) const {
     bool skip = false;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -5277,7 +5560,7 @@ bool SyncValidator::PreCallValidateCmdDrawIndirectCount(VkCommandBuffer commandB
 void SyncValidator::RecordCmdDrawIndirectCount(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset,
                                                VkBuffer countBuffer, VkDeviceSize countBufferOffset, uint32_t maxDrawCount,
                                                uint32_t stride, CMD_TYPE cmd_type) {
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     const auto tag = cb_access_context->NextCommandTag(cmd_type);
     auto *context = cb_access_context->GetCurrentAccessContext();
@@ -5338,7 +5621,7 @@ bool SyncValidator::ValidateCmdDrawIndexedIndirectCount(VkCommandBuffer commandB
                                                         VkBuffer countBuffer, VkDeviceSize countBufferOffset, uint32_t maxDrawCount,
                                                         uint32_t stride, CMD_TYPE cmd_type) const {
     bool skip = false;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -5369,7 +5652,7 @@ bool SyncValidator::PreCallValidateCmdDrawIndexedIndirectCount(VkCommandBuffer c
 void SyncValidator::RecordCmdDrawIndexedIndirectCount(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset,
                                                       VkBuffer countBuffer, VkDeviceSize countBufferOffset, uint32_t maxDrawCount,
                                                       uint32_t stride, CMD_TYPE cmd_type) {
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     const auto tag = cb_access_context->NextCommandTag(cmd_type);
     auto *context = cb_access_context->GetCurrentAccessContext();
@@ -5433,7 +5716,7 @@ bool SyncValidator::PreCallValidateCmdClearColorImage(VkCommandBuffer commandBuf
                                                       const VkClearColorValue *pColor, uint32_t rangeCount,
                                                       const VkImageSubresourceRange *pRanges) const {
     bool skip = false;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -5462,7 +5745,7 @@ void SyncValidator::PreCallRecordCmdClearColorImage(VkCommandBuffer commandBuffe
                                                     const VkClearColorValue *pColor, uint32_t rangeCount,
                                                     const VkImageSubresourceRange *pRanges) {
     StateTracker::PreCallRecordCmdClearColorImage(commandBuffer, image, imageLayout, pColor, rangeCount, pRanges);
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     const auto tag = cb_access_context->NextCommandTag(CMD_CLEARCOLORIMAGE);
     auto *context = cb_access_context->GetCurrentAccessContext();
@@ -5483,7 +5766,7 @@ bool SyncValidator::PreCallValidateCmdClearDepthStencilImage(VkCommandBuffer com
                                                              const VkClearDepthStencilValue *pDepthStencil, uint32_t rangeCount,
                                                              const VkImageSubresourceRange *pRanges) const {
     bool skip = false;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -5512,7 +5795,7 @@ void SyncValidator::PreCallRecordCmdClearDepthStencilImage(VkCommandBuffer comma
                                                            const VkClearDepthStencilValue *pDepthStencil, uint32_t rangeCount,
                                                            const VkImageSubresourceRange *pRanges) {
     StateTracker::PreCallRecordCmdClearDepthStencilImage(commandBuffer, image, imageLayout, pDepthStencil, rangeCount, pRanges);
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     const auto tag = cb_access_context->NextCommandTag(CMD_CLEARDEPTHSTENCILIMAGE);
     auto *context = cb_access_context->GetCurrentAccessContext();
@@ -5533,7 +5816,7 @@ bool SyncValidator::PreCallValidateCmdCopyQueryPoolResults(VkCommandBuffer comma
                                                            VkDeviceSize dstOffset, VkDeviceSize stride,
                                                            VkQueryResultFlags flags) const {
     bool skip = false;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -5563,7 +5846,7 @@ void SyncValidator::PreCallRecordCmdCopyQueryPoolResults(VkCommandBuffer command
                                                          VkDeviceSize stride, VkQueryResultFlags flags) {
     StateTracker::PreCallRecordCmdCopyQueryPoolResults(commandBuffer, queryPool, firstQuery, queryCount, dstBuffer, dstOffset,
                                                        stride, flags);
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     const auto tag = cb_access_context->NextCommandTag(CMD_COPYQUERYPOOLRESULTS);
     auto *context = cb_access_context->GetCurrentAccessContext();
@@ -5582,7 +5865,7 @@ void SyncValidator::PreCallRecordCmdCopyQueryPoolResults(VkCommandBuffer command
 bool SyncValidator::PreCallValidateCmdFillBuffer(VkCommandBuffer commandBuffer, VkBuffer dstBuffer, VkDeviceSize dstOffset,
                                                  VkDeviceSize size, uint32_t data) const {
     bool skip = false;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -5607,7 +5890,7 @@ bool SyncValidator::PreCallValidateCmdFillBuffer(VkCommandBuffer commandBuffer,
 void SyncValidator::PreCallRecordCmdFillBuffer(VkCommandBuffer commandBuffer, VkBuffer dstBuffer, VkDeviceSize dstOffset,
                                                VkDeviceSize size, uint32_t data) {
     StateTracker::PreCallRecordCmdFillBuffer(commandBuffer, dstBuffer, dstOffset, size, data);
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     const auto tag = cb_access_context->NextCommandTag(CMD_FILLBUFFER);
     auto *context = cb_access_context->GetCurrentAccessContext();
@@ -5625,7 +5908,7 @@ bool SyncValidator::PreCallValidateCmdResolveImage(VkCommandBuffer commandBuffer
                                                    VkImage dstImage, VkImageLayout dstImageLayout, uint32_t regionCount,
                                                    const VkImageResolve *pRegions) const {
     bool skip = false;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -5670,7 +5953,7 @@ void SyncValidator::PreCallRecordCmdResolveImage(VkCommandBuffer commandBuffer,
                                                  const VkImageResolve *pRegions) {
     StateTracker::PreCallRecordCmdResolveImage(commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount,
                                                pRegions);
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     const auto tag = cb_access_context->NextCommandTag(CMD_RESOLVEIMAGE);
     auto *context = cb_access_context->GetCurrentAccessContext();
@@ -5695,7 +5978,7 @@ void SyncValidator::PreCallRecordCmdResolveImage(VkCommandBuffer commandBuffer,
 bool SyncValidator::ValidateCmdResolveImage2(VkCommandBuffer commandBuffer, const VkResolveImageInfo2KHR *pResolveImageInfo,
                                              CMD_TYPE cmd_type) const {
     bool skip = false;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -5748,7 +6031,7 @@ bool SyncValidator::PreCallValidateCmdResolveImage2(VkCommandBuffer commandBuffe
 void SyncValidator::RecordCmdResolveImage2(VkCommandBuffer commandBuffer, const VkResolveImageInfo2KHR *pResolveImageInfo,
                                            CMD_TYPE cmd_type) {
     StateTracker::PreCallRecordCmdResolveImage2KHR(commandBuffer, pResolveImageInfo);
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     const auto tag = cb_access_context->NextCommandTag(cmd_type);
     auto *context = cb_access_context->GetCurrentAccessContext();
@@ -5782,7 +6065,7 @@ void SyncValidator::PreCallRecordCmdResolveImage2(VkCommandBuffer commandBuffer,
 bool SyncValidator::PreCallValidateCmdUpdateBuffer(VkCommandBuffer commandBuffer, VkBuffer dstBuffer, VkDeviceSize dstOffset,
                                                    VkDeviceSize dataSize, const void *pData) const {
     bool skip = false;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -5808,7 +6091,7 @@ bool SyncValidator::PreCallValidateCmdUpdateBuffer(VkCommandBuffer commandBuffer
 void SyncValidator::PreCallRecordCmdUpdateBuffer(VkCommandBuffer commandBuffer, VkBuffer dstBuffer, VkDeviceSize dstOffset,
                                                  VkDeviceSize dataSize, const void *pData) {
     StateTracker::PreCallRecordCmdUpdateBuffer(commandBuffer, dstBuffer, dstOffset, dataSize, pData);
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     const auto tag = cb_access_context->NextCommandTag(CMD_UPDATEBUFFER);
     auto *context = cb_access_context->GetCurrentAccessContext();
@@ -5826,7 +6109,7 @@ void SyncValidator::PreCallRecordCmdUpdateBuffer(VkCommandBuffer commandBuffer,
 bool SyncValidator::PreCallValidateCmdWriteBufferMarkerAMD(VkCommandBuffer commandBuffer, VkPipelineStageFlagBits pipelineStage,
                                                            VkBuffer dstBuffer, VkDeviceSize dstOffset, uint32_t marker) const {
     bool skip = false;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -5852,7 +6135,7 @@ bool SyncValidator::PreCallValidateCmdWriteBufferMarkerAMD(VkCommandBuffer comma
 void SyncValidator::PreCallRecordCmdWriteBufferMarkerAMD(VkCommandBuffer commandBuffer, VkPipelineStageFlagBits pipelineStage,
                                                          VkBuffer dstBuffer, VkDeviceSize dstOffset, uint32_t marker) {
     StateTracker::PreCallRecordCmdWriteBufferMarkerAMD(commandBuffer, pipelineStage, dstBuffer, dstOffset, marker);
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     const auto tag = cb_access_context->NextCommandTag(CMD_WRITEBUFFERMARKERAMD);
     auto *context = cb_access_context->GetCurrentAccessContext();
@@ -5868,7 +6151,7 @@ void SyncValidator::PreCallRecordCmdWriteBufferMarkerAMD(VkCommandBuffer command
 
 bool SyncValidator::PreCallValidateCmdSetEvent(VkCommandBuffer commandBuffer, VkEvent event, VkPipelineStageFlags stageMask) const {
     bool skip = false;
-    const auto *cb_context = GetAccessContext(commandBuffer);
+    const auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
     if (!cb_context) return skip;
     const auto *access_context = cb_context->GetCurrentAccessContext();
@@ -5881,7 +6164,7 @@ bool SyncValidator::PreCallValidateCmdSetEvent(VkCommandBuffer commandBuffer, Vk
 
 void SyncValidator::PostCallRecordCmdSetEvent(VkCommandBuffer commandBuffer, VkEvent event, VkPipelineStageFlags stageMask) {
     StateTracker::PostCallRecordCmdSetEvent(commandBuffer, event, stageMask);
-    auto *cb_context = GetAccessContext(commandBuffer);
+    auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
     if (!cb_context) return;
 
@@ -5892,7 +6175,7 @@ void SyncValidator::PostCallRecordCmdSetEvent(VkCommandBuffer commandBuffer, VkE
 bool SyncValidator::PreCallValidateCmdSetEvent2KHR(VkCommandBuffer commandBuffer, VkEvent event,
                                                    const VkDependencyInfoKHR *pDependencyInfo) const {
     bool skip = false;
-    const auto *cb_context = GetAccessContext(commandBuffer);
+    const auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
     if (!cb_context || !pDependencyInfo) return skip;
 
@@ -5907,7 +6190,7 @@ bool SyncValidator::PreCallValidateCmdSetEvent2KHR(VkCommandBuffer commandBuffer
 bool SyncValidator::PreCallValidateCmdSetEvent2(VkCommandBuffer commandBuffer, VkEvent event,
                                                 const VkDependencyInfo *pDependencyInfo) const {
     bool skip = false;
-    const auto *cb_context = GetAccessContext(commandBuffer);
+    const auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
     if (!cb_context || !pDependencyInfo) return skip;
 
@@ -5918,7 +6201,7 @@ bool SyncValidator::PreCallValidateCmdSetEvent2(VkCommandBuffer commandBuffer, V
 void SyncValidator::PostCallRecordCmdSetEvent2KHR(VkCommandBuffer commandBuffer, VkEvent event,
                                                   const VkDependencyInfoKHR *pDependencyInfo) {
     StateTracker::PostCallRecordCmdSetEvent2KHR(commandBuffer, event, pDependencyInfo);
-    auto *cb_context = GetAccessContext(commandBuffer);
+    auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
     if (!cb_context || !pDependencyInfo) return;
 
@@ -5929,7 +6212,7 @@ void SyncValidator::PostCallRecordCmdSetEvent2KHR(VkCommandBuffer commandBuffer,
 void SyncValidator::PostCallRecordCmdSetEvent2(VkCommandBuffer commandBuffer, VkEvent event,
                                                const VkDependencyInfo *pDependencyInfo) {
     StateTracker::PostCallRecordCmdSetEvent2(commandBuffer, event, pDependencyInfo);
-    auto *cb_context = GetAccessContext(commandBuffer);
+    auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
     if (!cb_context || !pDependencyInfo) return;
 
@@ -5940,7 +6223,7 @@ void SyncValidator::PostCallRecordCmdSetEvent2(VkCommandBuffer commandBuffer, Vk
 bool SyncValidator::PreCallValidateCmdResetEvent(VkCommandBuffer commandBuffer, VkEvent event,
                                                  VkPipelineStageFlags stageMask) const {
     bool skip = false;
-    const auto *cb_context = GetAccessContext(commandBuffer);
+    const auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
     if (!cb_context) return skip;
 
@@ -5950,7 +6233,7 @@ bool SyncValidator::PreCallValidateCmdResetEvent(VkCommandBuffer commandBuffer,
 
 void SyncValidator::PostCallRecordCmdResetEvent(VkCommandBuffer commandBuffer, VkEvent event, VkPipelineStageFlags stageMask) {
     StateTracker::PostCallRecordCmdResetEvent(commandBuffer, event, stageMask);
-    auto *cb_context = GetAccessContext(commandBuffer);
+    auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
     if (!cb_context) return;
 
@@ -5960,7 +6243,7 @@ void SyncValidator::PostCallRecordCmdResetEvent(VkCommandBuffer commandBuffer, V
 bool SyncValidator::PreCallValidateCmdResetEvent2KHR(VkCommandBuffer commandBuffer, VkEvent event,
                                                      VkPipelineStageFlags2KHR stageMask) const {
     bool skip = false;
-    const auto *cb_context = GetAccessContext(commandBuffer);
+    const auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
     if (!cb_context) return skip;
 
@@ -5971,7 +6254,7 @@ bool SyncValidator::PreCallValidateCmdResetEvent2KHR(VkCommandBuffer commandBuff
 bool SyncValidator::PreCallValidateCmdResetEvent2(VkCommandBuffer commandBuffer, VkEvent event,
                                                   VkPipelineStageFlags2 stageMask) const {
     bool skip = false;
-    const auto *cb_context = GetAccessContext(commandBuffer);
+    const auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
     if (!cb_context) return skip;
 
@@ -5982,7 +6265,7 @@ bool SyncValidator::PreCallValidateCmdResetEvent2(VkCommandBuffer commandBuffer,
 void SyncValidator::PostCallRecordCmdResetEvent2KHR(VkCommandBuffer commandBuffer, VkEvent event,
                                                     VkPipelineStageFlags2KHR stageMask) {
     StateTracker::PostCallRecordCmdResetEvent2KHR(commandBuffer, event, stageMask);
-    auto *cb_context = GetAccessContext(commandBuffer);
+    auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
     if (!cb_context) return;
 
@@ -5991,7 +6274,7 @@ void SyncValidator::PostCallRecordCmdResetEvent2KHR(VkCommandBuffer commandBuffe
 
 void SyncValidator::PostCallRecordCmdResetEvent2(VkCommandBuffer commandBuffer, VkEvent event, VkPipelineStageFlags2 stageMask) {
     StateTracker::PostCallRecordCmdResetEvent2(commandBuffer, event, stageMask);
-    auto *cb_context = GetAccessContext(commandBuffer);
+    auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
     if (!cb_context) return;
 
@@ -6006,7 +6289,7 @@ bool SyncValidator::PreCallValidateCmdWaitEvents(VkCommandBuffer commandBuffer,
                                                  uint32_t imageMemoryBarrierCount,
                                                  const VkImageMemoryBarrier *pImageMemoryBarriers) const {
     bool skip = false;
-    const auto *cb_context = GetAccessContext(commandBuffer);
+    const auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
     if (!cb_context) return skip;
 
@@ -6027,7 +6310,7 @@ void SyncValidator::PostCallRecordCmdWaitEvents(VkCommandBuffer commandBuffer, u
                                               pMemoryBarriers, bufferMemoryBarrierCount, pBufferMemoryBarriers,
                                               imageMemoryBarrierCount, pImageMemoryBarriers);
 
-    auto *cb_context = GetAccessContext(commandBuffer);
+    auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
     if (!cb_context) return;
 
@@ -6039,7 +6322,7 @@ void SyncValidator::PostCallRecordCmdWaitEvents(VkCommandBuffer commandBuffer, u
 bool SyncValidator::PreCallValidateCmdWaitEvents2KHR(VkCommandBuffer commandBuffer, uint32_t eventCount, const VkEvent *pEvents,
                                                      const VkDependencyInfoKHR *pDependencyInfos) const {
     bool skip = false;
-    const auto *cb_context = GetAccessContext(commandBuffer);
+    const auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
     if (!cb_context) return skip;
 
@@ -6052,7 +6335,7 @@ void SyncValidator::PostCallRecordCmdWaitEvents2KHR(VkCommandBuffer commandBuffe
                                                     const VkDependencyInfoKHR *pDependencyInfos) {
     StateTracker::PostCallRecordCmdWaitEvents2KHR(commandBuffer, eventCount, pEvents, pDependencyInfos);
 
-    auto *cb_context = GetAccessContext(commandBuffer);
+    auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
     if (!cb_context) return;
 
@@ -6063,7 +6346,7 @@ void SyncValidator::PostCallRecordCmdWaitEvents2KHR(VkCommandBuffer commandBuffe
 bool SyncValidator::PreCallValidateCmdWaitEvents2(VkCommandBuffer commandBuffer, uint32_t eventCount, const VkEvent *pEvents,
                                                   const VkDependencyInfo *pDependencyInfos) const {
     bool skip = false;
-    const auto *cb_context = GetAccessContext(commandBuffer);
+    const auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
     if (!cb_context) return skip;
 
@@ -6076,7 +6359,7 @@ void SyncValidator::PostCallRecordCmdWaitEvents2(VkCommandBuffer commandBuffer,
                                                  const VkDependencyInfo *pDependencyInfos) {
     StateTracker::PostCallRecordCmdWaitEvents2KHR(commandBuffer, eventCount, pEvents, pDependencyInfos);
 
-    auto *cb_context = GetAccessContext(commandBuffer);
+    auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
     if (!cb_context) return;
 
@@ -6719,7 +7002,7 @@ bool SyncOpWaitEvents::ReplayValidate(ResourceUsageTag recorded_tag, const Comma
 bool SyncValidator::PreCallValidateCmdWriteBufferMarker2AMD(VkCommandBuffer commandBuffer, VkPipelineStageFlags2KHR pipelineStage,
                                                             VkBuffer dstBuffer, VkDeviceSize dstOffset, uint32_t marker) const {
     bool skip = false;
-    const auto *cb_access_context = GetAccessContext(commandBuffer);
+    const auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     if (!cb_access_context) return skip;
 
@@ -7138,7 +7421,7 @@ void SyncOpEndRenderPass::ReplayRecord(CommandExecutionContext &exec_context, Re
 void SyncValidator::PreCallRecordCmdWriteBufferMarker2AMD(VkCommandBuffer commandBuffer, VkPipelineStageFlags2KHR pipelineStage,
                                                           VkBuffer dstBuffer, VkDeviceSize dstOffset, uint32_t marker) {
     StateTracker::PreCallRecordCmdWriteBufferMarker2AMD(commandBuffer, pipelineStage, dstBuffer, dstOffset, marker);
-    auto *cb_access_context = GetAccessContext(commandBuffer);
+    auto cb_access_context = GetAccessContext(commandBuffer);
     assert(cb_access_context);
     const auto tag = cb_access_context->NextCommandTag(CMD_WRITEBUFFERMARKERAMD);
     auto *context = cb_access_context->GetCurrentAccessContext();
@@ -7155,7 +7438,7 @@ void SyncValidator::PreCallRecordCmdWriteBufferMarker2AMD(VkCommandBuffer comman
 bool SyncValidator::PreCallValidateCmdExecuteCommands(VkCommandBuffer commandBuffer, uint32_t commandBufferCount,
                                                       const VkCommandBuffer *pCommandBuffers) const {
     bool skip = StateTracker::PreCallValidateCmdExecuteCommands(commandBuffer, commandBufferCount, pCommandBuffers);
-    const auto *cb_context = GetAccessContext(commandBuffer);
+    const auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
 
     // Heavyweight, but we need a proxy copy of the active command buffer access context
@@ -7164,8 +7447,10 @@ bool SyncValidator::PreCallValidateCmdExecuteCommands(VkCommandBuffer commandBuf
     // Make working copies of the access and events contexts
     for (uint32_t cb_index = 0; cb_index < commandBufferCount; ++cb_index) {
         proxy_cb_context.NextIndexedCommandTag(CMD_EXECUTECOMMANDS, cb_index);
+        // Executing the command buffer itself is reported by core validation. The context is already locked by this thread.
+        if (pCommandBuffers[cb_index] == commandBuffer) continue;
 
-        const auto *recorded_cb_context = GetAccessContext(pCommandBuffers[cb_index]);
+        const auto recorded_cb_context = GetAccessContext(pCommandBuffers[cb_index]);
         if (!recorded_cb_context) continue;
 
         const auto *recorded_context = recorded_cb_context->GetCurrentAccessContext();
@@ -7183,11 +7468,13 @@ bool SyncValidator::PreCallValidateCmdExecuteCommands(VkCommandBuffer commandBuf
 void SyncValidator::PreCallRecordCmdExecuteCommands(VkCommandBuffer commandBuffer, uint32_t commandBufferCount,
                                                     const VkCommandBuffer *pCommandBuffers) {
     StateTracker::PreCallRecordCmdExecuteCommands(commandBuffer, commandBufferCount, pCommandBuffers);
-    auto *cb_context = GetAccessContext(commandBuffer);
+    auto cb_context = GetAccessContext(commandBuffer);
     assert(cb_context);
     for (uint32_t cb_index = 0; cb_index < commandBufferCount; ++cb_index) {
         cb_context->NextIndexedCommandTag(CMD_EXECUTECOMMANDS, cb_index);
-        const auto *recorded_cb_context = GetAccessContext(pCommandBuffers[cb_index]);
+        // Locking the context of the command buffer itself again would deadlock
+        if (pCommandBuffers[cb_index] == commandBuffer) continue;
+        const auto recorded_cb_context = static_cast<const SyncValidator *>(this)->GetAccessContext(pCommandBuffers[cb_index]);
         if (!recorded_cb_context) continue;
         cb_context->RecordExecutedCommandBuffer(*recorded_cb_context);
     }
@@ -7196,6 +7483,7 @@ void SyncValidator::PreCallRecordCmdExecuteCommands(VkCommandBuffer commandBuffe
 void SyncValidator::PostCallRecordQueueWaitIdle(VkQueue queue, VkResult result) {
     StateTracker::PostCallRecordQueueWaitIdle(queue, result);
     if ((result != VK_SUCCESS) || (!enabled[sync_validation_queue_submit]) || (queue == VK_NULL_HANDLE)) return;
+    auto queue_lock = QueueWriteLock();
 
     const auto queue_state = GetQueueSyncStateShared(queue);
     if (!queue_state) return;  // Invalid queue
@@ -7208,6 +7496,7 @@ void SyncValidator::PostCallRecordQueueWaitIdle(VkQueue queue, VkResult result)
 
 void SyncValidator::PostCallRecordDeviceWaitIdle(VkDevice device, VkResult result) {
     StateTracker::PostCallRecordDeviceWaitIdle(device, result);
+    auto queue_lock = QueueWriteLock();
 
     QueueBatchContext::BatchSet queue_batch_contexts = GetQueueBatchSnapshot();
     for (auto &batch : queue_batch_contexts) {
@@ -7237,6 +7526,9 @@ bool SyncValidator::PreCallValidateQueueSubmit(VkQueue queue, uint32_t submitCou
     // Since this early return is above the TlsGuard, the Record phase must also be.
     if (!enabled[sync_validation_queue_submit]) return skip;
 
+    // Held until the end of the validate phase, the record phase retakes it exclusively to update the queue level state
+    auto queue_lock = QueueReadLock();
+
     layer_data::TlsGuard<QueueSubmitCmdState> cmd_state(&skip, global_access_log_, signaled_semaphores_);
     const auto fence_state = Get<FENCE_STATE>(fence);
     cmd_state->queue = GetQueueSyncStateShared(queue);
@@ -7305,6 +7597,7 @@ void SyncValidator::PostCallRecordQueueSubmit(VkQueue queue, uint32_t submitCoun
 
     if (VK_SUCCESS != result) return;  // dispatched QueueSubmit failed
     if (!cmd_state->queue) return;  // Validation couldn't find a valid queue object
+    auto queue_lock = QueueWriteLock();
 
     // Don't need to look up the queue state again, but we need a non-const version
     std::shared_ptr<QueueSyncState> queue_state = std::const_pointer_cast<QueueSyncState>(std::move(cmd_state->queue));
@@ -7340,6 +7633,7 @@ void SyncValidator::PostCallRecordQueueSubmit(VkQueue queue, uint32_t submitCoun
 
     // Update the global access log from the one built during validation
     global_access_log_.MergeMove(std::move(cmd_state->logger));
+    TrimAccessLog();
 
     ResourceUsageRange fence_tag_range = ReserveGlobalTagRange(1U);
     UpdateFenceWaitInfo(fence, queue_state->GetQueueId(), fence_tag_range.begin);
@@ -7367,6 +7661,7 @@ void SyncValidator::PostCallRecordQueueSubmit2KHR(VkQueue queue, uint32_t submit
 void SyncValidator::PostCallRecordGetFenceStatus(VkDevice device, VkFence fence, VkResult result) {
     StateTracker::PostCallRecordGetFenceStatus(device, fence, result);
     if (!enabled[sync_validation_queue_submit]) return;
+    auto queue_lock = QueueWriteLock();
     if (result == VK_SUCCESS) {
         // fence is signalled, mark it as waited for
         WaitForFence(fence);
@@ -7377,6 +7672,7 @@ void SyncValidator::PostCallRecordWaitForFences(VkDevice device, uint32_t fenceC
                                                 uint64_t timeout, VkResult result) {
     StateTracker::PostCallRecordWaitForFences(device, fenceCount, pFences, waitAll, timeout, result);
     if (!enabled[sync_validation_queue_submit]) return;
+    auto queue_lock = QueueWriteLock();
     if ((result == VK_SUCCESS) && ((VK_TRUE == waitAll) || (1 == fenceCount))) {
         // We can only know the pFences have signal if we waited for all of them, or there was only one of them
         for (uint32_t i = 0; i < fenceCount; i++) {
@@ -7661,7 +7957,14 @@ void QueueBatchContext::SetupAccessContext(const std::shared_ptr<const QueueBatc
 
     // If there are no semaphores to the previous batch, make sure a "submit order" non-barriered import is done
     if (prev && !layer_data::Contains(batches_resolved, prev)) {
-        access_context_.ResolveFromContext(NoopBarrierAction(), prev->access_context_);
+        if (batches_resolved.empty()) {
+            // Nothing has been imported, so the import is a copy. With the flat range map the previous batch's access state is
+            // shared instead, s.t. only the accesses this batch updates are copied, rather than all the state tracked for the
+            // queue.
+            access_context_.ShareAccessStateMaps(prev->access_context_);
+        } else {
+            access_context_.ResolveFromContext(NoopBarrierAction(), prev->access_context_);
+        }
     }
 
     // Gather async context information for hazard checks and conserve the QBC's for the async batches
@@ -7679,7 +7982,8 @@ void QueueBatchContext::SetupCommandBufferInfo(const BatchInfo &batch_info) {
     using Accessor = QueueBatchContext::SubmitInfoAccessor<BatchInfo>;
     Accessor batch(batch_info);
 
-    // Create the list of command buffers to submit
+    // Create the list of command buffers to submit. Submitted command buffers can't be in the recording state, so their
+    // access contexts are read without taking the per command buffer locks.
     const uint32_t cb_count = batch.CommandBufferCount();
     command_buffers_.reserve(cb_count);
     for (uint32_t index = 0; index < cb_count; ++index) {
@@ -7696,17 +8000,21 @@ std::string QueueBatchContext::FormatUsage(ResourceUsageTag tag) const {
     const AccessLogger &use_logger = (logger_) ? *logger_ : sync_state_->global_access_log_;
     std::stringstream out;
     AccessLogger::AccessRecord access = use_logger[tag];
-    if (access.IsValid()) {
+    if (access.batch) {
         const AccessLogger::BatchRecord &batch = *access.batch;
-        const ResourceUsageRecord &record = *access.record;
         // Queue and Batch information
         out << SyncNodeFormatter(*sync_state_, batch.queue->GetQueueState());
         out << ", submit: " << batch.submit_index << ", batch: " << batch.batch_index;
-
+    }
+    if (access.IsValid()) {
+        const ResourceUsageRecord &record = *access.record;
         // Commandbuffer Usages Information
         out << record;
         out << SyncNodeFormatter(*sync_state_, record.cb_state);
         out << ", reset_no: " << std::to_string(record.reset_count);
+    } else if (access.batch) {
+        // The record was dropped to limit the access log size
+        out << ", command buffer usage record not retained";
     }
     return out.str();
 }
@@ -7761,6 +8069,37 @@ void AccessLogger::Reset() {
     access_log_map_.clear();
 }
 
+void AccessLogger::Compact(const ResourceUsageTagSet &used) {
+    auto batch_it = access_log_map_.begin();
+    while (batch_it != access_log_map_.end()) {
+        const auto in_range = used.InRange(batch_it->first);
+        if (in_range.first == in_range.second) {
+            batch_it = access_log_map_.erase(batch_it);
+        } else {
+            batch_it->second.Compact(used, batch_it->first.begin);
+            ++batch_it;
+        }
+    }
+}
+
+void AccessLogger::LimitRecords(size_t max_records) {
+    size_t record_count = RecordCount();
+    // The map is in tag order, thus oldest batches first
+    for (auto &batch : access_log_map_) {
+        if (record_count <= max_records) break;
+        record_count -= batch.second.RecordCount();
+        batch.second.DropRecords();
+    }
+}
+
+size_t AccessLogger::RecordCount() const {
+    size_t record_count = 0;
+    for (const auto &batch : access_log_map_) {
+        record_count += batch.second.RecordCount();
+    }
+    return record_count;
+}
+
 // Since we're updating the QueueSync state, this is Record phase and the access log needs to point to the global one
 // Batch Contexts saved during signalling have their AccessLog reset when the pending signals are signalled.
 // NOTE: By design, QueueBatchContexts that are neither last, nor referenced by a signal are abandoned as unowned, since
@@ -7777,16 +8116,61 @@ void QueueSyncState::SetLastBatch(std::shared_ptr<QueueBatchContext> &&last) {
 uint64_t QueueSyncState::ReserveSubmitId() const { return submit_index_.fetch_add(1); }
 
 void AccessLogger::BatchLog::Append(const CommandExecutionContext::AccessLog &other) {
+    assert(!IsCompacted());  // Only batches still being built are appended to
     log_.insert(log_.end(), other.cbegin(), other.cend());
+    size_ = log_.size();
     for (const auto &record : other) {
         assert(record.cb_state);
         cbs_referenced_.insert(record.cb_state->shared_from_this());
     }
 }
 
+void AccessLogger::BatchLog::Compact(const ResourceUsageTagSet &used, ResourceUsageTag bias) {
+    const auto in_range = used.InRange(ResourceUsageRange(bias, bias + size_));
+    const size_t used_count = static_cast<size_t>(std::distance(in_range.first, in_range.second));
+    if (!IsCompacted() && (used_count == size_)) return;  // Nothing to retire
+
+    CommandExecutionContext::AccessLog compacted_log;
+    std::vector<ResourceUsageTag> compacted_index;
+    compacted_log.reserve(used_count);
+    compacted_index.reserve(used_count);
+    for (auto tag_it = in_range.first; tag_it != in_range.second; ++tag_it) {
+        const ResourceUsageTag index = *tag_it - bias;
+        AccessRecord access = (*this)[index];
+        if (access.record) {
+            compacted_log.emplace_back(*access.record);
+            compacted_index.emplace_back(index);
+        }
+    }
+
+    // Only the command buffers referenced by the retained records need to be kept alive
+    layer_data::unordered_set<std::shared_ptr<const CMD_BUFFER_STATE>> cbs_referenced;
+    for (const auto &record : compacted_log) {
+        cbs_referenced.insert(record.cb_state->shared_from_this());
+    }
+
+    log_ = std::move(compacted_log);
+    compacted_index_ = std::move(compacted_index);
+    cbs_referenced_ = std::move(cbs_referenced);
+}
+
+void AccessLogger::BatchLog::DropRecords() {
+    log_ = CommandExecutionContext::AccessLog();
+    compacted_index_ = std::vector<ResourceUsageTag>();
+    cbs_referenced_.clear();
+}
+
 AccessLogger::AccessRecord AccessLogger::BatchLog::operator[](size_t index) const {
-    assert(index < log_.size());
-    return AccessRecord{&batch_, &log_[index]};
+    assert(index < size_);
+    if (!IsCompacted()) {
+        return AccessRecord{&batch_, &log_[index]};
+    }
+
+    const auto found = std::lower_bound(compacted_index_.cbegin(), compacted_index_.cend(), index);
+    if ((found != compacted_index_.cend()) && (*found == index)) {
+        return AccessRecord{&batch_, &log_[static_cast<size_t>(std::distance(compacted_index_.cbegin(), found))]};
+    }
+    return AccessRecord{&batch_, nullptr};
 }
 
 AccessLogger::AccessRecord AccessLogger::operator[](ResourceUsageTag tag) const {
@@ -126,6 +126,24 @@ struct ResourceUsageRecord {
 using ResourceUsageTag = ResourceUsageRecord::TagIndex;
 using ResourceUsageRange = sparse_container::range<ResourceUsageTag>;
 
+// The tags referenced by a set of access states, s.t. the access log records no longer referenced can be retired
+class ResourceUsageTagSet {
+  public:
+    using const_iterator = std::vector<ResourceUsageTag>::const_iterator;
+    void insert(ResourceUsageTag tag) { tags_.push_back(tag); }
+    // Sort and remove duplicates, must be called after the last insert and before any query
+    void Normalize();
+    bool empty() const { return tags_.empty(); }
+    size_t size() const { return tags_.size(); }
+    const_iterator begin() const { return tags_.cbegin(); }
+    const_iterator end() const { return tags_.cend(); }
+    // The tags within range, [first, second)
+    std::pair<const_iterator, const_iterator> InRange(const ResourceUsageRange &range) const;
+
+  private:
+    std::vector<ResourceUsageTag> tags_;
+};
+
 struct HazardResult {
     std::unique_ptr<const ResourceAccessState> access_state;
     std::unique_ptr<const ResourceFirstAccess> recorded_access;
@@ -274,51 +292,124 @@ class ResourceAccessState : public SyncStageAccess {
     // given the only the second execution scope creates a dependency chain, we have to track each,
     // but only up to one per pipeline stage (as another read from the *same* stage become more recent,
     // and applicable one for hazard detection
-    struct ReadState {
-        VkPipelineStageFlags2KHR stage;  // The stage of this read
-        SyncStageAccessFlags access;    // TODO: Change to FlagBits when we have a None bit enum
-                                        // TODO: Revisit whether this needs to support multiple reads per stage
-        VkPipelineStageFlags2KHR barriers;  // all applicable barriered stages
-        VkPipelineStageFlags2KHR sync_stages;  // reads known to have happened after this
-        ResourceUsageTag tag;
-        QueueId queue;
-        VkPipelineStageFlags2KHR pending_dep_chain;  // Should be zero except during barrier application
-                                                     // Excluded from comparison
-        ReadState() = default;
-        ReadState(VkPipelineStageFlags2KHR stage_, SyncStageAccessFlags access_, VkPipelineStageFlags2KHR barriers_,
-                  ResourceUsageTag tag_);
-        bool operator==(const ReadState &rhs) const {
-            bool same = (stage == rhs.stage) && (access == rhs.access) && (barriers == rhs.barriers) && (tag == rhs.tag);
-            return same;
+    //
+    // The reads are stored by field (structure of arrays) rather than by read, so the per-read tests of hazard detection and
+    // barrier application are tight loops over contiguous stage masks. As there is at most one read per pipeline stage, the
+    // result of such a test fits in a ReadMask, one bit per read, in read order.
+    class ReadStates {
+      public:
+        using size_type = uint32_t;
+        using ReadMask = uint64_t;
+
+        ReadStates() : size_(0), capacity_(kInlineReads) {}
+        ReadStates(const ReadStates &other) : ReadStates() { CopyFrom(other); }
+        ReadStates(ReadStates &&other) : ReadStates() { MoveFrom(other); }
+        ReadStates &operator=(const ReadStates &other) {
+            if (this != &other) CopyFrom(other);
+            return *this;
+        }
+        ReadStates &operator=(ReadStates &&other) {
+            if (this != &other) MoveFrom(other);
+            return *this;
         }
-        bool IsReadBarrierHazard(VkPipelineStageFlags2KHR src_exec_scope) const {
-            // If the read stage is not in the src sync scope
-            // *AND* not execution chained with an existing sync barrier (that's the or)
-            // then the barrier access is unsafe (R/W after R)
-            return (src_exec_scope & (stage | barriers)) == 0;
+        // Compares stage, access, barriers, and tag.  The chaining and queue state is excluded from comparison
+        bool operator==(const ReadStates &rhs) const;
+        bool operator!=(const ReadStates &rhs) const { return !(*this == rhs); }
+
+        size_type size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        void clear() { size_ = 0; }
+        // All of the reads, as a mask
+        ReadMask All() const { return (size_ < 64) ? ((ReadMask(1) << size_) - 1) : ~ReadMask(0); }
+
+        // Add a read with no chained or pending barriers and an unset queue, returning its index
+        size_type Append(VkPipelineStageFlags2KHR stage, SyncStageAccessIndex access, VkPipelineStageFlags2KHR barriers,
+                         ResourceUsageTag tag);
+        size_type Append(const ReadStates &other, size_type other_index);
+        // Replace the read at index with a new read of the same stage, retaining the queue
+        void Set(size_type index, VkPipelineStageFlags2KHR stage, SyncStageAccessIndex access, VkPipelineStageFlags2KHR barriers,
+                 ResourceUsageTag tag);
+        // Remove the reads from the given stages, preserving the order of the remaining reads
+        void EraseStages(VkPipelineStageFlags2KHR stages);
+
+        VkPipelineStageFlags2KHR *Stages() { return Column<VkPipelineStageFlags2KHR>(kStageColumn); }
+        const VkPipelineStageFlags2KHR *Stages() const { return Column<VkPipelineStageFlags2KHR>(kStageColumn); }
+        SyncStageAccessIndex *Accesses() { return Column<SyncStageAccessIndex>(kAccessColumn); }
+        const SyncStageAccessIndex *Accesses() const { return Column<SyncStageAccessIndex>(kAccessColumn); }
+        // all applicable barriered stages
+        VkPipelineStageFlags2KHR *Barriers() { return Column<VkPipelineStageFlags2KHR>(kBarriersColumn); }
+        const VkPipelineStageFlags2KHR *Barriers() const { return Column<VkPipelineStageFlags2KHR>(kBarriersColumn); }
+        // reads known to have happened after this
+        VkPipelineStageFlags2KHR *SyncStages() { return Column<VkPipelineStageFlags2KHR>(kSyncStagesColumn); }
+        const VkPipelineStageFlags2KHR *SyncStages() const { return Column<VkPipelineStageFlags2KHR>(kSyncStagesColumn); }
+        // Should be zero except during barrier application
+        VkPipelineStageFlags2KHR *PendingDepChains() { return Column<VkPipelineStageFlags2KHR>(kPendingDepChainColumn); }
+        const VkPipelineStageFlags2KHR *PendingDepChains() const {
+            return Column<VkPipelineStageFlags2KHR>(kPendingDepChainColumn);
         }
-        bool IsReadBarrierHazard(QueueId barrier_queue, VkPipelineStageFlags2KHR src_exec_scope) const {
-            // If the read stage is not in the src sync scope
-            // *AND* not execution chained with an existing sync barrier (that's the or)
-            // then the barrier access is unsafe (R/W after R)
-            VkPipelineStageFlags2 queue_ordered_stage = (queue == barrier_queue) ? stage : VK_PIPELINE_STAGE_2_NONE;
-            return (src_exec_scope & (queue_ordered_stage | barriers)) == 0;
+        ResourceUsageTag *Tags() { return Column<ResourceUsageTag>(kTagColumn); }
+        const ResourceUsageTag *Tags() const { return Column<ResourceUsageTag>(kTagColumn); }
+        QueueId *Queues() { return Column<QueueId>(kQueueColumn); }
+        const QueueId *Queues() const { return Column<QueueId>(kQueueColumn); }
+
+        // The index of the first read in a non-empty mask
+        static size_type First(ReadMask reads) {
+            assert(reads);
+            return static_cast<size_type>(LeastSignificantBit(reads));
         }
+        VkPipelineStageFlags2KHR StagesOf(ReadMask reads) const;
+        // The reads from stages other than skip_stages, not barriered against all of usage_stages (R/W after R)
+        ReadMask ReadHazards(VkPipelineStageFlags2KHR usage_stages, VkPipelineStageFlags2KHR skip_stages = 0) const;
+        ReadMask TaggedAtOrAfter(ResourceUsageTag tag) const;
+        ReadMask NotOnQueue(QueueId queue) const;
+        // The reads in the src sync scope or execution chained with an existing sync barrier
+        ReadMask InScopeOrChain(VkPipelineStageFlags2KHR exec_scope) const;
+        ReadMask InQueueScopeOrChain(QueueId scope_queue, VkPipelineStageFlags2KHR exec_scope) const;
+        ReadMask InEventScope(VkPipelineStageFlags2KHR exec_scope, QueueId scope_queue, ResourceUsageTag scope_tag) const;
+
+        // Add dst_exec_scope to the pending chain of each read of, or known to be synchronized after, stages_in_scope
+        void PendDepChain(VkPipelineStageFlags2KHR stages_in_scope, VkPipelineStageFlags2KHR dst_exec_scope);
+        // Move the pending chains into the barriers, returning the union of all barriers
+        VkPipelineStageFlags2KHR ApplyPendingDepChains();
 
-        bool operator!=(const ReadState &rhs) const { return !(*this == rhs); }
-        void Set(VkPipelineStageFlags2KHR stage_, const SyncStageAccessFlags &access_, VkPipelineStageFlags2KHR barriers_,
-                 ResourceUsageTag tag_);
-        bool ReadInScopeOrChain(VkPipelineStageFlags2 exec_scope) const { return (exec_scope & (stage | barriers)) != 0; }
-        bool ReadInQueueScopeOrChain(QueueId queue, VkPipelineStageFlags2 exec_scope) const;
-        bool ReadInEventScope(VkPipelineStageFlags2 exec_scope, QueueId scope_queue, ResourceUsageTag scope_tag) const {
-            // If this read is the same one we included in the set event and in scope, then apply the execution barrier...
-            // NOTE: That's not really correct... this read stage might *not* have been included in the setevent, and the barriers
-            // representing the chain might have changed since then (that would be an odd usage), so as a first approximation
-            // we'll assume the barriers *haven't* been changed since (if the tag hasn't), and while this could be a false
-            // positive in the case of Set; SomeBarrier; Wait; we'll live with it until we can add more state to the first scope
-            // capture (the specific write and read stages that *were* in scope at the moment of SetEvents.
-            return (tag < scope_tag) && ReadInQueueScopeOrChain(scope_queue, exec_scope);
+      private:
+        static constexpr size_type kInlineReads = 3;
+        // Byte offset of each column, per read of capacity_.  The 8 byte columns come first and the 4 byte queue and access
+        // columns last, so each column is aligned to its element size for any capacity.
+        enum : size_t {
+            kStageColumn = 0,
+            kBarriersColumn = 8,
+            kSyncStagesColumn = 16,
+            kPendingDepChainColumn = 24,
+            kTagColumn = 32,
+            kQueueColumn = 40,
+            kAccessColumn = 44,
+            kReadBytes = 48,
+        };
+        static_assert(sizeof(VkPipelineStageFlags2KHR) == 8, "ReadStates column layout mismatch");
+        static_assert(sizeof(ResourceUsageTag) <= 8, "ReadStates column layout mismatch");
+        static_assert(sizeof(QueueId) <= 4, "ReadStates column layout mismatch");
+        static_assert(sizeof(SyncStageAccessIndex) <= 4, "ReadStates column layout mismatch");
+
+        uint8_t *Data() { return heap_ ? heap_.get() : inline_store_; }
+        const uint8_t *Data() const { return heap_ ? heap_.get() : inline_store_; }
+        template <typename T>
+        T *Column(size_t column) {
+            return reinterpret_cast<T *>(Data() + column * capacity_);
+        }
+        template <typename T>
+        const T *Column(size_t column) const {
+            return reinterpret_cast<const T *>(Data() + column * capacity_);
         }
+        void Reserve(size_type new_capacity, bool preserve);
+        void CopyColumns(const ReadStates &from, size_type count);
+        void CopyFrom(const ReadStates &other);
+        void MoveFrom(ReadStates &other);
+
+        size_type size_;
+        size_type capacity_;
+        std::unique_ptr<uint8_t[]> heap_;
+        alignas(uint64_t) uint8_t inline_store_[kInlineReads * kReadBytes];
     };
 
   public:
@@ -370,6 +461,7 @@ class ResourceAccessState : public SyncStageAccess {
     bool FirstAccessInTagRange(const ResourceUsageRange &tag_range) const;
 
     void OffsetTag(ResourceUsageTag offset);
+    void GatherReferencedTags(ResourceUsageTagSet &used) const;
     ResourceAccessState();
 
     bool HasPendingState() const {
@@ -405,8 +497,8 @@ class ResourceAccessState : public SyncStageAccess {
         bool WriteInScope(const SyncBarrier &barrier, const ResourceAccessState &access) const {
             return access.WriteInSourceScopeOrChain(barrier.src_exec_scope.exec_scope, barrier.src_access_scope);
         }
-        bool ReadInScope(const SyncBarrier &barrier, const ReadState &read_state) const {
-            return read_state.ReadInScopeOrChain(barrier.src_exec_scope.exec_scope);
+        ReadStates::ReadMask ReadsInScope(const SyncBarrier &barrier, const ReadStates &reads) const {
+            return reads.InScopeOrChain(barrier.src_exec_scope.exec_scope);
         }
     };
 
@@ -414,8 +506,8 @@ class ResourceAccessState : public SyncStageAccess {
         bool WriteInScope(const SyncBarrier &barrier, const ResourceAccessState &access) const {
             return access.WriteInQueueSourceScopeOrChain(queue, barrier.src_exec_scope.exec_scope, barrier.src_access_scope);
         }
-        bool ReadInScope(const SyncBarrier &barrier, const ReadState &read_state) const {
-            return read_state.ReadInQueueScopeOrChain(queue, barrier.src_exec_scope.exec_scope);
+        ReadStates::ReadMask ReadsInScope(const SyncBarrier &barrier, const ReadStates &reads) const {
+            return reads.InQueueScopeOrChain(queue, barrier.src_exec_scope.exec_scope);
         }
         QueueScopeOps(QueueId scope_queue) : queue(scope_queue) {}
         QueueId queue;
@@ -425,8 +517,8 @@ class ResourceAccessState : public SyncStageAccess {
         bool WriteInScope(const SyncBarrier &barrier, const ResourceAccessState &access) const {
             return access.WriteInEventScope(barrier.src_exec_scope.exec_scope, barrier.src_access_scope, scope_queue, scope_tag);
         }
-        bool ReadInScope(const SyncBarrier &barrier, const ReadState &read_state) const {
-            return read_state.ReadInEventScope(barrier.src_exec_scope.exec_scope, scope_queue, scope_tag);
+        ReadStates::ReadMask ReadsInScope(const SyncBarrier &barrier, const ReadStates &reads) const {
+            return reads.InEventScope(barrier.src_exec_scope.exec_scope, scope_queue, scope_tag);
         }
         EventScopeOps(QueueId qid, ResourceUsageTag event_tag) : scope_queue(qid), scope_tag(event_tag) {}
         QueueId scope_queue;
@@ -459,14 +551,6 @@ class ResourceAccessState : public SyncStageAccess {
     bool ReadInSourceScopeOrChain(VkPipelineStageFlags2KHR src_exec_scope) const {
         return (0 != (src_exec_scope & (last_read_stages | read_execution_barriers)));
     }
-
-    static bool IsReadHazard(VkPipelineStageFlags2KHR stage_mask, const VkPipelineStageFlags2KHR barriers) {
-        return stage_mask != (stage_mask & barriers);
-    }
-
-    bool IsReadHazard(VkPipelineStageFlags2KHR stage_mask, const ReadState &read_access) const {
-        return IsReadHazard(stage_mask, read_access.barriers);
-    }
     VkPipelineStageFlags2 GetOrderedStages(QueueId queue_id, const OrderingBarrier &ordering) const;
 
     void UpdateFirst(ResourceUsageTag tag, SyncStageAccessIndex usage_index, SyncOrdering ordering_rule);
@@ -493,7 +577,6 @@ class ResourceAccessState : public SyncStageAccess {
 
     VkPipelineStageFlags2KHR last_read_stages;
     VkPipelineStageFlags2KHR read_execution_barriers;
-    using ReadStates = small_vector<ReadState, 3, uint32_t>;
     ReadStates last_reads;
 
     // Pending execution state to support independent parallel barriers
@@ -511,7 +594,16 @@ using ResourceAccessStateFunction = std::function<void(ResourceAccessState *)>;
 using ResourceAccessStateConstFunction = std::function<void(const ResourceAccessState &)>;
 
 using ResourceAddress = VkDeviceSize;
+#ifdef SYNCVAL_FLAT_RANGE_MAP
+// The sorted flat map keeps lookups and in-order walks in contiguous memory and shares unchanged entries between maps, which
+// queue submit uses to carry the access state from batch to batch. Inserting into or splitting a large map shifts its slots,
+// so it is slower than std::map for random overwrites and stays opt-in (the SYNCVAL_FLAT_RANGE_MAP CMake option).
+using ResourceAccessRangeMap =
+    sparse_container::range_map<ResourceAddress, ResourceAccessState, sparse_container::range<ResourceAddress>,
+                                sparse_container::flat_range_map<ResourceAddress, ResourceAccessState>>;
+#else
 using ResourceAccessRangeMap = sparse_container::range_map<ResourceAddress, ResourceAccessState>;
+#endif
 using ResourceAccessRange = typename ResourceAccessRangeMap::key_type;
 using ResourceAccessRangeIndex = typename ResourceAccessRange::index_type;
 using ResourceRangeMergeIterator = sparse_container::parallel_iterator<ResourceAccessRangeMap, const ResourceAccessRangeMap>;
@@ -930,6 +1022,10 @@ class AccessContext {
     void ResolveChildContexts(const std::vector<AccessContext> &contexts);
 
     void ImportAsyncContexts(const AccessContext &from);
+    // Import all accesses of from without a barrier, replacing the current contents. The access states are shared with from
+    // and only copied as they are updated.
+    void ShareAccessStateMaps(const AccessContext &from);
+    void GatherReferencedTags(ResourceUsageTagSet &used) const;
     template <typename Action, typename RangeGen>
     void ApplyUpdateAction(AccessAddressType address_type, const Action &action, RangeGen *range_gen_arg);
     template <typename Action>
@@ -1313,9 +1409,14 @@ class CommandBufferAccessContext : public CommandExecutionContext {
     void InsertRecordedAccessLogEntries(const CommandBufferAccessContext &cb_context) override;
     const std::vector<SyncOpEntry> &GetSyncOps() const { return sync_ops_; };
 
+    // Command buffers are recorded concurrently, so each context carries its own lock (see SyncValidator::ReadLock)
+    ReadLockGuard ReadLock() const { return ReadLockGuard(lock_); }
+    WriteLockGuard WriteLock() { return WriteLockGuard(lock_); }
+
   private:
     // As this is passing around a shared pointer to record, move to avoid needless atomics.
     void RecordSyncOp(SyncOpPointer &&sync_op);
+    mutable ReadWriteLock lock_;
     std::shared_ptr<CMD_BUFFER_STATE> cb_state_;
     VkQueueFlags queue_flags_;
     bool destroyed_;
@@ -1354,6 +1455,7 @@ class AccessLogger {
         uint32_t batch_index;
     };
 
+    // After compaction or when over the record limit, the batch may be found without the record
     struct AccessRecord {
         const BatchRecord *batch;
         const ResourceUsageRecord *record;
@@ -1370,16 +1472,28 @@ class AccessLogger {
         BatchLog &operator=(BatchLog &&other) = default;
         BatchLog(const BatchRecord &batch) : batch_(batch) {}
 
-        size_t Size() const { return log_.size(); }
+        // The number of tags in the batch, which is unchanged by Compact and DropRecords
+        size_t Size() const { return size_; }
+        // The number of records actually retained
+        size_t RecordCount() const { return log_.size(); }
         const BatchRecord &GetBatch() const { return batch_; }
         AccessRecord operator[](size_t index) const;
 
         void Append(const CommandExecutionContext::AccessLog &other);
+        // Retain only the records of the used tags (at or after bias), and the command buffers they reference
+        void Compact(const ResourceUsageTagSet &used, ResourceUsageTag bias);
+        // Retain none of the records, only the batch information
+        void DropRecords();
 
       private:
+        bool IsCompacted() const { return log_.size() != size_; }
+
         BatchRecord batch_;
+        size_t size_ = 0;
         layer_data::unordered_set<std::shared_ptr<const CMD_BUFFER_STATE>> cbs_referenced_;
         CommandExecutionContext::AccessLog log_;
+        // Once compacted, the batch relative tag of each record in log_ (in order), otherwise empty
+        std::vector<ResourceUsageTag> compacted_index_;
     };
 
     using AccessLogRangeMap = sparse_container::range_map<ResourceUsageTag, BatchLog>;
@@ -1391,6 +1505,14 @@ class AccessLogger {
     void MergeMove(AccessLogger &&child);
     void Reset();
 
+    // The log can grow without bound as batches are submitted. Once no access state references the tags of a batch, it can be
+    // retired, and for the remainder only the referenced records need to be retained.
+    void Compact(const ResourceUsageTagSet &used);
+    // Drop the records of the oldest batches s.t. at most max_records remain. This only reduces the detail reported for the
+    // accesses of those batches, hazard detection is unaffected.
+    void LimitRecords(size_t max_records);
+    size_t RecordCount() const;
+
   private:
     const AccessLogger *prev_;
     AccessLogRangeMap access_log_map_;
@@ -1448,6 +1570,7 @@ class QueueBatchContext : public CommandExecutionContext {
         batch_log_ = nullptr;
     }
     void ResetEventsContext() { events_context_.Clear(); }
+    void GatherReferencedTags(ResourceUsageTagSet &used) const { access_context_.GatherReferencedTags(used); }
     ResourceUsageTag GetTagLimit() const override { return batch_log_->Size() + tag_range_.begin; }
     // begin is the tag bias  / .size() is the number of total records that should eventually be in access_log_
     ResourceUsageRange GetTagRange() const { return tag_range_; }
@@ -1550,8 +1673,22 @@ class SyncValidator : public ValidationStateTracker, public SyncStageAccess {
     ResourceUsageRange ReserveGlobalTagRange(size_t tag_count) const;  // Note that the tag_limit_ is mutable this has side effects
     // This is a snapshot value only
     AccessLogger global_access_log_;
-
-    layer_data::unordered_map<VkCommandBuffer, std::shared_ptr<CommandBufferAccessContext>> cb_access_state;
+    // Retention of the global access log records, set from the syncval_access_log_* layer settings
+    bool access_log_compaction_ = true;
+    size_t access_log_record_limit_ = 0;    // Zero is unlimited
+    size_t access_log_compacted_size_ = 0;  // Record count after the last compaction
+    void TrimAccessLog();
+
+    // With fine grained locking, command buffer recording only takes the lock of the command buffer's access context, while
+    // the queue level state below (queue sync states, signaled semaphores, waitable fences and the global access log) is
+    // guarded device wide by queue_lock_.
+    ReadLockGuard ReadLock() override;
+    WriteLockGuard WriteLock() override;
+    ReadLockGuard QueueReadLock() const { return ReadLockGuard(queue_lock_); }
+    WriteLockGuard QueueWriteLock() { return WriteLockGuard(queue_lock_); }
+    mutable ReadWriteLock queue_lock_;
+
+    vl_concurrent_unordered_map<VkCommandBuffer, std::shared_ptr<CommandBufferAccessContext>, 4> cb_access_state;
 
     using QueueSyncStatesMap = layer_data::unordered_map<VkQueue, std::shared_ptr<QueueSyncState>>;
     layer_data::unordered_map<VkQueue, std::shared_ptr<QueueSyncState>> queue_sync_states_;
@@ -1583,10 +1720,13 @@ class SyncValidator : public ValidationStateTracker, public SyncStageAccess {
     QueueBatchContext::BatchSet GetQueueLastBatchSnapshot(Predicate &&pred);
     QueueBatchContext::BatchSet GetQueueLastBatchSnapshot() { return GetQueueLastBatchSnapshot(QueueBatchContext::TruePred); };
 
+    // The access context accessors return the context locked for the duration of the returned object's lifetime
+    using AccessContextReadPtr = LockedSharedPtr<const CommandBufferAccessContext, ReadLockGuard>;
+    using AccessContextWritePtr = LockedSharedPtr<CommandBufferAccessContext, WriteLockGuard>;
     std::shared_ptr<CommandBufferAccessContext> AccessContextFactory(VkCommandBuffer command_buffer);
-    CommandBufferAccessContext *GetAccessContext(VkCommandBuffer command_buffer);
-    CommandBufferAccessContext *GetAccessContextNoInsert(VkCommandBuffer command_buffer);
-    const CommandBufferAccessContext *GetAccessContext(VkCommandBuffer command_buffer) const;
+    AccessContextWritePtr GetAccessContext(VkCommandBuffer command_buffer);
+    AccessContextWritePtr GetAccessContextNoInsert(VkCommandBuffer command_buffer);
+    AccessContextReadPtr GetAccessContext(VkCommandBuffer command_buffer) const;
     std::shared_ptr<CommandBufferAccessContext> GetAccessContextShared(VkCommandBuffer command_buffer);
     std::shared_ptr<const CommandBufferAccessContext> GetAccessContextShared(VkCommandBuffer command_buffer) const;
 
@@ -1753,7 +1893,7 @@ class SyncValidator : public ValidationStateTracker, public SyncStageAccess {
     template <typename RegionType>
     void RecordCmdBlitImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout srcImageLayout, VkImage dstImage,
                             VkImageLayout dstImageLayout, uint32_t regionCount, const RegionType *pRegions, VkFilter filter,
-                            ResourceUsageTag tag);
+                            CMD_TYPE cmd_type);
     void PreCallRecordCmdBlitImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout srcImageLayout, VkImage dstImage,
                                    VkImageLayout dstImageLayout, uint32_t regionCount, const VkImageBlit *pRegions,
                                    VkFilter filter) override;
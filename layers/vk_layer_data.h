@@ -24,6 +24,7 @@
 #define LAYER_DATA_H
 
 #include <cassert>
+#include <cstddef>
 #include <limits>
 #include <memory>
 #include <map>
@@ -32,6 +33,7 @@
 #include <algorithm>
 #include <iterator>
 #include <type_traits>
+#include <vector>
 
 #ifdef USE_ROBIN_HOOD_HASHING
 #include "robin_hood.h"
@@ -980,6 +982,249 @@ class TlsGuard {
 template <typename T>
 thread_local optional<T> TlsGuard<T>::payload_;
 
+// Per-thread bump allocator for short lived, call scoped copies of trivially copyable data, such as the unwrapped copies
+// of API structures built by the dispatch layer. Everything allocated within a Scope is released at once when the Scope
+// ends, and the backing blocks are kept for reuse by later calls on the same thread. Scopes may nest.
+class ScratchArena {
+  public:
+    static ScratchArena &ThreadLocal() {
+        thread_local ScratchArena arena;
+        return arena;
+    }
+
+    class Scope {
+      public:
+        explicit Scope(ScratchArena &arena = ThreadLocal()) : arena_(arena), block_(arena.block_), offset_(arena.offset_) {}
+        ~Scope() {
+            arena_.block_ = block_;
+            arena_.offset_ = offset_;
+        }
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+        ScratchArena &Arena() { return arena_; }
+
+      private:
+        ScratchArena &arena_;
+        size_t block_;
+        size_t offset_;
+    };
+
+    void *Allocate(size_t size, size_t alignment) {
+        while (block_ < blocks_.size()) {
+            const size_t aligned = (offset_ + alignment - 1) & ~(alignment - 1);
+            if (aligned + size <= blocks_[block_].size) {
+                offset_ = aligned + size;
+                return blocks_[block_].data.get() + aligned;
+            }
+            ++block_;
+            offset_ = 0;
+        }
+        blocks_.emplace_back((size + alignment > kBlockSize) ? size + alignment : kBlockSize);
+        // Fresh blocks come from operator new[], which is aligned for any fundamental type.
+        offset_ = size;
+        return blocks_[block_].data.get();
+    }
+
+    template <typename T>
+    T *Allocate(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "ScratchArena does not run destructors");
+        return static_cast<T *>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    template <typename T>
+    T *Copy(const T *src, size_t count) {
+        T *dst = Allocate<T>(count);
+        std::copy(src, src + count, dst);
+        return dst;
+    }
+
+  private:
+    static const size_t kBlockSize = 64 * 1024;
+
+    struct Block {
+        explicit Block(size_t block_size) : data(new uint8_t[block_size]), size(block_size) {}
+        std::unique_ptr<uint8_t[]> data;
+        size_t size;
+    };
+
+    ScratchArena() : block_(0), offset_(0) {}
+
+    std::vector<Block> blocks_;
+    size_t block_;
+    size_t offset_;
+};
+
+// A sequence of callables sharing a signature, such as the validation a command buffer defers until it is submitted. Unlike
+// std::vector<std::function<Signature>>, each callable is stored in place in blocks owned by the stream, next to the functions
+// that invoke, copy and destroy its closure type, and clear() keeps the blocks for reuse. Once a stream has grown to the size a
+// command buffer needs, re-recording the command buffer does not allocate for its deferred operations.
+template <typename Signature>
+class DeferredOpStream;
+
+template <typename R, typename... Args>
+class DeferredOpStream<R(Args...)> {
+    struct OpType {
+        R (*invoke)(void *closure, Args... args);
+        void (*copy)(void *dst, const void *src);
+        void (*destroy)(void *closure);
+    };
+
+  public:
+    // The header of a recorded callable, which is followed by the closure object
+    class Op {
+      public:
+        R operator()(Args... args) const { return type_->invoke(Payload(), std::forward<Args>(args)...); }
+
+      private:
+        friend class DeferredOpStream;
+        Op(const OpType *type, size_t size) : type_(type), size_(size) {}
+        void *Payload() const { return const_cast<uint8_t *>(reinterpret_cast<const uint8_t *>(this)) + kHeaderSize; }
+
+        const OpType *type_;
+        size_t size_;  // Of the header and the closure, rounded up to kAlignment
+    };
+
+  private:
+    struct Block {
+        explicit Block(size_t block_size) : data(new uint8_t[block_size]), size(block_size), used(0) {}
+        std::unique_ptr<uint8_t[]> data;
+        size_t size;
+        size_t used;
+    };
+
+  public:
+    class const_iterator {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Op;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Op *;
+        using reference = const Op &;
+
+        reference operator*() const { return *Current(); }
+        pointer operator->() const { return Current(); }
+        const_iterator &operator++() {
+            offset_ += Current()->size_;
+            SkipFinishedBlocks();
+            return *this;
+        }
+        bool operator==(const const_iterator &other) const { return block_ == other.block_ && offset_ == other.offset_; }
+        bool operator!=(const const_iterator &other) const { return !(*this == other); }
+
+      private:
+        friend class DeferredOpStream;
+        const_iterator(const std::vector<Block> &blocks, size_t block) : blocks_(&blocks), block_(block), offset_(0) {
+            SkipFinishedBlocks();
+        }
+        pointer Current() const { return reinterpret_cast<pointer>((*blocks_)[block_].data.get() + offset_); }
+        // Blocks can be left empty, when an op was too large for them
+        void SkipFinishedBlocks() {
+            while (block_ < blocks_->size() && offset_ >= (*blocks_)[block_].used) {
+                ++block_;
+                offset_ = 0;
+            }
+        }
+
+        const std::vector<Block> *blocks_;
+        size_t block_;
+        size_t offset_;
+    };
+
+    DeferredOpStream() : block_(0), count_(0) {}
+    DeferredOpStream(const DeferredOpStream &other) : block_(0), count_(0) { append(other); }
+    DeferredOpStream(DeferredOpStream &&other) : blocks_(std::move(other.blocks_)), block_(other.block_), count_(other.count_) {
+        other.blocks_.clear();
+        other.block_ = 0;
+        other.count_ = 0;
+    }
+    DeferredOpStream &operator=(const DeferredOpStream &other) {
+        if (this != &other) {
+            clear();
+            append(other);
+        }
+        return *this;
+    }
+    ~DeferredOpStream() { clear(); }
+
+    template <typename Fn>
+    void emplace_back(Fn &&fn) {
+        using Closure = typename std::decay<Fn>::type;
+        static_assert(alignof(Closure) <= kAlignment, "DeferredOpStream closures must not be over-aligned");
+        new (Push(TypeOf<Closure>(), sizeof(Closure))) Closure(std::forward<Fn>(fn));
+    }
+
+    // Copy the ops of other to the end of this stream
+    void append(const DeferredOpStream &other) {
+        assert(this != &other);
+        for (const auto &op : other) {
+            op.type_->copy(Push(op.type_, op.size_ - kHeaderSize), op.Payload());
+        }
+    }
+
+    void clear() {
+        for (const auto &op : *this) {
+            op.type_->destroy(op.Payload());
+        }
+        for (auto &block : blocks_) {
+            block.used = 0;
+        }
+        block_ = 0;
+        count_ = 0;
+    }
+
+    const_iterator begin() const { return const_iterator(blocks_, 0); }
+    const_iterator end() const { return const_iterator(blocks_, blocks_.size()); }
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+  private:
+    static const size_t kBlockSize = 4 * 1024;
+    static const size_t kAlignment = alignof(std::max_align_t);
+    static const size_t kHeaderSize = (sizeof(Op) + kAlignment - 1) & ~(kAlignment - 1);
+
+    template <typename Closure>
+    static R Invoke(void *closure, Args... args) {
+        return (*static_cast<Closure *>(closure))(std::forward<Args>(args)...);
+    }
+    template <typename Closure>
+    static void Copy(void *dst, const void *src) {
+        new (dst) Closure(*static_cast<const Closure *>(src));
+    }
+    template <typename Closure>
+    static void Destroy(void *closure) {
+        static_cast<Closure *>(closure)->~Closure();
+    }
+    template <typename Closure>
+    static const OpType *TypeOf() {
+        static const OpType type = {&Invoke<Closure>, &Copy<Closure>, &Destroy<Closure>};
+        return &type;
+    }
+
+    // Returns the location of the closure of a new op, which must be constructed by the caller
+    void *Push(const OpType *type, size_t closure_size) {
+        const size_t size = kHeaderSize + ((closure_size + kAlignment - 1) & ~(kAlignment - 1));
+        while (block_ < blocks_.size() && blocks_[block_].used + size > blocks_[block_].size) {
+            ++block_;
+        }
+        if (block_ == blocks_.size()) {
+            size_t block_size = kBlockSize;
+            if (size > block_size) block_size = size;
+            // Fresh blocks come from operator new[], which is aligned for any fundamental type.
+            blocks_.emplace_back(block_size);
+        }
+        Block &block = blocks_[block_];
+        uint8_t *header = block.data.get() + block.used;
+        block.used += size;
+        ++count_;
+        return reinterpret_cast<uint8_t *>(new (header) Op(type, size)) + kHeaderSize;
+    }
+
+    std::vector<Block> blocks_;
+    size_t block_;  // The block ops are currently added to. Blocks after it are empty.
+    size_t count_;
+};
+
 // Only use this if you aren't planning to use what you would have gotten from a find.
 template <typename Container, typename Key = typename Container::key_type>
 bool Contains(const Container &container, const Key &key) {
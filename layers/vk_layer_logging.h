@@ -659,6 +659,33 @@ static inline int vasprintf(char **strp, char const *fmt, va_list ap) {
 }
 #endif
 
+// A message logged while a LogMsgDeferral was active, waiting to be reported by ReportDeferredLogMsgs()
+struct DeferredLogMsg {
+    VkFlags msg_flags;
+    LogObjectList objects;
+    std::string vuid_text;
+    std::unique_ptr<char, void (*)(void *)> err_msg;
+};
+
+// While a LogMsgDeferral is alive, messages logged on its thread are appended to its list instead of being reported. This lets
+// validation that is split across worker threads report its messages in the same order as when run on a single thread. The
+// duplicate message limit is applied when the messages are reported.
+class LogMsgDeferral {
+  public:
+    explicit LogMsgDeferral(std::vector<DeferredLogMsg> &msgs) : previous_(Active()) { Active() = &msgs; }
+    ~LogMsgDeferral() { Active() = previous_; }
+    LogMsgDeferral(const LogMsgDeferral &) = delete;
+    LogMsgDeferral &operator=(const LogMsgDeferral &) = delete;
+
+    static std::vector<DeferredLogMsg> *&Active() {
+        thread_local std::vector<DeferredLogMsg> *active = nullptr;
+        return active;
+    }
+
+  private:
+    std::vector<DeferredLogMsg> *previous_;
+};
+
 // helper for VUID based filtering. This needs to be separate so it can be called before incurring
 // the cost of sprintf()-ing the err_msg needed by LogMsgLocked().
 static inline bool LogMsgEnabled(const debug_report_data *debug_data, const std::string &vuid_text,
@@ -672,7 +699,8 @@ static inline bool LogMsgEnabled(const debug_report_data *debug_data, const std:
         != debug_data->filter_message_ids.end()) {
         return false;
     }
-    if ((debug_data->duplicate_message_limit > 0) && UpdateLogMsgCounts(debug_data, static_cast<int32_t>(message_id))) {
+    if ((debug_data->duplicate_message_limit > 0) && !LogMsgDeferral::Active() &&
+        UpdateLogMsgCounts(debug_data, static_cast<int32_t>(message_id))) {
         // Count for this particular message is over the limit, ignore it
         return false;
     }
@@ -681,6 +709,11 @@ static inline bool LogMsgEnabled(const debug_report_data *debug_data, const std:
 
 static inline bool LogMsgLocked(const debug_report_data *debug_data, VkFlags msg_flags, const LogObjectList &objects,
                                 const std::string &vuid_text, char *err_msg) {
+    if (auto deferred_msgs = LogMsgDeferral::Active()) {
+        deferred_msgs->emplace_back(DeferredLogMsg{msg_flags, objects, vuid_text, {err_msg, free}});
+        return false;
+    }
+
     std::string str_plus_spec_text(err_msg ? err_msg : "Allocation failure");
 
     // Append the spec error text to the error message, unless it's an UNASSIGNED or UNDEFINED vuid
@@ -741,6 +774,23 @@ static inline bool LogMsgLocked(const debug_report_data *debug_data, VkFlags msg
     return result;
 }
 
+// Report the messages recorded by a LogMsgDeferral, in the order they were logged, and clear the list. Returns true if a callback
+// requested that the call be skipped.
+static inline bool ReportDeferredLogMsgs(const debug_report_data *debug_data, std::vector<DeferredLogMsg> &msgs) {
+    assert(!LogMsgDeferral::Active());
+    bool bail = false;
+    std::unique_lock<std::mutex> lock(debug_data->debug_output_mutex);
+    for (auto &msg : msgs) {
+        const uint32_t message_id = XXH32(msg.vuid_text.c_str(), msg.vuid_text.size(), 8);
+        if ((debug_data->duplicate_message_limit > 0) && UpdateLogMsgCounts(debug_data, static_cast<int32_t>(message_id))) {
+            continue;
+        }
+        bail |= LogMsgLocked(debug_data, msg.msg_flags, msg.objects, msg.vuid_text, msg.err_msg.release());
+    }
+    msgs.clear();
+    return bail;
+}
+
 static inline VKAPI_ATTR VkBool32 VKAPI_CALL report_log_callback(VkFlags msg_flags, VkDebugReportObjectTypeEXT obj_type,
                                                                  uint64_t src_object, size_t location, int32_t msg_code,
                                                                  const char *layer_prefix, const char *message, void *user_data) {
@@ -22,9 +22,19 @@
 #include "vk_layer_utils.h"
 
 #include <string.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
 #include <string>
+#include <thread>
 #include <vector>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
 #include "vulkan/vulkan.h"
 #include "vk_layer_config.h"
 
@@ -219,3 +229,149 @@ VK_LAYER_EXPORT VkLayerDeviceCreateInfo *get_chain_info(const VkDeviceCreateInfo
     assert(chain_info != NULL);
     return chain_info;
 }
+
+EpochDomain::EpochDomain() : parity_(0) {
+    for (auto &slot : slots_) {
+        slot.readers[0].store(0, std::memory_order_relaxed);
+        slot.readers[1].store(0, std::memory_order_relaxed);
+    }
+}
+
+uint32_t EpochDomain::ThreadSlotIndex() {
+    // Threads are spread round robin over the slots, threads sharing a slot only share a counter. The slot is chosen per
+    // thread rather than per domain, so a thread uses the same slot index in every domain.
+    static std::atomic<uint32_t> next_slot{0};
+    thread_local uint32_t slot_index = next_slot.fetch_add(1, std::memory_order_relaxed) % kSlotCount;
+    return slot_index;
+}
+
+void EpochDomain::Synchronize() {
+    std::lock_guard<std::mutex> lock(synchronize_lock_);
+    // Pairs with the fence in EnterRead(), making the caller's unlinks visible to any reader the scan below misses.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    // Flip twice: a reader that sampled the parity before the first flip may have registered on either counter.
+    for (int flip = 0; flip < 2; ++flip) {
+        const uint32_t parity = parity_.load(std::memory_order_relaxed);
+        parity_.store(parity ^ 1, std::memory_order_seq_cst);
+        for (auto &slot : slots_) {
+            while (slot.readers[parity].load(std::memory_order_acquire) != 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+bool ReadBinaryFile(const std::string &path, std::vector<char> &data) {
+    std::ifstream read_file(path.c_str(), std::ios::in | std::ios::binary);
+    if (!read_file) return false;
+    data.assign(std::istreambuf_iterator<char>(read_file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+static uint64_t CurrentProcessId() {
+#ifdef _WIN32
+    return ::GetCurrentProcessId();
+#else
+    return static_cast<uint64_t>(getpid());
+#endif
+}
+
+bool WriteFileAtomically(const std::string &path, const void *data, size_t size) {
+    // The temporary file is unique to this process and call, so concurrent writers never share one
+    static std::atomic<uint64_t> write_count{0};
+    const std::string temp_path = path + "." + std::to_string(CurrentProcessId()) + "." + std::to_string(write_count++) + ".tmp";
+    {
+        std::ofstream write_file(temp_path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (write_file) {
+            write_file.write(static_cast<const char *>(data), size);
+        }
+        if (!write_file) {
+            write_file.close();
+            std::remove(temp_path.c_str());
+            return false;
+        }
+    }
+#ifdef _WIN32
+    const bool replaced = MoveFileExA(temp_path.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    const bool replaced = std::rename(temp_path.c_str(), path.c_str()) == 0;
+#endif
+    if (!replaced) {
+        std::remove(temp_path.c_str());
+    }
+    return replaced;
+}
+
+WorkerPool::WorkerPool(uint32_t thread_count)
+    : thread_count_(thread_count ? thread_count : std::max(std::thread::hardware_concurrency(), 1U)) {}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        exit_ = true;
+    }
+    work_cv_.notify_all();
+    for (auto &thread : threads_) {
+        thread.join();
+    }
+}
+
+void WorkerPool::RunJobs(const std::function<void(uint32_t)> &job, uint32_t count) {
+    for (uint32_t index = next_index_.fetch_add(1); index < count; index = next_index_.fetch_add(1)) {
+        job(index);
+    }
+}
+
+void WorkerPool::WorkerMain() {
+    uint64_t last_batch = 0;
+    std::unique_lock<std::mutex> guard(lock_);
+    while (true) {
+        work_cv_.wait(guard, [this, last_batch] { return exit_ || batch_ != last_batch; });
+        if (exit_) return;
+        last_batch = batch_;
+        // The batch may have been completed by the other threads before this one woke up
+        if (!job_) continue;
+        const auto *job = job_;
+        const uint32_t count = count_;
+        busy_workers_++;
+        guard.unlock();
+        RunJobs(*job, count);
+        guard.lock();
+        if (--busy_workers_ == 0) {
+            done_cv_.notify_one();
+        }
+    }
+}
+
+void WorkerPool::ParallelFor(uint32_t count, const std::function<void(uint32_t)> &job) {
+    std::unique_lock<std::mutex> submit_guard(submit_lock_, std::try_to_lock);
+    if (count < 2 || thread_count_ < 2 || !submit_guard.owns_lock()) {
+        for (uint32_t index = 0; index < count; ++index) {
+            job(index);
+        }
+        return;
+    }
+
+    std::unique_lock<std::mutex> guard(lock_);
+    if (threads_.empty()) {
+        threads_.reserve(thread_count_ - 1);
+        for (uint32_t i = 1; i < thread_count_; ++i) {
+            threads_.emplace_back(&WorkerPool::WorkerMain, this);
+        }
+    }
+    job_ = &job;
+    count_ = count;
+    next_index_.store(0);
+    batch_++;
+    guard.unlock();
+    work_cv_.notify_all();
+
+    RunJobs(job, count);
+
+    // All jobs have been claimed, but workers may still be running the last ones they claimed. Workers that have not woken up for
+    // this batch yet will see job_ cleared and go back to waiting.
+    guard.lock();
+    done_cv_.wait(guard, [this] { return busy_workers_ == 0; });
+    job_ = nullptr;
+}
+
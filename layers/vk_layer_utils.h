@@ -21,11 +21,17 @@
 
 #pragma once
 
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
 #include <cstddef>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <stdbool.h>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 #include <iomanip>
 #include "cast_utils.h"
@@ -175,6 +181,24 @@ static inline int MostSignificantBit(uint32_t mask) {
 #endif
 }
 
+// Returns the 0-based index of the LSB, like the x86 bit scan forward (bsf) instruction
+// Note: an input mask of 0 yields -1
+static inline int LeastSignificantBit(uint64_t mask) {
+#if defined __GNUC__
+    return mask ? __builtin_ctzll(mask) : -1;
+#elif defined _MSC_VER && defined _WIN64
+    unsigned long bit_pos;
+    return _BitScanForward64(&bit_pos, mask) ? int(bit_pos) : -1;
+#else
+    for (int k = 0; k < 64; ++k) {
+        if (((mask >> k) & 1) != 0) {
+            return k;
+        }
+    }
+    return -1;
+#endif
+}
+
 static inline uint32_t SampleCountSize(VkSampleCountFlagBits sample_count) {
     uint32_t size = 0;
     switch (sample_count) {
@@ -324,6 +348,12 @@ VK_LAYER_EXPORT void layer_debug_messenger_actions(debug_report_data *report_dat
 VK_LAYER_EXPORT VkStringErrorFlags vk_string_validate(const int max_length, const char *char_array);
 VK_LAYER_EXPORT bool white_list(const char *item, const std::set<std::string> &whitelist);
 
+// Helpers for the layer's on-disk caches
+bool ReadBinaryFile(const std::string &path, std::vector<char> &data);
+// Write data to a temporary file next to path, then rename it over path, so that concurrent readers of path (including other
+// processes) see either its old or its new contents, never a partially written file.
+bool WriteFileAtomically(const std::string &path, const void *data, size_t size);
+
 static inline int u_ffs(int val) {
 #ifdef WIN32
     unsigned long bit_pos = 0;
@@ -407,6 +437,23 @@ class LockedSharedPtr : public std::shared_ptr<T> {
     Guard guard_;
 };
 
+// Non-owning counterpart of LockedSharedPtr, for state objects whose lifetime is guaranteed by the caller
+template <typename T, typename Guard>
+class LockedBorrowedPtr {
+  public:
+    LockedBorrowedPtr(T *ptr, Guard &&guard) : ptr_(ptr), guard_(std::move(guard)) {}
+    LockedBorrowedPtr() : ptr_(nullptr), guard_() {}
+
+    T *get() const { return ptr_; }
+    T &operator*() const { return *ptr_; }
+    T *operator->() const { return ptr_; }
+    explicit operator bool() const { return ptr_ != nullptr; }
+
+  private:
+    T *ptr_;
+    Guard guard_;
+};
+
 // Limited concurrent_unordered_map that supports internally-synchronized
 // insert/erase/access. Splits locking across N buckets and uses shared_mutex
 // for read/write locking. Iterators are not supported. The following
@@ -504,6 +551,18 @@ class vl_concurrent_unordered_map {
         }
     }
 
+    // For maps of (smart) pointers, returns the stored pointer without copying the value (and touching its reference
+    // count). The caller must guarantee that the element is not erased while the result is in use, i.e. by only using it
+    // within an API call that is externally synchronized with the destruction of the object named by key.
+    template <typename U = T>
+    auto find_borrowed(const Key &key) const -> decltype(std::declval<const U &>().get()) {
+        uint32_t h = ConcurrentMapHashObject(key);
+        ReadLockGuard lock(locks[h].lock);
+
+        auto itr = maps[h].find(key);
+        return (itr != maps[h].end()) ? itr->second.get() : nullptr;
+    }
+
     FindResult pop(const Key &key) {
         uint32_t h = ConcurrentMapHashObject(key);
         WriteLockGuard lock(locks[h].lock);
@@ -576,4 +635,599 @@ class vl_concurrent_unordered_map {
         return hash;
     }
 };
+
+// Epoch based reclamation used by the read-mostly containers below, one domain per container. Readers enter a
+// critical section by bumping a counter on a cache line chosen per thread, so concurrent readers never write to a
+// shared cache line or take a lock. Writers unlink memory and hand it to Synchronize(), which returns once every
+// reader of the domain that could still observe the unlinked memory has left its critical section.
+class EpochDomain {
+  public:
+    EpochDomain();
+    EpochDomain(const EpochDomain &) = delete;
+    EpochDomain &operator=(const EpochDomain &) = delete;
+
+    class ReadGuard {
+      public:
+        explicit ReadGuard(EpochDomain &domain) : counter_(domain.EnterRead()) {}
+        ~ReadGuard() { counter_->fetch_sub(1, std::memory_order_release); }
+        ReadGuard(const ReadGuard &) = delete;
+        ReadGuard &operator=(const ReadGuard &) = delete;
+
+      private:
+        std::atomic<uint32_t> *counter_;
+    };
+
+    // Blocks until all read critical sections which began before the call have completed.
+    // Must not be called from inside a read critical section.
+    void Synchronize();
+
+  private:
+    static const uint32_t kSlotCount = 64;
+    struct Slot {
+        std::atomic<uint32_t> readers[2];
+        // Put each slot on its own cache line to avoid false cache line sharing between threads.
+        char padding[(-int(2 * sizeof(std::atomic<uint32_t>))) & 63];
+    };
+
+    std::atomic<uint32_t> *EnterRead() {
+        Slot &slot = slots_[ThreadSlotIndex()];
+        const uint32_t parity = parity_.load(std::memory_order_relaxed);
+        std::atomic<uint32_t> *counter = &slot.readers[parity];
+        counter->fetch_add(1, std::memory_order_relaxed);
+        // Pairs with the fence in Synchronize(): either the writer sees this reader, or this reader sees the unlink.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return counter;
+    }
+    static uint32_t ThreadSlotIndex();
+
+    std::atomic<uint32_t> parity_;
+    std::mutex synchronize_lock_;
+    Slot slots_[kSlotCount];
+};
+
+// Concurrent unordered map with the same interface as vl_concurrent_unordered_map, intended for maps that
+// are looked up far more often than they are modified (i.e. handle -> state object maps).
+//
+// Lookups (find, contains, size) take no locks and perform no atomic read-modify-write on shared cache lines.
+// Each bucket is an open addressed, linear probed table of immutable nodes. Writers serialize per bucket,
+// publish whole nodes with a single pointer store, and retire replaced nodes and tables through the map's
+// EpochDomain. The write which retires a value waits only for the readers of this map, and releases the value
+// before returning, so erased values don't outlive erase().
+template <typename Key, typename T, int BUCKETSLOG2 = 2, typename Hash = layer_data::hash<Key>>
+class vl_concurrent_read_mostly_map {
+  public:
+    using FindResult = typename vl_concurrent_unordered_map<Key, T, BUCKETSLOG2, Hash>::FindResult;
+
+    vl_concurrent_read_mostly_map() = default;
+    vl_concurrent_read_mostly_map(const vl_concurrent_read_mostly_map &) = delete;
+    vl_concurrent_read_mostly_map &operator=(const vl_concurrent_read_mostly_map &) = delete;
+    ~vl_concurrent_read_mostly_map() {
+        // No readers can be active once the map itself is being destroyed.
+        for (auto &bucket : buckets_) {
+            Retired reclaim;
+            bucket.Clear(reclaim);
+            Free(reclaim);
+        }
+    }
+
+    template <typename... Args>
+    void insert_or_assign(const Key &key, Args &&...args) {
+        Bucket &bucket = GetBucket(key);
+        Retired reclaim;
+        {
+            std::lock_guard<std::mutex> lock(bucket.write_lock);
+            bucket.Store(key, new Node(key, T{std::forward<Args>(args)...}), true);
+            bucket.TakeReclaimable(reclaim);
+        }
+        Reclaim(reclaim);
+    }
+
+    template <typename... Args>
+    bool insert(const Key &key, Args &&...args) {
+        Bucket &bucket = GetBucket(key);
+        Retired reclaim;
+        bool inserted;
+        {
+            std::lock_guard<std::mutex> lock(bucket.write_lock);
+            if (bucket.Locate(key) != nullptr) {
+                return false;
+            }
+            inserted = bucket.Store(key, new Node(key, std::forward<Args>(args)...), false);
+            bucket.TakeReclaimable(reclaim);
+        }
+        Reclaim(reclaim);
+        return inserted;
+    }
+
+    // returns size_type
+    size_t erase(const Key &key) {
+        Bucket &bucket = GetBucket(key);
+        Retired reclaim;
+        size_t erased;
+        {
+            std::lock_guard<std::mutex> lock(bucket.write_lock);
+            erased = bucket.Remove(key) ? 1 : 0;
+            bucket.TakeReclaimable(reclaim);
+        }
+        Reclaim(reclaim);
+        return erased;
+    }
+
+    bool contains(const Key &key) const {
+        EpochDomain::ReadGuard guard(epoch_);
+        return GetBucket(key).Find(key) != nullptr;
+    }
+
+    FindResult end() const { return FindResult(false, T()); }
+    FindResult cend() const { return end(); }
+
+    FindResult find(const Key &key) const {
+        EpochDomain::ReadGuard guard(epoch_);
+        const Node *node = GetBucket(key).Find(key);
+        if (node) {
+            return FindResult(true, node->value);
+        }
+        return end();
+    }
+
+    // See vl_concurrent_unordered_map::find_borrowed()
+    template <typename U = T>
+    auto find_borrowed(const Key &key) const -> decltype(std::declval<const U &>().get()) {
+        EpochDomain::ReadGuard guard(epoch_);
+        const Node *node = GetBucket(key).Find(key);
+        return node ? node->value.get() : nullptr;
+    }
+
+    FindResult pop(const Key &key) {
+        Bucket &bucket = GetBucket(key);
+        Retired reclaim;
+        T value;
+        {
+            std::lock_guard<std::mutex> lock(bucket.write_lock);
+            const Node *node = bucket.Locate(key);
+            if (!node) {
+                return end();
+            }
+            // Copy (rather than move) the value, as concurrent readers may still be copying from the retired node.
+            value = node->value;
+            bucket.Remove(key);
+            bucket.TakeReclaimable(reclaim);
+        }
+        Reclaim(reclaim);
+        return FindResult(true, std::move(value));
+    }
+
+    std::vector<std::pair<const Key, T>> snapshot(std::function<bool(T)> f = nullptr) const {
+        std::vector<std::pair<const Key, T>> entries;
+        {
+            EpochDomain::ReadGuard guard(epoch_);
+            for (const auto &bucket : buckets_) {
+                bucket.ForEach([&entries](const Node &node) { entries.emplace_back(node.key, node.value); });
+            }
+        }
+        if (!f) {
+            return entries;
+        }
+        // The predicate is evaluated outside of the read critical section, as it may modify this map.
+        std::vector<std::pair<const Key, T>> ret;
+        for (auto &entry : entries) {
+            if (f(entry.second)) {
+                ret.emplace_back(entry.first, std::move(entry.second));
+            }
+        }
+        return ret;
+    }
+
+    void clear() {
+        Retired reclaim;
+        for (auto &bucket : buckets_) {
+            std::lock_guard<std::mutex> lock(bucket.write_lock);
+            bucket.Clear(reclaim);
+        }
+        Reclaim(reclaim);
+    }
+
+    size_t size() const {
+        size_t result = 0;
+        for (const auto &bucket : buckets_) {
+            result += bucket.size.load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    bool empty() const { return size() == 0; }
+
+  private:
+    static const int BUCKETS = (1 << BUCKETSLOG2);
+    static const size_t kInitialCapacity = 16;
+
+    struct Node {
+        template <typename... Args>
+        Node(const Key &k, Args &&...args) : key(k), value(std::forward<Args>(args)...) {}
+        const Key key;
+        const T value;
+    };
+
+    struct Table {
+        explicit Table(size_t capacity) : mask(capacity - 1), slots(new std::atomic<Node *>[capacity]) {
+            for (size_t i = 0; i < capacity; ++i) {
+                slots[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+        size_t capacity() const { return mask + 1; }
+        const size_t mask;
+        std::unique_ptr<std::atomic<Node *>[]> slots;
+    };
+
+    struct Retired {
+        std::vector<Node *> nodes;
+        std::vector<Table *> tables;
+        bool empty() const { return nodes.empty() && tables.empty(); }
+    };
+
+    // Marks an erased slot, so that probe sequences passing through it continue.
+    static Node *Tombstone() { return reinterpret_cast<Node *>(uintptr_t(1)); }
+    static bool IsLive(const Node *node) { return node != nullptr && node != Tombstone(); }
+
+    // Spread the hash over the low bits used for probing, identity hashes of handles are often aligned.
+    static size_t Probe(const Key &key) {
+        const uint64_t h = static_cast<uint64_t>(Hash()(key)) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(h ^ (h >> 32));
+    }
+
+    struct Bucket {
+        // Lock free, requires an active EpochDomain::ReadGuard.
+        const Node *Find(const Key &key) const {
+            const Table *t = table.load(std::memory_order_acquire);
+            if (!t) return nullptr;
+            for (size_t i = Probe(key) & t->mask;; i = (i + 1) & t->mask) {
+                const Node *node = t->slots[i].load(std::memory_order_acquire);
+                if (node == nullptr) return nullptr;
+                if (node != Tombstone() && node->key == key) return node;
+            }
+        }
+
+        template <typename Fn>
+        void ForEach(Fn &&fn) const {
+            const Table *t = table.load(std::memory_order_acquire);
+            if (!t) return;
+            for (size_t i = 0; i < t->capacity(); ++i) {
+                const Node *node = t->slots[i].load(std::memory_order_acquire);
+                if (IsLive(node)) fn(*node);
+            }
+        }
+
+        // The remaining members require write_lock to be held.
+        const Node *Locate(const Key &key) const { return Find(key); }
+
+        // Returns true if a new key was added, false if an existing entry was replaced.
+        bool Store(const Key &key, Node *node, bool replace) {
+            Table *t = table.load(std::memory_order_relaxed);
+            if (!t || (used + 1) * 2 > t->capacity()) {
+                t = Rehash();
+            }
+            size_t insert_pos = t->capacity();
+            for (size_t i = Probe(key) & t->mask;; i = (i + 1) & t->mask) {
+                Node *current = t->slots[i].load(std::memory_order_relaxed);
+                if (current == nullptr) {
+                    if (insert_pos == t->capacity()) {
+                        insert_pos = i;
+                        ++used;
+                    }
+                    break;
+                }
+                if (current == Tombstone()) {
+                    if (insert_pos == t->capacity()) insert_pos = i;
+                } else if (current->key == key) {
+                    assert(replace);
+                    (void)replace;
+                    t->slots[i].store(node, std::memory_order_release);
+                    retired.nodes.push_back(current);
+                    return false;
+                }
+            }
+            t->slots[insert_pos].store(node, std::memory_order_release);
+            size.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        bool Remove(const Key &key) {
+            Table *t = table.load(std::memory_order_relaxed);
+            if (!t) return false;
+            for (size_t i = Probe(key) & t->mask;; i = (i + 1) & t->mask) {
+                Node *current = t->slots[i].load(std::memory_order_relaxed);
+                if (current == nullptr) return false;
+                if (current != Tombstone() && current->key == key) {
+                    t->slots[i].store(Tombstone(), std::memory_order_release);
+                    retired.nodes.push_back(current);
+                    size.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+        }
+
+        // Builds a new table sized for the live entries (dropping tombstones) and publishes it.
+        Table *Rehash() {
+            Table *old_table = table.load(std::memory_order_relaxed);
+            const size_t live = size.load(std::memory_order_relaxed);
+            size_t capacity = kInitialCapacity;
+            while (capacity < (live + 1) * 4) capacity *= 2;
+            Table *new_table = new Table(capacity);
+            if (old_table) {
+                for (size_t i = 0; i < old_table->capacity(); ++i) {
+                    Node *node = old_table->slots[i].load(std::memory_order_relaxed);
+                    if (!IsLive(node)) continue;
+                    size_t pos = Probe(node->key) & new_table->mask;
+                    while (new_table->slots[pos].load(std::memory_order_relaxed) != nullptr) pos = (pos + 1) & new_table->mask;
+                    new_table->slots[pos].store(node, std::memory_order_relaxed);
+                }
+                retired.tables.push_back(old_table);
+            }
+            used = live;
+            table.store(new_table, std::memory_order_release);
+            return new_table;
+        }
+
+        // Hands back the retired memory, for release outside of write_lock.
+        void TakeReclaimable(Retired &reclaim) { std::swap(reclaim, retired); }
+
+        void Clear(Retired &reclaim) {
+            Table *t = table.exchange(nullptr, std::memory_order_acq_rel);
+            if (t) {
+                for (size_t i = 0; i < t->capacity(); ++i) {
+                    Node *node = t->slots[i].load(std::memory_order_relaxed);
+                    if (IsLive(node)) reclaim.nodes.push_back(node);
+                }
+                reclaim.tables.push_back(t);
+            }
+            reclaim.nodes.insert(reclaim.nodes.end(), retired.nodes.begin(), retired.nodes.end());
+            reclaim.tables.insert(reclaim.tables.end(), retired.tables.begin(), retired.tables.end());
+            retired = Retired();
+            size.store(0, std::memory_order_relaxed);
+            used = 0;
+        }
+
+        std::atomic<Table *> table{nullptr};
+        std::atomic<size_t> size{0};
+        size_t used = 0;  // live entries + tombstones
+        Retired retired;
+        std::mutex write_lock;
+        // Keep buckets on separate cache lines, writers touch their own bucket only.
+        char padding[64];
+    };
+
+    static void Free(Retired &reclaim) {
+        for (auto *node : reclaim.nodes) {
+            delete node;
+        }
+        for (auto *table : reclaim.tables) {
+            delete table;
+        }
+    }
+
+    void Reclaim(Retired &reclaim) {
+        if (reclaim.empty()) return;
+        epoch_.Synchronize();
+        Free(reclaim);
+    }
+
+    Bucket &GetBucket(const Key &key) { return buckets_[ConcurrentMapHashObject(key)]; }
+    const Bucket &GetBucket(const Key &key) const { return buckets_[ConcurrentMapHashObject(key)]; }
+
+    uint32_t ConcurrentMapHashObject(const Key &object) const {
+        uint64_t u64 = (uint64_t)(uintptr_t)object;
+        uint32_t hash = (uint32_t)(u64 >> 32) + (uint32_t)u64;
+        hash ^= (hash >> BUCKETSLOG2) ^ (hash >> (2 * BUCKETSLOG2));
+        hash &= (BUCKETS - 1);
+        return hash;
+    }
+
+    Bucket buckets_[BUCKETS];
+    mutable EpochDomain epoch_;
+};
+
+// Concurrent map from layer generated ids to 64-bit values, used for handle wrapping. Unlike the maps above,
+// the key is chosen by the container: insert() returns a new id which encodes a slab slot index and the slot's
+// generation, so that find() is a single array read without locks or hashing. Ids of erased entries (and ids never
+// handed out by this map) are rejected by comparing the full id against the one stored in the slot.
+//
+// Id layout: bits [0, 32) slot index + 1, bits [32, 56) slot generation, bits [56, 64) a constant tag, which keeps
+// wrapped ids from overlapping the small integer or pointer values typically used as driver handles.
+//
+// Once max_slots slots are live, further entries are stored in a hashed overflow map instead, under ids with a
+// different tag and a counter in bits [0, 56).
+class vl_concurrent_slab_map {
+  public:
+    using FindResult = vl_concurrent_unordered_map<uint64_t, uint64_t>::FindResult;
+
+    explicit vl_concurrent_slab_map(uint32_t max_slots = kMaxChunks * kChunkSize)
+        : size_(0),
+          max_slots_(max_slots < kMaxChunks * kChunkSize ? max_slots : kMaxChunks * kChunkSize),
+          slot_count_(0),
+          overflow_count_(0) {
+        for (auto &chunk : chunks_) {
+            chunk.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+    vl_concurrent_slab_map(const vl_concurrent_slab_map &) = delete;
+    vl_concurrent_slab_map &operator=(const vl_concurrent_slab_map &) = delete;
+    ~vl_concurrent_slab_map() {
+        for (auto &chunk : chunks_) {
+            delete[] chunk.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Stores value in a free slot, or the overflow map, and returns the new id naming it
+    uint64_t insert(uint64_t value) {
+        uint32_t index = 0;
+        uint32_t generation = 0;
+        Slot *slot = nullptr;
+        uint64_t overflow_id = 0;
+        {
+            std::lock_guard<std::mutex> lock(alloc_lock_);
+            if (!free_slots_.empty()) {
+                index = free_slots_.back();
+                free_slots_.pop_back();
+                slot = GetSlot(index);
+            } else if (slot_count_ >= max_slots_) {
+                overflow_id = kOverflowTag | (++overflow_count_ & ~kTagMask);
+            } else {
+                index = slot_count_++;
+                const uint32_t chunk_index = index / kChunkSize;
+                if (chunks_[chunk_index].load(std::memory_order_relaxed) == nullptr) {
+                    chunks_[chunk_index].store(new Slot[kChunkSize], std::memory_order_release);
+                }
+                slot = GetSlot(index);
+            }
+            if (slot) {
+                generation = slot->generation = (slot->generation + 1) & kGenerationMask;
+                if (generation == 0) {
+                    generation = slot->generation = 1;
+                }
+            }
+        }
+        if (!slot) {
+            overflow_.insert(overflow_id, value);
+            size_.fetch_add(1, std::memory_order_relaxed);
+            return overflow_id;
+        }
+        const uint64_t id = MakeId(index, generation);
+        // The release orders this store after the slot's previous id was cleared, see the re-check in find().
+        slot->value.store(value, std::memory_order_release);
+        // Publishing the id last, any reader matching it also sees the value.
+        slot->id.store(id, std::memory_order_release);
+        size_.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    bool contains(uint64_t id) const { return find(id) != end(); }
+
+    FindResult end() const { return FindResult(false, 0); }
+    FindResult cend() const { return end(); }
+
+    FindResult find(uint64_t id) const {
+        if ((id & kTagMask) == kOverflowTag) {
+            return overflow_.find(id);
+        }
+        const Slot *slot = LookupSlot(id);
+        if (slot && slot->id.load(std::memory_order_acquire) == id) {
+            const uint64_t value = slot->value.load(std::memory_order_acquire);
+            // Re-check, in case the slot was recycled between reading the id and the value.
+            if (slot->id.load(std::memory_order_relaxed) == id) {
+                return FindResult(true, value);
+            }
+        }
+        return end();
+    }
+
+    FindResult pop(uint64_t id) {
+        if ((id & kTagMask) == kOverflowTag) {
+            auto result = overflow_.pop(id);
+            if (result != end()) {
+                size_.fetch_sub(1, std::memory_order_relaxed);
+            }
+            return result;
+        }
+        Slot *slot = LookupSlot(id);
+        if (!slot) {
+            return end();
+        }
+        uint64_t expected = id;
+        // Only one of any concurrent (invalid) pops of the same id may recycle the slot.
+        if (!slot->id.compare_exchange_strong(expected, 0, std::memory_order_acq_rel)) {
+            return end();
+        }
+        const uint64_t value = slot->value.load(std::memory_order_relaxed);
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(alloc_lock_);
+        free_slots_.push_back(SlotIndex(id));
+        return FindResult(true, value);
+    }
+
+    // returns size_type
+    size_t erase(uint64_t id) { return (pop(id) != end()) ? 1 : 0; }
+
+    size_t size() const { return size_.load(std::memory_order_relaxed); }
+    bool empty() const { return size() == 0; }
+
+  private:
+    static const uint32_t kChunkSize = 4096;
+    static const uint32_t kMaxChunks = 1 << 16;
+    static const uint32_t kGenerationMask = (1 << 24) - 1;
+    static const uint64_t kTagMask = 0xFFULL << 56;
+    static const uint64_t kIdTag = 0xA5ULL << 56;
+    static const uint64_t kOverflowTag = 0xA4ULL << 56;
+
+    struct Slot {
+        Slot() : id(0), value(0), generation(0) {}
+        std::atomic<uint64_t> id;
+        std::atomic<uint64_t> value;
+        uint32_t generation;  // guarded by alloc_lock_
+    };
+
+    static uint64_t MakeId(uint32_t index, uint32_t generation) {
+        return kIdTag | (static_cast<uint64_t>(generation) << 32) | (static_cast<uint64_t>(index) + 1);
+    }
+    static uint32_t SlotIndex(uint64_t id) { return static_cast<uint32_t>(id) - 1; }
+
+    Slot *GetSlot(uint32_t index) const {
+        return &chunks_[index / kChunkSize].load(std::memory_order_acquire)[index % kChunkSize];
+    }
+
+    Slot *LookupSlot(uint64_t id) const {
+        if ((id & kTagMask) != kIdTag || static_cast<uint32_t>(id) == 0) {
+            return nullptr;
+        }
+        const uint32_t index = SlotIndex(id);
+        if (index / kChunkSize >= kMaxChunks) {
+            return nullptr;
+        }
+        Slot *chunk = chunks_[index / kChunkSize].load(std::memory_order_acquire);
+        return chunk ? &chunk[index % kChunkSize] : nullptr;
+    }
+
+    std::atomic<size_t> size_;
+    std::mutex alloc_lock_;
+    const uint32_t max_slots_;
+    uint32_t slot_count_;
+    uint64_t overflow_count_;  // guarded by alloc_lock_
+    std::vector<uint32_t> free_slots_;
+    mutable std::atomic<Slot *> chunks_[kMaxChunks];
+    vl_concurrent_unordered_map<uint64_t, uint64_t> overflow_;
+};
+
+// A fixed set of worker threads for running independent validation jobs in parallel. The threads are started on first use and
+// joined when the pool is destroyed.
+class WorkerPool {
+  public:
+    // thread_count is the number of threads, including the calling thread, that run the jobs of a ParallelFor(). Zero uses the
+    // number of hardware threads.
+    explicit WorkerPool(uint32_t thread_count);
+    ~WorkerPool();
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    uint32_t ThreadCount() const { return thread_count_; }
+
+    // Calls job(0) .. job(count - 1) from the pool's threads and the calling thread, and returns once all calls have completed.
+    // Jobs may run in any order. If the pool is already running another caller's jobs, all jobs run on the calling thread.
+    void ParallelFor(uint32_t count, const std::function<void(uint32_t)> &job);
+
+  private:
+    void WorkerMain();
+    void RunJobs(const std::function<void(uint32_t)> &job, uint32_t count);
+
+    const uint32_t thread_count_;
+    std::vector<std::thread> threads_;
+    std::mutex submit_lock_;  // Held for the duration of a ParallelFor() using the worker threads
+    std::mutex lock_;         // Guards the batch state below
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    const std::function<void(uint32_t)> *job_ = nullptr;
+    uint32_t count_ = 0;
+    uint64_t batch_ = 0;
+    uint32_t busy_workers_ = 0;
+    bool exit_ = false;
+    std::atomic<uint32_t> next_index_{0};
+};
 #endif
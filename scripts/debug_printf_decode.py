@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+# Copyright (c) 2022 The Khronos Group Inc.
+# Copyright (c) 2022 Valve Corporation
+# Copyright (c) 2022 LunarG, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Format the records written by Debug Printf when khronos_validation.printf_binary_file is set.
+# The file layout is described with DPFBinaryFileHeader in layers/debug_printf.h.
+
+import argparse
+import re
+import struct
+import sys
+from collections import OrderedDict
+
+RING_MAGIC = b'VKDPFRNG'
+FORMATS_MAGIC = b'VKDPFFMT'
+VERSION = 1
+
+# DPFBinaryFileHeader: magic, version, header_size, capacity, begin_offset, end_offset, dropped_records
+RING_HEADER = struct.Struct('=8sIIQQQQ')
+# DPFBinaryRecord: size, count, shader_id, format_string_id, stage, stage_word_1, stage_word_2, stage_word_3
+RECORD_HEADER = struct.Struct('=8I')
+
+VARSIGNED, VARUNSIGNED, VARFLOAT = 0, 1, 2
+
+# spv::ExecutionModel values
+STAGES = {
+    0: 'Vertex', 1: 'TessellationControl', 2: 'TessellationEvaluation', 3: 'Geometry', 4: 'Fragment', 5: 'Compute',
+    5267: 'Task', 5268: 'Mesh', 5313: 'RayGeneration', 5314: 'Intersection', 5315: 'AnyHit', 5316: 'ClosestHit',
+    5317: 'Miss', 5318: 'Callable',
+}
+
+# C conversion specification, with the length modifiers Python does not accept
+CONVERSION = re.compile(r'%([-+ #0]*[0-9]*(?:\.[0-9]*)?)(?:hh|h|ll|l|L|I64|j|z|t)?([diouxXeEfFgGaA])')
+
+
+class Substring:
+    def __init__(self, flags, vartype, string):
+        self.needs_value = bool(flags & 1)
+        self.is_64bit = bool(flags & 2)
+        self.vartype = vartype
+        self.string = string
+
+
+def ReadFormats(path):
+    formats = {}
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[0:8] != FORMATS_MAGIC:
+        sys.exit('%s is not a Debug Printf formats file' % path)
+    offset = 12
+    while offset + 12 <= len(data):
+        shader_id, format_string_id, substring_count = struct.unpack_from('=3I', data, offset)
+        offset += 12
+        substrings = []
+        for _ in range(substring_count):
+            flags, vartype, length = struct.unpack_from('=3I', data, offset)
+            offset += 12
+            string = data[offset:offset + length].decode('utf-8', errors='replace')
+            offset += (length + 3) & ~3
+            substrings.append(Substring(flags, vartype, string))
+        formats[(shader_id, format_string_id)] = substrings
+    return formats
+
+
+def ReadRecords(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+    magic, version, header_size, capacity, begin, end, dropped = RING_HEADER.unpack_from(data, 0)
+    if magic != RING_MAGIC:
+        sys.exit('%s is not a Debug Printf binary output file' % path)
+    if version != VERSION:
+        sys.exit('%s has version %d, expected %d' % (path, version, VERSION))
+    if dropped:
+        print('%d records were larger than the ring and dropped' % dropped, file=sys.stderr)
+    if begin > 0:
+        print('The ring wrapped, records older than offset %d were overwritten' % begin, file=sys.stderr)
+    ring = memoryview(data)[header_size:header_size + capacity]
+
+    records = []
+    offset = begin
+    while offset < end:
+        position = offset % capacity
+        remaining = capacity - position
+        if remaining < 8:
+            offset += remaining
+            continue
+        size, count = struct.unpack_from('=2I', ring, position)
+        if size == 0:
+            sys.exit('Corrupt record at offset %d' % offset)
+        if count != 0:
+            header = RECORD_HEADER.unpack_from(ring, position)
+            value_count = (size - RECORD_HEADER.size) // 4
+            values = struct.unpack_from('=%dI' % value_count, ring, position + RECORD_HEADER.size)
+            records.append((header, values))
+        offset += size
+    return records
+
+
+def FormatValue(substring, values, index):
+    if substring.is_64bit:
+        value = values[index] | (values[index + 1] << 32)
+        return value, index + 2
+    word = values[index]
+    if substring.vartype == VARSIGNED:
+        value = struct.unpack('=i', struct.pack('=I', word))[0]
+    elif substring.vartype == VARFLOAT:
+        value = struct.unpack('=f', struct.pack('=I', word))[0]
+    else:
+        value = word
+    return value, index + 1
+
+
+def FormatMessage(substrings, values):
+    message = ''
+    index = 0
+    for substring in substrings:
+        if not substring.needs_value:
+            message += substring.string % ()
+            continue
+        if index >= len(values):
+            message += '<missing value>'
+            continue
+        value, index = FormatValue(substring, values, index)
+        match = CONVERSION.search(substring.string)
+        if not match:
+            message += substring.string
+            continue
+        flags, conversion = match.group(1), match.group(2)
+        if conversion in 'aA':
+            formatted = float(value).hex()
+            formatted = formatted.upper() if conversion == 'A' else formatted
+        else:
+            formatted = ('%' + flags + conversion) % value
+        prefix = substring.string[:match.start()] % ()
+        message += prefix + formatted + substring.string[match.end():]
+    return message
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description='Format the binary output of Debug Printf.')
+    parser.add_argument('file', help='file set with khronos_validation.printf_binary_file')
+    parser.add_argument('--formats', help='formats file, <file>.formats by default')
+    parser.add_argument('--aggregate', action='store_true',
+                        help='collapse records with the same shader, format string and values across the whole file')
+    parser.add_argument('--verbose', action='store_true', help='include the shader id and stage of each message')
+    args = parser.parse_args(argv)
+
+    formats = ReadFormats(args.formats if args.formats else args.file + '.formats')
+    records = ReadRecords(args.file)
+
+    # (shader id, format string id, values) -> [first record header, count]
+    messages = OrderedDict()
+    for index, (header, values) in enumerate(records):
+        key = (header[2], header[3], values) if args.aggregate else index
+        if key in messages:
+            messages[key][1] += header[1]
+        else:
+            messages[key] = [header, header[1], values]
+
+    for header, count, values in messages.values():
+        _, _, shader_id, format_string_id, stage, word_1, word_2, word_3 = header
+        substrings = formats.get((shader_id, format_string_id))
+        if substrings is None:
+            message = 'Unknown format string %d, values %s' % (format_string_id, list(values))
+        else:
+            message = FormatMessage(substrings, values)
+        if count > 1:
+            message = '[%d identical messages] %s' % (count, message)
+        if args.verbose:
+            stage_name = STAGES.get(stage, str(stage))
+            message = 'Shader %d, Stage = %s (%d, %d, %d): %s' % (shader_id, stage_name, word_1, word_2, word_3, message)
+        print(message, end='' if message.endswith('\n') else '\n')
+
+
+if __name__ == '__main__':
+    main(sys.argv[1:])
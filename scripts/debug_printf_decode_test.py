@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+# Copyright (c) 2022 The Khronos Group Inc.
+# Copyright (c) 2022 Valve Corporation
+# Copyright (c) 2022 LunarG, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Write Debug Printf binary output the way DPFBinarySink in layers/debug_printf.cpp does, and check that
+# debug_printf_decode.py formats it back.
+
+import contextlib
+import io
+import os
+import struct
+import sys
+import tempfile
+import unittest
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import debug_printf_decode as decode
+
+FLAG_NEEDS_VALUE, FLAG_64BIT = 1, 2
+
+
+class BinarySink:
+    """Mirrors DPFBinarySink::Write: records never straddle the end of the ring, and the oldest are dropped to make room."""
+
+    def __init__(self, path, capacity):
+        self.path = path
+        self.capacity = capacity & ~3
+        self.ring = bytearray(self.capacity)
+        self.begin = 0
+        self.end = 0
+        self.dropped = 0
+        self.formats = bytearray(decode.FORMATS_MAGIC + struct.pack('=I', decode.VERSION))
+        self.written_formats = set()
+
+    def RecordSizeAt(self, offset):
+        position = offset % self.capacity
+        remaining = self.capacity - position
+        if remaining < 8:
+            return remaining
+        return struct.unpack_from('=I', self.ring, position)[0]
+
+    def Reserve(self, size):
+        while self.end + size - self.begin > self.capacity:
+            self.begin += self.RecordSizeAt(self.begin)
+
+    def AddFormat(self, shader_id, format_string_id, substrings):
+        if (shader_id, format_string_id) in self.written_formats:
+            return
+        self.written_formats.add((shader_id, format_string_id))
+        self.formats += struct.pack('=3I', shader_id, format_string_id, len(substrings))
+        for flags, vartype, string in substrings:
+            data = string.encode('utf-8')
+            self.formats += struct.pack('=3I', flags, vartype, len(data)) + data + b'\0' * (-len(data) % 4)
+
+    def Write(self, shader_id, format_string_id, values, count=1, stage=(5, 0, 0, 0)):
+        size = decode.RECORD_HEADER.size + 4 * len(values)
+        if size > self.capacity:
+            self.dropped += 1
+            return
+        remaining = self.capacity - self.end % self.capacity
+        if remaining < size:
+            self.Reserve(remaining)
+            if remaining >= 8:
+                struct.pack_into('=2I', self.ring, self.end % self.capacity, remaining, 0)
+            self.end += remaining
+        self.Reserve(size)
+        position = self.end % self.capacity
+        decode.RECORD_HEADER.pack_into(self.ring, position, size, count, shader_id, format_string_id, *stage)
+        struct.pack_into('=%dI' % len(values), self.ring, position + decode.RECORD_HEADER.size, *values)
+        self.end += size
+
+    def Save(self):
+        header = decode.RING_HEADER.pack(decode.RING_MAGIC, decode.VERSION, decode.RING_HEADER.size, self.capacity, self.begin,
+                                         self.end, self.dropped)
+        with open(self.path, 'wb') as f:
+            f.write(header + self.ring)
+        with open(self.path + '.formats', 'wb') as f:
+            f.write(self.formats)
+
+
+class DebugPrintfDecodeTest(unittest.TestCase):
+    def setUp(self):
+        self.directory = tempfile.TemporaryDirectory()
+        self.path = os.path.join(self.directory.name, 'printf.bin')
+
+    def tearDown(self):
+        self.directory.cleanup()
+
+    def Decode(self, *args):
+        output = io.StringIO()
+        with contextlib.redirect_stdout(output), contextlib.redirect_stderr(io.StringIO()):
+            decode.main([self.path] + list(args))
+        return output.getvalue().splitlines()
+
+    def testValueTypes(self):
+        sink = BinarySink(self.path, 4096)
+        sink.AddFormat(1, 7, [(FLAG_NEEDS_VALUE, decode.VARSIGNED, 'Signed %d'),
+                              (FLAG_NEEDS_VALUE, decode.VARUNSIGNED, ', unsigned %u'),
+                              (FLAG_NEEDS_VALUE, decode.VARFLOAT, ', float %.2f'),
+                              (FLAG_NEEDS_VALUE | FLAG_64BIT, decode.VARUNSIGNED, ', long %lx'),
+                              (0, 0, ' 100%%')])
+        value_64 = 0x123456789a
+        sink.Write(1, 7, [struct.unpack('=I', struct.pack('=i', -5))[0], 42, struct.unpack('=I', struct.pack('=f', 1.5))[0],
+                          value_64 & 0xffffffff, value_64 >> 32])
+        sink.Save()
+        self.assertEqual(self.Decode(), ['Signed -5, unsigned 42, float 1.50, long 123456789a 100%'])
+        self.assertEqual(self.Decode('--verbose'), ['Shader 1, Stage = Compute (0, 0, 0): '
+                                                    'Signed -5, unsigned 42, float 1.50, long 123456789a 100%'])
+
+    def testWrappedRing(self):
+        # 36 byte records leave 16 bytes of padding at the end of each lap of a 1024 byte ring, 44 byte ones leave 4
+        for value_count, record_count in ((1, 64), (3, 100)):
+            with self.subTest(value_count=value_count):
+                sink = BinarySink(self.path, 1024)
+                sink.AddFormat(2, 3, [(FLAG_NEEDS_VALUE, decode.VARUNSIGNED, 'Record %u')] +
+                               [(FLAG_NEEDS_VALUE, decode.VARUNSIGNED, ' %u')] * (value_count - 1))
+                for i in range(record_count):
+                    sink.Write(2, 3, [i] * value_count)
+                sink.Save()
+                self.assertGreater(sink.begin, 0)
+
+                # The newest records are all there, oldest first
+                record_size = decode.RECORD_HEADER.size + 4 * value_count
+                expected_count = 1024 // record_size - (1 if sink.end % 1024 else 0)
+                messages = self.Decode()
+                self.assertGreaterEqual(len(messages), expected_count)
+                first = record_count - len(messages)
+                self.assertEqual(messages, [' '.join(['Record %d' % i] + ['%d' % i] * (value_count - 1))
+                                            for i in range(first, record_count)])
+
+    def testAggregate(self):
+        sink = BinarySink(self.path, 4096)
+        sink.AddFormat(1, 1, [(FLAG_NEEDS_VALUE, decode.VARUNSIGNED, 'Group %u')])
+        sink.Write(1, 1, [0], count=32)
+        sink.Write(1, 1, [1])
+        sink.Write(1, 1, [0], count=8)
+        sink.Save()
+        self.assertEqual(self.Decode(), ['[32 identical messages] Group 0', 'Group 1', '[8 identical messages] Group 0'])
+        self.assertEqual(self.Decode('--aggregate'), ['[40 identical messages] Group 0', 'Group 1'])
+
+    def testUnknownFormat(self):
+        sink = BinarySink(self.path, 4096)
+        sink.Write(4, 9, [1, 2])
+        sink.Save()
+        self.assertEqual(self.Decode(), ['Unknown format string 9, values [1, 2]'])
+
+
+if __name__ == '__main__':
+    unittest.main()
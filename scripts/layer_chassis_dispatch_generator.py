@@ -166,78 +166,151 @@ void CopyCreatePipelineFeedbackData(const void *src_chain, const void *dst_chain
     }
 }
 
-VkResult DispatchCreateGraphicsPipelines(VkDevice device, VkPipelineCache pipelineCache, uint32_t createInfoCount,
-                                         const VkGraphicsPipelineCreateInfo *pCreateInfos,
-                                         const VkAllocationCallbacks *pAllocator, VkPipeline *pPipelines) {
-    auto layer_data = GetLayerDataPtr(get_dispatch_key(device), layer_data_map);
-    if (!wrap_handles) return layer_data->device_dispatch_table.CreateGraphicsPipelines(device, pipelineCache, createInfoCount,
-                                                                                           pCreateInfos, pAllocator, pPipelines);
-    safe_VkGraphicsPipelineCreateInfo *local_pCreateInfos = nullptr;
-    if (pCreateInfos) {
-        local_pCreateInfos = new safe_VkGraphicsPipelineCreateInfo[createInfoCount];
-        ReadLockGuard lock(dispatch_lock);
-        for (uint32_t idx0 = 0; idx0 < createInfoCount; ++idx0) {
-            bool uses_color_attachment = false;
-            bool uses_depthstencil_attachment = false;
-            {
-                const auto subpasses_uses_it = layer_data->renderpasses_states.find(layer_data->Unwrap(pCreateInfos[idx0].renderPass));
-                if (subpasses_uses_it != layer_data->renderpasses_states.end()) {
-                    const auto &subpasses_uses = subpasses_uses_it->second;
-                    if (subpasses_uses.subpasses_using_color_attachment.count(pCreateInfos[idx0].subpass))
-                        uses_color_attachment = true;
-                    if (subpasses_uses.subpasses_using_depthstencil_attachment.count(pCreateInfos[idx0].subpass))
-                        uses_depthstencil_attachment = true;
-                }
-            }
+// Returns pNext unchanged unless the chain contains handles, in which case a deep copy with the handles unwrapped is returned
+// and appended to pnext_copies, to be released with FreePnextChain after the down-chain call.
+static const void *UnwrapPnextChainCopy(ValidationObject *layer_data, const void *pNext, std::vector<void *> &pnext_copies) {
+    if (!PnextChainHasHandles(pNext)) return pNext;
+    void *pnext_copy = SafePnextCopy(pNext);
+    WrapPnextChainHandles(layer_data, pnext_copy);
+    pnext_copies.push_back(pnext_copy);
+    return pnext_copy;
+}
 
-            auto dynamic_rendering = LvlFindInChain<VkPipelineRenderingCreateInfo>(pCreateInfos[idx0].pNext);
-            if (dynamic_rendering) {
-                uses_color_attachment        = (dynamic_rendering->colorAttachmentCount > 0);
-                uses_depthstencil_attachment = (dynamic_rendering->depthAttachmentFormat != VK_FORMAT_UNDEFINED ||
-                                                dynamic_rendering->stencilAttachmentFormat != VK_FORMAT_UNDEFINED);
+// Copies graphics pipeline create infos into the scratch arena with their handles unwrapped. Only the create infos, shader
+// stages and viewport state are copied, the other state is shared with the caller. State that
+// safe_VkGraphicsPipelineCreateInfo would drop as ignored is cleared here too, so the driver sees the same create info.
+static const VkGraphicsPipelineCreateInfo *UnwrapGraphicsPipelineCreateInfos(ValidationObject *layer_data,
+                                                                             uint32_t createInfoCount,
+                                                                             const VkGraphicsPipelineCreateInfo *pCreateInfos,
+                                                                             layer_data::ScratchArena &arena,
+                                                                             std::vector<void *> &pnext_copies) {
+    if (!pCreateInfos) return nullptr;
+    VkGraphicsPipelineCreateInfo *local_pCreateInfos = arena.Copy(pCreateInfos, createInfoCount);
+    ReadLockGuard lock(dispatch_lock);
+    for (uint32_t idx0 = 0; idx0 < createInfoCount; ++idx0) {
+        VkGraphicsPipelineCreateInfo &create_info = local_pCreateInfos[idx0];
+        bool uses_color_attachment = false;
+        bool uses_depthstencil_attachment = false;
+        {
+            const auto subpasses_uses_it = layer_data->renderpasses_states.find(layer_data->Unwrap(create_info.renderPass));
+            if (subpasses_uses_it != layer_data->renderpasses_states.end()) {
+                const auto &subpasses_uses = subpasses_uses_it->second;
+                if (subpasses_uses.subpasses_using_color_attachment.count(create_info.subpass))
+                    uses_color_attachment = true;
+                if (subpasses_uses.subpasses_using_depthstencil_attachment.count(create_info.subpass))
+                    uses_depthstencil_attachment = true;
             }
+        }
 
-            local_pCreateInfos[idx0].initialize(&pCreateInfos[idx0], uses_color_attachment, uses_depthstencil_attachment);
-
-            if (pCreateInfos[idx0].basePipelineHandle) {
-                local_pCreateInfos[idx0].basePipelineHandle = layer_data->Unwrap(pCreateInfos[idx0].basePipelineHandle);
-            }
-            if (pCreateInfos[idx0].layout) {
-                local_pCreateInfos[idx0].layout = layer_data->Unwrap(pCreateInfos[idx0].layout);
-            }
-            if (pCreateInfos[idx0].pStages) {
-                for (uint32_t idx1 = 0; idx1 < pCreateInfos[idx0].stageCount; ++idx1) {
-                    if (pCreateInfos[idx0].pStages[idx1].module) {
-                        local_pCreateInfos[idx0].pStages[idx1].module = layer_data->Unwrap(pCreateInfos[idx0].pStages[idx1].module);
-                    }
+        auto dynamic_rendering = LvlFindInChain<VkPipelineRenderingCreateInfo>(create_info.pNext);
+        if (dynamic_rendering) {
+            uses_color_attachment        = (dynamic_rendering->colorAttachmentCount > 0);
+            uses_depthstencil_attachment = (dynamic_rendering->depthAttachmentFormat != VK_FORMAT_UNDEFINED ||
+                                            dynamic_rendering->stencilAttachmentFormat != VK_FORMAT_UNDEFINED);
+        }
+        const bool is_graphics_library = LvlFindInChain<VkGraphicsPipelineLibraryCreateInfoEXT>(create_info.pNext) != nullptr;
+
+        bool has_tessellation_stage = false;
+        if (create_info.stageCount && create_info.pStages) {
+            auto stages = arena.Copy(create_info.pStages, create_info.stageCount);
+            for (uint32_t idx1 = 0; idx1 < create_info.stageCount; ++idx1) {
+                if (stages[idx1].stage == VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT ||
+                    stages[idx1].stage == VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT) {
+                    has_tessellation_stage = true;
                 }
+                if (stages[idx1].module) {
+                    stages[idx1].module = layer_data->Unwrap(stages[idx1].module);
+                }
+                stages[idx1].pNext = UnwrapPnextChainCopy(layer_data, stages[idx1].pNext, pnext_copies);
             }
-            if (pCreateInfos[idx0].renderPass) {
-                local_pCreateInfos[idx0].renderPass = layer_data->Unwrap(pCreateInfos[idx0].renderPass);
-            }
+            create_info.pStages = stages;
+        } else {
+            create_info.pStages = nullptr;
+        }
 
-            auto* link_info = LvlFindInChain<VkPipelineLibraryCreateInfoKHR>(local_pCreateInfos[idx0].pNext);
-            if (link_info) {
-                auto* unwrapped_libs = const_cast<VkPipeline*>(link_info->pLibraries);
-                for (uint32_t idx1 = 0; idx1 < link_info->libraryCount; ++idx1) {
-                    unwrapped_libs[idx1] = layer_data->Unwrap(link_info->pLibraries[idx1]);
+        bool is_dynamic_has_rasterization = false;
+        bool is_dynamic_viewports = false;
+        bool is_dynamic_scissors = false;
+        if (create_info.pDynamicState && create_info.pDynamicState->pDynamicStates) {
+            for (uint32_t idx1 = 0; idx1 < create_info.pDynamicState->dynamicStateCount; ++idx1) {
+                switch (create_info.pDynamicState->pDynamicStates[idx1]) {
+                    case VK_DYNAMIC_STATE_RASTERIZER_DISCARD_ENABLE_EXT:
+                        is_dynamic_has_rasterization = true;
+                        break;
+                    case VK_DYNAMIC_STATE_VIEWPORT:
+                        is_dynamic_viewports = true;
+                        break;
+                    case VK_DYNAMIC_STATE_SCISSOR:
+                        is_dynamic_scissors = true;
+                        break;
+                    default:
+                        break;
                 }
             }
         }
+        const bool has_rasterization =
+            create_info.pRasterizationState &&
+            (is_dynamic_has_rasterization || !create_info.pRasterizationState->rasterizerDiscardEnable);
+        if (!has_tessellation_stage) {
+            create_info.pTessellationState = nullptr;
+        }
+        if (!has_rasterization && !is_graphics_library) {
+            create_info.pViewportState = nullptr;
+            create_info.pMultisampleState = nullptr;
+        } else if (create_info.pViewportState && (is_dynamic_viewports || is_dynamic_scissors)) {
+            auto viewport_state = arena.Copy(create_info.pViewportState, 1);
+            if (is_dynamic_viewports) viewport_state->pViewports = nullptr;
+            if (is_dynamic_scissors) viewport_state->pScissors = nullptr;
+            create_info.pViewportState = viewport_state;
+        }
+        if (!(has_rasterization && uses_depthstencil_attachment) && !is_graphics_library) {
+            create_info.pDepthStencilState = nullptr;
+        }
+        if (!(has_rasterization && uses_color_attachment) && !is_graphics_library) {
+            create_info.pColorBlendState = nullptr;
+        }
+
+        if (create_info.basePipelineHandle) {
+            create_info.basePipelineHandle = layer_data->Unwrap(create_info.basePipelineHandle);
+        }
+        if (create_info.layout) {
+            create_info.layout = layer_data->Unwrap(create_info.layout);
+        }
+        if (create_info.renderPass) {
+            create_info.renderPass = layer_data->Unwrap(create_info.renderPass);
+        }
+        // Unwraps the libraries of a VkPipelineLibraryCreateInfoKHR, among others
+        create_info.pNext = UnwrapPnextChainCopy(layer_data, create_info.pNext, pnext_copies);
     }
+    return local_pCreateInfos;
+}
+
+VkResult DispatchCreateGraphicsPipelines(VkDevice device, VkPipelineCache pipelineCache, uint32_t createInfoCount,
+                                         const VkGraphicsPipelineCreateInfo *pCreateInfos,
+                                         const VkAllocationCallbacks *pAllocator, VkPipeline *pPipelines) {
+    auto layer_data = GetLayerDataPtr(get_dispatch_key(device), layer_data_map);
+    if (!wrap_handles) return layer_data->device_dispatch_table.CreateGraphicsPipelines(device, pipelineCache, createInfoCount,
+                                                                                           pCreateInfos, pAllocator, pPipelines);
+    // Unwrapped copies live in the per-thread scratch arena, which is rewound when this scope exits
+    layer_data::ScratchArena::Scope scratch;
+    std::vector<void *> pnext_copies;
+    const VkGraphicsPipelineCreateInfo *local_pCreateInfos =
+        UnwrapGraphicsPipelineCreateInfos(layer_data, createInfoCount, pCreateInfos, scratch.Arena(), pnext_copies);
     if (pipelineCache) {
         pipelineCache = layer_data->Unwrap(pipelineCache);
     }
 
     VkResult result = layer_data->device_dispatch_table.CreateGraphicsPipelines(device, pipelineCache, createInfoCount,
-                                                                                local_pCreateInfos->ptr(), pAllocator, pPipelines);
+                                                                                local_pCreateInfos, pAllocator, pPipelines);
     for (uint32_t i = 0; i < createInfoCount; ++i) {
-        if (pCreateInfos[i].pNext != VK_NULL_HANDLE) {
+        // A chain shared with the caller already received the feedback
+        if (local_pCreateInfos[i].pNext != pCreateInfos[i].pNext) {
             CopyCreatePipelineFeedbackData(local_pCreateInfos[i].pNext, pCreateInfos[i].pNext);
         }
     }
-
-    delete[] local_pCreateInfos;
+    for (auto pnext_copy : pnext_copies) {
+        FreePnextChain(pnext_copy);
+    }
     {
         for (uint32_t i = 0; i < createInfoCount; ++i) {
             if (pPipelines[i] != VK_NULL_HANDLE) {
@@ -248,6 +321,53 @@ VkResult DispatchCreateGraphicsPipelines(VkDevice device, VkPipelineCache pipeli
     return result;
 }
 
+VkResult DispatchCreateComputePipelines(VkDevice device, VkPipelineCache pipelineCache, uint32_t createInfoCount,
+                                        const VkComputePipelineCreateInfo *pCreateInfos, const VkAllocationCallbacks *pAllocator,
+                                        VkPipeline *pPipelines) {
+    auto layer_data = GetLayerDataPtr(get_dispatch_key(device), layer_data_map);
+    if (!wrap_handles) return layer_data->device_dispatch_table.CreateComputePipelines(device, pipelineCache, createInfoCount,
+                                                                                          pCreateInfos, pAllocator, pPipelines);
+    layer_data::ScratchArena::Scope scratch;
+    std::vector<void *> pnext_copies;
+    VkComputePipelineCreateInfo *local_pCreateInfos = nullptr;
+    pipelineCache = layer_data->Unwrap(pipelineCache);
+    if (pCreateInfos) {
+        local_pCreateInfos = scratch.Arena().Copy(pCreateInfos, createInfoCount);
+        for (uint32_t index0 = 0; index0 < createInfoCount; ++index0) {
+            VkComputePipelineCreateInfo &create_info = local_pCreateInfos[index0];
+            create_info.pNext = UnwrapPnextChainCopy(layer_data, create_info.pNext, pnext_copies);
+            if (create_info.stage.module) {
+                create_info.stage.module = layer_data->Unwrap(create_info.stage.module);
+            }
+            create_info.stage.pNext = UnwrapPnextChainCopy(layer_data, create_info.stage.pNext, pnext_copies);
+            if (create_info.layout) {
+                create_info.layout = layer_data->Unwrap(create_info.layout);
+            }
+            if (create_info.basePipelineHandle) {
+                create_info.basePipelineHandle = layer_data->Unwrap(create_info.basePipelineHandle);
+            }
+        }
+    }
+    VkResult result = layer_data->device_dispatch_table.CreateComputePipelines(device, pipelineCache, createInfoCount,
+                                                                               local_pCreateInfos, pAllocator, pPipelines);
+    for (uint32_t i = 0; i < createInfoCount; ++i) {
+        if (local_pCreateInfos[i].pNext != pCreateInfos[i].pNext) {
+            CopyCreatePipelineFeedbackData(local_pCreateInfos[i].pNext, pCreateInfos[i].pNext);
+        }
+    }
+    for (auto pnext_copy : pnext_copies) {
+        FreePnextChain(pnext_copy);
+    }
+    {
+        for (uint32_t index0 = 0; index0 < createInfoCount; index0++) {
+            if (pPipelines[index0] != VK_NULL_HANDLE) {
+                pPipelines[index0] = layer_data->WrapNew(pPipelines[index0]);
+            }
+        }
+    }
+    return result;
+}
+
 template <typename T>
 static void UpdateCreateRenderPassState(ValidationObject *layer_data, const T *pCreateInfo, VkRenderPass renderPass) {
     auto &renderpass_state = layer_data->renderpasses_states[renderPass];
@@ -570,6 +690,124 @@ VkResult DispatchFreeDescriptorSets(VkDevice device, VkDescriptorPool descriptor
     return result;
 }
 
+// Copies descriptor writes into the scratch arena with their handles unwrapped. As in safe_VkWriteDescriptorSet, only the info
+// array selected by descriptorType is copied. pNext chains are unwrapped with UnwrapPnextChainCopy.
+static const VkWriteDescriptorSet *UnwrapDescriptorWrites(ValidationObject *layer_data, uint32_t descriptorWriteCount,
+                                                          const VkWriteDescriptorSet *pDescriptorWrites,
+                                                          layer_data::ScratchArena &arena, std::vector<void *> &pnext_copies) {
+    if (!pDescriptorWrites) return nullptr;
+    VkWriteDescriptorSet *local_pDescriptorWrites = arena.Copy(pDescriptorWrites, descriptorWriteCount);
+    for (uint32_t index0 = 0; index0 < descriptorWriteCount; ++index0) {
+        VkWriteDescriptorSet &write = local_pDescriptorWrites[index0];
+        write.pNext = UnwrapPnextChainCopy(layer_data, write.pNext, pnext_copies);
+        if (write.dstSet) {
+            write.dstSet = layer_data->Unwrap(write.dstSet);
+        }
+        const VkDescriptorImageInfo *src_image_info = write.pImageInfo;
+        const VkDescriptorBufferInfo *src_buffer_info = write.pBufferInfo;
+        const VkBufferView *src_texel_buffer_view = write.pTexelBufferView;
+        write.pImageInfo = nullptr;
+        write.pBufferInfo = nullptr;
+        write.pTexelBufferView = nullptr;
+        if (!write.descriptorCount) continue;
+        switch (write.descriptorType) {
+            case VK_DESCRIPTOR_TYPE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+            case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+            case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+                if (src_image_info) {
+                    auto image_info = arena.Copy(src_image_info, write.descriptorCount);
+                    for (uint32_t index1 = 0; index1 < write.descriptorCount; ++index1) {
+                        if (image_info[index1].sampler) {
+                            image_info[index1].sampler = layer_data->Unwrap(image_info[index1].sampler);
+                        }
+                        if (image_info[index1].imageView) {
+                            image_info[index1].imageView = layer_data->Unwrap(image_info[index1].imageView);
+                        }
+                    }
+                    write.pImageInfo = image_info;
+                }
+                break;
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+                if (src_buffer_info) {
+                    auto buffer_info = arena.Copy(src_buffer_info, write.descriptorCount);
+                    for (uint32_t index1 = 0; index1 < write.descriptorCount; ++index1) {
+                        if (buffer_info[index1].buffer) {
+                            buffer_info[index1].buffer = layer_data->Unwrap(buffer_info[index1].buffer);
+                        }
+                    }
+                    write.pBufferInfo = buffer_info;
+                }
+                break;
+            case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+            case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+                if (src_texel_buffer_view) {
+                    auto texel_buffer_view = arena.Copy(src_texel_buffer_view, write.descriptorCount);
+                    for (uint32_t index1 = 0; index1 < write.descriptorCount; ++index1) {
+                        texel_buffer_view[index1] = layer_data->Unwrap(texel_buffer_view[index1]);
+                    }
+                    write.pTexelBufferView = texel_buffer_view;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return local_pDescriptorWrites;
+}
+
+void DispatchUpdateDescriptorSets(VkDevice device, uint32_t descriptorWriteCount, const VkWriteDescriptorSet *pDescriptorWrites,
+                                  uint32_t descriptorCopyCount, const VkCopyDescriptorSet *pDescriptorCopies) {
+    auto layer_data = GetLayerDataPtr(get_dispatch_key(device), layer_data_map);
+    if (!wrap_handles)
+        return layer_data->device_dispatch_table.UpdateDescriptorSets(device, descriptorWriteCount, pDescriptorWrites,
+                                                                      descriptorCopyCount, pDescriptorCopies);
+    // Unwrapped copies live in the per-thread scratch arena, which is rewound when this scope exits
+    layer_data::ScratchArena::Scope scratch;
+    std::vector<void *> pnext_copies;
+    const VkWriteDescriptorSet *local_pDescriptorWrites =
+        UnwrapDescriptorWrites(layer_data, descriptorWriteCount, pDescriptorWrites, scratch.Arena(), pnext_copies);
+    VkCopyDescriptorSet *local_pDescriptorCopies = nullptr;
+    if (pDescriptorCopies) {
+        local_pDescriptorCopies = scratch.Arena().Copy(pDescriptorCopies, descriptorCopyCount);
+        for (uint32_t index0 = 0; index0 < descriptorCopyCount; ++index0) {
+            if (local_pDescriptorCopies[index0].srcSet) {
+                local_pDescriptorCopies[index0].srcSet = layer_data->Unwrap(local_pDescriptorCopies[index0].srcSet);
+            }
+            if (local_pDescriptorCopies[index0].dstSet) {
+                local_pDescriptorCopies[index0].dstSet = layer_data->Unwrap(local_pDescriptorCopies[index0].dstSet);
+            }
+        }
+    }
+    layer_data->device_dispatch_table.UpdateDescriptorSets(device, descriptorWriteCount, local_pDescriptorWrites,
+                                                           descriptorCopyCount, local_pDescriptorCopies);
+    for (auto pnext_copy : pnext_copies) {
+        FreePnextChain(pnext_copy);
+    }
+}
+
+void DispatchCmdPushDescriptorSetKHR(VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelineBindPoint, VkPipelineLayout layout,
+                                     uint32_t set, uint32_t descriptorWriteCount, const VkWriteDescriptorSet *pDescriptorWrites) {
+    auto layer_data = GetLayerDataPtr(get_dispatch_key(commandBuffer), layer_data_map);
+    if (!wrap_handles)
+        return layer_data->device_dispatch_table.CmdPushDescriptorSetKHR(commandBuffer, pipelineBindPoint, layout, set,
+                                                                         descriptorWriteCount, pDescriptorWrites);
+    layer_data::ScratchArena::Scope scratch;
+    std::vector<void *> pnext_copies;
+    layout = layer_data->Unwrap(layout);
+    const VkWriteDescriptorSet *local_pDescriptorWrites =
+        UnwrapDescriptorWrites(layer_data, descriptorWriteCount, pDescriptorWrites, scratch.Arena(), pnext_copies);
+    layer_data->device_dispatch_table.CmdPushDescriptorSetKHR(commandBuffer, pipelineBindPoint, layout, set, descriptorWriteCount,
+                                                              local_pDescriptorWrites);
+    for (auto pnext_copy : pnext_copies) {
+        FreePnextChain(pnext_copy);
+    }
+}
+
 // This is the core version of this routine.  The extension version is below.
 VkResult DispatchCreateDescriptorUpdateTemplate(VkDevice device, const VkDescriptorUpdateTemplateCreateInfo *pCreateInfo,
                                                 const VkAllocationCallbacks *pAllocator,
@@ -1443,6 +1681,7 @@ VkResult DispatchBuildAccelerationStructuresKHR(
             'vkDestroySwapchainKHR',
             'vkQueuePresentKHR',
             'vkCreateGraphicsPipelines',
+            'vkCreateComputePipelines',
             'vkResetDescriptorPool',
             'vkDestroyDescriptorPool',
             'vkAllocateDescriptorSets',
@@ -1454,6 +1693,8 @@ VkResult DispatchBuildAccelerationStructuresKHR(
             'vkUpdateDescriptorSetWithTemplate',
             'vkUpdateDescriptorSetWithTemplateKHR',
             'vkCmdPushDescriptorSetWithTemplateKHR',
+            'vkUpdateDescriptorSets',
+            'vkCmdPushDescriptorSetKHR',
             'vkDebugMarkerSetObjectTagEXT',
             'vkDebugMarkerSetObjectNameEXT',
             'vkCreateRenderPass',
@@ -1790,6 +2031,28 @@ VkResult DispatchBuildAccelerationStructuresKHR(
         pnext_proc += '        // Process the next structure in the chain\n'
         pnext_proc += '        cur_pnext = header->pNext;\n'
         pnext_proc += '    }\n'
+        pnext_proc += '}\n\n'
+        # Companion query, allowing callers to skip the deep copy of chains which don't need unwrapping
+        pnext_proc += '// Returns true if any structure in the pNext chain contains handles which WrapPnextChainHandles would unwrap\n'
+        pnext_proc += 'bool PnextChainHasHandles(const void *pNext) {\n'
+        pnext_proc += '    for (auto header = reinterpret_cast<const VkBaseInStructure *>(pNext); header != NULL; header = header->pNext) {\n'
+        pnext_proc += '        switch (header->sType) {\n'
+        for item in self.ndo_extension_structs:
+            struct_info = self.struct_member_dict[item]
+            (tmp_decl, tmp_pre, tmp_post) = self.uniquify_members(struct_info, '', 'safe_struct->', 0, False, False, False, False)
+            if not tmp_pre:
+                continue
+            if struct_info[0].feature_protect is not None:
+                pnext_proc += '#ifdef %s \n' % struct_info[0].feature_protect
+            pnext_proc += '            case %s:\n' % self.structTypes[item].value
+            if struct_info[0].feature_protect is not None:
+                pnext_proc += '#endif // %s \n' % struct_info[0].feature_protect
+        pnext_proc += '                return true;\n'
+        pnext_proc += '            default:\n'
+        pnext_proc += '                break;\n'
+        pnext_proc += '        }\n'
+        pnext_proc += '    }\n'
+        pnext_proc += '    return false;\n'
         pnext_proc += '}\n'
         return pnext_proc
 
@@ -679,52 +679,74 @@ def StageAccessEnums(stage_accesses, config):
 def UnpackField(map, field='name'):
     return [ e[field] for e in map ]
 
-def CrossReferenceTable(table_name, table_desc, key_type, mapped_type, key_vec, mask_map, config):
-    indent = config['indent']
-
-    table = ['// ' + table_desc]
+def BitTableHelpers(config):
     if config['is_source']:
-        table.append('const std::map<{}, {}> {} {{'.format(key_type, mapped_type, config['var_prefix'] + table_name))
-
-        for mask_key in key_vec:
-            mask_vec = mask_map[mask_key]
-            if len(mask_vec) == 0:
-                continue
-
-            if len(mask_vec) > 1:
-                sep = ' |\n' + indent * 2
-                table.append( '{tab}{{ {}, (\n{tab}{tab}{}\n{tab})}},'.format(mask_key, sep.join(mask_vec), tab=indent))
-            else:
-                table.append( '{}{{ {}, {}}},'.format(indent, mask_key, mask_vec[0]))
-        if(table_name == 'StageAccessMaskByAccessBit'):
-            table.append( '{}{{ {}, {}}},'.format(indent, 'VK_ACCESS_2_MEMORY_READ_BIT', 'syncStageAccessReadMask'))
-            table.append( '{}{{ {}, {}}},'.format(indent, 'VK_ACCESS_2_MEMORY_WRITE_BIT', 'syncStageAccessWriteMask'))
-        table.append('};')
-    else:
-        table.append('extern const std::map<{}, {}> {};'.format(key_type, mapped_type, config['var_prefix'] + table_name))
-    table.append('')
+        return ['// Entry of a table keyed by a single flag bit, expanded at compile time into a table indexed by bit position',
+                'template <typename Value>',
+                'struct SyncBitTableEntry {',
+                '    VkFlags64 bit;',
+                '    Value value;',
+                '};',
+                '',
+                '// Value for the single flag bit, or none if the bit has no entry',
+                'template <typename Value, size_t N>',
+                'constexpr Value SyncBitTableLookup(const SyncBitTableEntry<Value> (&entries)[N], VkFlags64 bit, Value none, size_t i = 0) {',
+                '    return (i == N) ? none : ((entries[i].bit == bit) ? entries[i].value : SyncBitTableLookup(entries, bit, none, i + 1));',
+                '}',
+                '']
+    return ['// Union of the table values for each bit set in mask',
+            'template <typename Value, size_t N>',
+            'Value SyncBitTableUnion(const std::array<Value, N> &table, VkFlags64 mask) {',
+            '    Value result = Value();',
+            '    if (N < 64) mask &= (VkFlags64(1) << (N % 64)) - 1;',
+            '    for (; mask; mask &= mask - 1) {',
+            '        result |= table[LeastSignificantBit(mask)];',
+            '    }',
+            '    return result;',
+            '}',
+            '']
+
+def CrossReferenceEntries(table_name, entry_type, key_vec, mask_map, config):
+    indent = config['indent']
+    table = ['{}SyncBitTableEntry<{}> {}Entries[] = {{'.format(entry_type, config['mapped_type'], config['var_prefix'] + table_name)]
+    for mask_key in key_vec:
+        mask_vec = mask_map[mask_key]
+        if len(mask_vec) == 0:
+            continue
 
+        if len(mask_vec) > 1:
+            sep = ' |\n' + indent * 2
+            table.append( '{tab}{{ {}, (\n{tab}{tab}{}\n{tab})}},'.format(mask_key, sep.join(mask_vec), tab=indent))
+        else:
+            table.append( '{}{{ {}, {}}},'.format(indent, mask_key, mask_vec[0]))
+    if(table_name == 'StageAccessMaskByAccessBit'):
+        table.append( '{}{{ {}, {}}},'.format(indent, 'VK_ACCESS_2_MEMORY_READ_BIT', 'syncStageAccessReadMask'))
+        table.append( '{}{{ {}, {}}},'.format(indent, 'VK_ACCESS_2_MEMORY_WRITE_BIT', 'syncStageAccessWriteMask'))
+    table.append('};')
     return table
 
-def DoubleCrossReferenceTable(table_name, table_desc, stage_keys, access_keys, stage_access_stage_access_map, config):
-    indent = config['indent']
-    ordinal_name = config['ordinal_name']
+def BitPositionTable(table_name, table_type, none, table_bits, config):
+    name = config['var_prefix'] + table_name
+    table = ['{}std::array<{}, {}> {} {{{{'.format(table_type, config['mapped_type'], table_bits, name)]
+    for bit in range(table_bits):
+        table.append('{}SyncBitTableLookup({}Entries, VkFlags64(1) << {}, {}),'.format(config['indent'], name, bit, none))
+    table.append('}};')
+    return table
 
-    table = ['// ' + table_desc]
+# Lookup tables are indexed by bit position of the key flag, filled in from the entry list.  Both are defined once in the
+# source, the VkFlags valued ones at compile time.  Tables of SyncStageAccessFlags can't be constant expressions in C++11
+# (std::bitset<128>), so their entries are static const instead.
+def CrossReferenceTable(table_name, table_desc, mapped_type, key_vec, mask_map, config, none=None, table_bits=64):
+    table_config = dict(config, mapped_type=mapped_type)
+    if none is None:
+        none = '{}(0)'.format(mapped_type)
+    table = ['// ' + table_desc + ', indexed by bit position']
     if config['is_source']:
-        table.append('const std::map<{vk_stage_flags}, std::map<{vk_access_flags}, {ordinal_name}>> {var_prefix}{} {{'.format(table_name, **config))
-        sep = ' },\n' + indent * 2 + '{ '
-
-        # Because stage_access_stage_access_map's elements order might be different sometimes.
-        # It causes the generator creates different code. It needs to be sorted.
-        for i in sorted(stage_access_stage_access_map):
-            if len(stage_access_stage_access_map[i].keys()) == 0: continue
-            accesses = [ '{}, {}'.format(access, index) for access, index in sorted(stage_access_stage_access_map[i].items()) ]
-            entry_format = '{tab}{{ {key}, {{\n{tab}{tab}{{ {val} }}\n{tab}}} }},'
-            table.append( entry_format.format(key=i, val=sep.join(accesses), tab=indent))
-        table.append('};')
+        entry_type = 'static const ' if mapped_type == config['sync_mask_name'] else 'static constexpr '
+        table.extend(CrossReferenceEntries(table_name, entry_type, key_vec, mask_map, table_config))
+        table.extend(BitPositionTable(table_name, 'const ', none, table_bits, table_config))
     else:
-        table.append('extern const std::map<{vk_stage_flags}, std::map<{vk_access_flags}, {ordinal_name}>> {var_prefix}{};'.format(table_name, **config))
+        table.append('extern const std::array<{}, {}> {};'.format(mapped_type, table_bits, config['var_prefix'] + table_name))
     table.append('')
 
     return table
@@ -741,7 +763,6 @@ def StageAccessCrossReference(sync_enum, stage_access_combinations, config):
     stage_access_mask_stage_map = { e['name']: [] for e in stages_in_bit_order }
     #stage_access_mask_stage_map[none_stage] = [] # Support for N/A
     stage_access_mask_access_map = { e['name']: [] for e in access_in_bit_order }
-    stage_access_stage_access_map = {  e['name']: dict() for e in stages_in_bit_order }
     direct_stage_to_access_map = {  e['name']: [] for e in stages_in_bit_order }
 
     for stage_access_combo in stage_access_combinations:
@@ -752,31 +773,24 @@ def StageAccessCrossReference(sync_enum, stage_access_combinations, config):
         if access == 'VK_ACCESS_2_FLAG_NONE_KHR' : continue
         stage_access_mask_stage_map[stage].append(combo_bit)
         stage_access_mask_access_map[access].append(combo_bit)
-        stage_access_stage_access_map[stage][access] = stage_access_combo['stage_access']
         direct_stage_to_access_map[stage].append(stage_access_combo['access'])
 
     # sas: stage_access masks by stage used to build up SyncMaskTypes from VkPipelineStageFlagBits
     sas_desc = 'Bit order mask of stage_access bit for each stage'
     sas_name = 'StageAccessMaskByStageBit'
-    output.extend(CrossReferenceTable(sas_name, sas_desc, 'VkPipelineStageFlags2', config['sync_mask_name'],
+    output.extend(CrossReferenceTable(sas_name, sas_desc, config['sync_mask_name'],
                                       UnpackField(stages_in_bit_order), stage_access_mask_stage_map, config))
 
     # saa -- stage_access by access used to build up SyncMaskTypes from VkAccessFlagBits
     saa_name = 'StageAccessMaskByAccessBit'
     saa_desc = 'Bit order mask of stage_access bit for each access'
-    output.extend(CrossReferenceTable(saa_name, saa_desc, 'VkAccessFlags2',  config['sync_mask_name'],
+    output.extend(CrossReferenceTable(saa_name, saa_desc, config['sync_mask_name'],
                                       UnpackField(access_in_bit_order), stage_access_mask_access_map, config))
 
-    #sasa -- stage access index by stage by access
-    sasa_name = 'StageAccessIndexByStageAndAccess'
-    sasa_desc = 'stage_access index for each stage and access'
-    output.extend(DoubleCrossReferenceTable(sasa_name, sasa_desc,stages_in_bit_order, access_in_bit_order, stage_access_stage_access_map, config))
-
-
     # direct VkPipelineStageFlags to valid VkAccessFlags lookup table
     direct_name = 'DirectStageToAccessMask'
     direct_desc = 'Direct VkPipelineStageFlags to valid VkAccessFlags lookup table'
-    output.extend(CrossReferenceTable(direct_name, direct_desc, 'VkPipelineStageFlags2', 'VkAccessFlags2',
+    output.extend(CrossReferenceTable(direct_name, direct_desc, 'VkAccessFlags2',
                                       UnpackField(stages_in_bit_order), direct_stage_to_access_map, config))
 
     return output
@@ -828,26 +842,25 @@ def AllCommandsByQueueCapability(stage_order, stage_queue_table, config):
 
     name = 'AllCommandStagesByQueueFlags'
     desc = 'Pipeline stages corresponding to VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT for each VkQueueFlagBits'
-    return CrossReferenceTable(name, desc, 'VkQueueFlagBits', 'VkPipelineStageFlags2', queue_caps, queue_flag_map, config)
+    return CrossReferenceTable(name, desc, 'VkPipelineStageFlags2', queue_caps, queue_flag_map, config, table_bits=32)
 
 def PipelineOrderMaskMap(stage_order, stage_order_map, config):
     output = list()
     prior_name = 'LogicallyEarlierStages'
     prior_desc = 'Masks of logically earlier stage flags for a given stage flag'
-    output.extend(CrossReferenceTable(prior_name, prior_desc, config['vk_stage_bits'], config['vk_stage_flags'], stage_order,
+    output.extend(CrossReferenceTable(prior_name, prior_desc, config['vk_stage_flags'], stage_order,
                                      stage_order_map['prior'], config))
 
     subseq_name = 'LogicallyLaterStages'
     subseq_desc = 'Masks of logically later stage flags for a given stage flag'
-    output.extend(CrossReferenceTable(subseq_name, subseq_desc, config['vk_stage_bits'], config['vk_stage_flags'], stage_order,
+    output.extend(CrossReferenceTable(subseq_name, subseq_desc, config['vk_stage_flags'], stage_order,
                                      stage_order_map['subseq'], config))
 
     order_name = 'StageOrder'
     order_desc = 'Lookup table of stage orderings'
     order_nums = {stage_order[i] : [i] for i in range(len(stage_order)) }
 
-    output.extend(CrossReferenceTable(order_name, order_desc, config['vk_stage_bits'], 'int', stage_order,
-                                      order_nums, config))
+    output.extend(CrossReferenceTable(order_name, order_desc, 'int', stage_order, order_nums, config, none='-1'))
     return output
 
 def ShaderStageToSyncStageAccess( shader_stage_key, sync_stage_key ):
@@ -855,6 +868,7 @@ def ShaderStageToSyncStageAccess( shader_stage_key, sync_stage_key ):
 
 def ShaderStageAndSyncStageAccessMap(config):
     output = []
+    desc = '// Stage/access indices of the descriptor accesses for each VkShaderStageFlagBits, indexed by bit position'
     if not config['is_source']:
         output.append('struct SyncShaderStageAccess {')
         output.append('    SyncStageAccessIndex sampled_read;')
@@ -862,9 +876,11 @@ def ShaderStageAndSyncStageAccessMap(config):
         output.append('    SyncStageAccessIndex storage_write;')
         output.append('    SyncStageAccessIndex uniform_read;')
         output.append('};\n')
-        output.append('extern const std::map<VkShaderStageFlagBits, SyncShaderStageAccess> syncStageAccessMaskByShaderStage;')
+        output.append(desc)
+        output.append('extern const std::array<SyncShaderStageAccess, 32> syncStageAccessMaskByShaderStage;')
     else:
-        output.append('const std::map<VkShaderStageFlagBits, SyncShaderStageAccess> syncStageAccessMaskByShaderStage {')
+        output.append(desc)
+        output.append('static constexpr SyncBitTableEntry<SyncShaderStageAccess> syncStageAccessMaskByShaderStageEntries[] = {')
         output.append(ShaderStageToSyncStageAccess('VERTEX_BIT', 'VERTEX_SHADER'))
         output.append(ShaderStageToSyncStageAccess('TESSELLATION_CONTROL_BIT', 'TESSELLATION_CONTROL_SHADER'))
         output.append(ShaderStageToSyncStageAccess('TESSELLATION_EVALUATION_BIT', 'TESSELLATION_EVALUATION_SHADER'))
@@ -879,7 +895,10 @@ def ShaderStageAndSyncStageAccessMap(config):
         output.append(ShaderStageToSyncStageAccess('CALLABLE_BIT_KHR', 'RAY_TRACING_SHADER'))
         output.append(ShaderStageToSyncStageAccess('TASK_BIT_NV', 'TASK_SHADER_NV'))
         output.append(ShaderStageToSyncStageAccess('MESH_BIT_NV', 'MESH_SHADER_NV'))
-        output.append('};\n')
+        output.append('};')
+        none = 'SyncShaderStageAccess{SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE, SYNC_ACCESS_INDEX_NONE}'
+        output.extend(BitPositionTable('StageAccessMaskByShaderStage', 'const ', none, 32,
+                                       dict(config, mapped_type='SyncShaderStageAccess')))
     return output
 
 def GenSyncTypeHelper(gen, is_source) :
@@ -901,8 +920,8 @@ def GenSyncTypeHelper(gen, is_source) :
     if config['is_source']:
         lines = ['#include "synchronization_validation_types.h"', '']
     else:
-        lines = ['#pragma once', '', '#include <array>', '#include <bitset>', '#include <map>', '#include <stdint.h>', '#include <vulkan/vulkan.h>',
-                 '#include "vk_layer_data.h"']
+        lines = ['#pragma once', '', '#include <array>', '#include <bitset>', '#include <stdint.h>', '#include <vulkan/vulkan.h>',
+                 '#include "vk_layer_data.h"', '#include "vk_layer_utils.h"']
         lines.extend(('using {} = {};'.format(config['sync_mask_name'], config['sync_mask_base_type']), ''))
     lines.extend(['// clang-format off', ''])
 
@@ -920,6 +939,8 @@ def GenSyncTypeHelper(gen, is_source) :
 
     lines.extend(ReadWriteMasks(stage_access_combinations, config))
 
+    lines.extend(BitTableHelpers(config))
+
     lines.extend(StageAccessCrossReference(gen.sync_enum, stage_access_combinations, config))
     lines.extend(AllCommandsByQueueCapability(stage_order, stage_queue_cap_table, config))
     lines.extend(PipelineOrderMaskMap(stage_order, stage_order_map, config))
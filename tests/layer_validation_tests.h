@@ -53,6 +53,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include <functional>
 #include <limits>
 #include <memory>
@@ -254,6 +255,23 @@ T NearestSmaller(const T from) {
     return std::nextafter(from, negative_direction);
 }
 
+// Sets an environment variable for the lifetime of the object, so layer options can be changed from a single test
+class ScopedEnvironmentVariable {
+  public:
+    ScopedEnvironmentVariable(const char *name, const char *value) : name_(name) { Set(value); }
+    ~ScopedEnvironmentVariable() { Set(""); }
+
+  private:
+    void Set(const char *value) {
+#if defined(_WIN32)
+        _putenv_s(name_.c_str(), value);
+#else
+        setenv(name_.c_str(), value, 1);
+#endif
+    }
+    std::string name_;
+};
+
 class VkLayerTest : public VkRenderFramework {
   public:
     const char *kValidationLayerName = "VK_LAYER_KHRONOS_validation";
@@ -365,6 +383,7 @@ class VkDebugPrintfTest : public VkLayerTest {
 class VkSyncValTest : public VkLayerTest {
   public:
     void InitSyncValFramework(bool enable_queue_submit_validation = false);
+    void AccessLogLimitTest(const char *compaction, const char *old_usage_message);
 
   protected:
     VkValidationFeatureEnableEXT enables_[1] = {VK_VALIDATION_FEATURE_ENABLE_SYNCHRONIZATION_VALIDATION_EXT};
@@ -649,6 +649,61 @@ TEST_F(VkPositiveLayerTest, QueueThreading) {
     vk::QueueWaitIdle(queue_h);
 }
 
+TEST_F(VkPositiveLayerTest, ThreadSafetyPinsReleased) {
+    TEST_DESCRIPTION("Record and free more command buffers than a call pins on other threads, then destroy their pools here.");
+
+    VkValidationFeatureDisableEXT disables[] = {
+        VK_VALIDATION_FEATURE_DISABLE_API_PARAMETERS_EXT, VK_VALIDATION_FEATURE_DISABLE_OBJECT_LIFETIMES_EXT,
+        VK_VALIDATION_FEATURE_DISABLE_CORE_CHECKS_EXT, VK_VALIDATION_FEATURE_DISABLE_UNIQUE_HANDLES_EXT};
+    VkValidationFeaturesEXT features = LvlInitStruct<VkValidationFeaturesEXT>();
+    features.disabledValidationFeatureCount = 4;
+    features.pDisabledValidationFeatures = disables;
+    ASSERT_NO_FATAL_FAILURE(InitFramework(m_errorMonitor, &features));
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    // More command buffers than a single call pins, so freeing them looks the rest up again
+    constexpr uint32_t kThreadCount = 4;
+    constexpr uint32_t kCommandBufferCount = 100;
+    constexpr uint32_t kCallCount = 1000;
+    std::array<VkCommandPool, kThreadCount> pools;
+    std::array<std::vector<VkCommandBuffer>, kThreadCount> command_buffers;
+    auto pool_ci = LvlInitStruct<VkCommandPoolCreateInfo>();
+    pool_ci.queueFamilyIndex = m_device->graphics_queue_node_index_;
+    for (uint32_t t = 0; t < kThreadCount; ++t) {
+        ASSERT_VK_SUCCESS(vk::CreateCommandPool(device(), &pool_ci, nullptr, &pools[t]));
+        auto alloc_info = LvlInitStruct<VkCommandBufferAllocateInfo>();
+        alloc_info.commandPool = pools[t];
+        alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        alloc_info.commandBufferCount = kCommandBufferCount;
+        command_buffers[t].resize(kCommandBufferCount);
+        ASSERT_VK_SUCCESS(vk::AllocateCommandBuffers(device(), &alloc_info, command_buffers[t].data()));
+    }
+
+    // Each call starts and finishes a write of the command buffer and its pool, which are only used by one thread at a time
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kThreadCount; ++t) {
+        threads.emplace_back([this, &pools, &command_buffers, t]() {
+            auto begin_info = LvlInitStruct<VkCommandBufferBeginInfo>();
+            for (VkCommandBuffer cb : command_buffers[t]) {
+                vk::BeginCommandBuffer(cb, &begin_info);
+                for (uint32_t i = 0; i < kCallCount / kCommandBufferCount; ++i) {
+                    vk::CmdSetLineWidth(cb, 1.0f);
+                }
+                vk::EndCommandBuffer(cb);
+            }
+            vk::FreeCommandBuffers(device(), pools[t], kCommandBufferCount, command_buffers[t].data());
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // A pool use left unfinished by the threads above, pinned or not, would be reported as a threading error here
+    for (uint32_t t = 0; t < kThreadCount; ++t) {
+        vk::DestroyCommandPool(device(), pools[t], nullptr);
+    }
+}
+
 TEST_F(VkPositiveLayerTest, TestAcquiringSwapchainImages) {
     TEST_DESCRIPTION("Test acquiring swapchain images.");
 
@@ -594,6 +594,39 @@ TEST_F(VkPositiveLayerTest, CreateComputePipelineMissingDescriptorUnusedPositive
     pipe.CreateComputePipeline();
 }
 
+TEST_F(VkPositiveLayerTest, CreateManyComputePipelines) {
+    TEST_DESCRIPTION("Create a large batch of valid compute pipelines in a single call, validated on several threads.");
+
+    ScopedEnvironmentVariable pipeline_threads("VK_LAYER_PIPELINE_VALIDATION_THREADS", "4");
+    ASSERT_NO_FATAL_FAILURE(Init());
+
+    char const *csSource = R"glsl(
+        #version 450
+        layout(local_size_x=1) in;
+        layout(set=0, binding=0) buffer block { vec4 x; };
+        void main(){
+           x = vec4(1.0);
+        }
+    )glsl";
+
+    CreateComputePipelineHelper pipe(*this);
+    pipe.InitInfo();
+    pipe.cs_.reset(new VkShaderObj(this, csSource, VK_SHADER_STAGE_COMPUTE_BIT));
+    pipe.dsl_bindings_[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    pipe.InitState();
+    pipe.LateBindPipelineInfo();
+
+    constexpr uint32_t pipeline_count = 1000;
+    std::vector<VkComputePipelineCreateInfo> create_infos(pipeline_count, pipe.cp_ci_);
+    std::vector<VkPipeline> pipelines(pipeline_count, VK_NULL_HANDLE);
+    ASSERT_VK_SUCCESS(vk::CreateComputePipelines(m_device->device(), VK_NULL_HANDLE, pipeline_count, create_infos.data(), nullptr,
+                                                 pipelines.data()));
+    for (auto pipeline : pipelines) {
+        ASSERT_NE(pipeline, VK_NULL_HANDLE);
+        vk::DestroyPipeline(m_device->device(), pipeline, nullptr);
+    }
+}
+
 TEST_F(VkPositiveLayerTest, CreateComputePipelineFragmentShadingRate) {
     TEST_DESCRIPTION("Verify that pipeline validation accepts a compute pipeline with fragment shading rate extension enabled");
 
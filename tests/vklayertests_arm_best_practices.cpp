@@ -16,6 +16,11 @@
 
 #include "cast_utils.h"
 #include "layer_validation_tests.h"
+#include "best_practices_index_scan.h"
+
+#include <cstring>
+#include <deque>
+#include <set>
 
 const char *kEnableArmValidation = "VALIDATION_CHECK_ENABLE_VENDOR_SPECIFIC_ARM";
 
@@ -429,6 +434,77 @@ TEST_F(VkArmBestPracticesLayerTest, SparseIndexBufferTest) {
     test_pipelines(sparse_ibo, sparse_indices.size(), true);
 }
 
+TEST_F(VkArmBestPracticesLayerTest, SparseIndexBufferTransferInvalidation) {
+    TEST_DESCRIPTION("Test that index buffer analysis is redone once a transfer command writing the index buffer is submitted.");
+
+    InitBestPracticesFramework(kEnableArmValidation);
+    InitState();
+    ASSERT_NO_FATAL_FAILURE(InitViewport());
+    ASSERT_NO_FATAL_FAILURE(InitRenderTarget());
+
+    if (IsPlatform(kMockICD) || DeviceSimulation()) {
+        GTEST_SKIP() << "Test not supported by MockICD";
+    }
+
+    std::vector<uint16_t> indices(128);
+    for (unsigned i = 0; i < indices.size(); i++) {
+        indices[i] = i;
+    }
+
+    // Index buffer scans are only memoized when the memory is not host coherent
+    VkBufferObj ibo;
+    ibo.init_no_mem(*m_device, VkBufferObj::create_info(indices.size() * sizeof(uint16_t),
+                                                        VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT));
+    const VkMemoryRequirements ib_requirements = ibo.memory_requirements();
+    VkMemoryAllocateInfo ib_alloc_info = vk_testing::DeviceMemory::alloc_info(ib_requirements.size, 0);
+    if (!m_device->phy().set_memory_type(ib_requirements.memoryTypeBits, &ib_alloc_info, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+                                         VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)) {
+        GTEST_SKIP() << "No host visible, non coherent memory type for the index buffer";
+    }
+    vk_testing::DeviceMemory ib_memory(*m_device, ib_alloc_info);
+    ibo.bind_memory(ib_memory, 0);
+
+    // the validation layer will only be able to analyse mapped memory, it's too expensive otherwise to do in the layer itself
+    auto* mapped_indices = static_cast<uint16_t*>(ib_memory.map());
+    std::copy(indices.begin(), indices.end(), mapped_indices);
+    auto flush_range = LvlInitStruct<VkMappedMemoryRange>();
+    flush_range.memory = ib_memory.handle();
+    flush_range.size = VK_WHOLE_SIZE;
+    vk::FlushMappedMemoryRanges(device(), 1, &flush_range);
+
+    CreatePipelineHelper pipe(*this);
+    pipe.InitInfo();
+    pipe.InitState();
+    pipe.CreateGraphicsPipeline();
+
+    // Recorded before any draw, the transfer rewrites the first two indices with the values they already have
+    VkCommandBufferObj transfer_cb(m_device, m_commandPool);
+    transfer_cb.begin();
+    transfer_cb.FillBuffer(ibo.handle(), 0, sizeof(uint32_t), 0x00010000u);
+    transfer_cb.end();
+
+    m_commandBuffer->begin();
+    m_commandBuffer->BeginRenderPass(m_renderPassBeginInfo);
+    vk::CmdBindPipeline(m_commandBuffer->handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipe.pipeline_);
+    m_commandBuffer->BindIndexBuffer(&ibo, static_cast<VkDeviceSize>(0), VK_INDEX_TYPE_UINT16);
+    m_commandBuffer->DrawIndexed(indices.size(), 1, 0, 0, 0);
+
+    // make the indices sparse without flushing, which the layer is not told about, so the memoized dense scan is still used
+    mapped_indices[indices.size() - 1] = 0xFFFF;
+    m_commandBuffer->DrawIndexed(indices.size(), 1, 0, 0, 0);
+
+    // submitting the transfer drops the scans of its destination, so the next draw sees the sparse indices
+    transfer_cb.QueueCommandBuffer();
+    m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_PERFORMANCE_WARNING_BIT_EXT,
+                                         "UNASSIGNED-BestPractices-vkCmdDrawIndexed-sparse-index-buffer");
+    m_commandBuffer->DrawIndexed(indices.size(), 1, 0, 0, 0);
+    m_errorMonitor->VerifyFound();
+    m_commandBuffer->EndRenderPass();
+    m_commandBuffer->end();
+
+    ib_memory.unmap();
+}
+
 TEST_F(VkArmBestPracticesLayerTest, PostTransformVertexCacheThrashingIndicesTest) {
     TEST_DESCRIPTION(
         "Test for appropriate warnings to be thrown when recording an indexed draw call where the indices thrash the "
@@ -495,6 +571,120 @@ TEST_F(VkArmBestPracticesLayerTest, PostTransformVertexCacheThrashingIndicesTest
     best_ibo.memory().unmap();
 }
 
+// Scans count indices of IndexType starting at a byte offset into a buffer, so that the vectorized scans also see unaligned
+// indices, with both the vectorized and the scalar scan
+template <typename IndexType>
+static void CheckIndexRangeScan(const std::vector<IndexType>& indices, size_t byte_offset, size_t count) {
+    std::vector<uint8_t> bytes(byte_offset + indices.size() * sizeof(IndexType));
+    std::memcpy(bytes.data() + byte_offset, indices.data(), indices.size() * sizeof(IndexType));
+    uint32_t scalar_min = ~0u, scalar_max = 0u;
+    IndexScanTraits<IndexType>::MinMaxScalar(bytes.data() + byte_offset, count, scalar_min, scalar_max);
+    uint32_t min_index = ~0u, max_index = 0u;
+    ScanIndexRange<IndexType>(bytes.data() + byte_offset, count, min_index, max_index);
+    EXPECT_EQ(min_index, scalar_min) << sizeof(IndexType) << " byte indices, offset " << byte_offset << ", count " << count;
+    EXPECT_EQ(max_index, scalar_max) << sizeof(IndexType) << " byte indices, offset " << byte_offset << ", count " << count;
+}
+
+template <typename IndexType>
+static void CheckIndexRangeScans() {
+    // Values over the full range of the index type, so that the biasing of the signed compares is exercised, with every
+    // eleventh index the primitive restart value
+    std::vector<IndexType> indices(1100);
+    uint64_t seed = 1;
+    for (size_t i = 0; i < indices.size(); ++i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        indices[i] = (i % 11 == 10) ? IndexScanTraits<IndexType>::kPrimitiveRestart : static_cast<IndexType>(seed >> 33);
+    }
+    // Lengths around each vector width, so that the minimum or maximum is found only in the scalar tail, and longer ones
+    for (size_t byte_offset = 0; byte_offset < sizeof(IndexType); ++byte_offset) {
+        for (size_t count = 0; count <= 40; ++count) {
+            CheckIndexRangeScan(indices, byte_offset, count);
+        }
+        CheckIndexRangeScan(indices, byte_offset, 1023);
+        CheckIndexRangeScan(indices, byte_offset, indices.size());
+    }
+
+    // The extremes in the vector part only, then in the tail only
+    std::vector<IndexType> extremes(35, 7);
+    extremes[3] = 0;
+    extremes[9] = IndexScanTraits<IndexType>::kPrimitiveRestart;
+    CheckIndexRangeScan(extremes, 0, extremes.size());
+    std::fill(extremes.begin(), extremes.end(), IndexType(7));
+    extremes[33] = 0;
+    extremes[34] = IndexScanTraits<IndexType>::kPrimitiveRestart;
+    CheckIndexRangeScan(extremes, 0, extremes.size());
+}
+
+// The post-transform cache the model stands in for: a vertex is shaded unless it is among the last kCacheSize shaded
+template <typename IndexType>
+static void ReferenceIndexReuse(const std::vector<IndexType>& indices, bool primitive_restart_enable, uint32_t& vertex_shade_count,
+                                uint32_t& vertex_reference_count) {
+    std::deque<uint32_t> fifo;
+    std::set<uint32_t> referenced;
+    vertex_shade_count = 0;
+    for (const IndexType index : indices) {
+        referenced.insert(index);
+        if (primitive_restart_enable && index == IndexScanTraits<IndexType>::kPrimitiveRestart) continue;
+        if (std::find(fifo.begin(), fifo.end(), index) != fifo.end()) continue;
+        ++vertex_shade_count;
+        fifo.push_back(index);
+        if (fifo.size() > PostTransformCacheModel::kCacheSize) fifo.pop_front();
+    }
+    vertex_reference_count = static_cast<uint32_t>(referenced.size());
+}
+
+template <typename IndexType>
+static void CheckIndexReuseScan(const std::vector<IndexType>& indices, bool primitive_restart_enable) {
+    uint32_t min_index = ~0u, max_index = 0u;
+    IndexScanTraits<IndexType>::MinMaxScalar(reinterpret_cast<const uint8_t*>(indices.data()), indices.size(), min_index,
+                                             max_index);
+    uint32_t vertex_shade_count = 0, vertex_reference_count = 0;
+    ScanIndexReuse<IndexType>(reinterpret_cast<const uint8_t*>(indices.data()), indices.size(), primitive_restart_enable,
+                              min_index, max_index, vertex_shade_count, vertex_reference_count);
+    uint32_t expected_shade_count = 0, expected_reference_count = 0;
+    ReferenceIndexReuse(indices, primitive_restart_enable, expected_shade_count, expected_reference_count);
+    EXPECT_EQ(vertex_shade_count, expected_shade_count) << "primitive restart " << primitive_restart_enable;
+    EXPECT_EQ(vertex_reference_count, expected_reference_count) << "primitive restart " << primitive_restart_enable;
+}
+
+TEST_F(VkArmBestPracticesLayerTest, IndexBufferScan) {
+    TEST_DESCRIPTION(
+        "Check that the vectorized index range scans find the same range as the scalar scan, and that the post-transform cache "
+        "model shades as many vertices as a FIFO cache.");
+
+    CheckIndexRangeScans<uint8_t>();
+    CheckIndexRangeScans<uint16_t>();
+    CheckIndexRangeScans<uint32_t>();
+
+    // Triangle strips of a 12x12 grid of vertices, whose indices are all below the first two that share a slot of the model, so
+    // that the model matches a FIFO cache exactly. One strip per row, each ending in a primitive restart.
+    std::vector<uint16_t> strips;
+    for (uint16_t y = 0; y + 1 < 12; ++y) {
+        for (uint16_t x = 0; x < 12; ++x) {
+            strips.push_back(y * 12 + x);
+            strips.push_back((y + 1) * 12 + x);
+        }
+        strips.push_back(IndexScanTraits<uint16_t>::kPrimitiveRestart);
+    }
+    CheckIndexReuseScan(strips, true);
+
+    // The same grid as a triangle list, drawn in row order and in an order that thrashes the cache
+    std::vector<uint32_t> list;
+    for (uint32_t y = 0; y + 1 < 12; ++y) {
+        for (uint32_t x = 0; x + 1 < 12; ++x) {
+            const uint32_t i = y * 12 + x;
+            const uint32_t quad[6] = {i, i + 12, i + 1, i + 1, i + 12, i + 13};
+            list.insert(list.end(), quad, quad + 6);
+        }
+    }
+    CheckIndexReuseScan(list, false);
+    std::vector<uint32_t> shuffled = list;
+    for (size_t i = 0; i < shuffled.size(); ++i) {
+        std::swap(shuffled[i], shuffled[(i * 7919) % shuffled.size()]);
+    }
+    CheckIndexReuseScan(shuffled, false);
+}
+
 TEST_F(VkArmBestPracticesLayerTest, PresentModeTest) {
     TEST_DESCRIPTION("Test for usage of Presentation Modes");
 
@@ -14,6 +14,12 @@
  * Author: Tony Barbour <tony@LunarG.com>
  */
 
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+
+#include "cast_utils.h"
 #include "layer_validation_tests.h"
 
 bool VkGpuAssistedLayerTest::InitGpuAssistedFramework(bool request_descriptor_indexing) {
@@ -911,6 +917,432 @@ TEST_F(VkGpuAssistedLayerTest, DrawTimeShaderUniformBufferTooSmallNestedStruct)
                          "Descriptor size is 8 and highest byte accessed was 19");
 }
 
+TEST_F(VkGpuAssistedLayerTest, GpuValidationCachedShaderModule) {
+    TEST_DESCRIPTION("Check that errors in a shader module instrumented from the cache are reported against that shader module.");
+    SetTargetApiVersion(VK_API_VERSION_1_1);
+
+    InitGpuAssistedFramework(false);
+    if (IsPlatform(kMockICD) || DeviceSimulation()) {
+        GTEST_SKIP() << "Test not supported by MockICD, GPU-Assisted validation test requires a driver that can draw";
+    }
+
+    VkPhysicalDeviceFeatures features = {};  // Make sure robust buffer access is not enabled
+    ASSERT_NO_FATAL_FAILURE(InitState(&features));
+
+    char const *csSource = R"glsl(
+        #version 450
+        layout(local_size_x=1) in;
+        layout(set=0, binding=0) buffer foo { int x; int y; } bar;
+        void main(){
+           bar.y = bar.x;
+        }
+    )glsl";
+
+    CreateComputePipelineHelper first_pipe(*this);
+    first_pipe.InitInfo();
+    first_pipe.cs_.reset(new VkShaderObj(this, csSource, VK_SHADER_STAGE_COMPUTE_BIT));
+    first_pipe.dsl_bindings_[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    first_pipe.InitState();
+    ASSERT_VK_SUCCESS(first_pipe.CreateComputePipeline());
+
+    // The second shader module is identical to the first, so is instrumented from the cache
+    CreateComputePipelineHelper pipe(*this);
+    pipe.InitInfo();
+    pipe.cs_.reset(new VkShaderObj(this, csSource, VK_SHADER_STAGE_COMPUTE_BIT));
+    pipe.dsl_bindings_[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    pipe.InitState();
+    ASSERT_VK_SUCCESS(pipe.CreateComputePipeline());
+
+    VkBufferObj buffer;
+    VkMemoryPropertyFlags reqs = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    buffer.init_as_storage(*m_device, 4, reqs);
+    pipe.descriptor_set_->WriteDescriptorBufferInfo(0, buffer.handle(), 0, 4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+    pipe.descriptor_set_->UpdateDescriptorSets();
+
+    m_commandBuffer->begin();
+    vk::CmdBindPipeline(m_commandBuffer->handle(), VK_PIPELINE_BIND_POINT_COMPUTE, pipe.pipeline_);
+    vk::CmdBindDescriptorSets(m_commandBuffer->handle(), VK_PIPELINE_BIND_POINT_COMPUTE, pipe.pipeline_layout_.handle(), 0, 1,
+                              &pipe.descriptor_set_->set_, 0, nullptr);
+    vk::CmdDispatch(m_commandBuffer->handle(), 1, 1, 1);
+    m_commandBuffer->end();
+
+    std::stringstream shader_module;
+    shader_module << std::hex << std::showbase << "Shader Module (" << CastToUint64(pipe.cs_->handle()) << ")";
+    m_errorMonitor->SetDesiredFailureMsg(kErrorBit, shader_module.str().c_str());
+    m_commandBuffer->QueueCommandBuffer(true);
+    m_errorMonitor->VerifyFound();
+}
+
+TEST_F(VkGpuAssistedLayerTest, GpuValidationDeferredInstrumentation) {
+    TEST_DESCRIPTION("Check that shader modules instrumented on the background thread are substituted when pipelines are created.");
+    SetTargetApiVersion(VK_API_VERSION_1_1);
+    ScopedEnvironmentVariable deferred_instrumentation("VK_LAYER_GPUAV_DEFERRED_INSTRUMENTATION", "1");
+
+    InitGpuAssistedFramework(false);
+    if (IsPlatform(kMockICD) || DeviceSimulation()) {
+        GTEST_SKIP() << "Test not supported by MockICD, GPU-Assisted validation test requires a driver that can draw";
+    }
+
+    VkPhysicalDeviceFeatures features = {};  // Make sure robust buffer access is not enabled
+    ASSERT_NO_FATAL_FAILURE(InitState(&features));
+
+    char const *csSource = R"glsl(
+        #version 450
+        layout(local_size_x=1) in;
+        layout(set=0, binding=0) buffer foo { int x; int y; } bar;
+        void main(){
+           bar.y = bar.x;
+        }
+    )glsl";
+
+    // Both pipelines are created from the one shader module, the second from the instrumentation result of the first
+    VkShaderObj cs(this, csSource, VK_SHADER_STAGE_COMPUTE_BIT);
+    CreateComputePipelineHelper first_pipe(*this);
+    first_pipe.InitInfo();
+    first_pipe.dsl_bindings_[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    first_pipe.InitState();
+    first_pipe.LateBindPipelineInfo();
+    first_pipe.cp_ci_.stage = cs.GetStageCreateInfo();
+    ASSERT_VK_SUCCESS(first_pipe.CreateComputePipeline(true, false));
+
+    CreateComputePipelineHelper pipe(*this);
+    pipe.InitInfo();
+    pipe.dsl_bindings_[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    pipe.InitState();
+    pipe.LateBindPipelineInfo();
+    pipe.cp_ci_.stage = cs.GetStageCreateInfo();
+    ASSERT_VK_SUCCESS(pipe.CreateComputePipeline(true, false));
+
+    VkBufferObj buffer;
+    VkMemoryPropertyFlags reqs = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    buffer.init_as_storage(*m_device, 4, reqs);
+    pipe.descriptor_set_->WriteDescriptorBufferInfo(0, buffer.handle(), 0, 4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+    pipe.descriptor_set_->UpdateDescriptorSets();
+
+    m_commandBuffer->begin();
+    vk::CmdBindPipeline(m_commandBuffer->handle(), VK_PIPELINE_BIND_POINT_COMPUTE, pipe.pipeline_);
+    vk::CmdBindDescriptorSets(m_commandBuffer->handle(), VK_PIPELINE_BIND_POINT_COMPUTE, pipe.pipeline_layout_.handle(), 0, 1,
+                              &pipe.descriptor_set_->set_, 0, nullptr);
+    vk::CmdDispatch(m_commandBuffer->handle(), 1, 1, 1);
+    m_commandBuffer->end();
+
+    // The error is only found if the pipeline was created from the instrumented shader, and is reported against the
+    // application's shader module
+    std::stringstream shader_module;
+    shader_module << std::hex << std::showbase << "Shader Module (" << CastToUint64(cs.handle()) << ")";
+    m_errorMonitor->SetDesiredFailureMsg(kErrorBit, shader_module.str().c_str());
+    m_commandBuffer->QueueCommandBuffer(true);
+    m_errorMonitor->VerifyFound();
+
+    // A shader module created right before the pipeline is instrumented by whichever thread gets to it first
+    m_errorMonitor->SetDesiredFailureMsg(kErrorBit, "Shader Module (");
+    CreateComputePipelineHelper late_pipe(*this);
+    late_pipe.InitInfo();
+    late_pipe.cs_.reset(new VkShaderObj(this, csSource, VK_SHADER_STAGE_COMPUTE_BIT));
+    late_pipe.dsl_bindings_[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    late_pipe.InitState();
+    ASSERT_VK_SUCCESS(late_pipe.CreateComputePipeline());
+    late_pipe.descriptor_set_->WriteDescriptorBufferInfo(0, buffer.handle(), 0, 4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+    late_pipe.descriptor_set_->UpdateDescriptorSets();
+
+    m_commandBuffer->begin();
+    vk::CmdBindPipeline(m_commandBuffer->handle(), VK_PIPELINE_BIND_POINT_COMPUTE, late_pipe.pipeline_);
+    vk::CmdBindDescriptorSets(m_commandBuffer->handle(), VK_PIPELINE_BIND_POINT_COMPUTE, late_pipe.pipeline_layout_.handle(), 0,
+                              1, &late_pipe.descriptor_set_->set_, 0, nullptr);
+    vk::CmdDispatch(m_commandBuffer->handle(), 1, 1, 1);
+    m_commandBuffer->end();
+    m_commandBuffer->QueueCommandBuffer(true);
+    m_errorMonitor->VerifyFound();
+}
+
+TEST_F(VkGpuAssistedLayerTest, GpuValidationDeferredInstrumentationDestroyQueued) {
+    TEST_DESCRIPTION(
+        "Destroy shader modules while they are queued for deferred instrumentation, and stop the background thread with their "
+        "instrumentation still queued.");
+    SetTargetApiVersion(VK_API_VERSION_1_1);
+    ScopedEnvironmentVariable deferred_instrumentation("VK_LAYER_GPUAV_DEFERRED_INSTRUMENTATION", "1");
+
+    InitGpuAssistedFramework(false);
+    if (IsPlatform(kMockICD) || DeviceSimulation()) {
+        GTEST_SKIP() << "Test not supported by MockICD, GPU-Assisted validation test requires a driver that can draw";
+    }
+    ASSERT_NO_FATAL_FAILURE(InitState());
+    ASSERT_NO_FATAL_FAILURE(InitRenderTarget());
+
+    const auto vs_spv = GLSLToSPV(VK_SHADER_STAGE_VERTEX_BIT, bindStateVertShaderText);
+    auto module_ci = LvlInitStruct<VkShaderModuleCreateInfo>();
+    module_ci.codeSize = vs_spv.size() * sizeof(decltype(vs_spv)::value_type);
+    module_ci.pCode = vs_spv.data();
+
+    // Most of these are destroyed before the background thread reaches them, the rest while it is instrumenting them
+    std::vector<VkShaderModule> modules(64, VK_NULL_HANDLE);
+    for (auto &module : modules) {
+        ASSERT_VK_SUCCESS(vk::CreateShaderModule(device(), &module_ci, nullptr, &module));
+    }
+    for (auto module : modules) {
+        vk::DestroyShaderModule(device(), module, nullptr);
+    }
+
+    // Shader modules created afterwards are still instrumented and used. The device is destroyed when the test ends, whether
+    // or not the background thread has reached the end of its queue.
+    CreatePipelineHelper pipe(*this);
+    pipe.InitInfo();
+    pipe.InitState();
+    ASSERT_VK_SUCCESS(pipe.CreateGraphicsPipeline());
+
+    m_commandBuffer->begin();
+    m_commandBuffer->BeginRenderPass(m_renderPassBeginInfo);
+    vk::CmdBindPipeline(m_commandBuffer->handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipe.pipeline_);
+    vk::CmdDraw(m_commandBuffer->handle(), 3, 1, 0, 0);
+    m_commandBuffer->EndRenderPass();
+    m_commandBuffer->end();
+    m_commandBuffer->QueueCommandBuffer(true);
+}
+
+TEST_F(VkGpuAssistedLayerTest, GpuValidationDeferredInstrumentationLibrary) {
+    TEST_DESCRIPTION("Create graphics pipeline libraries from shader modules queued for deferred instrumentation.");
+    SetTargetApiVersion(VK_API_VERSION_1_2);
+    AddRequiredExtensions(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+    ScopedEnvironmentVariable deferred_instrumentation("VK_LAYER_GPUAV_DEFERRED_INSTRUMENTATION", "1");
+
+    InitGpuAssistedFramework(false);
+    if (IsPlatform(kMockICD) || DeviceSimulation()) {
+        GTEST_SKIP() << "Test not supported by MockICD, GPU-Assisted validation test requires a driver that can draw";
+    }
+    if (DeviceValidationVersion() < VK_API_VERSION_1_2) {
+        GTEST_SKIP() << "At least Vulkan version 1.2 is required";
+    }
+    if (!AreRequiredExtensionsEnabled()) {
+        GTEST_SKIP() << RequiredExtensionsNotSupported() << " not supported";
+    }
+    auto gpl_features = LvlInitStruct<VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT>();
+    auto features2 = GetPhysicalDeviceFeatures2(gpl_features);
+    if (!gpl_features.graphicsPipelineLibrary) {
+        GTEST_SKIP() << "VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT::graphicsPipelineLibrary not supported";
+    }
+    ASSERT_NO_FATAL_FAILURE(InitState(nullptr, &features2));
+    ASSERT_NO_FATAL_FAILURE(InitRenderTarget());
+
+    VkShaderObj vs(this, bindStateVertShaderText, VK_SHADER_STAGE_VERTEX_BIT);
+    CreatePipelineHelper pre_raster_lib(*this);
+    pre_raster_lib.InitPreRasterLibInfo(1, &vs.GetStageCreateInfo());
+    pre_raster_lib.InitState();
+    ASSERT_VK_SUCCESS(pre_raster_lib.CreateGraphicsPipeline());
+
+    VkShaderObj fs(this, bindStateFragShaderText, VK_SHADER_STAGE_FRAGMENT_BIT);
+    CreatePipelineHelper frag_shader_lib(*this);
+    frag_shader_lib.InitFragmentLibInfo(1, &fs.GetStageCreateInfo());
+    frag_shader_lib.InitState();
+    ASSERT_VK_SUCCESS(frag_shader_lib.CreateGraphicsPipeline());
+
+    // The module is substituted again for every library created from it
+    CreatePipelineHelper second_pre_raster_lib(*this);
+    second_pre_raster_lib.InitPreRasterLibInfo(1, &vs.GetStageCreateInfo());
+    second_pre_raster_lib.InitState();
+    ASSERT_VK_SUCCESS(second_pre_raster_lib.CreateGraphicsPipeline());
+}
+
+// Keeps the text of every message in the order the layers reported it, from whichever thread reported it
+struct OrderedMessages {
+    std::mutex lock;
+    std::vector<std::string> messages;
+
+    size_t Find(const char *message) {
+        std::lock_guard<std::mutex> guard(lock);
+        for (size_t i = 0; i < messages.size(); ++i) {
+            if (messages[i].find(message) != std::string::npos) return i;
+        }
+        return messages.size();
+    }
+};
+
+static VKAPI_ATTR VkBool32 VKAPI_CALL OrderedMessagesCallback(VkDebugUtilsMessageSeverityFlagBitsEXT,
+                                                              VkDebugUtilsMessageTypeFlagsEXT,
+                                                              const VkDebugUtilsMessengerCallbackDataEXT *callback_data,
+                                                              void *user_data) {
+    auto *ordered_messages = reinterpret_cast<OrderedMessages *>(user_data);
+    std::lock_guard<std::mutex> guard(ordered_messages->lock);
+    ordered_messages->messages.emplace_back(callback_data->pMessage);
+    return VK_FALSE;
+}
+
+TEST_F(VkGpuAssistedLayerTest, GpuValidationAsyncResults) {
+    TEST_DESCRIPTION("Collect GPU-AV results without idling the queue and check they are reported in order when the app waits.");
+    SetTargetApiVersion(VK_API_VERSION_1_2);
+    AddRequiredExtensions(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+    ScopedEnvironmentVariable async_results("VK_LAYER_GPUAV_ASYNC_RESULTS", "1");
+
+    InitGpuAssistedFramework(false);
+    if (IsPlatform(kMockICD) || DeviceSimulation()) {
+        GTEST_SKIP() << "Test not supported by MockICD, GPU-Assisted validation test requires a driver that can draw";
+    }
+    if (DeviceValidationVersion() < VK_API_VERSION_1_2) {
+        GTEST_SKIP() << "At least Vulkan version 1.2 is required";
+    }
+    if (!AreRequiredExtensionsEnabled()) {
+        GTEST_SKIP() << RequiredExtensionsNotSupported() << " not supported";
+    }
+    auto timeline_semaphore_features = LvlInitStruct<VkPhysicalDeviceTimelineSemaphoreFeatures>();
+    auto features2 = GetPhysicalDeviceFeatures2(timeline_semaphore_features);
+    if (!timeline_semaphore_features.timelineSemaphore) {
+        GTEST_SKIP() << "Timeline semaphores not supported";
+    }
+    features2.features.robustBufferAccess = VK_FALSE;  // Make sure robust buffer access is not enabled
+    ASSERT_NO_FATAL_FAILURE(InitState(nullptr, &features2));
+
+    auto vkCreateDebugUtilsMessengerEXT = reinterpret_cast<PFN_vkCreateDebugUtilsMessengerEXT>(
+        vk::GetInstanceProcAddr(instance(), "vkCreateDebugUtilsMessengerEXT"));
+    auto vkDestroyDebugUtilsMessengerEXT = reinterpret_cast<PFN_vkDestroyDebugUtilsMessengerEXT>(
+        vk::GetInstanceProcAddr(instance(), "vkDestroyDebugUtilsMessengerEXT"));
+    ASSERT_TRUE(vkCreateDebugUtilsMessengerEXT && vkDestroyDebugUtilsMessengerEXT);
+    OrderedMessages ordered_messages;
+    auto messenger_create_info = LvlInitStruct<VkDebugUtilsMessengerCreateInfoEXT>();
+    messenger_create_info.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+    messenger_create_info.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT;
+    messenger_create_info.pfnUserCallback = OrderedMessagesCallback;
+    messenger_create_info.pUserData = &ordered_messages;
+    VkDebugUtilsMessengerEXT messenger = VK_NULL_HANDLE;
+    ASSERT_VK_SUCCESS(vkCreateDebugUtilsMessengerEXT(instance(), &messenger_create_info, nullptr, &messenger));
+
+    // Each shader writes past the end of a 4 byte descriptor through a different member, so their errors can be told apart
+    char const *cs_write_y = R"glsl(
+        #version 450
+        layout(local_size_x=1) in;
+        layout(set=0, binding=0) buffer foo { int x; int y; } bar;
+        void main(){
+           bar.y = bar.x;
+        }
+    )glsl";
+    char const *cs_write_z = R"glsl(
+        #version 450
+        layout(local_size_x=1) in;
+        layout(set=0, binding=0) buffer foo { int x; int y; int z; } bar;
+        void main(){
+           bar.z = bar.x;
+        }
+    )glsl";
+    const char *oob_y_message = "Descriptor size is 4 and highest byte accessed was 7";
+    const char *oob_z_message = "Descriptor size is 4 and highest byte accessed was 11";
+
+    VkBufferObj buffer;
+    VkMemoryPropertyFlags reqs = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    buffer.init_as_storage(*m_device, 4, reqs);
+
+    CreateComputePipelineHelper pipe_y(*this);
+    CreateComputePipelineHelper pipe_z(*this);
+    auto init_pipe = [&](CreateComputePipelineHelper &pipe, const char *cs_source) {
+        pipe.InitInfo();
+        pipe.cs_.reset(new VkShaderObj(this, cs_source, VK_SHADER_STAGE_COMPUTE_BIT));
+        pipe.dsl_bindings_[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        pipe.InitState();
+        pipe.descriptor_set_->WriteDescriptorBufferInfo(0, buffer.handle(), 0, 4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+        pipe.descriptor_set_->UpdateDescriptorSets();
+        return pipe.CreateComputePipeline();
+    };
+    ASSERT_VK_SUCCESS(init_pipe(pipe_y, cs_write_y));
+    ASSERT_VK_SUCCESS(init_pipe(pipe_z, cs_write_z));
+
+    auto record = [](VkCommandBufferObj &command_buffer, CreateComputePipelineHelper &pipe) {
+        auto begin_info = LvlInitStruct<VkCommandBufferBeginInfo>();
+        begin_info.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+        command_buffer.begin(&begin_info);
+        vk::CmdBindPipeline(command_buffer.handle(), VK_PIPELINE_BIND_POINT_COMPUTE, pipe.pipeline_);
+        vk::CmdBindDescriptorSets(command_buffer.handle(), VK_PIPELINE_BIND_POINT_COMPUTE, pipe.pipeline_layout_.handle(), 0,
+                                  1, &pipe.descriptor_set_->set_, 0, nullptr);
+        vk::CmdDispatch(command_buffer.handle(), 1, 1, 1);
+        command_buffer.end();
+    };
+    VkCommandBufferObj cb_z(m_device, m_commandPool);
+    record(*m_commandBuffer, pipe_y);
+    record(cb_z, pipe_z);
+
+    vk_testing::Fence fence(*m_device, LvlInitStruct<VkFenceCreateInfo>());
+    VkSubmitInfo submit_y = LvlInitStruct<VkSubmitInfo>();
+    submit_y.commandBufferCount = 1;
+    submit_y.pCommandBuffers = &m_commandBuffer->handle();
+    VkSubmitInfo submit_z = submit_y;
+    submit_z.pCommandBuffers = &cb_z.handle();
+
+    // Results for each submission are reported by the time the submit fence is waited on
+    for (uint32_t i = 0; i < 4; ++i) {
+        m_errorMonitor->SetDesiredFailureMsg(kErrorBit, oob_y_message);
+        vk::QueueSubmit(m_device->m_queue, 1, &submit_y, fence.handle());
+        vk::WaitForFences(device(), 1, &fence.handle(), VK_TRUE, UINT64_MAX);
+        m_errorMonitor->VerifyFound();
+        vk::ResetFences(device(), 1, &fence.handle());
+    }
+
+    // Results are processed in submission order, so waiting for the later submission also reports the earlier one, first
+    {
+        std::lock_guard<std::mutex> guard(ordered_messages.lock);
+        ordered_messages.messages.clear();
+    }
+    m_errorMonitor->SetDesiredFailureMsg(kErrorBit, oob_y_message);
+    m_errorMonitor->SetDesiredFailureMsg(kErrorBit, oob_z_message);
+    vk::QueueSubmit(m_device->m_queue, 1, &submit_y, VK_NULL_HANDLE);
+    vk::QueueSubmit(m_device->m_queue, 1, &submit_z, fence.handle());
+    vk::WaitForFences(device(), 1, &fence.handle(), VK_TRUE, UINT64_MAX);
+    m_errorMonitor->VerifyFound();
+    vk::ResetFences(device(), 1, &fence.handle());
+    const size_t y_index = ordered_messages.Find(oob_y_message);
+    const size_t z_index = ordered_messages.Find(oob_z_message);
+    ASSERT_LT(z_index, ordered_messages.messages.size());
+    ASSERT_LT(y_index, z_index);
+
+    // Without a fence, results are reported by the time the queue is idle
+    m_errorMonitor->SetDesiredFailureMsg(kErrorBit, oob_y_message);
+    vk::QueueSubmit(m_device->m_queue, 1, &submit_y, VK_NULL_HANDLE);
+    vk::QueueWaitIdle(m_device->m_queue);
+    m_errorMonitor->VerifyFound();
+
+    // Or by the time the device is idle, after which the command buffer can be re-recorded
+    m_errorMonitor->SetDesiredFailureMsg(kErrorBit, oob_y_message);
+    vk::QueueSubmit(m_device->m_queue, 1, &submit_y, VK_NULL_HANDLE);
+    vk::DeviceWaitIdle(device());
+    m_errorMonitor->VerifyFound();
+    record(*m_commandBuffer, pipe_y);
+
+    // While a submission of the simultaneous use command buffer is blocked on a timeline semaphore the application signals
+    // later, neither resubmitting it nor resetting an unrelated pool may wait for its results
+    auto semaphore_type_create_info = LvlInitStruct<VkSemaphoreTypeCreateInfo>();
+    semaphore_type_create_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    auto semaphore_create_info = LvlInitStruct<VkSemaphoreCreateInfo>(&semaphore_type_create_info);
+    vk_testing::Semaphore timeline(*m_device, semaphore_create_info);
+    const uint64_t wait_value = 1;
+    auto timeline_submit = LvlInitStruct<VkTimelineSemaphoreSubmitInfo>();
+    timeline_submit.waitSemaphoreValueCount = 1;
+    timeline_submit.pWaitSemaphoreValues = &wait_value;
+    const VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    VkSubmitInfo blocked_submit_y = submit_y;
+    blocked_submit_y.pNext = &timeline_submit;
+    blocked_submit_y.waitSemaphoreCount = 1;
+    blocked_submit_y.pWaitSemaphores = &timeline.handle();
+    blocked_submit_y.pWaitDstStageMask = &wait_stage;
+
+    VkCommandPoolObj other_pool(m_device, m_device->graphics_queue_node_index_);
+    VkCommandBufferObj other_cb(m_device, &other_pool);
+    other_cb.begin();
+    other_cb.end();
+
+    // Both executions write to the same debug buffer, whose record is reported once with the later submission
+    m_errorMonitor->SetDesiredFailureMsg(kErrorBit, oob_y_message);
+    m_errorMonitor->SetAllowedFailureMsg(oob_y_message);
+    vk::QueueSubmit(m_device->m_queue, 1, &blocked_submit_y, VK_NULL_HANDLE);
+    vk::QueueSubmit(m_device->m_queue, 1, &submit_y, fence.handle());
+    vk::ResetCommandPool(device(), other_pool.handle(), 0);
+    auto signal_info = LvlInitStruct<VkSemaphoreSignalInfo>();
+    signal_info.semaphore = timeline.handle();
+    signal_info.value = wait_value;
+    vk::SignalSemaphore(device(), &signal_info);
+    vk::WaitForFences(device(), 1, &fence.handle(), VK_TRUE, UINT64_MAX);
+    m_errorMonitor->VerifyFound();
+
+    // Leave a submission in flight, it is collected when the device is destroyed
+    m_errorMonitor->SetAllowedFailureMsg(oob_z_message);
+    vk::QueueSubmit(m_device->m_queue, 1, &submit_z, VK_NULL_HANDLE);
+    vkDestroyDebugUtilsMessengerEXT(instance(), messenger, nullptr);
+}
+
 TEST_F(VkGpuAssistedLayerTest, GpuBufferDeviceAddressOOB) {
     SetTargetApiVersion(VK_API_VERSION_1_2);
     bool supported = InstanceExtensionSupported(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
@@ -2790,6 +3222,173 @@ TEST_F(VkDebugPrintfTest, GpuDebugPrintf) {
         m_errorMonitor->VerifyFound();
     }
 }
+TEST_F(VkDebugPrintfTest, GpuDebugPrintfAggregate) {
+    TEST_DESCRIPTION("Verify that identical debugPrintfEXT messages from a dispatch are reported once with their count.");
+    SetTargetApiVersion(VK_API_VERSION_1_1);
+    AddRequiredExtensions(VK_KHR_SHADER_NON_SEMANTIC_INFO_EXTENSION_NAME);
+    ScopedEnvironmentVariable aggregate("VK_LAYER_PRINTF_AGGREGATE", "1");
+    InitDebugPrintfFramework();
+
+    if (IsPlatform(kMockICD) || DeviceSimulation()) {
+        GTEST_SKIP() << "Test not supported by MockICD, GPU-Assisted validation test requires a driver that can draw";
+    }
+    if (!AreRequiredExtensionsEnabled()) {
+        GTEST_SKIP() << RequiredExtensionsNotSupported() << " not supported";
+    }
+    ASSERT_NO_FATAL_FAILURE(InitState());
+    if (DeviceValidationVersion() < VK_API_VERSION_1_1) {
+        GTEST_SKIP() << "At least Vulkan version 1.1 is required";
+    }
+
+    char const *csSource = R"glsl(
+        #version 450
+        #extension GL_EXT_debug_printf : enable
+        layout(local_size_x = 64) in;
+        void main() {
+            debugPrintfEXT("Invocation group %d", gl_LocalInvocationIndex / 32);
+        }
+    )glsl";
+
+    CreateComputePipelineHelper pipe(*this);
+    pipe.InitInfo();
+    pipe.cs_.reset(new VkShaderObj(this, csSource, VK_SHADER_STAGE_COMPUTE_BIT));
+    pipe.InitState();
+    ASSERT_VK_SUCCESS(pipe.CreateComputePipeline());
+
+    m_commandBuffer->begin();
+    vk::CmdBindPipeline(m_commandBuffer->handle(), VK_PIPELINE_BIND_POINT_COMPUTE, pipe.pipeline_);
+    vk::CmdDispatch(m_commandBuffer->handle(), 1, 1, 1);
+    m_commandBuffer->end();
+
+    m_errorMonitor->SetDesiredFailureMsg(kInformationBit, "[32 identical messages] Invocation group 0");
+    m_errorMonitor->SetDesiredFailureMsg(kInformationBit, "[32 identical messages] Invocation group 1");
+    m_commandBuffer->QueueCommandBuffer();
+    ASSERT_VK_SUCCESS(vk::QueueWaitIdle(m_device->m_queue));
+    m_errorMonitor->VerifyFound();
+}
+
+// Reads a whole file, or returns an empty vector if it can't be opened
+static std::vector<uint8_t> ReadDebugPrintfFile(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+template <typename T>
+static T ReadDebugPrintfWord(const std::vector<uint8_t> &data, size_t offset) {
+    T value = 0;
+    if (offset + sizeof(T) <= data.size()) memcpy(&value, data.data() + offset, sizeof(T));
+    return value;
+}
+
+TEST_F(VkDebugPrintfTest, GpuDebugPrintfBinaryFile) {
+    TEST_DESCRIPTION("Write more debugPrintfEXT records than fit the binary output ring, and decode the newest ones back.");
+    SetTargetApiVersion(VK_API_VERSION_1_1);
+    AddRequiredExtensions(VK_KHR_SHADER_NON_SEMANTIC_INFO_EXTENSION_NAME);
+    const std::string path = "debug_printf_binary_file_test.bin";
+    // Room for about 28 of the 36 byte records, so the 64 records below wrap the ring twice
+    constexpr uint64_t kCapacity = 1024;
+    ScopedEnvironmentVariable binary_file("VK_LAYER_PRINTF_BINARY_FILE", path.c_str());
+    ScopedEnvironmentVariable binary_file_size("VK_LAYER_PRINTF_BINARY_FILE_SIZE", "1024");
+    InitDebugPrintfFramework();
+
+    if (IsPlatform(kMockICD) || DeviceSimulation()) {
+        GTEST_SKIP() << "Test not supported by MockICD, GPU-Assisted validation test requires a driver that can draw";
+    }
+    if (!AreRequiredExtensionsEnabled()) {
+        GTEST_SKIP() << RequiredExtensionsNotSupported() << " not supported";
+    }
+    ASSERT_NO_FATAL_FAILURE(InitState());
+    if (DeviceValidationVersion() < VK_API_VERSION_1_1) {
+        GTEST_SKIP() << "At least Vulkan version 1.1 is required";
+    }
+
+    char const *csSource = R"glsl(
+        #version 450
+        #extension GL_EXT_debug_printf : enable
+        layout(local_size_x = 64) in;
+        void main() {
+            debugPrintfEXT("Invocation %u", gl_LocalInvocationIndex);
+        }
+    )glsl";
+
+    CreateComputePipelineHelper pipe(*this);
+    pipe.InitInfo();
+    pipe.cs_.reset(new VkShaderObj(this, csSource, VK_SHADER_STAGE_COMPUTE_BIT));
+    pipe.InitState();
+    ASSERT_VK_SUCCESS(pipe.CreateComputePipeline());
+
+    m_commandBuffer->begin();
+    vk::CmdBindPipeline(m_commandBuffer->handle(), VK_PIPELINE_BIND_POINT_COMPUTE, pipe.pipeline_);
+    vk::CmdDispatch(m_commandBuffer->handle(), 1, 1, 1);
+    m_commandBuffer->end();
+    m_commandBuffer->QueueCommandBuffer();
+    ASSERT_VK_SUCCESS(vk::QueueWaitIdle(m_device->m_queue));
+
+    // DPFBinaryFileHeader: magic, version, header_size, capacity, begin_offset, end_offset, dropped_records
+    const std::vector<uint8_t> ring = ReadDebugPrintfFile(path);
+    ASSERT_GE(ring.size(), 48u);
+    ASSERT_EQ(std::string(reinterpret_cast<const char *>(ring.data()), 8), "VKDPFRNG");
+    const uint32_t header_size = ReadDebugPrintfWord<uint32_t>(ring, 12);
+    const uint64_t capacity = ReadDebugPrintfWord<uint64_t>(ring, 16);
+    const uint64_t begin = ReadDebugPrintfWord<uint64_t>(ring, 24);
+    const uint64_t end = ReadDebugPrintfWord<uint64_t>(ring, 32);
+    ASSERT_EQ(capacity, kCapacity);
+    ASSERT_EQ(ring.size(), header_size + capacity);
+    EXPECT_EQ(ReadDebugPrintfWord<uint64_t>(ring, 40), 0u);
+    EXPECT_GT(begin, 0u);
+    EXPECT_GE(end, 64u * 36u);
+    ASSERT_LE(end - begin, capacity);
+
+    // Walk the records from the oldest one left, skipping the padding at the end of each lap
+    std::vector<uint32_t> invocations;
+    uint32_t format_string_id = 0;
+    for (uint64_t offset = begin; offset < end;) {
+        const uint64_t position = offset % capacity;
+        const uint64_t remaining = capacity - position;
+        if (remaining < 8) {
+            offset += remaining;
+            continue;
+        }
+        const size_t record = static_cast<size_t>(header_size + position);
+        const uint32_t size = ReadDebugPrintfWord<uint32_t>(ring, record);
+        const uint32_t count = ReadDebugPrintfWord<uint32_t>(ring, record + 4);
+        ASSERT_GT(size, 0u) << "at offset " << offset;
+        if (count != 0) {
+            // DPFBinaryRecord: size, count, shader_id, format_string_id, stage, stage_word_1..3, then the values
+            EXPECT_EQ(size, 36u);
+            EXPECT_EQ(count, 1u);
+            format_string_id = ReadDebugPrintfWord<uint32_t>(ring, record + 12);
+            invocations.push_back(ReadDebugPrintfWord<uint32_t>(ring, record + 32));
+        }
+        offset += size;
+    }
+    EXPECT_GE(invocations.size(), capacity / 36 - 1);
+    std::sort(invocations.begin(), invocations.end());
+    EXPECT_TRUE(std::unique(invocations.begin(), invocations.end()) == invocations.end());
+    EXPECT_LT(invocations.back(), 64u);
+
+    // The format string is written once, split into the text before the value and the value itself
+    const std::vector<uint8_t> formats = ReadDebugPrintfFile(path + ".formats");
+    ASSERT_GE(formats.size(), 24u);
+    ASSERT_EQ(std::string(reinterpret_cast<const char *>(formats.data()), 8), "VKDPFFMT");
+    EXPECT_EQ(ReadDebugPrintfWord<uint32_t>(formats, 16), format_string_id);
+    const uint32_t substring_count = ReadDebugPrintfWord<uint32_t>(formats, 20);
+    std::string format_string;
+    size_t offset = 24;
+    for (uint32_t i = 0; i < substring_count; ++i) {
+        const uint32_t length = ReadDebugPrintfWord<uint32_t>(formats, offset + 8);
+        ASSERT_LE(offset + 12 + length, formats.size());
+        format_string.append(reinterpret_cast<const char *>(formats.data()) + offset + 12, length);
+        offset += 12 + ((length + 3) & ~3u);
+    }
+    EXPECT_EQ(format_string, "Invocation %u");
+    EXPECT_EQ(offset, formats.size());
+
+    std::remove(path.c_str());
+    std::remove((path + ".formats").c_str());
+}
+
+
 TEST_F(VkDebugPrintfTest, MeshTaskShadersPrintf) {
     TEST_DESCRIPTION("Test debug printf in mesh and task shaders.");
 
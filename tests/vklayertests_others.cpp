@@ -26,9 +26,18 @@
  * Author: Tobias Hector <tobias.hector@amd.com>
  */
 
+#include <array>
+#include <atomic>
+#include <new>
+#include <set>
+#include <thread>
+#include <tuple>
+
 #include "cast_utils.h"
 #include "layer_validation_tests.h"
 #include "core_validation_error_enums.h"
+#include "vk_layer_utils.h"
+#include "range_vector.h"
 
 class MessageIdFilter {
   public:
@@ -2115,6 +2124,57 @@ TEST_F(VkLayerTest, ValidationCacheTestBadMerge) {
     fpDestroyValidationCache(m_device->device(), validationCache, nullptr);
 }
 
+static VKAPI_ATTR VkBool32 VKAPI_CALL CountCacheWriteErrorsCallback(VkDebugUtilsMessageSeverityFlagBitsEXT,
+                                                                    VkDebugUtilsMessageTypeFlagsEXT,
+                                                                    const VkDebugUtilsMessengerCallbackDataEXT *callback_data,
+                                                                    void *user_data) {
+    if (callback_data->pMessageIdName && std::string(callback_data->pMessageIdName) == "UNASSIGNED-cache-write-error") {
+        ++*reinterpret_cast<std::atomic<uint32_t> *>(user_data);
+    }
+    return VK_FALSE;
+}
+
+TEST_F(VkLayerTest, ValidationCacheSaveFailure) {
+    TEST_DESCRIPTION("Check that a shader validation cache that can't be written is retried once per save interval.");
+    AddRequiredExtensions(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+    ScopedEnvironmentVariable cache_dir("VK_LAYER_SHADER_VALIDATION_CACHE_DIR", "/nonexistent/shader/validation/cache/dir");
+    ASSERT_NO_FATAL_FAILURE(InitFramework(m_errorMonitor));
+    if (!AreRequiredExtensionsEnabled()) {
+        GTEST_SKIP() << RequiredExtensionsNotSupported() << " not supported";
+    }
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    auto vkCreateDebugUtilsMessengerEXT = reinterpret_cast<PFN_vkCreateDebugUtilsMessengerEXT>(
+        vk::GetInstanceProcAddr(instance(), "vkCreateDebugUtilsMessengerEXT"));
+    auto vkDestroyDebugUtilsMessengerEXT = reinterpret_cast<PFN_vkDestroyDebugUtilsMessengerEXT>(
+        vk::GetInstanceProcAddr(instance(), "vkDestroyDebugUtilsMessengerEXT"));
+    ASSERT_TRUE(vkCreateDebugUtilsMessengerEXT && vkDestroyDebugUtilsMessengerEXT);
+    std::atomic<uint32_t> write_errors{0};
+    auto messenger_create_info = LvlInitStruct<VkDebugUtilsMessengerCreateInfoEXT>();
+    messenger_create_info.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT;
+    messenger_create_info.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT;
+    messenger_create_info.pfnUserCallback = CountCacheWriteErrorsCallback;
+    messenger_create_info.pUserData = &write_errors;
+    VkDebugUtilsMessengerEXT messenger = VK_NULL_HANDLE;
+    ASSERT_VK_SUCCESS(vkCreateDebugUtilsMessengerEXT(instance(), &messenger_create_info, nullptr, &messenger));
+
+    // Each module gets a larger id bound, which keeps it valid but gives it a cache entry of its own. The cache is saved every
+    // 1024 new entries, so creating 2500 modules tries to save it twice.
+    auto spv = GLSLToSPV(VK_SHADER_STAGE_COMPUTE_BIT, bindStateMinimalShaderText);
+    const uint32_t bound = spv[3];
+    auto module_ci = LvlInitStruct<VkShaderModuleCreateInfo>();
+    module_ci.codeSize = spv.size() * sizeof(decltype(spv)::value_type);
+    module_ci.pCode = spv.data();
+    for (uint32_t i = 0; i < 2500; ++i) {
+        spv[3] = bound + i;
+        VkShaderModule module = VK_NULL_HANDLE;
+        ASSERT_VK_SUCCESS(vk::CreateShaderModule(device(), &module_ci, nullptr, &module));
+        vk::DestroyShaderModule(device(), module, nullptr);
+    }
+    vkDestroyDebugUtilsMessengerEXT(instance(), messenger, nullptr);
+    ASSERT_EQ(write_errors.load(), 2u);
+}
+
 TEST_F(VkLayerTest, InvalidQueueFamilyIndex) {
     // Miscellaneous queueFamilyIndex validation tests
     bool get_physical_device_properties2 = InstanceExtensionSupported(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
@@ -13608,3 +13668,464 @@ TEST_F(VkLayerTest, ExportMetalObjects) {
     }
 }
 #endif  // VK_USE_PLATFORM_METAL_EXT
+
+TEST_F(VkLayerTest, SlabMapOverflow) {
+    TEST_DESCRIPTION("Entries past the slab map's slot limit go to its overflow map, and both kinds of ids behave the same.");
+    constexpr uint32_t kMaxSlots = 4;
+    constexpr uint64_t kEntryCount = 12;
+    vl_concurrent_slab_map map(kMaxSlots);
+
+    std::vector<uint64_t> ids;
+    for (uint64_t value = 0; value < kEntryCount; ++value) {
+        ids.push_back(map.insert(value + 100));
+    }
+    ASSERT_EQ(map.size(), kEntryCount);
+    std::set<uint64_t> unique_ids(ids.begin(), ids.end());
+    EXPECT_EQ(unique_ids.size(), kEntryCount);
+    for (uint64_t value = 0; value < kEntryCount; ++value) {
+        const auto found = map.find(ids[value]);
+        ASSERT_TRUE(found != map.end());
+        EXPECT_EQ(found->second, value + 100);
+    }
+
+    // Erase one slab and one overflow entry. Their ids are no longer found, and can't be erased twice.
+    const uint64_t slab_id = ids[1];
+    const uint64_t overflow_id = ids[kMaxSlots + 1];
+    EXPECT_EQ(map.pop(slab_id)->second, 101u);
+    EXPECT_EQ(map.erase(overflow_id), 1u);
+    EXPECT_FALSE(map.contains(slab_id));
+    EXPECT_FALSE(map.contains(overflow_id));
+    EXPECT_EQ(map.erase(slab_id), 0u);
+    EXPECT_EQ(map.erase(overflow_id), 0u);
+    EXPECT_EQ(map.size(), kEntryCount - 2);
+
+    // The freed slot is reused under a new id, while the stale ids stay invalid
+    const uint64_t reused_id = map.insert(200);
+    const uint64_t next_overflow_id = map.insert(201);
+    EXPECT_NE(reused_id, slab_id);
+    EXPECT_EQ(map.find(reused_id)->second, 200u);
+    EXPECT_EQ(map.find(next_overflow_id)->second, 201u);
+    EXPECT_FALSE(map.contains(slab_id));
+    EXPECT_FALSE(map.contains(overflow_id));
+    EXPECT_EQ(map.size(), kEntryCount);
+
+    for (uint64_t id : {ids[0], ids[2], ids[3], ids[kMaxSlots], reused_id, next_overflow_id}) {
+        EXPECT_EQ(map.erase(id), 1u);
+    }
+    EXPECT_EQ(map.size(), kEntryCount - 6);
+}
+
+// Look up entries of a handle -> shared state map from several threads, while one more thread keeps inserting and erasing
+// other entries. Stable entries must always be found with their value, churned entries either missing or intact.
+template <typename Map>
+static void CheckConcurrentMapLookups(uint32_t thread_count, uint32_t lookups_per_thread) {
+    constexpr uint64_t kEntryCount = 1024;
+    constexpr uint64_t kChurnCount = 64;
+    Map map;
+    for (uint64_t key = 1; key <= kEntryCount; ++key) {
+        map.insert(key, std::make_shared<uint64_t>(key));
+    }
+
+    std::atomic<bool> done{false};
+    std::thread writer([&map, &done]() {
+        for (uint64_t i = 0; !done.load(); ++i) {
+            const uint64_t key = kEntryCount + 1 + (i % kChurnCount);
+            map.insert(key, std::make_shared<uint64_t>(key));
+            if (i % 3 != 0) map.erase(key);
+        }
+    });
+
+    std::atomic<uint64_t> found{0};
+    std::atomic<uint64_t> mismatched{0};
+    std::vector<std::thread> readers;
+    for (uint32_t t = 0; t < thread_count; ++t) {
+        readers.emplace_back([&map, &found, &mismatched, t, lookups_per_thread]() {
+            uint64_t local_found = 0;
+            uint64_t local_mismatched = 0;
+            for (uint32_t i = 0; i < lookups_per_thread; ++i) {
+                const uint64_t key = 1 + ((i * 7919u + t * 104729u) % kEntryCount);
+                const uint64_t *value = map.find_borrowed(key);
+                if (value) {
+                    ++local_found;
+                    if (*value != key) ++local_mismatched;
+                }
+                const auto churned = map.find(kEntryCount + 1 + (i % kChurnCount));
+                if (churned != map.end() && *churned->second != kEntryCount + 1 + (i % kChurnCount)) ++local_mismatched;
+            }
+            found += local_found;
+            mismatched += local_mismatched;
+        });
+    }
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    done = true;
+    writer.join();
+    EXPECT_EQ(found.load(), uint64_t(thread_count) * lookups_per_thread);
+    EXPECT_EQ(mismatched.load(), 0u);
+    for (uint64_t key = 1; key <= kEntryCount; ++key) {
+        ASSERT_TRUE(map.contains(key));
+    }
+}
+
+TEST_F(VkLayerTest, ConcurrentReadMostlyMapLookups) {
+    TEST_DESCRIPTION("Look up entries of the read-mostly and bucketed concurrent maps from 1 to 16 reader threads during writes.");
+    using BucketedMap = vl_concurrent_unordered_map<uint64_t, std::shared_ptr<uint64_t>, 2>;
+    using ReadMostlyMap = vl_concurrent_read_mostly_map<uint64_t, std::shared_ptr<uint64_t>, 2>;
+    constexpr uint32_t kLookupsPerThread = 20000;
+
+    for (uint32_t thread_count = 1; thread_count <= 16; thread_count *= 4) {
+        CheckConcurrentMapLookups<BucketedMap>(thread_count, kLookupsPerThread);
+        CheckConcurrentMapLookups<ReadMostlyMap>(thread_count, kLookupsPerThread);
+    }
+}
+
+// Stands in for an access state, which is copied whenever its range is split
+struct RangeMapReplayValue {
+    uint64_t tag;
+    uint64_t payload[11];
+};
+
+using RangeMapReplayRange = sparse_container::range<VkDeviceSize>;
+using RangeMapReplayTree = std::map<RangeMapReplayRange, RangeMapReplayValue>;
+using RangeMapReplayFlat = sparse_container::flat_range_map<VkDeviceSize, RangeMapReplayValue>;
+using RangeMapReplayTreeMap =
+    sparse_container::range_map<VkDeviceSize, RangeMapReplayValue, RangeMapReplayRange, RangeMapReplayTree>;
+using RangeMapReplayFlatMap =
+    sparse_container::range_map<VkDeviceSize, RangeMapReplayValue, RangeMapReplayRange, RangeMapReplayFlat>;
+
+// The (begin, end, tag) entries of a replayed range map, in order
+template <typename Map>
+static std::vector<std::tuple<VkDeviceSize, VkDeviceSize, uint64_t>> RangeMapReplayEntries(const Map &map) {
+    std::vector<std::tuple<VkDeviceSize, VkDeviceSize, uint64_t>> entries;
+    for (const auto &entry : map) {
+        entries.emplace_back(entry.first.begin, entry.first.end, entry.second.tag);
+    }
+    return entries;
+}
+
+// Replay the access pattern of range_count resource regions, range_size bytes each and stride bytes apart, being recorded
+// and then partially overwritten and walked by later commands, as the sync val access maps see them. Both backends must
+// hold the same entries, and visit the same entries, at every step.
+static void ReplayRangeMapAccesses(uint64_t range_size, uint64_t stride, uint32_t range_count) {
+    using Range = RangeMapReplayRange;
+    constexpr uint32_t kOpCount = 10000;
+    RangeMapReplayValue value = {};
+    RangeMapReplayTreeMap tree;
+    RangeMapReplayFlatMap flat;
+
+    for (uint32_t i = 0; i < range_count; ++i) {
+        value.tag = i;
+        tree.overwrite_range(std::make_pair(Range(i * stride, i * stride + range_size), value));
+        flat.overwrite_range(std::make_pair(Range(i * stride, i * stride + range_size), value));
+    }
+    ASSERT_EQ(flat.size(), range_count);
+    ASSERT_EQ(RangeMapReplayEntries(flat), RangeMapReplayEntries(tree));
+    EXPECT_GE(flat.get_implementation_map().allocated_bytes(), range_count * sizeof(RangeMapReplayValue));
+
+    const uint64_t extent = range_count * stride;
+    uint64_t seed = 1;
+    auto next_random = [&seed](uint64_t limit) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (seed >> 33) % limit;
+    };
+    for (uint32_t i = 0; i < kOpCount; ++i) {
+        const uint64_t begin = next_random(extent);
+        const Range range(begin, begin + 1 + next_random(stride * 4));
+        value.tag = range_count + i;
+        tree.overwrite_range(std::make_pair(range, value));
+        flat.overwrite_range(std::make_pair(range, value));
+        if (i % 1000 == 999) {
+            ASSERT_EQ(RangeMapReplayEntries(flat), RangeMapReplayEntries(tree)) << "after " << i + 1 << " overwrites";
+        }
+    }
+
+    for (uint32_t i = 0; i < kOpCount; ++i) {
+        const uint64_t begin = next_random(extent);
+        const Range range(begin, begin + 1 + next_random(stride * 16));
+        std::vector<uint64_t> tree_tags;
+        std::vector<uint64_t> flat_tags;
+        const RangeMapReplayTreeMap &const_tree = tree;
+        for (auto pos = const_tree.lower_bound(range); (pos != const_tree.cend()) && (pos->first.begin < range.end); ++pos) {
+            tree_tags.push_back(pos->second.tag);
+        }
+        const RangeMapReplayFlatMap &const_flat = flat;
+        for (auto pos = const_flat.lower_bound(range); (pos != const_flat.cend()) && (pos->first.begin < range.end); ++pos) {
+            flat_tags.push_back(pos->second.tag);
+        }
+        ASSERT_EQ(flat_tags, tree_tags) << "walking [" << range.begin << ", " << range.end << ")";
+    }
+}
+
+TEST_F(VkLayerTest, RangeMapBackendReplay) {
+    TEST_DESCRIPTION("Replay buffer and image like access patterns through the std::map and flat range map backends.");
+
+    for (uint32_t range_count = 100; range_count <= 10000; range_count *= 10) {
+        // Buffer regions, 48 of every 64 bytes
+        ReplayRangeMapAccesses(48, 64, range_count);
+        // Image rows, 1024 of every 4096 bytes
+        ReplayRangeMapAccesses(1024, 4096, range_count);
+    }
+}
+
+// The (begin, end, value) entries of a range map, in order
+template <typename Map>
+static std::vector<std::tuple<VkDeviceSize, VkDeviceSize, uint64_t>> RangeMapEntries(const Map &map) {
+    std::vector<std::tuple<VkDeviceSize, VkDeviceSize, uint64_t>> entries;
+    for (const auto &entry : map) {
+        entries.emplace_back(entry.first.begin, entry.first.end, entry.second);
+    }
+    return entries;
+}
+
+TEST_F(VkLayerTest, RangeMapShareCopyOnWrite) {
+    TEST_DESCRIPTION("Writes to a flat range map sharing the entries of another must not show up in the other, and vice versa.");
+    using Range = sparse_container::range<VkDeviceSize>;
+    using FlatMap =
+        sparse_container::range_map<VkDeviceSize, uint64_t, Range, sparse_container::flat_range_map<VkDeviceSize, uint64_t>>;
+    using Entries = std::vector<std::tuple<VkDeviceSize, VkDeviceSize, uint64_t>>;
+
+    std::unique_ptr<FlatMap> batch_a(new FlatMap);
+    batch_a->overwrite_range(std::make_pair(Range(0, 10), uint64_t(1)));
+    batch_a->overwrite_range(std::make_pair(Range(10, 20), uint64_t(2)));
+    batch_a->overwrite_range(std::make_pair(Range(20, 30), uint64_t(3)));
+    const Entries a_entries = RangeMapEntries(*batch_a);
+
+    // Splitting, overwriting, erasing and writing through an iterator copy the shared entries of the writer only
+    FlatMap batch_b;
+    batch_b.share(*batch_a);
+    EXPECT_EQ(RangeMapEntries(batch_b), a_entries);
+    batch_b.overwrite_range(std::make_pair(Range(5, 15), uint64_t(7)));
+    batch_b.erase_range(Range(25, 30));
+    batch_b.find(VkDeviceSize(20))->second = 9;
+    const Entries b_entries = {Entries::value_type(0, 5, 1), Entries::value_type(5, 15, 7), Entries::value_type(15, 20, 2),
+                               Entries::value_type(20, 25, 9)};
+    EXPECT_EQ(RangeMapEntries(batch_b), b_entries);
+    EXPECT_EQ(RangeMapEntries(*batch_a), a_entries);
+
+    // The map shared from can be written, and destroyed, while the entries are still shared
+    FlatMap batch_c;
+    batch_c.share(*batch_a);
+    batch_a->find(VkDeviceSize(0))->second = 4;
+    batch_a->overwrite_range(std::make_pair(Range(10, 30), uint64_t(5)));
+    EXPECT_EQ(RangeMapEntries(batch_c), a_entries);
+    batch_a.reset();
+    EXPECT_EQ(RangeMapEntries(batch_c), a_entries);
+    EXPECT_EQ(RangeMapEntries(batch_b), b_entries);
+}
+
+// Counts the live copies of a deferred op closure
+struct DeferredOpCounted {
+    explicit DeferredOpCounted(int *live_count) : live(live_count) { ++*live; }
+    DeferredOpCounted(const DeferredOpCounted &other) : live(other.live) { ++*live; }
+    ~DeferredOpCounted() { --*live; }
+    int *live;
+};
+
+// Records op_count ops to stream, each appending its index to the vector it is invoked with. Every seventh op carries a
+// closure larger than a stream block.
+using DeferredOpTestStream = layer_data::DeferredOpStream<bool(std::vector<uint32_t> &)>;
+static void RecordDeferredOps(DeferredOpTestStream &stream, uint32_t first, uint32_t op_count) {
+    for (uint32_t i = first; i < first + op_count; ++i) {
+        if (i % 7 == 0) {
+            std::array<uint32_t, 2048> large = {};
+            large.back() = i;
+            stream.emplace_back([large](std::vector<uint32_t> &order) {
+                order.push_back(large.back());
+                return true;
+            });
+        } else {
+            stream.emplace_back([i](std::vector<uint32_t> &order) {
+                order.push_back(i);
+                return true;
+            });
+        }
+    }
+}
+
+static std::vector<uint32_t> InvokeDeferredOps(const DeferredOpTestStream &stream) {
+    std::vector<uint32_t> order;
+    for (const auto &op : stream) {
+        EXPECT_TRUE(op(order));
+    }
+    return order;
+}
+
+static std::vector<uint32_t> DeferredOpSequence(uint32_t first, uint32_t op_count) {
+    std::vector<uint32_t> sequence(op_count);
+    for (uint32_t i = 0; i < op_count; ++i) sequence[i] = first + i;
+    return sequence;
+}
+
+TEST_F(VkLayerTest, DeferredOpStreamOrder) {
+    TEST_DESCRIPTION("Ops recorded to a deferred op stream run in order across its blocks, including ops larger than a block.");
+    DeferredOpTestStream stream;
+    EXPECT_TRUE(stream.empty());
+    RecordDeferredOps(stream, 0, 1000);
+    EXPECT_EQ(stream.size(), 1000u);
+    EXPECT_EQ(InvokeDeferredOps(stream), DeferredOpSequence(0, 1000));
+
+    // Re-recording reuses the blocks, which now hold the ops at different offsets
+    stream.clear();
+    EXPECT_TRUE(stream.empty());
+    EXPECT_TRUE(InvokeDeferredOps(stream).empty());
+    RecordDeferredOps(stream, 3, 1500);
+    EXPECT_EQ(stream.size(), 1500u);
+    EXPECT_EQ(InvokeDeferredOps(stream), DeferredOpSequence(3, 1500));
+
+    // append copies the ops of the other stream after the existing ones, and leaves the other stream as it was
+    DeferredOpTestStream other;
+    RecordDeferredOps(other, 1503, 500);
+    stream.append(other);
+    EXPECT_EQ(stream.size(), 2000u);
+    EXPECT_EQ(InvokeDeferredOps(stream), DeferredOpSequence(3, 2000));
+    EXPECT_EQ(InvokeDeferredOps(other), DeferredOpSequence(1503, 500));
+
+    DeferredOpTestStream copy(stream);
+    EXPECT_EQ(InvokeDeferredOps(copy), DeferredOpSequence(3, 2000));
+    DeferredOpTestStream moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(InvokeDeferredOps(moved), DeferredOpSequence(3, 2000));
+}
+
+TEST_F(VkLayerTest, DeferredOpStreamDestroysOps) {
+    TEST_DESCRIPTION("Each closure in a deferred op stream is destroyed exactly once, on clear or with the stream.");
+    int live = 0;
+    {
+        layer_data::DeferredOpStream<bool()> stream;
+        for (uint32_t i = 0; i < 1000; ++i) {
+            DeferredOpCounted counted(&live);
+            stream.emplace_back([counted]() { return counted.live != nullptr; });
+        }
+        EXPECT_EQ(live, 1000);
+        stream.clear();
+        EXPECT_EQ(live, 0);
+
+        for (uint32_t i = 0; i < 300; ++i) {
+            DeferredOpCounted counted(&live);
+            stream.emplace_back([counted]() { return counted.live != nullptr; });
+        }
+        layer_data::DeferredOpStream<bool()> other;
+        other.append(stream);
+        other.append(stream);
+        EXPECT_EQ(live, 900);
+        other = stream;
+        EXPECT_EQ(live, 600);
+        layer_data::DeferredOpStream<bool()> moved(std::move(other));
+        EXPECT_EQ(live, 600);
+        for (const auto &op : moved) {
+            EXPECT_TRUE(op());
+        }
+    }
+    EXPECT_EQ(live, 0);
+}
+
+// Replaces the global operator new of the test executable, to count the allocations of the thread counting is enabled on
+static thread_local bool deferred_op_count_allocations = false;
+static thread_local size_t deferred_op_allocation_count = 0;
+
+void *operator new(size_t size) {
+    if (deferred_op_count_allocations) ++deferred_op_allocation_count;
+    void *p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+// Stands in for the query a command buffer ends, as captured by its deferred query updates
+struct DeferredOpQuery {
+    uint64_t pool;
+    uint32_t query;
+    uint32_t perf_pass;
+    uint64_t end_command_index;
+};
+
+TEST_F(VkLayerTest, DeferredOpStreamReuseDoesNotAllocate) {
+    TEST_DESCRIPTION("Re-recording as many query updates to a deferred op stream as before must not allocate.");
+    layer_data::DeferredOpStream<bool(uint32_t perf_pass, std::vector<DeferredOpQuery> &ended_queries)> stream;
+    auto record = [&stream]() {
+        for (uint32_t i = 0; i < 10000; ++i) {
+            const DeferredOpQuery query = {1, i, 0, i};
+            stream.emplace_back([query](uint32_t perf_pass, std::vector<DeferredOpQuery> &ended_queries) {
+                ended_queries.push_back(query);
+                ended_queries.back().perf_pass = perf_pass;
+                return false;
+            });
+        }
+    };
+    record();
+    stream.clear();
+
+    deferred_op_allocation_count = 0;
+    deferred_op_count_allocations = true;
+    record();
+    deferred_op_count_allocations = false;
+    EXPECT_EQ(deferred_op_allocation_count, 0u);
+    EXPECT_EQ(stream.size(), 10000u);
+
+    std::vector<DeferredOpQuery> ended_queries;
+    for (const auto &op : stream) {
+        EXPECT_FALSE(op(0, ended_queries));
+    }
+    ASSERT_EQ(ended_queries.size(), 10000u);
+    EXPECT_EQ(ended_queries.back().query, 9999u);
+}
+
+TEST_F(VkLayerTest, DescriptorRepeatedUpdateAndDraw) {
+    TEST_DESCRIPTION("Validate many descriptor updates and draws of a bound combined image sampler, then destroy the sampler.");
+
+    ASSERT_NO_FATAL_FAILURE(Init());
+    ASSERT_NO_FATAL_FAILURE(InitRenderTarget());
+    constexpr uint32_t kUpdateCount = 1000;
+    constexpr uint32_t kDrawCount = 1000;
+
+    VkSamplerCreateInfo sampler_ci = SafeSaneSamplerCreateInfo();
+    VkSampler sampler = VK_NULL_HANDLE;
+    ASSERT_VK_SUCCESS(vk::CreateSampler(m_device->device(), &sampler_ci, nullptr, &sampler));
+
+    VkImageObj image(m_device);
+    image.Init(128, 128, 1, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_USAGE_SAMPLED_BIT, VK_IMAGE_TILING_OPTIMAL, 0);
+    ASSERT_TRUE(image.initialized());
+    image.SetLayout(VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    VkImageView view = image.targetView(VK_FORMAT_R8G8B8A8_UNORM);
+
+    VkShaderObj fs(this, bindStateFragSamplerShaderText, VK_SHADER_STAGE_FRAGMENT_BIT);
+    CreatePipelineHelper pipe(*this);
+    pipe.InitInfo();
+    pipe.shader_stages_ = {pipe.vs_->GetStageCreateInfo(), fs.GetStageCreateInfo()};
+    pipe.dsl_bindings_ = {
+        {0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_ALL, nullptr},
+    };
+    pipe.InitState();
+    pipe.CreateGraphicsPipeline();
+
+    // None of the updates or draws below may report an error
+    pipe.descriptor_set_->WriteDescriptorImageInfo(0, view, sampler, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
+    for (uint32_t i = 0; i < kUpdateCount; ++i) {
+        pipe.descriptor_set_->UpdateDescriptorSets();
+    }
+
+    m_commandBuffer->begin();
+    m_commandBuffer->BeginRenderPass(m_renderPassBeginInfo);
+    vk::CmdBindPipeline(m_commandBuffer->handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipe.pipeline_);
+    vk::CmdBindDescriptorSets(m_commandBuffer->handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipe.pipeline_layout_.handle(), 0, 1,
+                              &pipe.descriptor_set_->set_, 0, nullptr);
+    for (uint32_t i = 0; i < kDrawCount; ++i) {
+        m_commandBuffer->Draw(3, 1, 0, 0);
+    }
+    m_commandBuffer->EndRenderPass();
+    m_commandBuffer->end();
+    m_commandBuffer->QueueCommandBuffer();
+    vk::QueueWaitIdle(m_device->m_queue);
+
+    // The command buffer must still reference the sampler, so destroying it invalidates the command buffer
+    vk::DestroySampler(m_device->device(), sampler, nullptr);
+    m_errorMonitor->SetDesiredFailureMsg(kErrorBit, "UNASSIGNED-CoreValidation-DrawState-InvalidCommandBuffer-VkSampler");
+    auto submit_info = LvlInitStruct<VkSubmitInfo>();
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = &m_commandBuffer->handle();
+    vk::QueueSubmit(m_device->m_queue, 1, &submit_info, VK_NULL_HANDLE);
+    m_errorMonitor->VerifyFound();
+}
@@ -6450,6 +6450,78 @@ TEST_F(VkLayerTest, CreateComputePipelineDescriptorTypeMismatch) {
                                              "but descriptor of type VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER");
 }
 
+// Keeps the text of the missing entry point errors, in the order they are reported
+static VKAPI_ATTR VkBool32 VKAPI_CALL CollectMissingEntrypointCallback(VkDebugUtilsMessageSeverityFlagBitsEXT,
+                                                                       VkDebugUtilsMessageTypeFlagsEXT,
+                                                                       const VkDebugUtilsMessengerCallbackDataEXT *callback_data,
+                                                                       void *user_data) {
+    if (callback_data->pMessageIdName &&
+        std::string(callback_data->pMessageIdName) == "VUID-VkPipelineShaderStageCreateInfo-pName-00707") {
+        reinterpret_cast<std::vector<std::string> *>(user_data)->emplace_back(callback_data->pMessage);
+    }
+    return VK_FALSE;
+}
+
+TEST_F(VkLayerTest, CreateManyInvalidComputePipelines) {
+    TEST_DESCRIPTION(
+        "Create a batch of compute pipelines, several of them invalid, validated on several threads, and check that the errors "
+        "are reported in pCreateInfos order.");
+
+    AddRequiredExtensions(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+    ScopedEnvironmentVariable pipeline_threads("VK_LAYER_PIPELINE_VALIDATION_THREADS", "4");
+    ASSERT_NO_FATAL_FAILURE(InitFramework(m_errorMonitor));
+    if (!AreRequiredExtensionsEnabled()) {
+        GTEST_SKIP() << RequiredExtensionsNotSupported() << " not supported";
+    }
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    CreateComputePipelineHelper pipe(*this);
+    pipe.InitInfo();
+    pipe.InitState();
+    pipe.LateBindPipelineInfo();
+
+    // Every fifth pipeline names an entry point its shader module does not have, each a different one
+    constexpr uint32_t pipeline_count = 64;
+    std::vector<std::string> names(pipeline_count, "main");
+    std::vector<std::string> missing_names;
+    std::vector<VkComputePipelineCreateInfo> create_infos(pipeline_count, pipe.cp_ci_);
+    for (uint32_t i = 0; i < pipeline_count; ++i) {
+        if (i % 5 == 3) {
+            names[i] = "missing_" + std::to_string(i);
+            missing_names.push_back(names[i]);
+        }
+        create_infos[i].stage.pName = names[i].c_str();
+    }
+
+    auto vkCreateDebugUtilsMessengerEXT = reinterpret_cast<PFN_vkCreateDebugUtilsMessengerEXT>(
+        vk::GetInstanceProcAddr(instance(), "vkCreateDebugUtilsMessengerEXT"));
+    auto vkDestroyDebugUtilsMessengerEXT = reinterpret_cast<PFN_vkDestroyDebugUtilsMessengerEXT>(
+        vk::GetInstanceProcAddr(instance(), "vkDestroyDebugUtilsMessengerEXT"));
+    ASSERT_TRUE(vkCreateDebugUtilsMessengerEXT && vkDestroyDebugUtilsMessengerEXT);
+    std::vector<std::string> messages;
+    auto messenger_create_info = LvlInitStruct<VkDebugUtilsMessengerCreateInfoEXT>();
+    messenger_create_info.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+    messenger_create_info.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT;
+    messenger_create_info.pfnUserCallback = CollectMissingEntrypointCallback;
+    messenger_create_info.pUserData = &messages;
+    VkDebugUtilsMessengerEXT messenger = VK_NULL_HANDLE;
+    ASSERT_VK_SUCCESS(vkCreateDebugUtilsMessengerEXT(instance(), &messenger_create_info, nullptr, &messenger));
+
+    for (size_t i = 0; i < missing_names.size(); ++i) {
+        m_errorMonitor->SetDesiredFailureMsg(kErrorBit, "VUID-VkPipelineShaderStageCreateInfo-pName-00707");
+    }
+    std::vector<VkPipeline> pipelines(pipeline_count, VK_NULL_HANDLE);
+    vk::CreateComputePipelines(m_device->device(), VK_NULL_HANDLE, pipeline_count, create_infos.data(), nullptr,
+                               pipelines.data());
+    m_errorMonitor->VerifyFound();
+    vkDestroyDebugUtilsMessengerEXT(instance(), messenger, nullptr);
+
+    ASSERT_EQ(messages.size(), missing_names.size());
+    for (size_t i = 0; i < missing_names.size(); ++i) {
+        EXPECT_NE(messages[i].find("`" + missing_names[i] + "`"), std::string::npos) << messages[i];
+    }
+}
+
 TEST_F(VkLayerTest, MultiplePushDescriptorSets) {
     TEST_DESCRIPTION("Verify an error message for multiple push descriptor sets.");
 
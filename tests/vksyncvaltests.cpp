@@ -23,6 +23,7 @@
  * Author: Shannon McPherson <shannon@lunarg.com>
  * Author: John Zulauf <jzulauf@lunarg.com>
  */
+#include <thread>
 #include <type_traits>
 
 #include "cast_utils.h"
@@ -4867,3 +4868,414 @@ TEST_F(VkSyncValTest, SyncQSRenderPass) {
     vk::QueueSubmit(m_device->m_queue, 1, &submit2, VK_NULL_HANDLE);
     m_errorMonitor->VerifyFound();
 }
+
+TEST_F(VkSyncValTest, SyncThreadedCommandBufferRecording) {
+    TEST_DESCRIPTION("Record command buffers concurrently, each guarded only by its own access context lock.");
+    ASSERT_NO_FATAL_FAILURE(InitSyncValFramework());
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    constexpr uint32_t kThreadCount = 4;
+    constexpr uint32_t kIterations = 1000;
+    VkMemoryPropertyFlags mem_prop = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    VkBufferObj buffer_a[kThreadCount];
+    VkBufferObj buffer_b[kThreadCount];
+    std::unique_ptr<VkCommandPoolObj> pools[kThreadCount];
+    std::unique_ptr<VkCommandBufferObj> cbs[kThreadCount];
+    for (uint32_t i = 0; i < kThreadCount; ++i) {
+        buffer_a[i].init_as_src_and_dst(*m_device, 256, mem_prop);
+        buffer_b[i].init_as_src_and_dst(*m_device, 256, mem_prop);
+        pools[i].reset(new VkCommandPoolObj(m_device, m_device->graphics_queue_node_index_));
+        cbs[i].reset(new VkCommandBufferObj(m_device, pools[i].get()));
+    }
+
+    VkBufferCopy region = {0, 0, 256};
+    auto mem_barrier = LvlInitStruct<VkMemoryBarrier>();
+    mem_barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+    mem_barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+
+    // Each thread ping-pongs between its own buffers, with barriers, so no hazards are expected
+    auto record = [&](uint32_t index) {
+        VkCommandBuffer cb = cbs[index]->handle();
+        cbs[index]->begin();
+        for (uint32_t iteration = 0; iteration < kIterations; ++iteration) {
+            const bool forward = (iteration % 2) == 0;
+            vk::CmdCopyBuffer(cb, forward ? buffer_a[index].handle() : buffer_b[index].handle(),
+                              forward ? buffer_b[index].handle() : buffer_a[index].handle(), 1, &region);
+            vk::CmdPipelineBarrier(cb, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &mem_barrier, 0,
+                                   nullptr, 0, nullptr);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < kThreadCount; ++i) {
+        threads.emplace_back(record, i);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // Each command buffer must still have its own accesses tracked: an unbarriered write after the last copy is a hazard
+    for (uint32_t i = 0; i < kThreadCount; ++i) {
+        m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT, "SYNC-HAZARD-WRITE_AFTER_WRITE");
+        vk::CmdCopyBuffer(cbs[i]->handle(), buffer_b[i].handle(), buffer_a[i].handle(), 1, &region);
+        vk::CmdCopyBuffer(cbs[i]->handle(), buffer_b[i].handle(), buffer_a[i].handle(), 1, &region);
+        m_errorMonitor->VerifyFound();
+        cbs[i]->end();
+    }
+}
+
+TEST_F(VkSyncValTest, SyncThreadedCommandBufferReRecording) {
+    TEST_DESCRIPTION("Re-record command buffers from a growing number of threads, each keeping its own access state.");
+    ASSERT_NO_FATAL_FAILURE(InitSyncValFramework());
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    constexpr uint32_t kMaxThreadCount = 8;
+    constexpr uint32_t kIterations = 2000;
+    VkMemoryPropertyFlags mem_prop = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    VkBufferObj buffer_a[kMaxThreadCount];
+    VkBufferObj buffer_b[kMaxThreadCount];
+    std::unique_ptr<VkCommandPoolObj> pools[kMaxThreadCount];
+    std::unique_ptr<VkCommandBufferObj> cbs[kMaxThreadCount];
+    for (uint32_t i = 0; i < kMaxThreadCount; ++i) {
+        buffer_a[i].init_as_src_and_dst(*m_device, 256, mem_prop);
+        buffer_b[i].init_as_src_and_dst(*m_device, 256, mem_prop);
+        // Command buffers are begun again in every round
+        pools[i].reset(
+            new VkCommandPoolObj(m_device, m_device->graphics_queue_node_index_, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT));
+        cbs[i].reset(new VkCommandBufferObj(m_device, pools[i].get()));
+    }
+
+    VkBufferCopy region = {0, 0, 256};
+    auto mem_barrier = LvlInitStruct<VkMemoryBarrier>();
+    mem_barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+    mem_barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+
+    // The ping-pong copies are separated by barriers, only the final unbarriered copy is a hazard. Since beginning the command
+    // buffer drops its previous access state, each round reports exactly one hazard per command buffer.
+    auto record = [&](uint32_t index) {
+        VkCommandBuffer cb = cbs[index]->handle();
+        cbs[index]->begin();
+        for (uint32_t iteration = 0; iteration < kIterations; ++iteration) {
+            const bool forward = (iteration % 2) == 0;
+            vk::CmdCopyBuffer(cb, forward ? buffer_a[index].handle() : buffer_b[index].handle(),
+                              forward ? buffer_b[index].handle() : buffer_a[index].handle(), 1, &region);
+            vk::CmdPipelineBarrier(cb, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &mem_barrier, 0,
+                                   nullptr, 0, nullptr);
+        }
+        vk::CmdCopyBuffer(cb, buffer_b[index].handle(), buffer_a[index].handle(), 1, &region);
+        vk::CmdCopyBuffer(cb, buffer_b[index].handle(), buffer_a[index].handle(), 1, &region);
+        cbs[index]->end();
+    };
+
+    for (uint32_t thread_count = 1; thread_count <= kMaxThreadCount; thread_count *= 2) {
+        for (uint32_t i = 0; i < thread_count; ++i) {
+            m_errorMonitor->SetDesiredFailureMsg(kErrorBit, "SYNC-HAZARD-WRITE_AFTER_WRITE");
+        }
+        std::vector<std::thread> threads;
+        for (uint32_t i = 0; i < thread_count; ++i) {
+            threads.emplace_back(record, i);
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        m_errorMonitor->VerifyFound();
+    }
+
+    // All the command buffers were recorded with barriers between their own copies only, and touch disjoint buffers
+    std::vector<VkCommandBuffer> handles;
+    for (uint32_t i = 0; i < kMaxThreadCount; ++i) {
+        handles.push_back(cbs[i]->handle());
+    }
+    auto submit_info = LvlInitStruct<VkSubmitInfo>();
+    submit_info.commandBufferCount = static_cast<uint32_t>(handles.size());
+    submit_info.pCommandBuffers = handles.data();
+    ASSERT_VK_SUCCESS(vk::QueueSubmit(m_device->m_queue, 1, &submit_info, VK_NULL_HANDLE));
+    vk::QueueWaitIdle(m_device->m_queue);
+}
+
+TEST_F(VkSyncValTest, SyncExecuteCommandsSelf) {
+    TEST_DESCRIPTION("Execute a primary command buffer within itself, which must be reported without deadlocking.");
+    ASSERT_NO_FATAL_FAILURE(InitSyncValFramework());
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    m_commandBuffer->begin();
+    VkCommandBuffer handle = m_commandBuffer->handle();
+    m_errorMonitor->SetDesiredFailureMsg(kErrorBit, "VUID-vkCmdExecuteCommands-pCommandBuffers-00088");
+    m_errorMonitor->SetAllowedFailureMsg("VUID-vkCmdExecuteCommands-pCommandBuffers-00089");
+    m_errorMonitor->SetAllowedFailureMsg("VUID-vkCmdExecuteCommands-pCommandBuffers-00092");
+    vk::CmdExecuteCommands(handle, 1, &handle);
+    m_errorMonitor->VerifyFound();
+    m_commandBuffer->end();
+}
+
+TEST_F(VkSyncValTest, Sync2PipelineBarrierWideMasks) {
+    TEST_DESCRIPTION("Order many copies with vkCmdPipelineBarrier2 using wide stage and access masks, which must convert exactly.");
+    SetTargetApiVersion(VK_API_VERSION_1_2);
+    ASSERT_NO_FATAL_FAILURE(InitSyncValFramework());
+    if (DeviceExtensionSupported(gpu(), nullptr, VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME)) {
+        m_device_extension_names.push_back(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME);
+    } else {
+        GTEST_SKIP() << "Synchronization2 not supported";
+    }
+
+    if (!CheckSynchronization2SupportAndInitState(this)) {
+        GTEST_SKIP() << "Synchronization2 not supported";
+    }
+    auto fpCmdPipelineBarrier2KHR = (PFN_vkCmdPipelineBarrier2KHR)vk::GetDeviceProcAddr(m_device->device(), "vkCmdPipelineBarrier2KHR");
+
+    VkBufferObj buffer_a;
+    VkBufferObj buffer_b;
+    VkMemoryPropertyFlags mem_prop = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    buffer_a.init_as_src_and_dst(*m_device, 256, mem_prop);
+    buffer_b.init_as_src_and_dst(*m_device, 256, mem_prop);
+    VkBufferCopy region = {0, 0, 256};
+
+    // The ALL_* stages and MEMORY_* accesses expand to most of the stage and access bits, so every barrier converts wide masks
+    auto mem_barrier = lvl_init_struct<VkMemoryBarrier2KHR>();
+    mem_barrier.srcStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT_KHR;
+    mem_barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT_KHR | VK_PIPELINE_STAGE_2_COPY_BIT_KHR;
+    mem_barrier.srcAccessMask = VK_ACCESS_2_MEMORY_WRITE_BIT_KHR;
+    mem_barrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT_KHR | VK_ACCESS_2_MEMORY_WRITE_BIT_KHR;
+    auto dep_info = lvl_init_struct<VkDependencyInfoKHR>();
+    dep_info.memoryBarrierCount = 1;
+    dep_info.pMemoryBarriers = &mem_barrier;
+
+    // Each copy reads the buffer the previous one wrote, which only the barrier between them makes safe
+    constexpr uint32_t kIterations = 1000;
+    auto cb = m_commandBuffer->handle();
+    m_commandBuffer->begin();
+    for (uint32_t iteration = 0; iteration < kIterations; ++iteration) {
+        const bool forward = (iteration % 2) == 0;
+        vk::CmdCopyBuffer(cb, forward ? buffer_a.handle() : buffer_b.handle(), forward ? buffer_b.handle() : buffer_a.handle(), 1,
+                          &region);
+        fpCmdPipelineBarrier2KHR(cb, &dep_info);
+    }
+
+    // ALL_GRAPHICS doesn't include the copy stage, so without COPY the barrier no longer protects the next copy
+    vk::CmdCopyBuffer(cb, buffer_a.handle(), buffer_b.handle(), 1, &region);
+    mem_barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT_KHR;
+    fpCmdPipelineBarrier2KHR(cb, &dep_info);
+    m_errorMonitor->SetDesiredFailureMsg(kErrorBit, "SYNC-HAZARD-READ_AFTER_WRITE");
+    m_errorMonitor->SetAllowedFailureMsg("SYNC-HAZARD-WRITE_AFTER_READ");
+    vk::CmdCopyBuffer(cb, buffer_b.handle(), buffer_a.handle(), 1, &region);
+    m_errorMonitor->VerifyFound();
+    m_commandBuffer->end();
+}
+
+TEST_F(VkSyncValTest, SyncAccessStateManyRanges) {
+    TEST_DESCRIPTION("Overwrite and read copies touching many separate ranges, then check hazards against single ranges and gaps.");
+    ASSERT_NO_FATAL_FAILURE(InitSyncValFramework());
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    // Each region leaves a gap after it, so every region is a separate range in the access maps of both buffers
+    constexpr uint32_t kRegionCount = 4096;
+    constexpr VkDeviceSize kRegionStride = 64;
+    constexpr uint32_t kIterations = 4;
+    std::vector<VkBufferCopy> regions(kRegionCount);
+    for (uint32_t i = 0; i < kRegionCount; ++i) {
+        regions[i] = {i * kRegionStride, i * kRegionStride, kRegionStride / 2};
+    }
+    VkBufferObj buffer_a;
+    VkBufferObj buffer_b;
+    VkBufferObj buffer_c;
+    VkMemoryPropertyFlags mem_prop = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    buffer_a.init_as_src_and_dst(*m_device, kRegionCount * kRegionStride, mem_prop);
+    buffer_b.init_as_src_and_dst(*m_device, kRegionCount * kRegionStride, mem_prop);
+    buffer_c.init_as_src_and_dst(*m_device, kRegionCount * kRegionStride, mem_prop);
+
+    auto barrier = lvl_init_struct<VkMemoryBarrier>();
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+
+    auto cb = m_commandBuffer->handle();
+    m_commandBuffer->begin();
+    vk::CmdCopyBuffer(cb, buffer_a.handle(), buffer_b.handle(), kRegionCount, regions.data());
+
+    // Every region is checked against, and then replaces, the write of the previous iteration
+    for (uint32_t iteration = 0; iteration < kIterations; ++iteration) {
+        vk::CmdPipelineBarrier(cb, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0,
+                               nullptr);
+        vk::CmdCopyBuffer(cb, buffer_a.handle(), buffer_b.handle(), kRegionCount, regions.data());
+    }
+
+    // Every region is checked against the last write and adds a read, the last copy is left without a barrier
+    vk::CmdPipelineBarrier(cb, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0,
+                           nullptr);
+    for (uint32_t iteration = 0; iteration < kIterations; ++iteration) {
+        if (iteration > 0) {
+            vk::CmdPipelineBarrier(cb, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr,
+                                   0, nullptr);
+        }
+        vk::CmdCopyBuffer(cb, buffer_b.handle(), buffer_c.handle(), kRegionCount, regions.data());
+    }
+
+    // The gaps between the regions were never accessed
+    VkBufferCopy gap = {kRegionStride / 2, (kRegionCount - 1) * kRegionStride + kRegionStride / 2, kRegionStride / 2};
+    vk::CmdCopyBuffer(cb, buffer_c.handle(), buffer_b.handle(), 1, &gap);
+
+    // While the last region of buffer_c has the write of the last copy, and that of buffer_b its read
+    const VkBufferCopy last = regions.back();
+    m_errorMonitor->SetDesiredFailureMsg(kErrorBit, "SYNC-HAZARD-READ_AFTER_WRITE");
+    vk::CmdCopyBuffer(cb, buffer_c.handle(), buffer_a.handle(), 1, &last);
+    m_errorMonitor->VerifyFound();
+    const VkBufferCopy overwrite_last = {0, last.dstOffset, last.size};
+    m_errorMonitor->SetDesiredFailureMsg(kErrorBit, "SYNC-HAZARD-WRITE_AFTER_READ");
+    vk::CmdCopyBuffer(cb, buffer_a.handle(), buffer_b.handle(), 1, &overwrite_last);
+    m_errorMonitor->VerifyFound();
+    m_commandBuffer->end();
+}
+
+// Submits a copy to buffer_b, then enough fills of buffer_d to exceed an access log limit of 1 MiB, and checks how the hazards
+// against the copy and the last fills report their prior usage
+void VkSyncValTest::AccessLogLimitTest(const char *compaction, const char *old_usage_message) {
+    ScopedEnvironmentVariable limit_env("VK_LAYER_SYNCVAL_ACCESS_LOG_LIMIT", "1");
+    ScopedEnvironmentVariable compaction_env("VK_LAYER_SYNCVAL_ACCESS_LOG_COMPACTION", compaction);
+    ASSERT_NO_FATAL_FAILURE(InitSyncValFramework(true));  // Enable QueueSubmit validation
+    ASSERT_NO_FATAL_FAILURE(InitState(nullptr, nullptr, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT));
+
+    // 1 MiB holds 32768 usage records of 32 bytes, so the fill batches log more records than the limit
+    constexpr uint32_t kFillCount = 4096;
+    constexpr uint32_t kFillSubmits = 10;
+    VkBufferObj buffer_a;
+    VkBufferObj buffer_b;
+    VkBufferObj buffer_d;
+    VkMemoryPropertyFlags mem_prop = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    buffer_a.init_as_src_and_dst(*m_device, 256, mem_prop);
+    buffer_b.init_as_src_and_dst(*m_device, 256, mem_prop);
+    buffer_d.init_as_src_and_dst(*m_device, kFillCount * 4, mem_prop);
+
+    VkBufferCopy region = {0, 0, 256};
+    VkCommandBufferObj cb_copy(m_device, m_commandPool);
+    cb_copy.begin();
+    vk::CmdCopyBuffer(cb_copy.handle(), buffer_a.handle(), buffer_b.handle(), 1, &region);
+    cb_copy.end();
+
+    // The barrier orders the fills after those of the previous submission of the same command buffer
+    auto barrier = lvl_init_struct<VkMemoryBarrier>();
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    VkCommandBufferObj cb_fill(m_device, m_commandPool);
+    auto begin_info = lvl_init_struct<VkCommandBufferBeginInfo>();
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+    cb_fill.begin(&begin_info);
+    vk::CmdPipelineBarrier(cb_fill.handle(), VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0,
+                           nullptr, 0, nullptr);
+    for (uint32_t i = 0; i < kFillCount; ++i) {
+        vk::CmdFillBuffer(cb_fill.handle(), buffer_d.handle(), i * 4, 4, i);
+    }
+    cb_fill.end();
+
+    VkCommandBufferObj cb_fill_b(m_device, m_commandPool);
+    cb_fill_b.begin();
+    vk::CmdFillBuffer(cb_fill_b.handle(), buffer_b.handle(), 0, 256, 0);
+    cb_fill_b.end();
+
+    VkCommandBufferObj cb_copy_d(m_device, m_commandPool);
+    cb_copy_d.begin();
+    vk::CmdCopyBuffer(cb_copy_d.handle(), buffer_a.handle(), buffer_d.handle(), 1, &region);
+    cb_copy_d.end();
+
+    auto submit = lvl_init_struct<VkSubmitInfo>();
+    submit.commandBufferCount = 1;
+    submit.pCommandBuffers = &cb_copy.handle();
+    vk::QueueSubmit(m_device->m_queue, 1, &submit, VK_NULL_HANDLE);
+    submit.pCommandBuffers = &cb_fill.handle();
+    for (uint32_t i = 0; i < kFillSubmits; ++i) {
+        vk::QueueSubmit(m_device->m_queue, 1, &submit, VK_NULL_HANDLE);
+    }
+
+    // The hazard against the oldest batch is still detected, whether or not its usage record was retained
+    m_errorMonitor->SetDesiredFailureMsg(kErrorBit, old_usage_message);
+    submit.pCommandBuffers = &cb_fill_b.handle();
+    vk::QueueSubmit(m_device->m_queue, 1, &submit, VK_NULL_HANDLE);
+    m_errorMonitor->VerifyFound();
+
+    // The records of the newest batch are always retained
+    m_errorMonitor->SetDesiredFailureMsg(kErrorBit, "command: vkCmdFillBuffer");
+    submit.pCommandBuffers = &cb_copy_d.handle();
+    vk::QueueSubmit(m_device->m_queue, 1, &submit, VK_NULL_HANDLE);
+    m_errorMonitor->VerifyFound();
+
+    m_device->wait();
+}
+
+TEST_F(VkSyncValTest, SyncAccessLogCompactionUnderLimit) {
+    TEST_DESCRIPTION("Compaction retires unreferenced usage records before the access log limit drops referenced ones.");
+    AccessLogLimitTest("true", "command: vkCmdCopyBuffer");
+}
+
+TEST_F(VkSyncValTest, SyncAccessLogLimit) {
+    TEST_DESCRIPTION("Without compaction the access log limit drops the oldest records, which hazards then report as such.");
+    AccessLogLimitTest("false", "command buffer usage record not retained");
+}
+
+TEST_F(VkSyncValTest, SyncQSSharedBatchStateCopyOnWrite) {
+    TEST_DESCRIPTION("A batch starting from the state of the previous one copies only what it writes, and hazards see both.");
+    ASSERT_NO_FATAL_FAILURE(InitSyncValFramework(true));  // Enable QueueSubmit validation
+    ASSERT_NO_FATAL_FAILURE(InitState(nullptr, nullptr, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT));
+
+    VkBufferObj buffer_a;
+    VkBufferObj buffer_b;
+    VkBufferObj buffer_c;
+    VkBufferObj buffer_e;
+    VkMemoryPropertyFlags mem_prop = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    buffer_a.init_as_src_and_dst(*m_device, 256, mem_prop);
+    buffer_b.init_as_src_and_dst(*m_device, 256, mem_prop);
+    buffer_c.init_as_src_and_dst(*m_device, 256, mem_prop);
+    buffer_e.init_as_src_and_dst(*m_device, 256, mem_prop);
+    VkBufferCopy region = {0, 0, 256};
+
+    // Submit 0 writes buffer_b and buffer_e
+    VkCommandBufferObj cb_write(m_device, m_commandPool);
+    cb_write.begin();
+    vk::CmdCopyBuffer(cb_write.handle(), buffer_a.handle(), buffer_b.handle(), 1, &region);
+    vk::CmdCopyBuffer(cb_write.handle(), buffer_a.handle(), buffer_e.handle(), 1, &region);
+    cb_write.end();
+
+    // Submit 1 starts from the state of submit 0, and writes buffer_b again after a barrier for buffer_b only
+    auto buffer_barrier = LvlInitStruct<VkBufferMemoryBarrier>();
+    buffer_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    buffer_barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    buffer_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    buffer_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    buffer_barrier.buffer = buffer_b.handle();
+    buffer_barrier.offset = 0;
+    buffer_barrier.size = VK_WHOLE_SIZE;
+    VkCommandBufferObj cb_rewrite(m_device, m_commandPool);
+    cb_rewrite.begin();
+    vk::CmdPipelineBarrier(cb_rewrite.handle(), VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 1,
+                           &buffer_barrier, 0, nullptr);
+    vk::CmdCopyBuffer(cb_rewrite.handle(), buffer_a.handle(), buffer_b.handle(), 1, &region);
+    cb_rewrite.end();
+
+    VkCommandBufferObj cb_read_b(m_device, m_commandPool);
+    cb_read_b.begin();
+    vk::CmdCopyBuffer(cb_read_b.handle(), buffer_b.handle(), buffer_c.handle(), 1, &region);
+    cb_read_b.end();
+
+    VkCommandBufferObj cb_read_e(m_device, m_commandPool);
+    cb_read_e.begin();
+    vk::CmdCopyBuffer(cb_read_e.handle(), buffer_e.handle(), buffer_c.handle(), 1, &region);
+    cb_read_e.end();
+
+    auto submit = lvl_init_struct<VkSubmitInfo>();
+    submit.commandBufferCount = 1;
+    submit.pCommandBuffers = &cb_write.handle();
+    vk::QueueSubmit(m_device->m_queue, 1, &submit, VK_NULL_HANDLE);
+    submit.pCommandBuffers = &cb_rewrite.handle();
+    vk::QueueSubmit(m_device->m_queue, 1, &submit, VK_NULL_HANDLE);
+
+    // The write copied into the state of submit 1 is the prior usage of buffer_b
+    m_errorMonitor->SetDesiredFailureMsg(kErrorBit, "submit: 1, batch: 0");
+    submit.pCommandBuffers = &cb_read_b.handle();
+    vk::QueueSubmit(m_device->m_queue, 1, &submit, VK_NULL_HANDLE);
+    m_errorMonitor->VerifyFound();
+
+    // While buffer_e, which submit 1 did not write, still has the write of submit 0
+    m_errorMonitor->SetDesiredFailureMsg(kErrorBit, "submit: 0, batch: 0");
+    submit.pCommandBuffers = &cb_read_e.handle();
+    vk::QueueSubmit(m_device->m_queue, 1, &submit, VK_NULL_HANDLE);
+    m_errorMonitor->VerifyFound();
+
+    m_device->wait();
+}